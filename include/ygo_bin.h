@@ -10,13 +10,26 @@ extern "C" {
 
 #define YGO_CARD_DATA_MAGIC_WORD                                                                   \
     { '\x0E', 'Y', 'G', 'O' }
-#define YGO_CARD_DATA_VERSION 0x00
+#define YGO_CARD_DATA_VERSION 0x02
+
+// BASIC record versions understood by the reader. Only the encoding of the name differs. Writers
+// use PACKED_NAME when it makes the name shorter, SHORT_NAME otherwise.
+#define YGO_CARD_DATA_VERSION_FIXED_NAME 0x00  // Null-padded to YGO_CARD_NAME_MAX_LEN bytes
+#define YGO_CARD_DATA_VERSION_SHORT_NAME 0x01  // One length byte, then that many bytes
+#define YGO_CARD_DATA_VERSION_PACKED_NAME 0x02 // Same, but the bytes come from ygo_name_pack()
 
 enum ygo_bin_errno {
     YGO_BIN_OK = 0x00,
     YGO_BIN_ERR_BAD_ARGS,
     YGO_BIN_ERR_BAD_MAGIC_WORD,
     YGO_BIN_ERR_BAD_CHECKSUM,
+    YGO_BIN_ERR_TRUNCATED,
+    YGO_BIN_ERR_END_OF_DATA,
+    YGO_BIN_ERR_BAD_VERSION,
+    YGO_BIN_ERR_NOT_FOUND,
+    YGO_BIN_ERR_IO,
+    YGO_BIN_ERR_NO_MEMORY,
+    YGO_BIN_ERR_BAD_LENGTH, // A length field claims more than its record can hold
 };
 
 typedef enum ygo_bin_errno ygo_bin_errno_t;
@@ -75,6 +88,35 @@ typedef struct {
     ygo_bin_errno_t err;
 } ygo_bin_read_context_t;
 
+/**
+ * Zero-copy view of one record inside a larger buffer. All pointers point into the buffer the
+ * cursor was started on, so they are only valid as long as that buffer is.
+ */
+typedef struct {
+    ygo_bin_record_header_t header;
+
+    // Start of the record header. Pass this to a record decoder, e.g. ygo_card_deserialize().
+    const uint8_t *record;
+
+    // Data following the header, excluding the checksum trailer (but including padding).
+    const uint8_t *payload;
+    size_t payload_len;
+
+    // Checksum stored in the trailer. Use ygo_bin_record_check_crc() to verify it.
+    uint16_t crc;
+} ygo_bin_record_view_t;
+
+/**
+ * Length-bounded cursor over a buffer of records, e.g. a whole tag image. Records are never
+ * parsed while walking, the record_length in each header is used to jump to the next one.
+ */
+typedef struct {
+    const uint8_t *buffer;
+    size_t len;
+    size_t ptr;
+    ygo_bin_errno_t err;
+} ygo_bin_cursor_t;
+
 void ygo_bin_begin_data_write(ygo_bin_write_context_t *ctx, uint8_t *buffer);
 
 ygo_bin_errno_t ygo_bin_begin_data_read(ygo_bin_read_context_t *ctx, const uint8_t *buffer);
@@ -90,6 +132,14 @@ ygo_bin_errno_t ygo_bin_read_record_header(ygo_bin_read_context_t *ctx,
 
 void ygo_bin_write_record_end(ygo_bin_write_context_t *ctx);
 
+/**
+ * Close the current record like ygo_bin_write_record_end(), but write a zero checksum. Meant for
+ * batch writers which compute the checksums of many records at once with
+ * ygo_bin_calculate_crc_many() and patch them in afterwards.
+ * @return Length of the record, which is where its checksum goes relative to the header.
+ */
+uint16_t ygo_bin_write_record_end_deferred(ygo_bin_write_context_t *ctx);
+
 ygo_bin_errno_t ygo_bin_check_record_end(ygo_bin_read_context_t *ctx);
 
 // Optimized read/write functions for 8-bit systems
@@ -124,8 +174,75 @@ void ygo_bin_write_str(ygo_bin_write_context_t *ctx, const char *str, size_t len
  */
 ygo_bin_errno_t ygo_bin_read_str(ygo_bin_read_context_t *ctx, char *str, size_t len);
 
+/**
+ * Start a cursor on a buffer of len bytes. The buffer must start with the magic word, which is
+ * checked here once.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_MAGIC_WORD, or YGO_BIN_ERR_TRUNCATED
+ */
+ygo_bin_errno_t ygo_bin_cursor_begin(ygo_bin_cursor_t *cur, const uint8_t *buffer, size_t len);
+
+/**
+ * Move to the next record and fill in a view of it. Empty (zeroed) tag memory or the end of the
+ * buffer both end the walk with YGO_BIN_ERR_END_OF_DATA. A record whose length runs past the
+ * end of the buffer yields YGO_BIN_ERR_TRUNCATED and stops the cursor.
+ */
+ygo_bin_errno_t ygo_bin_cursor_next(ygo_bin_cursor_t *cur, ygo_bin_record_view_t *view);
+
+/**
+ * Move to the next record of the given type, skipping over any others without looking at their
+ * contents. Returns YGO_BIN_ERR_END_OF_DATA if there is none.
+ */
+ygo_bin_errno_t ygo_bin_cursor_find(ygo_bin_cursor_t *cur,
+                                    ygo_bin_record_type_t type,
+                                    ygo_bin_record_view_t *view);
+
+/**
+ * Verify the checksum of a record view. Records are not checked while walking, so only the
+ * ones that actually get decoded pay for it.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_BAD_CHECKSUM
+ */
+ygo_bin_errno_t ygo_bin_record_check_crc(const ygo_bin_record_view_t *view);
+
+/**
+ * Write a length-prefixed string: one byte holding the length (up to the first null character,
+ * at most max_len), followed by that many bytes. No terminator or padding is written.
+ * @param ctx Write context
+ * @param str String to write
+ * @param max_len Maximum number of bytes to take from str, at most 255
+ */
+void ygo_bin_write_lstr(ygo_bin_write_context_t *ctx, const char *str, size_t max_len);
+
+/**
+ * Read a string written by ygo_bin_write_lstr(). Up to len bytes are copied into str and the rest
+ * of str is null-filled. Bytes that don't fit are skipped.
+ * @param ctx Read context
+ * @param str Destination buffer
+ * @param len Size of the destination buffer
+ * @return YGO_BIN_OK on success
+ */
+ygo_bin_errno_t ygo_bin_read_lstr(ygo_bin_read_context_t *ctx, char *str, size_t len);
+
 uint16_t ygo_bin_calculate_crc(const uint8_t *buffer, size_t size);
 
+/**
+ * Incremental form of ygo_bin_calculate_crc(), for data which arrives in pieces, e.g. SPI chunks.
+ * Feeding a buffer through init, any number of updates, and final gives the same checksum as
+ * ygo_bin_calculate_crc() on the whole buffer.
+ */
+uint16_t ygo_bin_crc_init(void);
+uint16_t ygo_bin_crc_update(uint16_t crc, const uint8_t *buffer, size_t size);
+uint16_t ygo_bin_crc_final(uint16_t crc);
+
+/**
+ * Calculate the checksums of n independent buffers, same as calling ygo_bin_calculate_crc() on
+ * each of them. The buffers are processed interleaved, so table lookups of different records
+ * overlap instead of forming one long dependency chain.
+ */
+void ygo_bin_calculate_crc_many(const uint8_t *const *buffers,
+                                const size_t *sizes,
+                                uint16_t *crcs,
+                                size_t n);
+
 #ifdef __cplusplus
 }
 #endif
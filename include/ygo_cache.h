@@ -0,0 +1,109 @@
+#ifndef __ygo_cache_h
+#define __ygo_cache_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Decoded card cache, for hosts which read the same tags over and over: a card lifted off a pad
+ * and put back reads back the same bytes, so those bytes are hashed and looked up before
+ * anything is decoded. A repeat read costs one hash of the tag image and a table probe, instead
+ * of a decode, a checksum and a signature check.
+ *
+ * The hash is SipHash-2-4 under a key chosen when the cache is set up. Being keyed, nobody who
+ * doesn't know the key can write a tag whose bytes hash like those of a verified card, so the
+ * verification state of an entry can be trusted as long as the key is random and kept on the
+ * host.
+ *
+ * Entries are evicted with CLOCK: every hit marks its entry, and the hand going round for a
+ * victim clears marks until it finds an entry which wasn't used since the last time around.
+ *
+ * Everything lives in memory given by the caller, nothing is allocated.
+ */
+
+#define YGO_CACHE_VERIFY_DEFS(X, V)                                                                \
+    X(YGO_CACHE_VERIFY_UNKNOWN, "unknown")                                                         \
+    X(YGO_CACHE_VERIFY_VALID, "valid")                                                             \
+    X(YGO_CACHE_VERIFY_INVALID, "invalid")
+
+/**
+ * Signature state of a cached card, set by the caller once it has checked the signature.
+ */
+ENUM_DECL(ygo_cache_verify, YGO_CACHE_VERIFY_DEFS);
+
+typedef struct {
+    uint64_t hash;
+    uint32_t len;
+    ygo_cache_verify_t verify;
+    uint8_t referenced; // CLOCK mark, set on every hit
+    ygo_card_t card;
+} ygo_cache_entry_t;
+
+typedef struct {
+    ygo_cache_entry_t *entries;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t hand;
+
+    // Open addressing table of entry + 1 per cached image, 0 when free.
+    uint32_t *slots;
+    uint32_t slot_count;
+
+    uint64_t key[2];
+
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} ygo_cache_t;
+
+/**
+ * Set up an empty cache of capacity entries. slot_count must be a power of two larger than
+ * capacity, twice as large keeps probes short.
+ * @param key 16 random bytes, e.g. from esp_fill_random() or getrandom()
+ * @return YGO_BIN_OK or YGO_BIN_ERR_BAD_ARGS
+ */
+ygo_bin_errno_t ygo_cache_init(ygo_cache_t *cache,
+                               ygo_cache_entry_t *entries,
+                               size_t capacity,
+                               uint32_t *slots,
+                               size_t slot_count,
+                               const uint8_t key[16]);
+
+/**
+ * Drop every entry and reset the counters.
+ */
+void ygo_cache_clear(ygo_cache_t *cache);
+
+/**
+ * Keyed hash of len bytes, as the cache computes it.
+ */
+uint64_t ygo_cache_hash(const ygo_cache_t *cache, const uint8_t *data, size_t len);
+
+/**
+ * Cached entry for the tag image in data, decoding it on a miss. Pass the image exactly as read
+ * (BASIC record first, signature records after it), so a card whose signature changed is a
+ * different entry. A miss evicts the least recently used entry once the cache is full, and the
+ * new entry starts as YGO_CACHE_VERIFY_UNKNOWN.
+ *
+ * The entry stays valid until the next call which may evict, set its verify field after checking
+ * the signature.
+ *
+ * @return YGO_BIN_OK, or the decode error from ygo_card_deserialize_many() in which case nothing
+ *         is cached and entry is set to NULL
+ */
+ygo_bin_errno_t ygo_cache_decode(ygo_cache_t *cache,
+                                 const uint8_t *data,
+                                 size_t len,
+                                 ygo_cache_entry_t **entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #define __ygo_card_h
 
 #include "../src/internals.h"
+#include "ygo_bin.h"
 #include <stdint.h>
 
 // Static assert compatibility for older AVR toolchains
@@ -34,7 +35,10 @@ ENUM_DECL(ygo_card_type, YGO_CARD_TYPE_DEFS);
 
 #define IS_MONSTER(type) (type & 0x80)
 #define IS_TRAP_MONSTER(type) ((!(type & 0x80u)) && (type & 0x40u))
-#define GET_CARD_TYPE(type) ((ygo_card_type_t)((type & 0x80u) || (type & 0x40u) || (type & 0x30u)))
+#define GET_CARD_TYPE(type)                                                                        \
+    ((ygo_card_type_t)(((type) & 0x80u)   ? 0x80u                                                  \
+                       : ((type) & 0x40u) ? 0x40u                                                  \
+                                          : ((type) & 0x30u)))
 
 #define YGO_MONSTER_FLAG_DEFS(B)                                                                   \
     B(YGO_MONSTER_FLAG_TUNER, "Tuner", 3u)                                                         \
@@ -226,6 +230,29 @@ struct _packed_ ygo_card {
 
 typedef struct ygo_card ygo_card_t;
 
+// Layout of a BASIC record: header, fixed fields, then the name. Offsets of the fixed fields are
+// relative to the end of the header, see docs/card_formats.md. YGO_CARD_BASIC_BLOCK_LEN is the
+// size of a version 0x00 record, whose name is always padded to YGO_CARD_NAME_MAX_LEN.
+#define YGO_CARD_BASIC_HEADER_LEN 4
+#define YGO_CARD_BASIC_FIXED_LEN 16
+#define YGO_CARD_BASIC_BLOCK_LEN                                                                   \
+    (YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_FIXED_LEN + YGO_CARD_NAME_MAX_LEN)
+
+// Largest BASIC record of any version, up to and including the checksum trailer: a length byte
+// and a full name, padded to 4 bytes. Records whose header claims more are rejected.
+#define YGO_CARD_BASIC_MAX_LEN ((((YGO_CARD_BASIC_BLOCK_LEN + 1) + 3) & ~3) + 4)
+
+#define YGO_CARD_BASIC_OFFSET_ID 0
+#define YGO_CARD_BASIC_OFFSET_TYPE1 4
+#define YGO_CARD_BASIC_OFFSET_TYPE0 5
+#define YGO_CARD_BASIC_OFFSET_ATK 8
+#define YGO_CARD_BASIC_OFFSET_DEF 10
+#define YGO_CARD_BASIC_OFFSET_LEVEL 12
+#define YGO_CARD_BASIC_OFFSET_ATTRIBUTE 13
+#define YGO_CARD_BASIC_OFFSET_SCALE 14
+#define YGO_CARD_BASIC_OFFSET_LINK_MARKERS 15
+#define YGO_CARD_BASIC_OFFSET_NAME 16 // Version 0x01 and up: length byte, name follows it
+
 /////
 
 /**
@@ -235,10 +262,108 @@ typedef struct ygo_card ygo_card_t;
 size_t ygo_card_serialize(uint8_t *buffer, const ygo_card_t *card);
 
 /**
- * Deserialize a card buffer into a card object.
+ * Same as ygo_card_serialize(), but always version 0x01 with the name in plain bytes. Unlike the
+ * dictionary coded form, this doesn't change with the name dictionary, so it is the encoding
+ * signatures cover (see ygo_sig_card_hash()).
+ */
+size_t ygo_card_serialize_plain(uint8_t *buffer, const ygo_card_t *card);
+
+/**
+ * Deserialize a card buffer into a card object. The record length and name length come from the
+ * buffer and are checked against what its version allows, so at most YGO_CARD_BASIC_MAX_LEN
+ * bytes are read.
+ * @return Number of bytes read, or 0 (card untouched) if a length is out of range
  */
 size_t ygo_card_deserialize(ygo_card_t *card, const uint8_t *buffer);
 
+/**
+ * Number of bytes of the BASIC record at record (its header, past the magic word) up to and
+ * including the checksum trailer, i.e. what ygo_card_deserialize() reads after the magic word.
+ * Records can be copied or compared as bytes with this, without decoding them.
+ * @return The size, or 0 if len bytes can't hold the record
+ */
+size_t ygo_card_record_size(const uint8_t *record, size_t len);
+
+/**
+ * Serialize n cards back to back into one buffer, each exactly as ygo_card_serialize() writes it.
+ * The checksums are computed together once a group of records has been written. A NULL buffer
+ * only returns the required size.
+ * @return Total number of bytes written.
+ */
+size_t ygo_card_serialize_many(uint8_t *buffer, const ygo_card_t *cards, size_t n);
+
+/**
+ * Deserialize n cards from a buffer of len bytes holding back to back ygo_card_serialize()
+ * images, e.g. the output of ygo_card_serialize_many(). status[i] receives the result for card i:
+ * YGO_BIN_OK or YGO_BIN_ERR_BAD_CHECKSUM for cards which were decoded, and the reason (bad magic
+ * word, truncated, bad length, end of data) for the first card which couldn't be located and all
+ * following.
+ * @return Number of bytes consumed.
+ */
+size_t ygo_card_deserialize_many(ygo_card_t *cards,
+                                 ygo_bin_errno_t *status,
+                                 size_t n,
+                                 const uint8_t *buffer,
+                                 size_t len);
+
+/**
+ * Progress of a streaming decode, in the order the parts of the image arrive. Once the state is
+ * past YGO_CARD_STREAM_FIXED, all fields of the card except the name are valid.
+ */
+enum ygo_card_stream_state {
+    YGO_CARD_STREAM_MAGIC = 0x00,
+    YGO_CARD_STREAM_HEADER,
+    YGO_CARD_STREAM_FIXED,
+    YGO_CARD_STREAM_NAME_LEN,
+    YGO_CARD_STREAM_NAME,
+    YGO_CARD_STREAM_PADDING,
+    YGO_CARD_STREAM_CHECKSUM,
+    YGO_CARD_STREAM_DONE,
+};
+
+typedef enum ygo_card_stream_state ygo_card_stream_state_t;
+
+/**
+ * Resumable decoder for a ygo_card_serialize() image which arrives in pieces, e.g. Q_CARD_DATA
+ * chunks over SPI. Only the header, fixed fields and name are kept, the checksum is updated as
+ * the bytes come in, so nothing has to be buffered by the caller.
+ */
+typedef struct {
+    ygo_card_t *card;
+    ygo_card_stream_state_t state;
+    ygo_bin_errno_t err;
+    uint16_t crc;
+
+    // Bytes of the record received so far, counted from its header, and where the current state
+    // ends. record[] holds the longest name, longer ones are rejected with YGO_BIN_ERR_BAD_LENGTH.
+    size_t pos;
+    size_t end;
+    uint8_t
+        record[YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_FIXED_LEN + 1 + YGO_CARD_NAME_MAX_LEN];
+
+    // Magic word or checksum trailer, whichever is being received.
+    uint8_t word[4];
+    uint8_t word_pos;
+
+    // Total number of input bytes used, i.e. the image size once the state is DONE.
+    size_t consumed;
+} ygo_card_stream_t;
+
+/**
+ * Start decoding a new image into card.
+ */
+void ygo_card_stream_begin(ygo_card_stream_t *stream, ygo_card_t *card);
+
+/**
+ * Feed the next len bytes of the image. Bytes past the end of the image (other records on the
+ * tag) are left alone, stream->consumed tells where the image ended.
+ * @return YGO_BIN_OK while the image is fine so far, check stream->state for how much of the card
+ *         is valid. Otherwise YGO_BIN_ERR_BAD_MAGIC_WORD, YGO_BIN_ERR_BAD_ARGS (not a BASIC
+ *         record), YGO_BIN_ERR_BAD_VERSION, YGO_BIN_ERR_BAD_LENGTH or YGO_BIN_ERR_BAD_CHECKSUM,
+ *         which sticks to the stream.
+ */
+ygo_bin_errno_t ygo_card_stream_update(ygo_card_stream_t *stream, const uint8_t *data, size_t len);
+
 #ifdef YGO_ENABLE_PRINT_DEBUG
 /**
  * Print card data to stdout. Requires stdio.h (printf).
@@ -0,0 +1,159 @@
+#ifndef __ygo_card_view_h
+#define __ygo_card_view_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include "ygo_name.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Read-only view of a serialized BASIC record. Rather than decoding a whole ygo_card_t (and
+ * copying its 64 byte name), each getter decodes just its own field from the record bytes. The
+ * view only holds a pointer, so the record must outlive it.
+ *
+ * Getters return the same values ygo_card_deserialize() would store in the matching field.
+ */
+typedef struct {
+    // First byte after the record header, i.e. the card id.
+    const uint8_t *data;
+    uint8_t data_version;
+} ygo_card_view_t;
+
+/**
+ * Point a view at a BASIC record of len bytes, starting at its header (the same place
+ * ygo_card_deserialize() expects). The checksum is not verified, use ygo_bin_record_check_crc()
+ * for that when the record comes from a ygo_bin_cursor_t.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_ARGS if this isn't a BASIC record,
+ *         YGO_BIN_ERR_BAD_VERSION for an unknown data_version, or YGO_BIN_ERR_TRUNCATED if len
+ *         can't hold the record.
+ */
+static inline ygo_bin_errno_t ygo_card_view_init(ygo_card_view_t *view,
+                                                 const uint8_t *record,
+                                                 size_t len) {
+    const size_t fixed_end = YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME;
+    if (view == NULL || record == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    if (len <= fixed_end) return YGO_BIN_ERR_TRUNCATED;
+    if (record[0] != BIN_RECORD_CARD_BASIC) return YGO_BIN_ERR_BAD_ARGS;
+
+    switch (record[1]) {
+    case YGO_CARD_DATA_VERSION_FIXED_NAME:
+        if (len < fixed_end + YGO_CARD_NAME_MAX_LEN) return YGO_BIN_ERR_TRUNCATED;
+        break;
+    case YGO_CARD_DATA_VERSION_SHORT_NAME:
+    case YGO_CARD_DATA_VERSION_PACKED_NAME:
+        if (len < fixed_end + 1 + record[fixed_end]) return YGO_BIN_ERR_TRUNCATED;
+        break;
+    default: return YGO_BIN_ERR_BAD_VERSION;
+    }
+
+    view->data = record + YGO_CARD_BASIC_HEADER_LEN;
+    view->data_version = record[1];
+    return YGO_BIN_OK;
+}
+
+static inline uint32_t ygo_card_view_id(const ygo_card_view_t *view) {
+    return ygo_load_be32(view->data + YGO_CARD_BASIC_OFFSET_ID);
+}
+
+static inline ygo_card_type_t ygo_card_view_type(const ygo_card_view_t *view) {
+    return GET_CARD_TYPE(view->data[YGO_CARD_BASIC_OFFSET_TYPE1]);
+}
+
+static inline ygo_monster_flag_t ygo_card_view_flags(const ygo_card_view_t *view) {
+    return GET_MONSTER_FLAG(view->data[YGO_CARD_BASIC_OFFSET_TYPE1]);
+}
+
+static inline ygo_monster_ability_t ygo_card_view_ability(const ygo_card_view_t *view) {
+    return GET_ABILITY(view->data[YGO_CARD_BASIC_OFFSET_TYPE1]);
+}
+
+static inline ygo_summon_type_t ygo_card_view_summon(const ygo_card_view_t *view) {
+    return GET_SUMMON_TYPE(view->data[YGO_CARD_BASIC_OFFSET_TYPE0]);
+}
+
+static inline ygo_monster_type_t ygo_card_view_monster_type(const ygo_card_view_t *view) {
+    return GET_MONSTER_TYPE(view->data[YGO_CARD_BASIC_OFFSET_TYPE0]);
+}
+
+static inline uint16_t ygo_card_view_atk(const ygo_card_view_t *view) {
+    return ygo_load_be16(view->data + YGO_CARD_BASIC_OFFSET_ATK);
+}
+
+static inline uint16_t ygo_card_view_def(const ygo_card_view_t *view) {
+    return ygo_load_be16(view->data + YGO_CARD_BASIC_OFFSET_DEF);
+}
+
+static inline uint8_t ygo_card_view_level(const ygo_card_view_t *view) {
+    return view->data[YGO_CARD_BASIC_OFFSET_LEVEL];
+}
+
+static inline ygo_attribute_t ygo_card_view_attribute(const ygo_card_view_t *view) {
+    return (ygo_attribute_t)view->data[YGO_CARD_BASIC_OFFSET_ATTRIBUTE];
+}
+
+static inline uint8_t ygo_card_view_scale(const ygo_card_view_t *view) {
+    return view->data[YGO_CARD_BASIC_OFFSET_SCALE];
+}
+
+static inline uint8_t ygo_card_view_link_value(const ygo_card_view_t *view) {
+    return view->data[YGO_CARD_BASIC_OFFSET_SCALE];
+}
+
+static inline ygo_card_link_markers_t ygo_card_view_link_markers(const ygo_card_view_t *view) {
+    return (ygo_card_link_markers_t)view->data[YGO_CARD_BASIC_OFFSET_LINK_MARKERS];
+}
+
+/**
+ * Pointer to the name inside the record. It is NOT null terminated (version 0x01 records never
+ * store a terminator), so always use the returned length. Version 0x02 records only hold the
+ * dictionary coded name, for those this returns NULL and ygo_card_view_copy_name() is needed.
+ * @param len Output: length of the name in bytes, excluding any padding.
+ */
+static inline const char *ygo_card_view_name(const ygo_card_view_t *view, size_t *len) {
+    const uint8_t *name = view->data + YGO_CARD_BASIC_OFFSET_NAME;
+    if (view->data_version == YGO_CARD_DATA_VERSION_PACKED_NAME) {
+        *len = 0;
+        return NULL;
+    }
+
+    if (view->data_version == YGO_CARD_DATA_VERSION_SHORT_NAME) {
+        *len = (name[0] < YGO_CARD_NAME_MAX_LEN) ? name[0] : YGO_CARD_NAME_MAX_LEN;
+        return (const char *)(name + 1);
+    }
+
+    const uint8_t *end = (const uint8_t *)memchr(name, '\0', YGO_CARD_NAME_MAX_LEN);
+    *len = (end != NULL) ? (size_t)(end - name) : YGO_CARD_NAME_MAX_LEN;
+    return (const char *)name;
+}
+
+/**
+ * Copy the name into dest, decoding it if needed. Up to len bytes are written and the rest of
+ * dest is null-filled, so with len of YGO_CARD_NAME_MAX_LEN this matches ygo_card_t.name.
+ * @return YGO_BIN_OK, or the error from ygo_name_unpack()
+ */
+static inline ygo_bin_errno_t ygo_card_view_copy_name(const ygo_card_view_t *view,
+                                                      char *dest,
+                                                      size_t len) {
+    const uint8_t *name = view->data + YGO_CARD_BASIC_OFFSET_NAME;
+    if (view->data_version == YGO_CARD_DATA_VERSION_PACKED_NAME) {
+        return ygo_name_unpack(dest, len, name + 1, name[0]);
+    }
+
+    size_t name_len;
+    const char *plain = ygo_card_view_name(view, &name_len);
+    if (name_len > len) name_len = len;
+    memcpy(dest, plain, name_len);
+    memset(dest + name_len, 0, len - name_len);
+    return YGO_BIN_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef __ygo_crc_h
+#define __ygo_crc_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../src/internals.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Host-side CRC-16 engine used by ygo_bin_calculate_crc() when YGO_USE_FAST_CRC is defined.
+ *
+ * All engines compute exactly the same CRC as the 256-entry table (and the YGO_USE_SLOW_CRC
+ * bit-by-bit loop) in ygo_bin.c, they only differ in how many bytes they consume per step:
+ *
+ *  - BITWISE:  reference, 1 bit per step
+ *  - TABLE:    reference, 1 byte per step (crc16_tab)
+ *  - SLICE8:   8 bytes per step, 8 KiB of tables shared with SLICE16
+ *  - SLICE16:  16 bytes per step
+ *  - CLMUL:    carry-less multiply folding, 64 bytes per step (PCLMULQDQ on x86-64, PMULL on
+ *              ARMv8 built with the crypto extension)
+ *
+ * AUTO picks the fastest engine the running CPU supports the first time a CRC is requested.
+ * This is not meant for AVR, none of it is compiled unless YGO_USE_FAST_CRC is defined.
+ */
+#define YGO_CRC_ENGINE_DEFS(X, V)                                                                  \
+    X(YGO_CRC_ENGINE_AUTO, "auto")                                                                 \
+    X(YGO_CRC_ENGINE_BITWISE, "bitwise")                                                           \
+    X(YGO_CRC_ENGINE_TABLE, "table")                                                               \
+    X(YGO_CRC_ENGINE_SLICE8, "slice8")                                                             \
+    X(YGO_CRC_ENGINE_SLICE16, "slice16")                                                           \
+    X(YGO_CRC_ENGINE_CLMUL, "clmul")
+
+ENUM_DECL(ygo_crc_engine, YGO_CRC_ENGINE_DEFS);
+
+/**
+ * Continue a CRC-16 over n more bytes using the currently selected engine. Starting from 0x01
+ * (as ygo_bin_calculate_crc does) gives the record checksum.
+ */
+uint16_t ygo_crc16_update(uint16_t crc, const uint8_t *buffer, size_t n);
+
+/**
+ * Continue n independent CRCs, crcs[i] over buffers[i]. Table based engines interleave the
+ * buffers so their lookups overlap, CLMUL is already bound by memory and runs them one by one.
+ */
+void ygo_crc16_update_many(const uint8_t *const *buffers,
+                           const size_t *sizes,
+                           uint16_t *crcs,
+                           size_t n);
+
+/**
+ * Same as ygo_crc16_update(), but forces a specific engine. Useful for cross-checking the
+ * accelerated engines against the reference ones. Engines which are not available on this CPU
+ * fall back to SLICE16.
+ */
+uint16_t ygo_crc16_update_engine(ygo_crc_engine_t engine,
+                                 uint16_t crc,
+                                 const uint8_t *buffer,
+                                 size_t n);
+
+/**
+ * Returns 1 if the engine can run on this CPU, 0 otherwise.
+ */
+int ygo_crc16_engine_available(ygo_crc_engine_t engine);
+
+/**
+ * Select the engine used by ygo_crc16_update(). Passing YGO_CRC_ENGINE_AUTO re-runs detection.
+ * Returns the engine actually selected.
+ */
+ygo_crc_engine_t ygo_crc16_select_engine(ygo_crc_engine_t engine);
+
+/**
+ * Return the engine currently used by ygo_crc16_update().
+ */
+ygo_crc_engine_t ygo_crc16_active_engine(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef __ygo_db_h
+#define __ygo_db_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include "ygo_card_view.h"
+#include "ygo_mph.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Card database file (.ygodb), for hosts which need the whole card list at hand. The file is
+ * queried in place, so opening it is a mmap and a checksum rather than decoding every card.
+ *
+ * Layout, all integers big-endian like the tag format:
+ *
+ *   0  magic word {0x0E, 'Y', 'D', 'B'}
+ *   4  u16 version (YGO_DB_VERSION)
+ *   6  u16 flags, 0
+ *   8  u32 number of cards
+ *  12  u32 offset of the id index
+ *  16  u32 offset of the records
+ *  20  u32 size of the records
+ *  24  u32 offset of the id hash, 0 if there is none
+ *  28  2 bytes reserved, 0
+ *  30  u16 CRC-16 of bytes 0-29, the whole index and the id hash, same CRC as the records use
+ *
+ * The index holds one 8 byte entry per card: u32 id, then u32 offset of the card's BASIC record
+ * header from the start of the records. The records are ygo_card_serialize() images (magic word
+ * included) back to back, in the order the cards were given to ygo_db_build(). Each record keeps
+ * its own checksum, which is only verified when the card is decoded.
+ *
+ * The id hash is a ygo_mph.h table over the distinct ids. With one, the index is in slot order:
+ * the entry at position k is the first card of the id hashing to slot k, and entries of repeated
+ * ids follow the last slot, sorted by id. ygo_db_find() goes straight to the entry, with no table
+ * between the hash and the index. Without an id hash the index is sorted by id, and cards with
+ * the same id keep the order they were given in.
+ */
+#define YGO_DB_MAGIC_WORD                                                                          \
+    { '\x0E', 'Y', 'D', 'B' }
+#define YGO_DB_VERSION 0x0002
+#define YGO_DB_HEADER_LEN 32
+#define YGO_DB_INDEX_ENTRY_LEN 8
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+
+    uint32_t count;
+    const uint8_t *index;
+    const uint8_t *records;
+    size_t records_len;
+
+    // Id hash, mph.n is 0 without one.
+    ygo_mph_t mph;
+
+    // Set by ygo_db_open_file(), released by ygo_db_close().
+    void *map_base;
+    size_t map_len;
+    void *map_handle;
+} ygo_db_t;
+
+/**
+ * Build a database from n cards into buffer. A NULL buffer only returns the required size, which
+ * may be a few bytes more than what gets written when ids repeat.
+ * @return Size of the database in bytes
+ */
+size_t ygo_db_build(uint8_t *buffer, const ygo_card_t *cards, size_t n);
+
+/**
+ * Open a database held in memory, e.g. one just built or read by other means. The memory must
+ * stay valid until the database is no longer used.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_MAGIC_WORD, YGO_BIN_ERR_BAD_VERSION,
+ *         YGO_BIN_ERR_TRUNCATED if a section lies outside the data, or YGO_BIN_ERR_BAD_CHECKSUM
+ */
+ygo_bin_errno_t ygo_db_open_memory(ygo_db_t *db, const uint8_t *data, size_t len);
+
+/**
+ * Map a database file read-only (mmap, or a file mapping on Windows) and open it.
+ * @return Same as ygo_db_open_memory(), or YGO_BIN_ERR_IO if the file can't be mapped
+ */
+ygo_bin_errno_t ygo_db_open_file(ygo_db_t *db, const char *path);
+
+/**
+ * Unmap a database opened with ygo_db_open_file(). Harmless for ygo_db_open_memory().
+ */
+void ygo_db_close(ygo_db_t *db);
+
+/**
+ * Position of the card with the given id in the index, the first one if the id repeats. One hash
+ * probe when the database has an id hash, binary search otherwise. The other prints of a repeated
+ * id don't follow the first one in a slot ordered index, use ygo_db_find_next() to reach them.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_NOT_FOUND
+ */
+ygo_bin_errno_t ygo_db_find(const ygo_db_t *db, uint32_t id, size_t *pos);
+
+/**
+ * Position of the next card with the same id as the one at pos, in the order the cards were
+ * given to ygo_db_build(). Start from what ygo_db_find() returned and call again with each
+ * position found to visit every print of an id. A binary search over the repeated entries when
+ * stepping from the first print of a database with an id hash, a single compare otherwise.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_NOT_FOUND after the last print, or YGO_BIN_ERR_BAD_ARGS if pos
+ *         is out of range
+ */
+ygo_bin_errno_t ygo_db_find_next(const ygo_db_t *db, size_t pos, size_t *next);
+
+/**
+ * Id of the card at position pos of the index. Ids are ascending with pos only in a database
+ * without an id hash, see the layout above.
+ */
+uint32_t ygo_db_id_at(const ygo_db_t *db, size_t pos);
+
+/**
+ * Point a view at the record of the card at position pos, nothing is decoded or copied.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_ARGS if pos is out of range, or an error from
+ *         ygo_card_view_init() if the record is damaged
+ */
+ygo_bin_errno_t ygo_db_view(const ygo_db_t *db, size_t pos, ygo_card_view_t *view);
+
+/**
+ * Decode the card at position pos, verifying its record checksum.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_ARGS if pos is out of range, or the record's error
+ */
+ygo_bin_errno_t ygo_db_read_card(const ygo_db_t *db, size_t pos, ygo_card_t *card);
+
+/**
+ * Catalog delta (.ygodd), the difference between two generations of a database, e.g. what a new
+ * set release adds and errata change. It names the cards to drop by id and carries the records
+ * of every card added or changed, so shipping it costs the changed cards rather than the whole
+ * catalog.
+ *
+ * Cards are matched by id. Every id the delta mentions is replaced as a whole: the base's records
+ * with that id are dropped and the delta's records with that id (none for a removed card) take
+ * their place.
+ *
+ * Layout, all integers big-endian:
+ *
+ *   0  magic word {0x0E, 'Y', 'D', 'D'}
+ *   4  u16 version (YGO_DB_DELTA_VERSION)
+ *   6  u16 flags, 0
+ *   8  u32 number of cards in the base database
+ *  12  u16 CRC of the base database (bytes 30-31 of its header)
+ *  14  2 bytes reserved, 0
+ *  16  u32 number of removed ids
+ *  20  u32 number of records
+ *  24  u32 size of the records
+ *  28  2 bytes reserved, 0
+ *  30  u16 CRC-16 of bytes 0-29 and everything after the header
+ *
+ * The removed ids follow the header as ascending u32. Then come the records,
+ * ygo_card_serialize() images back to back, ascending by id. No id is both removed and in a
+ * record.
+ */
+#define YGO_DB_DELTA_MAGIC_WORD                                                                    \
+    { '\x0E', 'Y', 'D', 'D' }
+#define YGO_DB_DELTA_VERSION 0x0001
+#define YGO_DB_DELTA_HEADER_LEN 32
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+
+    uint32_t base_count;
+    uint16_t base_crc;
+
+    uint32_t removed_count;
+    const uint8_t *removed;
+    uint32_t record_count;
+    const uint8_t *records;
+    size_t records_len;
+} ygo_db_delta_t;
+
+/**
+ * Write the delta turning database from into database to into buffer. Cards whose records are
+ * byte for byte the same in both are left out. A NULL buffer only returns the size.
+ * @return Size of the delta in bytes, 0 if a record of either database is damaged or there is no
+ *         memory for sorting their indexes
+ */
+size_t ygo_db_diff(uint8_t *buffer, const ygo_db_t *from, const ygo_db_t *to);
+
+/**
+ * Open a delta held in memory, checking its checksum and every record in it. The memory must stay
+ * valid until the delta is no longer used.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_MAGIC_WORD, YGO_BIN_ERR_BAD_VERSION,
+ *         YGO_BIN_ERR_TRUNCATED if a section lies outside the data, YGO_BIN_ERR_BAD_CHECKSUM, or
+ *         YGO_BIN_ERR_BAD_ARGS if the ids or records aren't what the layout says
+ */
+ygo_bin_errno_t ygo_db_delta_open(ygo_db_delta_t *delta, const uint8_t *data, size_t len);
+
+/**
+ * Write the next generation of base with delta applied into buffer. A sorted copy of the base
+ * index is merged with the delta and records are copied as bytes, nothing is decoded. The id hash
+ * is carried over when no id was added or removed. Adding or removing even one id builds the whole
+ * hash again over every id, which is not incremental and takes most of the time of such a patch.
+ *
+ * Records end up in id order, so patching gives the same bytes as ygo_db_build() over the new
+ * card list sorted by id.
+ *
+ * @param len Output, the size of the new database. With a NULL buffer, the size to allocate.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_ARGS, YGO_BIN_ERR_BAD_VERSION if the delta was made for
+ *         another generation than base, YGO_BIN_ERR_TRUNCATED if a record of base is damaged, or
+ *         YGO_BIN_ERR_NO_MEMORY if the index of base can't be sorted
+ */
+ygo_bin_errno_t ygo_db_patch(uint8_t *buffer,
+                             size_t *len,
+                             const ygo_db_t *base,
+                             const ygo_db_delta_t *delta);
+
+/**
+ * Apply the delta of len bytes in data to the database file at path. The next generation is
+ * written next to it (path with ".tmp" appended), flushed to disk and then renamed over it, and
+ * the directory is flushed after the rename (POSIX), so the file at path is always one whole
+ * generation or the other, even across a power loss.
+ * Databases already opened on the old file keep reading the old generation until reopened. On
+ * Windows the file can't be replaced while another database has it mapped.
+ * @return Same as ygo_db_delta_open() and ygo_db_patch(), YGO_BIN_ERR_IO if a file can't be read,
+ *         written or renamed, or YGO_BIN_ERR_NO_MEMORY
+ */
+ygo_bin_errno_t ygo_db_patch_file(const char *path, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __ygo_ed25519_h
+#define __ygo_ed25519_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ygo_ed25519.h
+ * @brief Ed25519 signature verification (RFC 8032), built with YGO_USE_ED25519.
+ *
+ * Portable C for hosts and 32-bit MCUs such as the ESP32: no 128-bit arithmetic, no assembly,
+ * and about 4KB of stack for a single verification. Signing is not included, keys never leave
+ * the signing tool.
+ *
+ * Verification is cofactored, [8][S]B = [8]R + [8][k]A, both one at a time and in batches, so
+ * the two always agree. S must be below the group order L, and A and R must be canonical
+ * encodings of curve points.
+ *
+ * Batches check every signature with one multi-scalar multiplication: each equation is scaled by
+ * a 128-bit coefficient and the sum is checked, sharing the 253 doublings across the batch, and
+ * summing the coefficients of signatures made by the same key so that each key is one point. The
+ * coefficients are derived by hashing the whole batch, so no random number source is needed.
+ */
+
+// Signatures checked by one multi-scalar multiplication; larger batches are split. The work area
+// is malloc'd, about 3KB per signature of a split.
+#define YGO_ED25519_BATCH_MAX 32
+
+/**
+ * Verify a signature of len bytes of message.
+ * @return 1 if the signature is valid, 0 if not, -1 on a NULL argument
+ */
+int ygo_ed25519_verify(const uint8_t signature[64],
+                       const uint8_t *message,
+                       size_t len,
+                       const uint8_t public_key[32]);
+
+/**
+ * Verify count signatures at once: signatures[i] of messages[i], lens[i] bytes long, made by
+ * public_keys[i]. Keys may repeat, and are best passed as the same pointer when they do.
+ *
+ * A batch is valid if every signature in it is. Which ones are not takes ygo_ed25519_verify().
+ * @return 1 if all signatures are valid, 0 if at least one is not, -1 on a NULL argument or if
+ *         the work area could not be allocated
+ */
+int ygo_ed25519_verify_batch(const uint8_t *const signatures[],
+                             const uint8_t *const messages[],
+                             const size_t lens[],
+                             const uint8_t *const public_keys[],
+                             size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ygo_ed25519_h */
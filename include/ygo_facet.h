@@ -0,0 +1,89 @@
+#ifndef __ygo_facet_h
+#define __ygo_facet_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include "ygo_roaring.h"
+#include "ygo_table.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define YGO_FACET_DEFS(X, V)                                                                       \
+    X(YGO_FACET_CARD_TYPE, "card_type")                                                            \
+    X(YGO_FACET_ATTRIBUTE, "attribute")                                                            \
+    X(YGO_FACET_MONSTER_TYPE, "monster_type")                                                      \
+    X(YGO_FACET_SUMMON_TYPE, "summon_type")                                                        \
+    X(YGO_FACET_SPELL_TYPE, "spell_type")                                                          \
+    X(YGO_FACET_TRAP_TYPE, "trap_type")                                                            \
+    X(YGO_FACET_MONSTER_FLAG, "monster_flag")                                                      \
+    X(YGO_FACET_LINK_MARKER, "link_marker")
+
+/**
+ * Card enums which the deck builder offers as facets. Each facet value is addressed by the enum
+ * value itself, e.g. (YGO_FACET_SUMMON_TYPE, YGO_SUMMON_TYPE_XYZ) or
+ * (YGO_FACET_LINK_MARKER, YGO_CARD_LINK_TOP).
+ *
+ * CARD_TYPE uses GET_CARD_TYPE(), so every card has exactly one. Monster facets only hold
+ * monsters and Trap-Monsters, SPELL_TYPE only spells, TRAP_TYPE only traps. MONSTER_FLAG and
+ * LINK_MARKER are bit sets, a card is in every value whose bit it has.
+ */
+ENUM_DECL(ygo_facet, YGO_FACET_DEFS);
+
+#define YGO_FACET_COUNT (YGO_FACET_LINK_MARKER + 1)
+#define YGO_FACET_VALUES 32 // Slots per facet, enough for the largest enum (monster types)
+
+/**
+ * One compressed bitmap of table rows per facet value, plus the values of every row packed into
+ * a byte per facet, which is what ygo_facet_counts() reads for sparse filters.
+ */
+typedef struct {
+    uint32_t count;
+    ygo_roaring_t values[YGO_FACET_COUNT][YGO_FACET_VALUES];
+    uint8_t *rows; // count * YGO_FACET_COUNT: slot, bit set, or YGO_FACET_VALUES for "none"
+} ygo_facet_index_t;
+
+/**
+ * Slot of an enum value within its facet, or -1 if the value doesn't belong to the facet.
+ */
+int ygo_facet_slot(ygo_facet_t facet, uint32_t value);
+
+/**
+ * Build the index over all rows of a table. Rows keep their numbers, so bitmaps from the index and
+ * from ygo_table_select() (through ygo_roaring_from_words()) can be combined.
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_NO_MEMORY in which case the index is left empty
+ */
+ygo_bin_errno_t ygo_facet_build(ygo_facet_index_t *index, const ygo_table_t *table);
+
+/**
+ * Release everything held by the index.
+ */
+void ygo_facet_free(ygo_facet_index_t *index);
+
+/**
+ * Rows having a facet value, e.g. all DARK cards. Combine them with ygo_roaring_and() and friends.
+ * @return The bitmap, owned by the index, or NULL if the value doesn't belong to the facet
+ */
+const ygo_roaring_t *ygo_facet_get(const ygo_facet_index_t *index,
+                                   ygo_facet_t facet,
+                                   uint32_t value);
+
+/**
+ * Count, for every value of every facet, how many rows of filter have it, in one pass over the
+ * filter. counts[facet][slot] is indexed like ygo_facet_slot(). A NULL filter counts all rows.
+ *
+ * Sparse parts of the filter are counted row by row from the packed values, dense parts by
+ * intersecting them with each value's bitmap, whichever touches less memory.
+ */
+void ygo_facet_counts(const ygo_facet_index_t *index,
+                      const ygo_roaring_t *filter,
+                      uint32_t counts[YGO_FACET_COUNT][YGO_FACET_VALUES]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
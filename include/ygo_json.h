@@ -59,8 +59,40 @@ typedef enum {
     YGO_JSON_ERR_NAME_TOO_LONG,
     YGO_JSON_ERR_UNKNOWN_ATTRIBUTE,
     YGO_JSON_ERR_UNKNOWN_RACE,
+    YGO_JSON_ERR_SYNTAX,
+    YGO_JSON_ERR_END_OF_DATA,
+    YGO_JSON_ERR_NO_MEMORY,
 } ygo_json_err_t;
 
+/**
+ * Keys a card is read from, numbered for both readers: numbers up to YGO_JSON_KEY_LINK_MARKERS_ID,
+ * then strings. Every other key of a card object is ignored.
+ */
+#define YGO_JSON_KEY_DEFS(X, V)                                                                    \
+    X(YGO_JSON_KEY_ID, "id")                                                                       \
+    X(YGO_JSON_KEY_TYPE_ID, "type_id")                                                             \
+    X(YGO_JSON_KEY_FLAGS_ID, "flags_id")                                                           \
+    X(YGO_JSON_KEY_ABILITY_ID, "ability_id")                                                       \
+    X(YGO_JSON_KEY_SUMMON_ID, "summon_id")                                                         \
+    X(YGO_JSON_KEY_MONSTER_TYPE_ID, "monster_type_id")                                             \
+    X(YGO_JSON_KEY_ATTRIBUTE_ID, "attribute_id")                                                   \
+    X(YGO_JSON_KEY_ATK, "atk")                                                                     \
+    X(YGO_JSON_KEY_DEF, "def")                                                                     \
+    X(YGO_JSON_KEY_LEVEL, "level")                                                                 \
+    X(YGO_JSON_KEY_SCALE, "scale")                                                                 \
+    X(YGO_JSON_KEY_LINKVAL, "linkval")                                                             \
+    X(YGO_JSON_KEY_LINK_MARKERS_ID, "link_markers_id")                                             \
+    X(YGO_JSON_KEY_NAME, "name")                                                                   \
+    X(YGO_JSON_KEY_TYPE, "type")                                                                   \
+    X(YGO_JSON_KEY_RACE, "race")                                                                   \
+    X(YGO_JSON_KEY_ATTRIBUTE, "attribute")                                                         \
+    X(YGO_JSON_KEY_LINKMARKERS, "linkmarkers")
+
+ENUM_DECL(ygo_json_key, YGO_JSON_KEY_DEFS);
+
+#define YGO_JSON_KEY_COUNT 18
+static_assert(YGO_JSON_KEY_LINKMARKERS + 1 == YGO_JSON_KEY_COUNT, "YGO_JSON_KEY_COUNT incorrect!");
+
 /**
  * Convert a cJSON object to a ygo_card_t structure.
  *
@@ -86,7 +118,7 @@ ygo_json_err_t ygo_json_to_card(const struct cJSON *json, ygo_card_t *card);
  *   "Continuous Spell"            -> type=SPELL, spell_type=CONTINUOUS
  *   "Counter Trap"                -> type=TRAP, trap_type=COUNTER
  *
- * @param type_str   The type string to parse (will be copied internally, not modified)
+ * @param type_str   The type string to parse (not modified, only its first 127 bytes are read)
  * @param out_type   Output: card type enum
  * @param out_flags  Output: monster flags (bitfield)
  * @param out_ability Output: monster ability enum
@@ -107,6 +139,58 @@ ygo_json_err_t ygo_json_parse_type_string(const char *type_str,
  */
 ygo_card_link_markers_t ygo_json_parse_link_markers(const struct cJSON *markers_array);
 
+/**
+ * Parse one link marker string ("Top", "Bottom-Left" or "Bottom Left", etc.).
+ *
+ * @param marker  Marker string
+ * @return The matching ygo_card_link_markers_t bit, 0 if there is none
+ */
+ygo_card_link_markers_t ygo_json_parse_link_marker(const char *marker);
+
+#define YGO_JSON_SCHEMA_DEFS(X, V)                                                                 \
+    X(YGO_JSON_SCHEMA_API, "api")                                                                  \
+    X(YGO_JSON_SCHEMA_NUMERIC, "numeric")
+
+/**
+ * Layout of the JSON written by ygo_card_to_json(): the YGOPRODeck API fields ("type", "race",
+ * "attribute", "linkmarkers" as strings), or the numeric *_id fields, which keep every field of
+ * the card as is.
+ */
+ENUM_DECL(ygo_json_schema, YGO_JSON_SCHEMA_DEFS);
+
+// Longest JSON object ygo_card_to_json() writes for one card, without the terminating NUL.
+#define YGO_JSON_CARD_MAX_LEN 768
+
+/**
+ * Write a card as a JSON object, like snprintf(): at most len bytes, NUL included, are written,
+ * and the return value is the length of the whole object. The object is complete if that is less
+ * than len, and buffer may be NULL with len 0 to ask for the size.
+ *
+ * Names of enums are those of the *_to_str() tables, e.g. "Beast Warrior", which the readers
+ * take as well as the API's "Beast-Warrior". With YGO_JSON_SCHEMA_API the Spell/Trap subtype is
+ * written to "race" as the API does, so reading the object back needs the numeric schema to keep
+ * every field. Nothing is allocated.
+ *
+ * A name filling all YGO_CARD_NAME_MAX_LEN bytes, with no NUL, is written whole, but the readers
+ * keep YGO_CARD_NAME_MAX_LEN - 1 bytes of it: a 64-byte name comes back as 63 bytes.
+ *
+ * @return Length of the JSON text, 0 if card is NULL
+ */
+size_t ygo_card_to_json(const ygo_card_t *card,
+                        ygo_json_schema_t schema,
+                        char *buffer,
+                        size_t len);
+
+/**
+ * Write cards as a dump, {"data":[card,card,...]}, which ygo_json_stream and ygo_json_ingest read
+ * back. Same buffer and return rules as ygo_card_to_json().
+ */
+size_t ygo_cards_to_json(const ygo_card_t *cards,
+                         size_t count,
+                         ygo_json_schema_t schema,
+                         char *buffer,
+                         size_t len);
+
 /**
  * Return a human-readable error string for a ygo_json_err_t.
  */
@@ -0,0 +1,143 @@
+#ifndef __ygo_json_arena_h
+#define __ygo_json_arena_h
+
+#include "ygo_json.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ygo_json_arena.h
+ * @brief Bump allocator for cJSON trees, reset after each parse.
+ *
+ * cJSON_Parse() makes one malloc per value and one per string, and a tree is only ever freed as a
+ * whole: a card is a few dozen allocations, the full dump a few hundred thousand. On an ESP32 that
+ * leaves the heap in pieces. With an arena installed, cJSON takes its memory from one region
+ * instead, bumping a pointer, and frees nothing: the whole tree goes at once when the arena is
+ * reset.
+ *
+ * Two modes:
+ *   - Fixed: a region given by the caller, e.g. a static array, which is never grown. A parse
+ *     which doesn't fit fails with YGO_JSON_ERR_NO_MEMORY, and nothing comes from the heap.
+ *   - Growable: chunks of malloc'd memory, added as a parse needs them and kept across resets,
+ *     so that after the largest parse no more allocation is made.
+ *
+ * The arena is installed with cJSON_InitHooks(), which is global to cJSON: only one arena can be
+ * in use at a time, and no other thread may use cJSON meanwhile. Trees from an arena must not
+ * outlive it, nor be passed to cJSON_Delete() once the default hooks are back.
+ *
+ * Usage:
+ *   static uint8_t memory[24 * 1024];
+ *   ygo_json_arena_t arena;
+ *   ygo_json_arena_init_fixed(&arena, memory, sizeof(memory));
+ *   err = ygo_json_arena_parse_card(&arena, body, body_len, &card);
+ *   // arena.high_water tells how much of memory the largest card took
+ */
+
+// Alignment of every allocation, enough for a cJSON node and its double.
+#define YGO_JSON_ARENA_ALIGN 8
+
+// Chunk size of a growable arena started with chunk_len 0, about a dozen API cards.
+#define YGO_JSON_ARENA_CHUNK_LEN (16 * 1024)
+
+typedef struct ygo_json_arena_chunk ygo_json_arena_chunk_t;
+
+typedef struct {
+    // Region allocations are taken from, its length and the part of it already taken
+    uint8_t *base;
+    size_t len;
+    size_t pos;
+
+    // Growable mode: every chunk, the one base is in, and the size new chunks get. chunks is NULL
+    // and chunk_len 0 in fixed mode.
+    ygo_json_arena_chunk_t *chunks;
+    ygo_json_arena_chunk_t *chunk;
+    size_t chunk_len;
+
+    // Statistics. used and allocs count from the last reset, the others from init.
+    size_t used;       // Bytes handed out, alignment included
+    size_t allocs;     // Allocations made
+    size_t high_water; // Highest used
+    size_t reserved;   // Bytes of memory held, the region in fixed mode
+    size_t failed;     // Allocations refused for lack of memory
+} ygo_json_arena_t;
+
+/**
+ * Called for each element of the card array, with the card, or the error from the field mapping
+ * for which it was skipped.
+ */
+typedef void (*ygo_json_arena_card_fn)(void *ctx, const ygo_card_t *card, ygo_json_err_t err);
+
+/**
+ * Use len bytes of memory, which must stay valid while the arena is used. Nothing is ever
+ * allocated, and ygo_json_arena_free() is not needed.
+ */
+void ygo_json_arena_init_fixed(ygo_json_arena_t *arena, void *memory, size_t len);
+
+/**
+ * Start a growable arena, taking memory from malloc() chunk_len bytes at a time, or the size of
+ * an allocation if that is larger, YGO_JSON_ARENA_CHUNK_LEN if chunk_len is 0. Nothing is
+ * allocated until the first allocation.
+ */
+void ygo_json_arena_init(ygo_json_arena_t *arena, size_t chunk_len);
+
+/**
+ * Route cJSON's allocations to the arena, until ygo_json_arena_end().
+ */
+void ygo_json_arena_begin(ygo_json_arena_t *arena);
+
+/**
+ * Restore cJSON's default allocator and reset the arena: every tree parsed since
+ * ygo_json_arena_begin() is gone.
+ */
+void ygo_json_arena_end(ygo_json_arena_t *arena);
+
+/**
+ * Drop every allocation, keeping the memory for the next ones.
+ */
+void ygo_json_arena_reset(ygo_json_arena_t *arena);
+
+/**
+ * Release the chunks of a growable arena. The arena can be used again, and starts empty.
+ */
+void ygo_json_arena_free(ygo_json_arena_t *arena);
+
+/**
+ * Allocate len bytes, aligned to YGO_JSON_ARENA_ALIGN. This is what cJSON calls once the arena is
+ * installed.
+ * @return The memory, NULL if a fixed arena is full or malloc() failed
+ */
+void *ygo_json_arena_alloc(ygo_json_arena_t *arena, size_t len);
+
+/**
+ * Parse one card object of len bytes of JSON and convert it, within the arena, which is reset
+ * afterwards.
+ * @return As ygo_json_to_card(), YGO_JSON_ERR_SYNTAX if the JSON doesn't parse, or
+ *         YGO_JSON_ERR_NO_MEMORY if it doesn't fit in the arena
+ */
+ygo_json_err_t ygo_json_arena_parse_card(ygo_json_arena_t *arena,
+                                         const char *json,
+                                         size_t len,
+                                         ygo_card_t *card);
+
+/**
+ * Parse a cardinfo dump, {"data": [...]} or a bare array, within the arena, convert every element
+ * and pass it to fn in order. The arena is reset afterwards.
+ * @return YGO_JSON_OK, even when some cards were skipped (see fn) or there is no card array,
+ *         YGO_JSON_ERR_SYNTAX if the JSON doesn't parse, or YGO_JSON_ERR_NO_MEMORY, in which
+ *         cases fn is not called
+ */
+ygo_json_err_t ygo_json_arena_parse_cards(ygo_json_arena_t *arena,
+                                          const char *json,
+                                          size_t len,
+                                          ygo_json_arena_card_fn fn,
+                                          void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ygo_json_arena_h */
@@ -0,0 +1,91 @@
+#ifndef __ygo_json_ingest_h
+#define __ygo_json_ingest_h
+
+#include "ygo_json.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ygo_json_ingest.h
+ * @brief Multi-threaded conversion of a whole cardinfo dump held in memory.
+ *
+ * Every element of data[] is converted on its own, so a full rebuild needn't run on one core.
+ * The text is split in three passes over a work-stealing thread pool:
+ *
+ *   1. Each block of text counts its unescaped quotes and how deep its brackets go, once as if it
+ *      started outside a string and once as if it started inside one.
+ *   2. Adding those up block after block tells whether every block starts inside a string and at
+ *      which depth, without reading the text again.
+ *   3. Each block then finds the commas between elements of data[], and where data[] ends.
+ *
+ * Runs of elements are then read by ygo_json_stream_init_slice() readers, which map fields
+ * exactly as ygo_json_to_card() does. Each run sorts its cards, and the runs are merged by id,
+ * then by position in data[] for repeated ids. The result doesn't depend on the number of threads
+ * or on which thread read what: it is the same, byte for byte, as with threads set to 1.
+ *
+ * Host only: the cards are allocated, and threads are pthreads (Windows threads on _WIN32).
+ *
+ * Usage:
+ *   ygo_json_ingest_t ingest;
+ *   if (ygo_json_ingest(&ingest, json, len, 0) == YGO_JSON_OK) {
+ *       ygo_db_build(buffer, ingest.cards, ingest.count);
+ *       for (size_t i = 0; i < ingest.error_count; i++) {
+ *           report(ingest.errors[i].element, ygo_json_err_str(ingest.errors[i].err));
+ *       }
+ *   }
+ *   ygo_json_ingest_free(&ingest);
+ */
+
+// Bytes of text per task of the split passes.
+#define YGO_JSON_INGEST_BLOCK_LEN (64 * 1024)
+
+// Elements of data[] per conversion task.
+#define YGO_JSON_INGEST_RUN_LEN 64
+
+/**
+ * A card which was skipped, with the error from the field mapping.
+ */
+typedef struct {
+    uint32_t element; // Position in data[]
+    ygo_json_err_t err;
+} ygo_json_ingest_error_t;
+
+typedef struct {
+    ygo_card_t *cards; // Sorted by id, repeated ids in data[] order
+    size_t count;
+
+    ygo_json_ingest_error_t *errors; // In data[] order
+    size_t error_count;
+
+    size_t elements; // Elements of data[], cards and errors
+    unsigned threads;
+    size_t offset; // Where the input was found broken, with YGO_JSON_ERR_SYNTAX
+} ygo_json_ingest_t;
+
+/**
+ * Convert every card of a dump held in memory, {"data": [...]} or a bare array.
+ *
+ * @param threads Threads to run on, the calling one included. 0 for one per online CPU.
+ * @return YGO_JSON_OK, even when some cards were skipped (see errors), YGO_JSON_ERR_SYNTAX if the
+ *         input is malformed, in which case no card is returned, YGO_JSON_ERR_NULL_INPUT or
+ *         YGO_JSON_ERR_NO_MEMORY. ygo_json_ingest_free() is needed in every case.
+ */
+ygo_json_err_t ygo_json_ingest(ygo_json_ingest_t *ingest,
+                               const char *json,
+                               size_t len,
+                               unsigned threads);
+
+/**
+ * Release the cards and errors of an ingest.
+ */
+void ygo_json_ingest_free(ygo_json_ingest_t *ingest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ygo_json_ingest_h */
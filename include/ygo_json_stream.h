@@ -0,0 +1,130 @@
+#ifndef __ygo_json_stream_h
+#define __ygo_json_stream_h
+
+#include "ygo_json.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ygo_json_stream.h
+ * @brief Streaming reader for the YGOPRODeck cardinfo dump, without a cJSON tree.
+ *
+ * The dump is {"data": [card, card, ...], ...}, tens of MB for the full card list, and
+ * ygo_json_to_card() needs all of it parsed into cJSON objects first. This reader walks the text
+ * once instead and hands out each element of data[] as soon as its closing brace is read. Memory
+ * use is the ygo_json_stream_t itself, whatever the size of the input, and nothing is allocated.
+ *
+ * Fields are mapped exactly as ygo_json_to_card() maps them: the same required fields, numeric
+ * fields before strings, the first of repeated keys wins and values of an unexpected type are
+ * ignored. Keys other than the ones listed in ygo_json.h, with whatever they hold (card_sets,
+ * card_images...), are skipped without being stored. A bare array of cards is read too.
+ *
+ * Usage:
+ *   ygo_json_stream_t stream;
+ *   ygo_json_stream_init_reader(&stream, read_fn, file);
+ *
+ *   ygo_card_t card;
+ *   ygo_json_err_t err;
+ *   while ((err = ygo_json_stream_next(&stream, &card)) != YGO_JSON_ERR_END_OF_DATA) {
+ *       if (err == YGO_JSON_ERR_SYNTAX) break;  // Input is broken, nothing follows
+ *       if (err == YGO_JSON_OK) add_card(&card); // Otherwise skip this card, go on
+ *   }
+ */
+
+// Bytes asked of the read callback at a time.
+#define YGO_JSON_STREAM_CHUNK 256
+
+// Deepest nesting of arrays and objects accepted in skipped values, counted from the card object.
+// Deeper values are a syntax error, where cJSON accepts up to 1000 levels.
+#define YGO_JSON_STREAM_MAX_DEPTH 32
+
+// Number of keys a card is read from, see ygo_json.h.
+#define YGO_JSON_STREAM_KEYS YGO_JSON_KEY_COUNT
+
+/**
+ * Read up to len bytes of input into buffer.
+ * @return Number of bytes read, 0 at the end of the input (or on a read error)
+ */
+typedef size_t (*ygo_json_read_fn)(void *ctx, char *buffer, size_t len);
+
+typedef struct {
+    const char *input;
+    size_t input_len;
+    size_t pos;
+    size_t base; // Bytes of input before the current one, with a reader
+
+    ygo_json_read_fn read;
+    void *read_ctx;
+
+    uint8_t state;
+    ygo_json_err_t err; // Set once the input is done with or found broken
+    uint32_t count;     // Elements read so far
+
+    // Fields of the element being read, indexed by key. seen marks the keys met so far, valid
+    // those which held a value of the type the mapping wants.
+    uint32_t seen;
+    uint32_t valid;
+    double id;
+    int numbers[YGO_JSON_STREAM_KEYS];
+    char name[YGO_CARD_NAME_MAX_LEN];
+    char type[128];
+    char race[32];
+    char attribute[32];
+    ygo_card_link_markers_t link_markers;
+    char scratch[32];
+
+    char chunk[YGO_JSON_STREAM_CHUNK];
+} ygo_json_stream_t;
+
+/**
+ * Read from len bytes of JSON held in memory. The memory must stay valid while the stream is used.
+ */
+void ygo_json_stream_init_buffer(ygo_json_stream_t *stream, const char *json, size_t len);
+
+/**
+ * Read JSON through a callback, YGO_JSON_STREAM_CHUNK bytes at a time, e.g. fread() on the dump
+ * or an HTTP client's body reader.
+ */
+void ygo_json_stream_init_reader(ygo_json_stream_t *stream, ygo_json_read_fn read, void *ctx);
+
+/**
+ * Read a slice of the card array held in memory: len bytes of elements and the commas between
+ * them, without the brackets, e.g. the part of data[] one thread was given. The slice ends with
+ * its text, where ygo_json_stream_next() returns YGO_JSON_ERR_END_OF_DATA.
+ */
+void ygo_json_stream_init_slice(ygo_json_stream_t *stream, const char *json, size_t len);
+
+/**
+ * Skip to the first element of the card array, which ygo_json_stream_next() otherwise does on
+ * its first call. ygo_json_stream_offset() is then the offset just past the opening bracket.
+ * @return YGO_JSON_OK, YGO_JSON_ERR_END_OF_DATA if there is no data[] array, or
+ *         YGO_JSON_ERR_SYNTAX
+ */
+ygo_json_err_t ygo_json_stream_find_cards(ygo_json_stream_t *stream);
+
+/**
+ * Read the next card. The card is cleared first, so it needs no zeroing by the caller.
+ *
+ * @return YGO_JSON_OK, an error from the field mapping (same as ygo_json_to_card() would return)
+ *         in which case the card should be skipped and the stream goes on with the next one,
+ *         YGO_JSON_ERR_END_OF_DATA after the last card, or YGO_JSON_ERR_SYNTAX if the input is
+ *         malformed. The last two are returned again by every later call.
+ */
+ygo_json_err_t ygo_json_stream_next(ygo_json_stream_t *stream, ygo_card_t *card);
+
+/**
+ * Bytes of input consumed, e.g. where a syntax error was found.
+ */
+static inline size_t ygo_json_stream_offset(const ygo_json_stream_t *stream) {
+    return stream->base + stream->pos;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ygo_json_stream_h */
@@ -0,0 +1,137 @@
+#ifndef __ygo_mph_h
+#define __ygo_mph_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Minimal perfect hash over card ids (CHD/PTHash style): every id the table was built from maps
+ * to its own slot in [0, n), with one bucket lookup and no collision handling at query time.
+ * Ids it wasn't built from map to some slot as well, so callers compare the id stored there.
+ *
+ * Keys are first placed into ygo_mph_range(n) slots, about 1% more than n, which keeps the pilot
+ * search short for the last buckets. The few keys landing past n are sent to the slots left free
+ * below n by a small remap table.
+ *
+ * Serialized table, big-endian so it can be mapped from a file or placed in flash as is:
+ *
+ *   0  u32 number of keys n
+ *   4  u32 number of buckets
+ *   8  u32 seed
+ *  12  u16 pilot per bucket, padded to 4 bytes
+ *   .  u32 remap entry per slot from n to ygo_mph_range(n)
+ *
+ * Buckets hold YGO_MPH_BUCKET_KEYS keys on average, so the table is a little over
+ * 16 / YGO_MPH_BUCKET_KEYS bits per key. Building (ygo_mph_build) is host-only, lookups are
+ * header-only and can be used on ESP32 with the table in flash.
+ */
+#define YGO_MPH_HEADER_LEN 12
+#define YGO_MPH_BUCKET_KEYS 4
+
+typedef struct {
+    uint32_t n;
+    uint32_t buckets;
+    uint32_t seed;
+    uint32_t range;
+    const uint8_t *pilots;
+    const uint8_t *remap;
+} ygo_mph_t;
+
+static inline size_t ygo_mph_buckets(size_t n) {
+    return (n + YGO_MPH_BUCKET_KEYS - 1) / YGO_MPH_BUCKET_KEYS;
+}
+
+/**
+ * Number of slots keys are placed into before remapping, n plus about 1%.
+ */
+static inline size_t ygo_mph_range(size_t n) {
+    return n + (n + 99) / 100;
+}
+
+static inline size_t _ygo_mph_remap_offset(size_t n) {
+    return (YGO_MPH_HEADER_LEN + 2 * ygo_mph_buckets(n) + 3) & ~(size_t)3;
+}
+
+/**
+ * Size of the serialized table for n keys.
+ */
+static inline size_t ygo_mph_size(size_t n) {
+    return _ygo_mph_remap_offset(n) + 4 * (ygo_mph_range(n) - n);
+}
+
+/**
+ * Build a table over n distinct keys into buffer, which must hold ygo_mph_size(n) bytes.
+ * @return Size of the table, or 0 if keys repeat (or, very unlikely, no seed worked)
+ */
+size_t ygo_mph_build(uint8_t *buffer, const uint32_t *keys, size_t n);
+
+/**
+ * Point mph at a serialized table of len bytes. Nothing is copied.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_ARGS if the header doesn't describe a table, or
+ *         YGO_BIN_ERR_TRUNCATED if len can't hold the table
+ */
+static inline ygo_bin_errno_t ygo_mph_open(ygo_mph_t *mph, const uint8_t *data, size_t len) {
+    if (mph == NULL || data == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    if (len < YGO_MPH_HEADER_LEN) return YGO_BIN_ERR_TRUNCATED;
+
+    mph->n = ygo_load_be32(data);
+    mph->buckets = ygo_load_be32(data + 4);
+    mph->seed = ygo_load_be32(data + 8);
+    mph->range = (uint32_t)ygo_mph_range(mph->n);
+    mph->pilots = data + YGO_MPH_HEADER_LEN;
+    mph->remap = data + _ygo_mph_remap_offset(mph->n);
+
+    if (mph->n >= UINT32_MAX / 2 || mph->buckets != ygo_mph_buckets(mph->n)) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    if (len < ygo_mph_size(mph->n)) return YGO_BIN_ERR_TRUNCATED;
+    return YGO_BIN_OK;
+}
+
+/**
+ * 64-bit finalizer from MurmurHash3, all hashing goes through this.
+ */
+static inline uint64_t ygo_mph_mix(uint64_t x) {
+    x ^= x >> 33u;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33u;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33u;
+    return x;
+}
+
+/**
+ * Map x onto [0, range) with a multiply instead of a division.
+ */
+static inline uint32_t ygo_mph_reduce(uint32_t x, uint32_t range) {
+    return (uint32_t)(((uint64_t)x * range) >> 32u);
+}
+
+static inline uint32_t ygo_mph_pilot_hash(uint32_t seed, uint16_t pilot) {
+    return (uint32_t)ygo_mph_mix(((uint64_t)pilot * 0x9E3779B97F4A7C15ull) ^ seed);
+}
+
+/**
+ * Slot of key, in [0, n). Only meaningful for keys the table was built from, and for n > 0.
+ */
+static inline uint32_t ygo_mph_lookup(const ygo_mph_t *mph, uint32_t key) {
+    uint64_t h = ygo_mph_mix(((uint64_t)mph->seed << 32u) | key);
+    uint32_t bucket = ygo_mph_reduce((uint32_t)(h >> 32u), mph->buckets);
+    uint16_t pilot = ygo_load_be16(mph->pilots + 2 * (size_t)bucket);
+    uint32_t slot = ygo_mph_reduce((uint32_t)h ^ ygo_mph_pilot_hash(mph->seed, pilot), mph->range);
+
+    // Taken about 1% of the time, and never a loop.
+    if (slot >= mph->n) slot = ygo_load_be32(mph->remap + 4 * (size_t)(slot - mph->n));
+    return slot;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef __ygo_name_h
+#define __ygo_name_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Dictionary coding for card names, used by BASIC records of version 0x02.
+ *
+ * Card names reuse a small vocabulary ("Dragon", "Blue-Eyes ", " of the "...), so each encoded
+ * byte is one of:
+ *
+ *  - 0x00:        escape, the next byte is copied as is (UTF-8 and other bytes >= 0x80)
+ *  - 0x01 - 0x7F: that ASCII character
+ *  - 0x80 - 0xFF: one of the 128 dictionary words, see ygo_name.c
+ *
+ * The dictionary is fixed and part of the format, it lives in flash (PROGMEM on AVR). On a
+ * typical set of names the encoded form is about half the size of the plain string.
+ */
+
+// Encoded size of a name of len bytes in the worst case, where every byte had to be escaped.
+#define YGO_NAME_PACKED_MAX_LEN(len) (2 * (len))
+
+/**
+ * Encode up to max_len bytes of name (less if a null character comes first). The shortest
+ * possible encoding is picked, not just the longest dictionary match at each position.
+ * @param dest Destination, or NULL to just compute the encoded size
+ * @param dest_len Size of dest. Nothing is written if the encoded name doesn't fit.
+ * @param name Name to encode
+ * @param max_len Maximum number of bytes to take from name, at most YGO_CARD_NAME_MAX_LEN
+ * @return Size of the encoded name, even if it didn't fit in dest
+ */
+size_t ygo_name_pack(uint8_t *dest, size_t dest_len, const char *name, size_t max_len);
+
+/**
+ * Decode n bytes produced by ygo_name_pack(). Up to len bytes are written to name and the rest of
+ * it is null-filled, same as ygo_bin_read_lstr().
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_TRUNCATED if the data ends in the middle of an escape
+ */
+ygo_bin_errno_t ygo_name_unpack(char *name, size_t len, const uint8_t *src, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
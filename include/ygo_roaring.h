@@ -0,0 +1,133 @@
+#ifndef __ygo_roaring_h
+#define __ygo_roaring_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Compressed bitmap of 32-bit row numbers, in the style of Roaring bitmaps. Rows are split by
+ * their upper 16 bits into containers of up to 65536 rows, and each container stores its lower 16
+ * bits as whichever is smaller:
+ *
+ *  - ARRAY:  sorted uint16_t values, up to YGO_ROARING_ARRAY_MAX of them
+ *  - BITMAP: 65536 bits, once there are more
+ *  - RUN:    sorted runs of consecutive values, as pairs of their first and last value, only made
+ *            by ygo_roaring_optimize()
+ *
+ * A facet such as "DARK" over a 13k card catalog is a single array of ~2k entries (4KB), while the
+ * set of all monsters becomes one 8KB bitmap, or a few runs if the table is sorted by card type.
+ * Operations work container by container and pick the loop for the pair of kinds at hand, e.g. AND
+ * of two arrays is a merge, AND of an array and a bitmap tests the array's entries. A RUN operand
+ * is read as a bitmap, and results are ARRAY or BITMAP again. Host-only (YGO_BUILD_HOST),
+ * containers are malloc'd.
+ */
+#define YGO_ROARING_ARRAY_MAX 4096
+#define YGO_ROARING_BITMAP_WORDS 1024
+
+enum ygo_roaring_kind {
+    YGO_ROARING_ARRAY = 0x00,
+    YGO_ROARING_BITMAP,
+    YGO_ROARING_RUN,
+};
+
+typedef struct {
+    uint16_t key;
+    uint8_t kind;
+    uint32_t cardinality;
+    uint32_t capacity; // Entries allocated for an ARRAY, number of runs of a RUN
+
+    union {
+        uint16_t *array;
+        uint64_t *words;
+        uint16_t *runs; // First and last value of each run
+    };
+} ygo_roaring_container_t;
+
+typedef struct {
+    uint32_t n;
+    uint32_t capacity;
+    ygo_roaring_container_t *containers; // Ascending by key
+} ygo_roaring_t;
+
+/**
+ * Start with an empty bitmap. Nothing is allocated until the first row is added.
+ */
+void ygo_roaring_init(ygo_roaring_t *r);
+
+/**
+ * Release all containers, leaving an empty bitmap.
+ */
+void ygo_roaring_free(ygo_roaring_t *r);
+
+/**
+ * Add a row. Adding rows in ascending order is cheapest, as with the ones of a table. A RUN
+ * container the row falls into is turned back into an ARRAY or BITMAP.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_NO_MEMORY
+ */
+ygo_bin_errno_t ygo_roaring_add(ygo_roaring_t *r, uint32_t row);
+
+/**
+ * Turn every container which is smaller as runs into a RUN, 4 bytes a run, once all rows are
+ * added: rows set in long stretches, such as those of a table sorted by the value.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_NO_MEMORY, in which case r holds the same rows as before
+ */
+ygo_bin_errno_t ygo_roaring_optimize(ygo_roaring_t *r);
+
+/**
+ * Returns 1 if the row is set, 0 otherwise.
+ */
+int ygo_roaring_contains(const ygo_roaring_t *r, uint32_t row);
+
+/**
+ * Number of rows set.
+ */
+size_t ygo_roaring_cardinality(const ygo_roaring_t *r);
+
+/**
+ * dest = a AND b, a OR b, a AND NOT b. dest is replaced and may be a or b.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_NO_MEMORY, in which case dest is left empty
+ */
+ygo_bin_errno_t ygo_roaring_and(ygo_roaring_t *dest,
+                                const ygo_roaring_t *a,
+                                const ygo_roaring_t *b);
+ygo_bin_errno_t ygo_roaring_or(ygo_roaring_t *dest,
+                               const ygo_roaring_t *a,
+                               const ygo_roaring_t *b);
+ygo_bin_errno_t ygo_roaring_andnot(ygo_roaring_t *dest,
+                                   const ygo_roaring_t *a,
+                                   const ygo_roaring_t *b);
+
+/**
+ * Number of rows set in both a and b, without building the intersection.
+ */
+size_t ygo_roaring_and_cardinality(const ygo_roaring_t *a, const ygo_roaring_t *b);
+
+/**
+ * Replace r with the rows set in a plain bitmap of count bits, e.g. a ygo_table_select() result.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_NO_MEMORY, in which case r is left empty
+ */
+ygo_bin_errno_t ygo_roaring_from_words(ygo_roaring_t *r, const uint64_t *words, size_t count);
+
+/**
+ * Write r into a plain bitmap of count bits, (count + 63) / 64 words. Rows from count on are left
+ * out.
+ */
+void ygo_roaring_to_words(const ygo_roaring_t *r, uint64_t *words, size_t count);
+
+/**
+ * Write the rows of r in ascending order to rows, which must hold ygo_roaring_cardinality(r)
+ * entries.
+ * @return Number of rows written
+ */
+size_t ygo_roaring_to_array(const ygo_roaring_t *r, uint32_t *rows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
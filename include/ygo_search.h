@@ -0,0 +1,159 @@
+#ifndef __ygo_search_h
+#define __ygo_search_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Card name search index (.ygonx), for finding cards by what an operator types or a scanner reads
+ * off a card, typos included. It is built from the same cards as a .ygodb and refers to them by
+ * id, so it can be shipped next to the database and resolved with ygo_db_find().
+ *
+ * Names are folded first (ygo_search_fold()), so "Blue-Eyes White Dragon" is searched as
+ * "blue eyes white dragon". The index then holds:
+ *
+ *  - the folded names, one entry per (id, name) pair, ascending by id
+ *  - a prefix array: every word start of every name, sorted by the text from there on, so all
+ *    names with a word starting with "eye" are one range found by binary search
+ *  - trigram postings: for every 3 byte sequence of the names padded with a space on each side,
+ *    the entries containing it, ascending
+ *
+ * Layout, all integers big-endian like the tag format:
+ *
+ *   0  magic word {0x0E, 'Y', 'N', 'X'}
+ *   4  u16 version (YGO_SEARCH_VERSION)
+ *   6  u16 flags, 0
+ *   8  u32 number of entries
+ *  12  u32 offset of the folded names
+ *  16  u32 size of the folded names
+ *  20  u32 offset of the prefix array
+ *  24  u32 number of word starts in it
+ *  28  u32 offset of the trigram table
+ *  32  u32 number of trigrams
+ *  36  u32 offset of the postings
+ *  40  u32 number of postings
+ *  44  2 bytes reserved, 0
+ *  46  u16 CRC-16 of bytes 0-45 and everything after the header
+ *
+ * The entries follow the header, 8 bytes each: u32 id, u32 offset of the folded name. A name ends
+ * where the next one starts. A word start is a u32 of (entry << 8) | byte offset in the name. A
+ * trigram is 8 bytes: u32 of the 3 bytes as a big-endian number, u32 position of its first
+ * posting, up to the next trigram's. A posting is the u32 number of an entry.
+ */
+#define YGO_SEARCH_MAGIC_WORD                                                                      \
+    { '\x0E', 'Y', 'N', 'X' }
+#define YGO_SEARCH_VERSION 0x0001
+#define YGO_SEARCH_HEADER_LEN 48
+#define YGO_SEARCH_ENTRY_LEN 8
+#define YGO_SEARCH_TRIGRAM_LEN 8
+
+// Longest folded query or name considered, the rest is cut off.
+#define YGO_SEARCH_MAX_LEN 64
+
+#define YGO_SEARCH_MATCH_DEFS(X, V)                                                                \
+    X(YGO_SEARCH_MATCH_EXACT, "exact")                                                             \
+    X(YGO_SEARCH_MATCH_PREFIX, "prefix")                                                           \
+    X(YGO_SEARCH_MATCH_WORD, "word")                                                               \
+    X(YGO_SEARCH_MATCH_INFIX, "infix")                                                             \
+    X(YGO_SEARCH_MATCH_FUZZY, "fuzzy")
+
+/**
+ * How a name matched a query, best first: the whole name, its start, the start of one of its
+ * words, somewhere else, or only with edits.
+ */
+ENUM_DECL(ygo_search_match, YGO_SEARCH_MATCH_DEFS);
+
+typedef struct {
+    uint32_t id;
+    uint32_t entry;
+    uint8_t distance; // Edits between the query and the closest part of the name
+    ygo_search_match_t match;
+} ygo_search_hit_t;
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+
+    uint32_t count;
+    const uint8_t *entries;
+    const uint8_t *text;
+    uint32_t text_len;
+    const uint8_t *prefix;
+    uint32_t prefix_count;
+    const uint8_t *trigrams;
+    uint32_t trigram_count;
+    const uint8_t *postings;
+    uint32_t posting_count;
+} ygo_search_t;
+
+/**
+ * Fold up to max_len bytes of name (less if a null character comes first) for searching: ASCII
+ * letters are lowercased, Latin-1 letters lose their accents, apostrophes are dropped and any
+ * other run of punctuation or white space becomes one space, none at either end. Other UTF-8
+ * sequences are kept as they are. The result is not null terminated.
+ * @return Length of the folded name, at most dest_len
+ */
+size_t ygo_search_fold(char *dest, size_t dest_len, const char *name, size_t max_len);
+
+/**
+ * Build an index over the names of n cards into buffer. A NULL buffer only returns the size.
+ * Cards listed twice with the same id and folded name get one entry.
+ * @return Size of the index in bytes, 0 if it couldn't be built (out of memory, 2^24 cards or more)
+ */
+size_t ygo_search_build(uint8_t *buffer, const ygo_card_t *cards, size_t n);
+
+/**
+ * Open an index held in memory. Every offset in it is checked, so a damaged index can't make a
+ * query read outside of it. The memory must stay valid until the index is no longer used.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_MAGIC_WORD, YGO_BIN_ERR_BAD_VERSION,
+ *         YGO_BIN_ERR_TRUNCATED if a section lies outside the data, YGO_BIN_ERR_BAD_CHECKSUM, or
+ *         YGO_BIN_ERR_BAD_ARGS if a section doesn't hold what it should
+ */
+ygo_bin_errno_t ygo_search_open_memory(ygo_search_t *index, const uint8_t *data, size_t len);
+
+/**
+ * Number of uint16_t a query needs as scratch memory, one per entry rounded up for the SIMD
+ * filter.
+ */
+static inline size_t ygo_search_scratch_len(const ygo_search_t *index) {
+    return ((size_t)index->count + 15) & ~(size_t)15;
+}
+
+/**
+ * Find the names closest to query, best first: by match kind, then distance, then shorter names,
+ * then lower ids. Each entry is reported once.
+ *
+ * Queries of 3 or more folded bytes use the trigrams: entries sharing enough of the query's
+ * trigrams (counted into scratch and compared 16 at a time with SSE2 or NEON) are the candidates.
+ * Candidates not holding the query as it is are scored with a bit-parallel edit distance against
+ * their closest substring. An edit breaks up to 3 trigrams, so max_distance is lowered to what
+ * the query length can rule out: 1 edit takes 7 bytes, 2 take 10 and so on. Shorter queries only
+ * look for words starting with them in the prefix array.
+ *
+ * @param scratch ygo_search_scratch_len(index) entries, so concurrent queries need not lock
+ * @return Number of hits written, at most max_hits
+ */
+size_t ygo_search_query(const ygo_search_t *index,
+                        const char *query,
+                        uint8_t max_distance,
+                        ygo_search_hit_t *hits,
+                        size_t max_hits,
+                        uint16_t *scratch);
+
+/**
+ * Folded name of an entry, not null terminated.
+ * @return The name, within the index data, or NULL if entry is out of range
+ */
+const char *ygo_search_name(const ygo_search_t *index, uint32_t entry, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
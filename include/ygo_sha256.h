@@ -0,0 +1,86 @@
+#ifndef __ygo_sha256_h
+#define __ygo_sha256_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../src/internals.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file ygo_sha256.h
+ * @brief SHA-256 (FIPS 180-4), for the card hash of signature payloads.
+ *
+ * Engines, which all give the same digests:
+ *
+ *  - PORTABLE: plain C, 64 bytes of message schedule on the stack, constants in flash on AVR
+ *  - SHANI:    the x86 SHA extensions, one message at a time
+ *  - AVX2:     eight messages at a time, one per 32-bit lane, for ygo_sha256_many() only; single
+ *              messages go to PORTABLE
+ *
+ * Only PORTABLE is compiled unless YGO_USE_FAST_SHA256 is defined, which is meant for x86-64
+ * hosts. AUTO picks the fastest engine the running CPU supports the first time a hash is
+ * requested.
+ */
+#define YGO_SHA256_ENGINE_DEFS(X, V)                                                               \
+    X(YGO_SHA256_ENGINE_AUTO, "auto")                                                              \
+    X(YGO_SHA256_ENGINE_PORTABLE, "portable")                                                      \
+    X(YGO_SHA256_ENGINE_SHANI, "shani")                                                            \
+    X(YGO_SHA256_ENGINE_AVX2, "avx2")
+
+ENUM_DECL(ygo_sha256_engine, YGO_SHA256_ENGINE_DEFS);
+
+#define YGO_SHA256_LEN 32
+#define YGO_SHA256_BLOCK_LEN 64
+
+/**
+ * Incremental hash, for data which doesn't come in one piece.
+ */
+typedef struct {
+    uint32_t state[8];
+    uint64_t len; // Bytes hashed so far
+    uint8_t block[YGO_SHA256_BLOCK_LEN];
+} ygo_sha256_t;
+
+void ygo_sha256_init(ygo_sha256_t *sha);
+void ygo_sha256_update(ygo_sha256_t *sha, const uint8_t *data, size_t len);
+void ygo_sha256_final(ygo_sha256_t *sha, uint8_t digest[YGO_SHA256_LEN]);
+
+/**
+ * Hash len bytes of data in one go.
+ */
+void ygo_sha256(const uint8_t *data, size_t len, uint8_t digest[YGO_SHA256_LEN]);
+
+/**
+ * Hash n independent buffers, digests[i] of sizes[i] bytes at buffers[i]. With AVX2 the buffers
+ * are hashed eight at a time, which pays off for many short ones such as card records.
+ */
+void ygo_sha256_many(const uint8_t *const *buffers,
+                     const size_t *sizes,
+                     uint8_t (*digests)[YGO_SHA256_LEN],
+                     size_t n);
+
+/**
+ * Returns 1 if the engine can run on this CPU, 0 otherwise.
+ */
+int ygo_sha256_engine_available(ygo_sha256_engine_t engine);
+
+/**
+ * Select the engine used by the functions above. Passing YGO_SHA256_ENGINE_AUTO re-runs
+ * detection, and engines which are not available fall back to PORTABLE.
+ * Returns the engine actually selected.
+ */
+ygo_sha256_engine_t ygo_sha256_select_engine(ygo_sha256_engine_t engine);
+
+/**
+ * Return the engine currently in use.
+ */
+ygo_sha256_engine_t ygo_sha256_active_engine(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ygo_sha256_h */
@@ -7,6 +7,7 @@ extern "C" {
 
 #include "ygo_bin.h"
 #include "ygo_card.h"
+#include "ygo_sha256.h"
 #include <stdint.h>
 
 // Signature algorithm identifiers
@@ -22,6 +23,9 @@ extern "C" {
 // Domain tag for canonical payload (prevents cross-protocol attacks)
 #define YGO_SIG_DOMAIN_TAG "CYBSIGv1"
 
+// Longest canonical payload, with both duelist and deck binding
+#define YGO_SIG_PAYLOAD_MAX_LEN 93
+
 /**
  * Card signature record for certification and authentication.
  * Stored as BIN_RECORD_CARD_SIGNATURE (0x10).
@@ -69,7 +73,7 @@ void ygo_sig_write(ygo_bin_write_context_t *ctx, const ygo_card_signature_t *sig
  * Payload format:
  * - Domain tag: "CYBSIGv1" (8 bytes)
  * - Card ID: 4 bytes
- * - Card hash: 32 bytes (SHA-256 of BASIC record)
+ * - Card hash: 32 bytes (see ygo_sig_card_hash())
  * - Flags: 1 byte
  * - Timestamp: 4 bytes
  * - Expiry: 4 bytes
@@ -79,7 +83,7 @@ void ygo_sig_write(ygo_bin_write_context_t *ctx, const ygo_card_signature_t *sig
  *
  * @param card Card data to sign
  * @param sigmeta Signature metadata (flags, IDs, timestamps)
- * @param payload_out Buffer to receive canonical payload (must be >= 93 bytes)
+ * @param payload_out Buffer to receive canonical payload (>= YGO_SIG_PAYLOAD_MAX_LEN bytes)
  * @param payload_len Output: actual payload length
  * @return 0 on success, negative error code otherwise
  */
@@ -88,6 +92,38 @@ int ygo_sig_build_payload(const ygo_card_t *card,
                           uint8_t *payload_out,
                           size_t *payload_len);
 
+/**
+ * Build the canonical payloads of n cards at once, e.g. a collection being re-certified. The card
+ * hashes are computed several at a time (see ygo_sha256_many()), which makes this faster than
+ * ygo_sig_build_payload() in a loop.
+ *
+ * @param cards Card data to sign
+ * @param sigmetas Signature metadata of each card
+ * @param n Number of cards
+ * @param payloads Receives the canonical payload of each card
+ * @param payload_lens Output: actual length of each payload
+ * @return 0 on success, negative error code otherwise
+ */
+int ygo_sig_build_payloads(const ygo_card_t *cards,
+                           const ygo_card_signature_t *sigmetas,
+                           size_t n,
+                           uint8_t (*payloads)[YGO_SIG_PAYLOAD_MAX_LEN],
+                           size_t *payload_lens);
+
+/**
+ * Card hash of the canonical payload: SHA-256 of the card's BASIC record in data version 0x01
+ * (YGO_CARD_DATA_VERSION_SHORT_NAME) as ygo_card_serialize_plain() writes it, from its header to
+ * the end of its checksum trailer. The magic word is not included.
+ *
+ * The version is fixed by the signature format ("CYBSIGv1"), whatever version the tag holds or
+ * ygo_card_serialize() writes. A card read from a 0x00 or 0x02 record hashes the same as from a
+ * 0x01 one, and a new name dictionary doesn't invalidate signatures already issued.
+ *
+ * @param card Card data
+ * @param hash Receives the hash
+ */
+void ygo_sig_card_hash(const ygo_card_t *card, uint8_t hash[YGO_SHA256_LEN]);
+
 /**
  * Calculate signature record size based on flags.
  * Useful for checking NTAG capacity before writing.
@@ -98,19 +134,42 @@ int ygo_sig_build_payload(const ygo_card_t *card,
 size_t ygo_sig_calc_size(uint8_t flags);
 
 /**
- * Verify signature (requires Ed25519 implementation - not included on AVR).
- * This function is a stub on embedded systems; actual verification happens
- * on cybermat-core or connected apps.
+ * Verify signature over the canonical payload of card.
+ * Requires a build with YGO_USE_ED25519 (see ygo_ed25519.h); without it, e.g. on AVR, this is a
+ * stub and verification happens on cybermat-core or connected apps.
  *
  * @param card Card data
  * @param sig Signature record
  * @param pubkey Signing authority's public key (32 bytes)
- * @return 1 if valid, 0 if invalid, negative on error
+ * @return 1 if valid, 0 if invalid, negative on error, an algorithm other than Ed25519 or a
+ *         build without YGO_USE_ED25519
  */
 int ygo_sig_verify(const ygo_card_t *card,
                    const ygo_card_signature_t *sig,
                    const uint8_t pubkey[32]);
 
+/**
+ * Verify count signatures at once, e.g. a whole deck at check-in: sigs[i] of cards[i], by the
+ * authority with key pubkeys[i]. This is several times faster per signature than
+ * ygo_sig_verify(), more so when most cards share an authority.
+ *
+ * A batch only tells whether all its signatures are valid. When one is not, the cards of its
+ * batch are checked one at a time to fill results, if given.
+ *
+ * @param cards Card data
+ * @param sigs Signature record of each card
+ * @param pubkeys Signing authority's public key (32 bytes) of each card
+ * @param count Number of cards
+ * @param results Optional: receives ygo_sig_verify()'s result for each card
+ * @return 1 if all are valid, 0 if any is not (or has an algorithm other than Ed25519), negative
+ *         on error or a build without YGO_USE_ED25519
+ */
+int ygo_sig_verify_batch(const ygo_card_t *cards,
+                         const ygo_card_signature_t *sigs,
+                         const uint8_t *const pubkeys[],
+                         size_t count,
+                         int *results);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,172 @@
+#ifndef __ygo_slim_h
+#define __ygo_slim_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Compact in-memory card list. A ygo_card_t takes 81 bytes, 64 of them for a name buffer that is
+ * mostly padding, so a resident catalog keeps slim cards instead: the same fields in 20 bytes,
+ * with the name moved to a string pool shared by all cards, where each distinct name is stored
+ * once. 13k cards take about 1MB as ygo_card_t, about 260KB slim plus 265KB of names.
+ *
+ * Everything lives in memory given by the caller, nothing is allocated.
+ */
+
+/**
+ * Null-terminated strings back to back. Strings are addressed by their byte offset, which stays
+ * valid for the life of the pool. The hash slots are only needed while interning: once the pool
+ * is complete they can be dropped (set slots to NULL), and the data alone is a read-only pool,
+ * e.g. kept in flash and opened with ygo_strpool_open().
+ */
+typedef struct {
+    char *data;
+    uint32_t len;
+    uint32_t capacity;
+
+    // Open addressing table of offset + 1 per string, 0 when free. NULL to skip deduplication.
+    uint32_t *slots;
+    uint32_t slot_count;
+    uint32_t count;
+} ygo_strpool_t;
+
+/**
+ * Start an empty pool in capacity bytes of data. slot_count must be a power of two, and the pool
+ * takes up to 3/4 of it in distinct strings, e.g. 16384 slots (64KB) for a 12k name catalog.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_BAD_ARGS
+ */
+ygo_bin_errno_t ygo_strpool_init(ygo_strpool_t *pool,
+                                 char *data,
+                                 size_t capacity,
+                                 uint32_t *slots,
+                                 size_t slot_count);
+
+/**
+ * Use len bytes of strings written by an earlier pool as a read-only pool. Offsets from the earlier
+ * pool stay valid.
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_BAD_ARGS if data doesn't end with a null character
+ */
+ygo_bin_errno_t ygo_strpool_open(ygo_strpool_t *pool, const char *data, size_t len);
+
+/**
+ * Offset of up to max_len bytes of str (less if a null character comes first) in the pool. The
+ * string is added unless the pool already holds it.
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_TRUNCATED if the data or the slots are full
+ */
+ygo_bin_errno_t ygo_strpool_intern(ygo_strpool_t *pool,
+                                   const char *str,
+                                   size_t max_len,
+                                   uint32_t *offset);
+
+/**
+ * String at offset, or NULL if the offset lies outside the pool.
+ */
+const char *ygo_strpool_get(const ygo_strpool_t *pool, uint32_t offset);
+
+/**
+ * A ygo_card_t without the name buffer, naturally aligned so arrays of it need no packing. Monster
+ * flags and ability share one byte, they never overlap.
+ *
+ * Enums are stored as bytes, since only some compilers pack them (MSVC keeps them int sized), and
+ * read back with the accessors below.
+ */
+typedef struct {
+    uint32_t id;
+    uint32_t name; // Offset in the string pool
+    uint16_t atk;
+    uint16_t def;
+
+    uint8_t type;   // ygo_card_type_t
+    uint8_t traits; // ygo_monster_flag_t bits | ygo_monster_ability_t
+    uint8_t monster_type;
+
+    union {
+        uint8_t summon; // ygo_summon_type_t
+        uint8_t spell_type;
+        uint8_t trap_type;
+    };
+
+    uint8_t attribute;
+    uint8_t level;
+
+    union {
+        uint8_t scale;
+        uint8_t link_value;
+    };
+    uint8_t link_markers; // ygo_card_link_markers_t bits
+} ygo_card_slim_t;
+
+static_assert(sizeof(ygo_card_slim_t) == 20, "ygo_card_slim_t should be 20 bytes!");
+
+static inline ygo_card_type_t ygo_card_slim_type(const ygo_card_slim_t *slim) {
+    return (ygo_card_type_t)slim->type;
+}
+
+static inline ygo_monster_flag_t ygo_card_slim_flags(const ygo_card_slim_t *slim) {
+    return GET_MONSTER_FLAG(slim->traits);
+}
+
+static inline ygo_monster_ability_t ygo_card_slim_ability(const ygo_card_slim_t *slim) {
+    return GET_ABILITY(slim->traits);
+}
+
+static inline ygo_monster_type_t ygo_card_slim_monster_type(const ygo_card_slim_t *slim) {
+    return (ygo_monster_type_t)slim->monster_type;
+}
+
+static inline ygo_summon_type_t ygo_card_slim_summon(const ygo_card_slim_t *slim) {
+    return (ygo_summon_type_t)slim->summon;
+}
+
+static inline ygo_spell_type_t ygo_card_slim_spell_type(const ygo_card_slim_t *slim) {
+    return (ygo_spell_type_t)slim->spell_type;
+}
+
+static inline ygo_trap_type_t ygo_card_slim_trap_type(const ygo_card_slim_t *slim) {
+    return (ygo_trap_type_t)slim->trap_type;
+}
+
+static inline ygo_attribute_t ygo_card_slim_attribute(const ygo_card_slim_t *slim) {
+    return (ygo_attribute_t)slim->attribute;
+}
+
+static inline ygo_card_link_markers_t ygo_card_slim_link_markers(const ygo_card_slim_t *slim) {
+    return (ygo_card_link_markers_t)slim->link_markers;
+}
+
+/**
+ * Name of a slim card, or NULL if its offset lies outside the pool.
+ */
+static inline const char *ygo_card_slim_name(const ygo_card_slim_t *slim,
+                                             const ygo_strpool_t *pool) {
+    return ygo_strpool_get(pool, slim->name);
+}
+
+/**
+ * Copy a card into a slim one, interning its name into pool.
+ * @return YGO_BIN_OK, or an error from ygo_strpool_intern() in which case slim is unchanged
+ */
+ygo_bin_errno_t ygo_card_slim_from_card(ygo_card_slim_t *slim,
+                                        const ygo_card_t *card,
+                                        ygo_strpool_t *pool);
+
+/**
+ * Expand a slim card, copying its name from pool and null-filling the rest of the buffer. Names
+ * longer than the buffer are cut to YGO_CARD_NAME_MAX_LEN bytes, same as ygo_bin_read_lstr().
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_BAD_ARGS if the name offset lies outside the pool
+ */
+ygo_bin_errno_t ygo_card_slim_to_card(ygo_card_t *card,
+                                      const ygo_card_slim_t *slim,
+                                      const ygo_strpool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
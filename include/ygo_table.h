@@ -0,0 +1,228 @@
+#ifndef __ygo_table_h
+#define __ygo_table_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Columnar (struct of arrays) copy of the fields card filters look at, for scanning a whole
+ * catalog on every keystroke. Each column is a plain array in memory given by the caller, 64 byte
+ * aligned and padded to a multiple of 64 rows, so the scan kernels never need a tail loop and the
+ * columns can be handed to Arrow as they are (ygo_table_export_arrow()).
+ *
+ * Filters are conjunctions of predicates evaluated into a selection bitmap: one bit per row, bit
+ * i of word i / 64 for row i, the same layout as an Arrow boolean or validity buffer.
+ */
+#define YGO_TABLE_ALIGN 64
+#define YGO_TABLE_BLOCK_ROWS 64
+
+#define YGO_TABLE_COLUMN_DEFS(X, V)                                                                \
+    X(YGO_TABLE_COLUMN_ID, "id")                                                                   \
+    X(YGO_TABLE_COLUMN_TYPE, "type")                                                               \
+    X(YGO_TABLE_COLUMN_FLAGS, "flags")                                                             \
+    X(YGO_TABLE_COLUMN_MONSTER_TYPE, "monster_type")                                               \
+    X(YGO_TABLE_COLUMN_ABILITY, "ability")                                                         \
+    X(YGO_TABLE_COLUMN_SUMMON, "summon")                                                           \
+    X(YGO_TABLE_COLUMN_ATTRIBUTE, "attribute")                                                     \
+    X(YGO_TABLE_COLUMN_ATK, "atk")                                                                 \
+    X(YGO_TABLE_COLUMN_DEF, "def")                                                                 \
+    X(YGO_TABLE_COLUMN_LEVEL, "level")                                                             \
+    X(YGO_TABLE_COLUMN_SCALE, "scale")                                                             \
+    X(YGO_TABLE_COLUMN_LINK_MARKERS, "link_markers")
+
+/**
+ * Columns of the table, named after the ygo_card_t fields they hold. ID is 32 bits wide, ATK and
+ * DEF 16 bits, all others 8 bits. SUMMON holds the summon/spell/trap type union as it is stored.
+ */
+ENUM_DECL(ygo_table_column, YGO_TABLE_COLUMN_DEFS);
+
+#define YGO_TABLE_OP_DEFS(X, V)                                                                    \
+    X(YGO_TABLE_OP_EQ, "==")                                                                       \
+    X(YGO_TABLE_OP_NE, "!=")                                                                       \
+    X(YGO_TABLE_OP_LT, "<")                                                                        \
+    X(YGO_TABLE_OP_LE, "<=")                                                                       \
+    X(YGO_TABLE_OP_GT, ">")                                                                        \
+    X(YGO_TABLE_OP_GE, ">=")                                                                       \
+    X(YGO_TABLE_OP_ALL, "all")                                                                     \
+    X(YGO_TABLE_OP_ANY, "any")
+
+/**
+ * Comparison of a column against a value, unsigned. ALL and ANY treat the value as a bit mask,
+ * e.g. (FLAGS ALL YGO_MONSTER_FLAG_TUNER) or (LINK_MARKERS ANY YGO_CARD_LINK_TOP).
+ */
+ENUM_DECL(ygo_table_op, YGO_TABLE_OP_DEFS);
+
+typedef struct {
+    ygo_table_column_t column;
+    ygo_table_op_t op;
+    uint32_t value;
+} ygo_table_pred_t;
+
+#define YGO_TABLE_ENGINE_DEFS(X, V)                                                                \
+    X(YGO_TABLE_ENGINE_AUTO, "auto")                                                               \
+    X(YGO_TABLE_ENGINE_SCALAR, "scalar")                                                           \
+    X(YGO_TABLE_ENGINE_SSE2, "sse2")                                                               \
+    X(YGO_TABLE_ENGINE_AVX2, "avx2")                                                               \
+    X(YGO_TABLE_ENGINE_NEON, "neon")
+
+/**
+ * Scan kernels. All of them produce the same bitmap, they differ in how many rows one compare
+ * covers: 1 (SCALAR), 16 or 8 (SSE2 and NEON, 8 and 16 bit columns), 32 or 16 (AVX2). AUTO
+ * picks the widest one the running CPU supports the first time a table is scanned.
+ */
+ENUM_DECL(ygo_table_engine, YGO_TABLE_ENGINE_DEFS);
+
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+
+    uint32_t *id;
+    uint16_t *atk;
+    uint16_t *def;
+    uint8_t *type;
+    uint8_t *flags;
+    uint8_t *monster_type;
+    uint8_t *ability;
+    uint8_t *summon;
+    uint8_t *attribute;
+    uint8_t *level;
+    uint8_t *scale;
+    uint8_t *link_markers;
+} ygo_table_t;
+
+/**
+ * Number of 64-bit words in the selection bitmap of a table with count rows.
+ */
+static inline size_t ygo_table_bitmap_words(size_t count) {
+    return (count + YGO_TABLE_BLOCK_ROWS - 1) / YGO_TABLE_BLOCK_ROWS;
+}
+
+/**
+ * Bytes of memory ygo_table_init() needs for a table of up to capacity rows, alignment included.
+ */
+size_t ygo_table_size(size_t capacity);
+
+/**
+ * Set up an empty table of up to capacity rows in memory, which must hold ygo_table_size(capacity)
+ * bytes and stay valid as long as the table is used.
+ * @return YGO_BIN_OK or YGO_BIN_ERR_BAD_ARGS
+ */
+ygo_bin_errno_t ygo_table_init(ygo_table_t *table, void *memory, size_t capacity);
+
+/**
+ * Append a card as the next row.
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_TRUNCATED if the table is full
+ */
+ygo_bin_errno_t ygo_table_append(ygo_table_t *table, const ygo_card_t *card);
+
+/**
+ * Value of a column at row, widened to 32 bits.
+ */
+uint32_t ygo_table_get(const ygo_table_t *table, ygo_table_column_t column, size_t row);
+
+/**
+ * Evaluate the conjunction of n predicates over all rows into bitmap, which must hold
+ * ygo_table_bitmap_words(table->count) words. No predicates selects every row. Blocks of 64 rows
+ * rejected by one predicate are skipped by the following ones, so put the most selective first.
+ * @return Number of selected rows, 0 with an empty bitmap if a predicate names an unknown column
+ *         or op
+ */
+size_t ygo_table_select(const ygo_table_t *table,
+                        const ygo_table_pred_t *preds,
+                        size_t n,
+                        uint64_t *bitmap);
+
+/**
+ * Call fn for every row set in bitmap, in ascending order.
+ */
+void ygo_table_foreach(const ygo_table_t *table,
+                       const uint64_t *bitmap,
+                       void (*fn)(const ygo_table_t *table, size_t row, void *ctx),
+                       void *ctx);
+
+/**
+ * Returns 1 if the engine can run on this CPU, 0 otherwise.
+ */
+int ygo_table_engine_available(ygo_table_engine_t engine);
+
+/**
+ * Select the engine used by ygo_table_select(). Passing YGO_TABLE_ENGINE_AUTO re-runs detection.
+ * Returns the engine actually selected, SCALAR if the requested one is unavailable.
+ */
+ygo_table_engine_t ygo_table_select_engine(ygo_table_engine_t engine);
+
+/**
+ * Return the engine currently used by ygo_table_select().
+ */
+ygo_table_engine_t ygo_table_active_engine(void);
+
+/**
+ * Arrow C Data Interface structures, as published in the Arrow specification. Other libraries
+ * (arrow-c, nanoarrow, pyarrow via _import_from_c) define the same ABI behind the same guard.
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+#endif
+
+/**
+ * Export the table as an Arrow struct array with one non-nullable child per column (uint32 id,
+ * uint16 atk/def, uint8 for the rest). The column buffers are shared, not copied, so the table
+ * memory must outlive the array; the release callbacks only free the Arrow structures.
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_NO_MEMORY if the structures couldn't be allocated
+ */
+ygo_bin_errno_t ygo_table_export_arrow(const ygo_table_t *table,
+                                       struct ArrowSchema *schema,
+                                       struct ArrowArray *array);
+
+/**
+ * Export a selection bitmap of ygo_table_select() as an Arrow boolean array of count rows, e.g. to
+ * filter the struct array with Arrow compute. The bitmap is shared, not copied, and matches the
+ * Arrow bit order on little-endian hosts only.
+ * @return YGO_BIN_OK, or YGO_BIN_ERR_NO_MEMORY if the structures couldn't be allocated
+ */
+ygo_bin_errno_t ygo_table_export_selection(const uint64_t *bitmap,
+                                           size_t count,
+                                           struct ArrowSchema *schema,
+                                           struct ArrowArray *array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
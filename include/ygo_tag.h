@@ -0,0 +1,56 @@
+#ifndef __ygo_tag_h
+#define __ygo_tag_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ygo_bin.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// NTAG21x memory is written one 4 byte page at a time, user memory starts at page 4.
+#define YGO_TAG_PAGE_SIZE 4
+#define YGO_TAG_FIRST_USER_PAGE 4
+
+/**
+ * One page write. The page number is relative to the start of the image, add
+ * YGO_TAG_FIRST_USER_PAGE (or wherever the image lives) to get the page on the tag.
+ */
+typedef struct {
+    uint16_t page;
+    uint8_t data[YGO_TAG_PAGE_SIZE];
+} ygo_tag_page_write_t;
+
+/**
+ * Compute the page writes which turn a tag holding old_image into one holding new_image, e.g. to
+ * re-sign a card without rewriting all of it. Pages which are equal in both are skipped. The
+ * shorter image is treated as zero-padded, so pages past the end of new_image are cleared.
+ *
+ * Writes are ordered so the tag stays invalid until the last one lands: data pages first, then
+ * checksum trailers, then record headers (their lengths) and the magic word. Pages holding a
+ * trailer or header in either image count as such. A tag pulled away halfway fails its checksum
+ * rather than reading back as a mix of old and new.
+ *
+ * @param writes Output, or NULL to only count the writes
+ * @param max_writes Number of entries in writes. Writes past this are counted but not stored.
+ * @return Number of page writes needed
+ */
+size_t ygo_tag_diff(ygo_tag_page_write_t *writes,
+                    size_t max_writes,
+                    const uint8_t *old_image,
+                    size_t old_len,
+                    const uint8_t *new_image,
+                    size_t new_len);
+
+/**
+ * Apply page writes to an in-memory copy of the tag, e.g. to keep a cache in sync with what was
+ * written. The image must be large enough for every page written.
+ */
+void ygo_tag_apply(uint8_t *image, const ygo_tag_page_write_t *writes, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
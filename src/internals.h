@@ -13,6 +13,7 @@ extern "C" {
 #define strlcpy(dest, src, size) strcpy_s(dest, size, src)
 #endif
 
+#include <stdint.h>
 #include <string.h>
 
 enum debug_level { DEBUG_OFF, DEBUG_ON };
@@ -29,6 +30,80 @@ extern enum debug_level DEBUG_LEVEL;
 #define LOGD(...) ((void)0)
 #endif
 
+/**
+ * Big-endian loads from possibly unaligned buffers. On 32/64-bit GCC/Clang targets these compile
+ * down to a single load (plus bswap on little-endian), elsewhere they assemble byte-by-byte.
+ */
+static inline uint16_t ygo_load_be16(const uint8_t *p) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (UINTPTR_MAX > 0xFFFFu)
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap16(v);
+#endif
+    return v;
+#else
+    return (uint16_t)(((unsigned)p[0] << 8u) | p[1]);
+#endif
+}
+
+static inline uint32_t ygo_load_be32(const uint8_t *p) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (UINTPTR_MAX > 0xFFFFu)
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+#else
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+#endif
+}
+
+/**
+ * Number of set bits. A single instruction where the target has one, SWAR otherwise.
+ */
+static inline unsigned ygo_popcount64(uint64_t x) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__POPCNT__) || defined(__aarch64__))
+    return (unsigned)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (unsigned)((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * Index of the lowest set bit of x, which must not be 0.
+ */
+static inline unsigned ygo_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    return ygo_popcount64((x & (0 - x)) - 1);
+#endif
+}
+
+/**
+ * Read-only tables which should stay in flash on AVR (PROGMEM), and how to read them back. On
+ * every other target flash is memory mapped and these are plain accesses.
+ */
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define YGO_FLASH PROGMEM
+#define ygo_flash_read_byte(p) pgm_read_byte(p)
+#define ygo_flash_read_ptr(p) ((const void *)pgm_read_word(p))
+#define ygo_flash_memcpy(dest, src, n) memcpy_P(dest, src, n)
+#define ygo_flash_memcmp(ram, flash, n) memcmp_P(ram, flash, n)
+#else
+#define YGO_FLASH /* nothing */
+#define ygo_flash_read_byte(p) (*(const uint8_t *)(p))
+#define ygo_flash_read_ptr(p) ((const void *)*(p))
+#define ygo_flash_memcpy(dest, src, n) memcpy(dest, src, n)
+#define ygo_flash_memcmp(ram, flash, n) memcmp(ram, flash, n)
+#endif
+
 #define ENUM_DEFS(id, name) id,
 #define ENUM_DEFS_VAL(id, name, value) id = ((unsigned)value),
 #define ENUM_DEFS_BITS(id, name, value) id = (0x1u << value),
@@ -36,8 +111,54 @@ extern enum debug_level DEBUG_LEVEL;
 #define ENUM_CASE(id, name, ...)                                                                   \
     case id:                                                                                       \
         return name;
-#define ENUM_PARSE(id, name, ...)                                                                  \
-    if (strcmp(str, name) == 0) return id;
+#define ENUM_ENTRY(id, name, ...) {name, (uint8_t)(sizeof(name) - 1), (uint8_t)(id)},
+
+/**
+ * A name and value of an enum, as generated from its DEFS for the *_from_str() lookups.
+ */
+typedef struct {
+    const char *name;
+    uint8_t len; // strlen(name), known at compile time
+    uint8_t value;
+} ygo_enum_entry_t;
+
+// Longest name which is also looked up with its hyphens and spaces swapped.
+#define YGO_ENUM_NAME_MAX 32
+
+/**
+ * Index of the len bytes at str among n table entries, -1 if none matches. Hyphens and spaces
+ * stand for each other, so "Beast-Warrior" finds "Beast Warrior" and "Top Right" finds
+ * "Top-Right". Only entries of the same length and first byte, neither of which depends on the
+ * spelling, are compared, each with one memcmp (two when the input has hyphens or spaces and the
+ * first one fails).
+ */
+static inline int ygo_enum_lookup(const ygo_enum_entry_t *table,
+                                  size_t n,
+                                  const char *str,
+                                  size_t len) {
+    char swapped[YGO_ENUM_NAME_MAX];
+    int have_swapped = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (ygo_flash_read_byte(&table[i].len) != len) continue;
+        const char *name = (const char *)ygo_flash_read_ptr(&table[i].name);
+        if (len == 0) return (int)i;
+        if (name[0] != str[0]) continue;
+        if (memcmp(name, str, len) == 0) return (int)i;
+
+        if (!have_swapped) {
+            have_swapped = -1;
+            if (len <= sizeof(swapped) && (memchr(str, '-', len) || memchr(str, ' ', len))) {
+                for (size_t c = 0; c < len; c++) {
+                    swapped[c] = str[c] == '-' ? ' ' : str[c] == ' ' ? '-' : str[c];
+                }
+                have_swapped = 1;
+            }
+        }
+        if (have_swapped > 0 && memcmp(name, swapped, len) == 0) return (int)i;
+    }
+    return -1;
+}
 
 #define ENUM_DECL(name, DEFS)                                                                      \
     enum _packed_ name {                                                                           \
@@ -45,7 +166,7 @@ extern enum debug_level DEBUG_LEVEL;
     };                                                                                             \
     typedef enum name name##_t;                                                                    \
     /**                                                                                            \
-     * Parse a string into a name enum. Returns -1 if failure.                                     \
+     * Parse a string into a name enum, hyphens and spaces alike. Returns -1 if failure.           \
      */                                                                                            \
     name##_t name##_from_str(const char *str);                                                     \
     /**                                                                                            \
@@ -57,7 +178,7 @@ extern enum debug_level DEBUG_LEVEL;
     enum _packed_ name { DEFS(ENUM_DEFS_BITS) };                                                   \
     typedef enum name name##_t;                                                                    \
     /**                                                                                            \
-     * Parse a string into a name enum. Returns -1 if failure.                                     \
+     * Parse a string into a name enum, hyphens and spaces alike. Returns -1 if failure.           \
      */                                                                                            \
     name##_t name##_from_str(const char *str);                                                     \
     /**                                                                                            \
@@ -66,8 +187,11 @@ extern enum debug_level DEBUG_LEVEL;
     const char *name##_to_str(name##_t val)
 
 #define ENUM_IMPL(name, DEFS)                                                                      \
+    static const ygo_enum_entry_t _##name##_entries[] YGO_FLASH = {DEFS(ENUM_ENTRY, ENUM_ENTRY)};  \
     name##_t name##_from_str(const char *str) {                                                    \
-        DEFS(ENUM_PARSE, ENUM_PARSE)                                                               \
+        size_t n = sizeof(_##name##_entries) / sizeof(_##name##_entries[0]);                       \
+        int i = str != NULL ? ygo_enum_lookup(_##name##_entries, n, str, strlen(str)) : -1;        \
+        if (i >= 0) return (name##_t)ygo_flash_read_byte(&_##name##_entries[i].value);             \
         LOGD("Could not determine " #name " from string: \"%s\"\n", str);                          \
         return _##name##_invalid;                                                                  \
     }                                                                                              \
@@ -79,8 +203,11 @@ extern enum debug_level DEBUG_LEVEL;
     }
 
 #define ENUM_IMPL_BITS(name, DEFS)                                                                 \
+    static const ygo_enum_entry_t _##name##_entries[] YGO_FLASH = {DEFS(ENUM_ENTRY)};              \
     name##_t name##_from_str(const char *str) {                                                    \
-        DEFS(ENUM_PARSE)                                                                           \
+        size_t n = sizeof(_##name##_entries) / sizeof(_##name##_entries[0]);                       \
+        int i = str != NULL ? ygo_enum_lookup(_##name##_entries, n, str, strlen(str)) : -1;        \
+        if (i >= 0) return (name##_t)ygo_flash_read_byte(&_##name##_entries[i].value);             \
         LOGD("Could not determine " #name " from string: \"%s\"\n", str);                          \
         return -1;                                                                                 \
     }                                                                                              \
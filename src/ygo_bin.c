@@ -1,9 +1,12 @@
 ﻿#include "ygo_bin.h"
 #include <stdio.h>
+#ifdef YGO_USE_FAST_CRC
+#include "ygo_crc.h"
+#endif
 
 static uint8_t _ygo_magic_word[] = YGO_CARD_DATA_MAGIC_WORD;
 
-#ifndef YGO_USE_SLOW_CRC
+#if !defined(YGO_USE_SLOW_CRC) && !defined(YGO_USE_FAST_CRC)
 static uint16_t crc16_tab[256] = {
     0x0000, 0xc0c1, 0xc181, 0x0140, 0xc301, 0x03c0, 0x0280, 0xc241, 0xc601, 0x06c0, 0x0780, 0xc741,
     0x0500, 0xc5c1, 0xc481, 0x0440, 0xcc01, 0x0cc0, 0x0d80, 0xcd41, 0x0f00, 0xcfc1, 0xce81, 0x0e40,
@@ -29,10 +32,17 @@ static uint16_t crc16_tab[256] = {
     0x4100, 0x81c1, 0x8081, 0x4040};
 #endif
 
-uint16_t ygo_bin_calculate_crc(const uint8_t *buffer, size_t size) {
-    if (buffer == NULL) return 0x0000;
+uint16_t ygo_bin_crc_init(void) {
+    return 0x01;
+}
+
+uint16_t ygo_bin_crc_update(uint16_t crc, const uint8_t *buffer, size_t size) {
+    if (buffer == NULL) return crc;
+#ifdef YGO_USE_FAST_CRC
+    // Host builds hand off to the sliced/folded engines in ygo_crc.c, same CRC, fewer cycles.
+    return ygo_crc16_update(crc, buffer, size);
+#else
     const uint8_t *ptr = buffer;
-    uint16_t crc = 0x01;
 
     while (size--) {
 #ifndef YGO_USE_SLOW_CRC
@@ -60,9 +70,69 @@ uint16_t ygo_bin_calculate_crc(const uint8_t *buffer, size_t size) {
 #endif
     }
 
+    return crc;
+#endif
+}
+
+uint16_t ygo_bin_crc_final(uint16_t crc) {
+    // CRC-16/ARC has no final XOR, this only exists so callers don't depend on that.
     return crc;
 }
 
+uint16_t ygo_bin_calculate_crc(const uint8_t *buffer, size_t size) {
+    if (buffer == NULL) return 0x0000;
+    return ygo_bin_crc_final(ygo_bin_crc_update(ygo_bin_crc_init(), buffer, size));
+}
+
+void ygo_bin_calculate_crc_many(const uint8_t *const *buffers,
+                                const size_t *sizes,
+                                uint16_t *crcs,
+                                size_t n) {
+    if (buffers == NULL || sizes == NULL || crcs == NULL) return;
+    size_t i = 0;
+
+#if defined(YGO_USE_FAST_CRC)
+    for (; i < n; i++) {
+        crcs[i] = 0x01;
+    }
+    ygo_crc16_update_many(buffers, sizes, crcs, n);
+#elif !defined(YGO_USE_SLOW_CRC)
+    // Run four independent CRC chains side by side. Each step of a single chain has to wait on
+    // the previous table load, interleaving lets the CPU overlap the loads of all four records.
+    for (; i + 4 <= n; i += 4) {
+        const uint8_t *p0 = buffers[i], *p1 = buffers[i + 1];
+        const uint8_t *p2 = buffers[i + 2], *p3 = buffers[i + 3];
+        if (p0 == NULL || p1 == NULL || p2 == NULL || p3 == NULL) break;
+
+        size_t common = sizes[i];
+        for (size_t k = 1; k < 4; k++) {
+            if (sizes[i + k] < common) common = sizes[i + k];
+        }
+
+        uint16_t c0 = 0x01, c1 = 0x01, c2 = 0x01, c3 = 0x01;
+        for (size_t k = 0; k < common; k++) {
+            c0 = crc16_tab[((unsigned)(c0 ^ p0[k])) & 0xFFu] ^ (unsigned)(c0 >> 8u);
+            c1 = crc16_tab[((unsigned)(c1 ^ p1[k])) & 0xFFu] ^ (unsigned)(c1 >> 8u);
+            c2 = crc16_tab[((unsigned)(c2 ^ p2[k])) & 0xFFu] ^ (unsigned)(c2 >> 8u);
+            c3 = crc16_tab[((unsigned)(c3 ^ p3[k])) & 0xFFu] ^ (unsigned)(c3 >> 8u);
+        }
+
+        uint16_t c[4] = {c0, c1, c2, c3};
+        for (size_t j = 0; j < 4; j++) {
+            const uint8_t *ptr = buffers[i + j] + common;
+            for (size_t k = common; k < sizes[i + j]; k++) {
+                c[j] = crc16_tab[((unsigned)(c[j] ^ (*ptr++))) & 0xFFu] ^ (unsigned)(c[j] >> 8u);
+            }
+            crcs[i + j] = c[j];
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        crcs[i] = ygo_bin_calculate_crc(buffers[i], sizes[i]);
+    }
+}
+
 ygo_bin_errno_t ygo_bin_read_int8(ygo_bin_read_context_t *ctx, uint8_t *dest) {
     if (ctx == NULL || ctx->buffer == NULL) return YGO_BIN_ERR_BAD_ARGS;
     *dest = ctx->buffer[ctx->ptr++];
@@ -155,7 +225,10 @@ void ygo_bin_write_str(ygo_bin_write_context_t *ctx, const char *str, size_t len
     for (; i < len; i++) {
         if (ctx->buffer != NULL) ctx->buffer[ctx->ptr] = str[i];
         ctx->ptr++;
-        if (str[i] == '\0') break;
+        if (str[i] == '\0') {
+            i++;
+            break;
+        }
     }
 
     // Fill the rest (if any) with null.
@@ -165,6 +238,33 @@ void ygo_bin_write_str(ygo_bin_write_context_t *ctx, const char *str, size_t len
     }
 }
 
+void ygo_bin_write_lstr(ygo_bin_write_context_t *ctx, const char *str, size_t max_len) {
+    if (ctx == NULL || str == NULL) return;
+    size_t len = 0;
+    while (len < max_len && len < 0xFF && str[len] != '\0') {
+        len++;
+    }
+
+    ygo_bin_write_int8(ctx, (uint8_t)len);
+    ygo_bin_write_bytes(ctx, (const uint8_t *)str, len);
+}
+
+ygo_bin_errno_t ygo_bin_read_lstr(ygo_bin_read_context_t *ctx, char *str, size_t len) {
+    if (ctx == NULL || ctx->buffer == NULL || str == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    uint8_t stored_len = ctx->buffer[ctx->ptr++];
+    size_t i = 0;
+    for (; i < stored_len && i < len; i++) {
+        str[i] = ctx->buffer[ctx->ptr + i];
+    }
+    for (; i < len; i++) {
+        str[i] = '\0';
+    }
+
+    ctx->ptr += stored_len;
+    return YGO_BIN_OK;
+}
+
 void ygo_bin_begin_data_write(ygo_bin_write_context_t *ctx, uint8_t *buffer) {
     if (ctx == NULL) return;
     ctx->buffer = buffer;
@@ -187,6 +287,15 @@ void ygo_bin_write_magic_word(ygo_bin_write_context_t *ctx) {
     ygo_bin_write_bytes(ctx, _ygo_magic_word, 4);
 }
 
+ygo_bin_errno_t ygo_bin_check_magic_word(ygo_bin_read_context_t *ctx) {
+    if (ctx == NULL || ctx->buffer == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    for (size_t i = 0; i < sizeof(_ygo_magic_word); i++) {
+        if (ctx->buffer[ctx->ptr + i] != _ygo_magic_word[i]) return YGO_BIN_ERR_BAD_MAGIC_WORD;
+    }
+    ctx->ptr += sizeof(_ygo_magic_word);
+    return YGO_BIN_OK;
+}
+
 void ygo_bin_write_record_header(ygo_bin_write_context_t *ctx, ygo_bin_record_header_t *header) {
     if (ctx == NULL) return;
     if (ctx->header != NULL) ygo_bin_write_record_end(ctx);
@@ -209,22 +318,33 @@ ygo_bin_errno_t ygo_bin_read_record_header(ygo_bin_read_context_t *ctx,
     return YGO_BIN_OK;
 }
 
-void ygo_bin_write_record_end(ygo_bin_write_context_t *ctx) {
-    if (ctx == NULL) return;
-    uint16_t crc16 = 0x0000;
-
+/**
+ * Pad the open record to 4 byte blocks and patch its length into the header. Returns the length,
+ * which is also the number of bytes covered by the checksum.
+ */
+static uint16_t _ygo_bin_close_record(ygo_bin_write_context_t *ctx) {
     // Pad the data up to 4 byte blocks:
     while ((ctx->ptr - ctx->header_start) % 4 != 0) {
         ygo_bin_write_int8(ctx, 0x00);
     }
 
-    // We can actually skip the calculations if we're not writing to the buffer.
+    // Alter record header with current length:
+    uint16_t block_len = (ctx->ptr - ctx->header_start);
     if (ctx->buffer != NULL) {
-        // Alter record header with current length:
-        uint16_t block_len = (ctx->ptr - ctx->header_start);
         ctx->buffer[ctx->header_start + 2] = (block_len >> 8u);
         ctx->buffer[ctx->header_start + 3] = (block_len >> 0u);
+    }
+
+    return block_len;
+}
 
+void ygo_bin_write_record_end(ygo_bin_write_context_t *ctx) {
+    if (ctx == NULL) return;
+    uint16_t crc16 = 0x0000;
+    uint16_t block_len = _ygo_bin_close_record(ctx);
+
+    // We can actually skip the calculations if we're not writing to the buffer.
+    if (ctx->buffer != NULL) {
         // Append Checksum Bytes:
         crc16 = ygo_bin_calculate_crc(ctx->buffer + ctx->header_start, block_len);
     }
@@ -233,6 +353,15 @@ void ygo_bin_write_record_end(ygo_bin_write_context_t *ctx) {
     ygo_bin_write_int16(ctx, 0x0000); // unused data.
 }
 
+uint16_t ygo_bin_write_record_end_deferred(ygo_bin_write_context_t *ctx) {
+    if (ctx == NULL) return 0;
+    uint16_t block_len = _ygo_bin_close_record(ctx);
+
+    ygo_bin_write_int16(ctx, 0x0000); // checksum, filled in by the caller.
+    ygo_bin_write_int16(ctx, 0x0000); // unused data.
+    return block_len;
+}
+
 ygo_bin_errno_t ygo_bin_check_record_end(ygo_bin_read_context_t *ctx) {
     if (ctx == NULL || ctx->buffer == NULL) return YGO_BIN_ERR_BAD_ARGS;
 
@@ -259,3 +388,63 @@ ygo_bin_errno_t ygo_bin_check_record_end(ygo_bin_read_context_t *ctx) {
 
     return YGO_BIN_OK;
 }
+
+ygo_bin_errno_t ygo_bin_cursor_begin(ygo_bin_cursor_t *cur, const uint8_t *buffer, size_t len) {
+    if (cur == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    cur->buffer = buffer;
+    cur->len = len;
+    cur->ptr = 0;
+
+    if (buffer == NULL) return cur->err = YGO_BIN_ERR_BAD_ARGS;
+    if (len < sizeof(_ygo_magic_word)) return cur->err = YGO_BIN_ERR_TRUNCATED;
+
+    ygo_bin_read_context_t ctx;
+    ygo_bin_begin_data_read(&ctx, buffer);
+    cur->err = ygo_bin_check_magic_word(&ctx);
+    cur->ptr = ctx.ptr;
+    return cur->err;
+}
+
+ygo_bin_errno_t ygo_bin_cursor_next(ygo_bin_cursor_t *cur, ygo_bin_record_view_t *view) {
+    if (cur == NULL || view == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    if (cur->err != YGO_BIN_OK) return cur->err;
+
+    // Need at least a header to know where this record ends.
+    if (cur->len - cur->ptr < 4) return cur->err = YGO_BIN_ERR_END_OF_DATA;
+
+    const uint8_t *rec = cur->buffer + cur->ptr;
+    uint16_t record_length = (uint16_t)(((unsigned)rec[2] << 8u) | rec[3]);
+
+    // record_length counts the header itself, so anything shorter is unwritten (zeroed) memory.
+    if (record_length < 4) return cur->err = YGO_BIN_ERR_END_OF_DATA;
+
+    // On the wire the record is followed by checksum (2) and unused (2) bytes.
+    if ((size_t)record_length + 4 > cur->len - cur->ptr) return cur->err = YGO_BIN_ERR_TRUNCATED;
+
+    view->header.record_type = (ygo_bin_record_type_t)rec[0];
+    view->header.data_version = rec[1];
+    view->header.record_length = record_length;
+    view->record = rec;
+    view->payload = rec + 4;
+    view->payload_len = record_length - 4;
+    view->crc = (uint16_t)(((unsigned)rec[record_length] << 8u) | rec[record_length + 1]);
+
+    cur->ptr += (size_t)record_length + 4;
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_bin_cursor_find(ygo_bin_cursor_t *cur,
+                                    ygo_bin_record_type_t type,
+                                    ygo_bin_record_view_t *view) {
+    ygo_bin_errno_t err;
+    while ((err = ygo_bin_cursor_next(cur, view)) == YGO_BIN_OK) {
+        if (view->header.record_type == type) return YGO_BIN_OK;
+    }
+    return err;
+}
+
+ygo_bin_errno_t ygo_bin_record_check_crc(const ygo_bin_record_view_t *view) {
+    if (view == NULL || view->record == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    uint16_t calc_crc = ygo_bin_calculate_crc(view->record, view->header.record_length);
+    return calc_crc == view->crc ? YGO_BIN_OK : YGO_BIN_ERR_BAD_CHECKSUM;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file ygo_cache.c
+ * @brief Decoded card cache keyed by a SipHash-2-4 of the tag image, CLOCK eviction.
+ */
+#include "ygo_cache.h"
+
+ENUM_IMPL(ygo_cache_verify, YGO_CACHE_VERIFY_DEFS);
+
+/**
+ * SipHash reads its input as little-endian words, whatever the host order.
+ */
+static inline uint64_t _ygo_cache_load_le64(const uint8_t *p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+           ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+#define YGO_CACHE_ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define YGO_CACHE_SIPROUND                                                                         \
+    do {                                                                                           \
+        v0 += v1;                                                                                  \
+        v1 = YGO_CACHE_ROTL(v1, 13);                                                               \
+        v1 ^= v0;                                                                                  \
+        v0 = YGO_CACHE_ROTL(v0, 32);                                                               \
+        v2 += v3;                                                                                  \
+        v3 = YGO_CACHE_ROTL(v3, 16);                                                               \
+        v3 ^= v2;                                                                                  \
+        v0 += v3;                                                                                  \
+        v3 = YGO_CACHE_ROTL(v3, 21);                                                               \
+        v3 ^= v0;                                                                                  \
+        v2 += v1;                                                                                  \
+        v1 = YGO_CACHE_ROTL(v1, 17);                                                               \
+        v1 ^= v2;                                                                                  \
+        v2 = YGO_CACHE_ROTL(v2, 32);                                                               \
+    } while (0)
+
+uint64_t ygo_cache_hash(const ygo_cache_t *cache, const uint8_t *data, size_t len) {
+    uint64_t v0 = cache->key[0] ^ 0x736F6D6570736575ull;
+    uint64_t v1 = cache->key[1] ^ 0x646F72616E646F6Dull;
+    uint64_t v2 = cache->key[0] ^ 0x6C7967656E657261ull;
+    uint64_t v3 = cache->key[1] ^ 0x7465646279746573ull;
+
+    size_t whole = len & ~(size_t)7;
+    for (size_t i = 0; i < whole; i += 8) {
+        uint64_t m = _ygo_cache_load_le64(data + i);
+        v3 ^= m;
+        YGO_CACHE_SIPROUND;
+        YGO_CACHE_SIPROUND;
+        v0 ^= m;
+    }
+
+    // Last word: the remaining bytes, and the length in the top byte.
+    uint64_t m = (uint64_t)len << 56;
+    for (size_t i = whole; i < len; i++) {
+        m |= (uint64_t)data[i] << (8 * (i - whole));
+    }
+    v3 ^= m;
+    YGO_CACHE_SIPROUND;
+    YGO_CACHE_SIPROUND;
+    v0 ^= m;
+
+    v2 ^= 0xFF;
+    YGO_CACHE_SIPROUND;
+    YGO_CACHE_SIPROUND;
+    YGO_CACHE_SIPROUND;
+    YGO_CACHE_SIPROUND;
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+ygo_bin_errno_t ygo_cache_init(ygo_cache_t *cache,
+                               ygo_cache_entry_t *entries,
+                               size_t capacity,
+                               uint32_t *slots,
+                               size_t slot_count,
+                               const uint8_t key[16]) {
+    if (cache == NULL || entries == NULL || slots == NULL || key == NULL) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    if (capacity == 0 || slot_count <= capacity || (slot_count & (slot_count - 1)) != 0) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    if (slot_count > UINT32_MAX / 2) return YGO_BIN_ERR_BAD_ARGS;
+
+    cache->entries = entries;
+    cache->capacity = (uint32_t)capacity;
+    cache->slots = slots;
+    cache->slot_count = (uint32_t)slot_count;
+    cache->key[0] = _ygo_cache_load_le64(key);
+    cache->key[1] = _ygo_cache_load_le64(key + 8);
+    ygo_cache_clear(cache);
+    return YGO_BIN_OK;
+}
+
+void ygo_cache_clear(ygo_cache_t *cache) {
+    if (cache == NULL) return;
+    memset(cache->slots, 0, (size_t)cache->slot_count * sizeof(uint32_t));
+    cache->count = 0;
+    cache->hand = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
+
+/**
+ * Empty a slot, moving later entries of its probe run back so none of them is cut off from its
+ * home slot by the gap.
+ */
+static void _ygo_cache_unlink(ygo_cache_t *cache, uint32_t slot) {
+    uint32_t mask = cache->slot_count - 1;
+    uint32_t gap = slot;
+
+    for (uint32_t next = (slot + 1) & mask; cache->slots[next] != 0; next = (next + 1) & mask) {
+        uint32_t home = (uint32_t)cache->entries[cache->slots[next] - 1].hash & mask;
+
+        // Distance from home to next, and from home to the gap. The entry may move back only if
+        // the gap lies on its way from home.
+        if (((gap - home) & mask) < ((next - home) & mask)) {
+            cache->slots[gap] = cache->slots[next];
+            gap = next;
+        }
+    }
+    cache->slots[gap] = 0;
+}
+
+/**
+ * Pick the entry to reuse once the cache is full and drop it from the slots.
+ */
+static uint32_t _ygo_cache_evict(ygo_cache_t *cache) {
+    while (cache->entries[cache->hand].referenced) {
+        cache->entries[cache->hand].referenced = 0;
+        cache->hand = (cache->hand + 1) % cache->capacity;
+    }
+
+    uint32_t victim = cache->hand;
+    cache->hand = (cache->hand + 1) % cache->capacity;
+
+    uint32_t mask = cache->slot_count - 1;
+    uint32_t slot = (uint32_t)cache->entries[victim].hash & mask;
+    while (cache->slots[slot] != victim + 1) {
+        slot = (slot + 1) & mask;
+    }
+    _ygo_cache_unlink(cache, slot);
+    cache->evictions++;
+    return victim;
+}
+
+ygo_bin_errno_t ygo_cache_decode(ygo_cache_t *cache,
+                                 const uint8_t *data,
+                                 size_t len,
+                                 ygo_cache_entry_t **entry) {
+    if (entry != NULL) *entry = NULL;
+    if (cache == NULL || data == NULL || entry == NULL || len > UINT32_MAX) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+
+    uint64_t hash = ygo_cache_hash(cache, data, len);
+    uint32_t mask = cache->slot_count - 1;
+    uint32_t slot = (uint32_t)hash & mask;
+
+    for (; cache->slots[slot] != 0; slot = (slot + 1) & mask) {
+        ygo_cache_entry_t *held = &cache->entries[cache->slots[slot] - 1];
+        if (held->hash == hash && held->len == len) {
+            held->referenced = 1;
+            cache->hits++;
+            *entry = held;
+            return YGO_BIN_OK;
+        }
+    }
+
+    cache->misses++;
+
+    ygo_card_t card;
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    ygo_card_deserialize_many(&card, &err, 1, data, len);
+    if (err != YGO_BIN_OK) return err;
+
+    uint32_t index = cache->count;
+    if (cache->count < cache->capacity) {
+        cache->count++;
+    } else {
+        index = _ygo_cache_evict(cache);
+
+        // Moving entries back may have filled the slot found above, look again.
+        for (slot = (uint32_t)hash & mask; cache->slots[slot] != 0; slot = (slot + 1) & mask) {
+        }
+    }
+
+    ygo_cache_entry_t *fresh = &cache->entries[index];
+    fresh->hash = hash;
+    fresh->len = (uint32_t)len;
+    fresh->verify = YGO_CACHE_VERIFY_UNKNOWN;
+    fresh->referenced = 0;
+    fresh->card = card;
+    cache->slots[slot] = index + 1;
+
+    *entry = fresh;
+    return YGO_BIN_OK;
+}
@@ -1,5 +1,6 @@
 #include "ygo_card.h"
 #include "ygo_bin.h"
+#include "ygo_name.h"
 #ifdef YGO_ENABLE_PRINT_DEBUG
 #include <stdio.h>
 #endif
@@ -15,48 +16,203 @@ ENUM_IMPL(ygo_trap_type, YGO_TRAP_TYPE_DEFS);
 ENUM_IMPL(ygo_attribute, YGO_ATTRIBUTE_DEFS);
 ENUM_IMPL_BITS(ygo_card_link_markers, YGO_CARD_LINK_MARKERS_DEFS);
 
-size_t ygo_card_serialize(uint8_t *buffer, const ygo_card_t *card) {
-    ygo_bin_write_context_t ctx;
-    ygo_bin_begin_data_write(&ctx, buffer);
-    ygo_bin_write_magic_word(&ctx);
+/**
+ * Write the magic word, and a BASIC record up to (not including) its end marker.
+ * @param allow_packed 0 to always write the name in plain bytes (version 0x01)
+ */
+static void _ygo_card_write_basic(ygo_bin_write_context_t *ctx,
+                                  const ygo_card_t *card,
+                                  int allow_packed) {
+    ygo_bin_write_magic_word(ctx);
+
+    // The dictionary coded name is only used if it is shorter, so it is never worse than plain.
+    uint8_t name_len = 0;
+    while (name_len < YGO_CARD_NAME_MAX_LEN && card->name[name_len] != '\0') {
+        name_len++;
+    }
+
+    uint8_t packed[YGO_CARD_NAME_MAX_LEN];
+    size_t packed_len =
+        allow_packed ? ygo_name_pack(packed, sizeof(packed), card->name, name_len) : name_len;
+    int use_packed = packed_len < name_len;
 
     // Card Record Header
     ygo_bin_record_header_t header = {
         .record_type = BIN_RECORD_CARD_BASIC,
-        .data_version = YGO_CARD_DATA_VERSION,
+        .data_version =
+            use_packed ? YGO_CARD_DATA_VERSION_PACKED_NAME : YGO_CARD_DATA_VERSION_SHORT_NAME,
         .record_length = 0x0000,
     };
 
-    ygo_bin_write_record_header(&ctx, &header);
+    ygo_bin_write_record_header(ctx, &header);
 
     // Write Card Data
-    ygo_bin_write_int32(&ctx, card->id);
+    ygo_bin_write_int32(ctx, card->id);
 
     uint8_t type1 = (((unsigned)card->type) | ((unsigned)card->flags) | ((unsigned)card->ability));
 
-    ygo_bin_write_int8(&ctx, type1);
+    ygo_bin_write_int8(ctx, type1);
 
     uint8_t type0 = (((unsigned)card->summon) | ((unsigned)card->monster_type));
 
-    ygo_bin_write_int8(&ctx, type0);
+    ygo_bin_write_int8(ctx, type0);
 
     // Unused, to align Attribute Start
-    ygo_bin_write_int16(&ctx, 0x0000);
-
-    ygo_bin_write_int16(&ctx, card->atk);
-    ygo_bin_write_int16(&ctx, card->def);
-    ygo_bin_write_int8(&ctx, card->level);
-    ygo_bin_write_int8(&ctx, card->attribute);
-    ygo_bin_write_int8(&ctx, card->scale);
-    ygo_bin_write_int8(&ctx, card->link_markers);
+    ygo_bin_write_int16(ctx, 0x0000);
+
+    ygo_bin_write_int16(ctx, card->atk);
+    ygo_bin_write_int16(ctx, card->def);
+    ygo_bin_write_int8(ctx, card->level);
+    ygo_bin_write_int8(ctx, card->attribute);
+    ygo_bin_write_int8(ctx, card->scale);
+    ygo_bin_write_int8(ctx, card->link_markers);
+
+    if (use_packed) {
+        ygo_bin_write_int8(ctx, (uint8_t)packed_len);
+        ygo_bin_write_bytes(ctx, packed, packed_len);
+    } else {
+        ygo_bin_write_lstr(ctx, card->name, name_len);
+    }
+}
 
-    ygo_bin_write_str(&ctx, card->name, YGO_CARD_NAME_MAX_LEN);
+size_t ygo_card_serialize(uint8_t *buffer, const ygo_card_t *card) {
+    ygo_bin_write_context_t ctx;
+    ygo_bin_begin_data_write(&ctx, buffer);
+    _ygo_card_write_basic(&ctx, card, 1);
+    ygo_bin_write_record_end(&ctx);
+    return ctx.ptr;
+}
 
+size_t ygo_card_serialize_plain(uint8_t *buffer, const ygo_card_t *card) {
+    ygo_bin_write_context_t ctx;
+    ygo_bin_begin_data_write(&ctx, buffer);
+    _ygo_card_write_basic(&ctx, card, 0);
     ygo_bin_write_record_end(&ctx);
     return ctx.ptr;
 }
 
-size_t ygo_card_deserialize(ygo_card_t *card, const uint8_t *buffer) {
+/**
+ * Number of bytes a BASIC record starting at buffer occupies, including the checksum trailer.
+ * This is where both decoders below look for the checksum. Returns 0 if the record length or the
+ * name length claims more than a record of its version can hold, which caps what the decoders
+ * read at YGO_CARD_BASIC_MAX_LEN.
+ */
+static size_t _ygo_card_basic_size(const uint8_t *buffer) {
+    const uint8_t *name = buffer + YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME;
+    size_t min_len = YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_FIXED_LEN;
+    size_t max_len = min_len + 1 + YGO_CARD_NAME_MAX_LEN;
+
+    switch (buffer[1]) {
+    case YGO_CARD_DATA_VERSION_FIXED_NAME:
+        // Writers of this version add a null character after the name, hence 88 and not 84.
+        min_len += YGO_CARD_NAME_MAX_LEN;
+        max_len = min_len + 1;
+        break;
+    case YGO_CARD_DATA_VERSION_SHORT_NAME:
+    case YGO_CARD_DATA_VERSION_PACKED_NAME: min_len += 1 + name[0]; break;
+    default: break;
+    }
+
+    size_t block_len = ygo_load_be16(buffer + 2);
+    if (block_len < min_len) block_len = min_len;
+    block_len = (block_len + 3u) & ~(size_t)3u;
+    if (min_len > max_len || block_len > ((max_len + 3u) & ~(size_t)3u)) return 0;
+    return block_len + 4;
+}
+
+/**
+ * Decode the 16 byte fixed prefix of a BASIC record (data points right after the header) with
+ * four big-endian word loads.
+ */
+static void _ygo_card_read_fixed(ygo_card_t *card, const uint8_t *data) {
+    uint32_t types = ygo_load_be32(data + 4);  // type1, type0, padding
+    uint32_t stats = ygo_load_be32(data + 8);  // atk, def
+    uint32_t extra = ygo_load_be32(data + 12); // level, attribute, scale, link markers
+
+    card->id = ygo_load_be32(data);
+
+    uint8_t type1 = (uint8_t)(types >> 24u);
+    card->type = GET_CARD_TYPE(type1);
+    card->flags = GET_MONSTER_FLAG(type1);
+    card->ability = GET_ABILITY(type1);
+
+    uint8_t type0 = (uint8_t)(types >> 16u);
+    card->summon = GET_SUMMON_TYPE(type0);
+    card->monster_type = GET_MONSTER_TYPE(type0);
+
+    card->atk = (uint16_t)(stats >> 16u);
+    card->def = (uint16_t)stats;
+    card->level = (uint8_t)(extra >> 24u);
+    card->attribute = (ygo_attribute_t)(uint8_t)(extra >> 16u);
+    card->scale = (uint8_t)(extra >> 8u);
+    card->link_markers = (ygo_card_link_markers_t)(uint8_t)extra;
+}
+
+/**
+ * Decode the name of a BASIC record of the given version into card->name, null-filling the rest.
+ * @return YGO_BIN_OK, YGO_BIN_ERR_BAD_VERSION, or an error from ygo_name_unpack()
+ */
+static ygo_bin_errno_t _ygo_card_read_name(ygo_card_t *card, uint8_t version, const uint8_t *name) {
+    ygo_bin_errno_t name_err = YGO_BIN_OK;
+    size_t name_len = 0;
+
+    switch (version) {
+    case YGO_CARD_DATA_VERSION_FIXED_NAME:
+        memcpy(card->name, name, YGO_CARD_NAME_MAX_LEN);
+        name_len = YGO_CARD_NAME_MAX_LEN;
+        break;
+    case YGO_CARD_DATA_VERSION_SHORT_NAME:
+        name_len = (name[0] < YGO_CARD_NAME_MAX_LEN) ? name[0] : YGO_CARD_NAME_MAX_LEN;
+        memcpy(card->name, name + 1, name_len);
+        break;
+    case YGO_CARD_DATA_VERSION_PACKED_NAME:
+        name_err = ygo_name_unpack(card->name, YGO_CARD_NAME_MAX_LEN, name + 1, name[0]);
+        name_len = YGO_CARD_NAME_MAX_LEN;
+        break;
+    default: name_err = YGO_BIN_ERR_BAD_VERSION; break;
+    }
+    memset(card->name + name_len, 0, YGO_CARD_NAME_MAX_LEN - name_len);
+    return name_err;
+}
+
+// Both decoders skip the checksum when err is NULL, for callers which verify it themselves.
+#ifdef YGO_USE_FAST_DECODE
+/**
+ * Word-at-a-time decoder for 32/64-bit hosts. The 16 byte fixed prefix is four big-endian word
+ * loads, the name is a single copy, and the checksum runs over the record right before the loads
+ * so they hit cache. Produces exactly what the portable decoder below does.
+ */
+static size_t _ygo_card_read_basic(ygo_card_t *card, const uint8_t *buffer, ygo_bin_errno_t *err) {
+    size_t size = _ygo_card_basic_size(buffer);
+    if (size == 0) {
+        if (err != NULL) *err = YGO_BIN_ERR_BAD_LENGTH;
+        return 0;
+    }
+
+    size_t block_len = size - 4;
+    uint16_t calc_crc = 0x0000;
+    if (err != NULL) calc_crc = ygo_bin_calculate_crc(buffer, block_len);
+
+    const uint8_t *data = buffer + YGO_CARD_BASIC_HEADER_LEN;
+    _ygo_card_read_fixed(card, data);
+    ygo_bin_errno_t name_err =
+        _ygo_card_read_name(card, buffer[1], data + YGO_CARD_BASIC_OFFSET_NAME);
+
+    if (err != NULL) {
+        *err = (calc_crc == ygo_load_be16(buffer + block_len)) ? name_err
+                                                                : YGO_BIN_ERR_BAD_CHECKSUM;
+    }
+    return block_len + 4;
+}
+#else
+static size_t _ygo_card_read_basic(ygo_card_t *card, const uint8_t *buffer, ygo_bin_errno_t *err) {
+    // Bounds the name and the record_length honoured below.
+    size_t size = _ygo_card_basic_size(buffer);
+    if (size == 0) {
+        if (err != NULL) *err = YGO_BIN_ERR_BAD_LENGTH;
+        return 0;
+    }
+
     ygo_bin_read_context_t ctx;
     ygo_bin_begin_data_read(&ctx, buffer);
 
@@ -81,17 +237,314 @@ size_t ygo_card_deserialize(ygo_card_t *card, const uint8_t *buffer) {
     uint16_t padding = 0x0000;
     ygo_bin_read_int16(&ctx, &padding);
 
-    ygo_bin_read_enum(&ctx, &card->attribute, 1);
     ygo_bin_read_int16(&ctx, &card->atk);
     ygo_bin_read_int16(&ctx, &card->def);
     ygo_bin_read_int8(&ctx, &card->level);
+
+    // One byte enums are read through a temporary, ygo_bin_read_enum() stores a full int.
+    uint8_t attribute = 0x00;
+    ygo_bin_read_int8(&ctx, &attribute);
+    card->attribute = (ygo_attribute_t)attribute;
+
     ygo_bin_read_int8(&ctx, &card->scale);
-    ygo_bin_read_enum(&ctx, &card->link_markers, 1);
-    ygo_bin_read_str(&ctx, card->name, YGO_CARD_NAME_MAX_LEN);
 
-    ygo_bin_check_record_end(&ctx);
+    uint8_t link_markers = 0x00;
+    ygo_bin_read_int8(&ctx, &link_markers);
+    card->link_markers = (ygo_card_link_markers_t)link_markers;
+
+    ygo_bin_errno_t name_err = YGO_BIN_OK;
+    switch (header.data_version) {
+    case YGO_CARD_DATA_VERSION_FIXED_NAME:
+        ygo_bin_read_str(&ctx, card->name, YGO_CARD_NAME_MAX_LEN);
+        break;
+    case YGO_CARD_DATA_VERSION_SHORT_NAME:
+        ygo_bin_read_lstr(&ctx, card->name, YGO_CARD_NAME_MAX_LEN);
+        break;
+    case YGO_CARD_DATA_VERSION_PACKED_NAME: {
+        uint8_t packed_len = 0x00;
+        ygo_bin_read_int8(&ctx, &packed_len);
+        name_err =
+            ygo_name_unpack(card->name, YGO_CARD_NAME_MAX_LEN, ctx.buffer + ctx.ptr, packed_len);
+        ctx.ptr += packed_len;
+        break;
+    }
+    default:
+        memset(card->name, 0, YGO_CARD_NAME_MAX_LEN);
+        name_err = YGO_BIN_ERR_BAD_VERSION;
+        break;
+    }
+
+    if (err == NULL) return size;
+
+    // Honour a longer record_length, the checksum sits after whatever the writer put there.
+    if (header.record_length > ctx.ptr - ctx.header_start) {
+        ctx.ptr = ctx.header_start + header.record_length;
+    }
+
+    *err = ygo_bin_check_record_end(&ctx);
+    if (*err == YGO_BIN_OK) *err = name_err;
     return ctx.ptr;
 }
+#endif
+
+size_t ygo_card_deserialize(ygo_card_t *card, const uint8_t *buffer) {
+    ygo_bin_errno_t err;
+    return _ygo_card_read_basic(card, buffer, &err);
+}
+
+size_t ygo_card_record_size(const uint8_t *record, size_t len) {
+    if (record == NULL || len <= YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME) return 0;
+    size_t size = _ygo_card_basic_size(record);
+    return size <= len ? size : 0;
+}
+
+// Records are checksummed in groups of this many, which bounds the stack used by the batch calls.
+#define YGO_CARD_BATCH_GROUP 16
+
+/**
+ * Checksum a group of records together and store the results in their trailers.
+ */
+static void _ygo_card_patch_crcs(uint8_t *const *records, const size_t *lengths, size_t n) {
+    uint16_t crcs[YGO_CARD_BATCH_GROUP];
+    ygo_bin_calculate_crc_many((const uint8_t *const *)records, lengths, crcs, n);
+    for (size_t k = 0; k < n; k++) {
+        records[k][lengths[k]] = (uint8_t)(crcs[k] >> 8u);
+        records[k][lengths[k] + 1] = (uint8_t)crcs[k];
+    }
+}
+
+/**
+ * Checksum a group of records together and compare against their trailers.
+ */
+static void _ygo_card_check_crcs(const uint8_t *const *records,
+                                 const size_t *lengths,
+                                 const size_t *index,
+                                 size_t n,
+                                 ygo_bin_errno_t *status) {
+    uint16_t crcs[YGO_CARD_BATCH_GROUP];
+    ygo_bin_calculate_crc_many(records, lengths, crcs, n);
+    for (size_t k = 0; k < n; k++) {
+        uint16_t stored_crc = ygo_load_be16(records[k] + lengths[k]);
+        status[index[k]] = (crcs[k] == stored_crc) ? YGO_BIN_OK : YGO_BIN_ERR_BAD_CHECKSUM;
+    }
+}
+
+size_t ygo_card_serialize_many(uint8_t *buffer, const ygo_card_t *cards, size_t n) {
+    if (cards == NULL) return 0;
+
+    uint8_t *records[YGO_CARD_BATCH_GROUP];
+    size_t lengths[YGO_CARD_BATCH_GROUP];
+    size_t grouped = 0;
+    size_t ptr = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        ygo_bin_write_context_t ctx;
+        ygo_bin_begin_data_write(&ctx, buffer != NULL ? buffer + ptr : NULL);
+        _ygo_card_write_basic(&ctx, &cards[i], 1);
+        uint16_t block_len = ygo_bin_write_record_end_deferred(&ctx);
+
+        if (buffer != NULL) {
+            records[grouped] = buffer + ptr + ctx.header_start;
+            lengths[grouped++] = block_len;
+        }
+        ptr += ctx.ptr;
+
+        if (grouped == YGO_CARD_BATCH_GROUP) {
+            _ygo_card_patch_crcs(records, lengths, grouped);
+            grouped = 0;
+        }
+    }
+
+    if (grouped > 0) _ygo_card_patch_crcs(records, lengths, grouped);
+    return ptr;
+}
+
+size_t ygo_card_deserialize_many(ygo_card_t *cards,
+                                 ygo_bin_errno_t *status,
+                                 size_t n,
+                                 const uint8_t *buffer,
+                                 size_t len) {
+    if (cards == NULL || status == NULL) return 0;
+
+    const uint8_t *records[YGO_CARD_BATCH_GROUP];
+    size_t lengths[YGO_CARD_BATCH_GROUP];
+    size_t index[YGO_CARD_BATCH_GROUP];
+    size_t grouped = 0;
+    size_t ptr = 0;
+    size_t i = 0;
+    ygo_bin_errno_t err = (buffer == NULL) ? YGO_BIN_ERR_BAD_ARGS : YGO_BIN_OK;
+
+    for (; i < n && err == YGO_BIN_OK; i++) {
+        ygo_bin_cursor_t cur;
+        ygo_bin_record_view_t view;
+
+        err = ygo_bin_cursor_begin(&cur, buffer + ptr, len - ptr);
+        if (err == YGO_BIN_OK) err = ygo_bin_cursor_next(&cur, &view);
+        if (err != YGO_BIN_OK) break;
+
+        // The decoder reads at least the fixed fields and the name, even if the header claims less.
+        if (view.payload_len <= YGO_CARD_BASIC_FIXED_LEN) {
+            err = YGO_BIN_ERR_TRUNCATED;
+            break;
+        }
+
+        size_t size = _ygo_card_basic_size(view.record);
+        if (size == 0) {
+            err = YGO_BIN_ERR_BAD_LENGTH;
+            break;
+        }
+        if (size > cur.len - (size_t)(view.record - cur.buffer)) {
+            err = YGO_BIN_ERR_TRUNCATED;
+            break;
+        }
+
+        _ygo_card_read_basic(&cards[i], view.record, NULL);
+        records[grouped] = view.record;
+        lengths[grouped] = size - 4;
+        index[grouped++] = i;
+        ptr += (size_t)(view.record - cur.buffer) + size;
+
+        if (grouped == YGO_CARD_BATCH_GROUP) {
+            _ygo_card_check_crcs(records, lengths, index, grouped, status);
+            grouped = 0;
+        }
+    }
+
+    if (grouped > 0) _ygo_card_check_crcs(records, lengths, index, grouped, status);
+
+    // Once a record can't be located, none of the following ones can be either.
+    for (; i < n; i++) {
+        status[i] = err;
+    }
+
+    return ptr;
+}
+
+void ygo_card_stream_begin(ygo_card_stream_t *stream, ygo_card_t *card) {
+    if (stream == NULL) return;
+    memset(stream, 0, sizeof(*stream));
+    stream->card = card;
+    stream->state = YGO_CARD_STREAM_MAGIC;
+    stream->err = YGO_BIN_OK;
+    stream->crc = ygo_bin_crc_init();
+    stream->end = YGO_CARD_BASIC_HEADER_LEN;
+}
+
+/**
+ * Act on a state whose bytes have all arrived, and move on to the next one.
+ */
+static ygo_bin_errno_t _ygo_card_stream_advance(ygo_card_stream_t *stream) {
+    static const uint8_t magic_word[] = YGO_CARD_DATA_MAGIC_WORD;
+    const size_t name_offset = YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME;
+    uint8_t *record = stream->record;
+
+    switch (stream->state) {
+    case YGO_CARD_STREAM_MAGIC:
+        if (memcmp(stream->word, magic_word, sizeof(magic_word)) != 0) {
+            return YGO_BIN_ERR_BAD_MAGIC_WORD;
+        }
+        stream->state = YGO_CARD_STREAM_HEADER;
+        break;
+
+    case YGO_CARD_STREAM_HEADER:
+        if (record[0] != BIN_RECORD_CARD_BASIC) return YGO_BIN_ERR_BAD_ARGS;
+        if (record[1] > YGO_CARD_DATA_VERSION) return YGO_BIN_ERR_BAD_VERSION;
+        stream->end += YGO_CARD_BASIC_FIXED_LEN;
+        stream->state = YGO_CARD_STREAM_FIXED;
+        break;
+
+    case YGO_CARD_STREAM_FIXED:
+        _ygo_card_read_fixed(stream->card, record + YGO_CARD_BASIC_HEADER_LEN);
+        if (record[1] == YGO_CARD_DATA_VERSION_FIXED_NAME) {
+            stream->end += YGO_CARD_NAME_MAX_LEN;
+            stream->state = YGO_CARD_STREAM_NAME;
+        } else {
+            stream->end += 1;
+            stream->state = YGO_CARD_STREAM_NAME_LEN;
+        }
+        break;
+
+    case YGO_CARD_STREAM_NAME_LEN:
+        // The header and name length are both in, which is all the size check looks at.
+        if (_ygo_card_basic_size(record) == 0) return YGO_BIN_ERR_BAD_LENGTH;
+        stream->end += record[name_offset];
+        stream->state = YGO_CARD_STREAM_NAME;
+        break;
+
+    case YGO_CARD_STREAM_NAME: {
+        // The checksum goes after the padding, which follows the name as stored on the tag.
+        size_t size = _ygo_card_basic_size(record);
+        if (size == 0) return YGO_BIN_ERR_BAD_LENGTH;
+        stream->end = size - 4;
+
+        ygo_bin_errno_t err = _ygo_card_read_name(stream->card, record[1], record + name_offset);
+        if (err != YGO_BIN_OK) return err;
+        stream->state = YGO_CARD_STREAM_PADDING;
+        break;
+    }
+
+    case YGO_CARD_STREAM_PADDING:
+        stream->word_pos = 0;
+        stream->state = YGO_CARD_STREAM_CHECKSUM;
+        break;
+
+    case YGO_CARD_STREAM_CHECKSUM:
+        if (ygo_bin_crc_final(stream->crc) != ygo_load_be16(stream->word)) {
+            return YGO_BIN_ERR_BAD_CHECKSUM;
+        }
+        stream->state = YGO_CARD_STREAM_DONE;
+        break;
+
+    default: break;
+    }
+
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_card_stream_update(ygo_card_stream_t *stream, const uint8_t *data, size_t len) {
+    if (stream == NULL || stream->card == NULL || (data == NULL && len > 0)) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+
+    while (stream->err == YGO_BIN_OK && stream->state != YGO_CARD_STREAM_DONE) {
+        int in_word = stream->state == YGO_CARD_STREAM_MAGIC ||
+                      stream->state == YGO_CARD_STREAM_CHECKSUM;
+
+        // States can be empty (e.g. no padding), so check for completion before needing input.
+        if ((in_word && stream->word_pos == sizeof(stream->word)) ||
+            (!in_word && stream->pos == stream->end)) {
+            stream->err = _ygo_card_stream_advance(stream);
+            continue;
+        }
+
+        if (len == 0) break;
+
+        size_t take;
+        if (in_word) {
+            take = sizeof(stream->word) - stream->word_pos;
+            if (take > len) take = len;
+            memcpy(stream->word + stream->word_pos, data, take);
+            stream->word_pos += (uint8_t)take;
+        } else {
+            take = stream->end - stream->pos;
+            if (take > len) take = len;
+            stream->crc = ygo_bin_crc_update(stream->crc, data, take);
+
+            // Padding (and any part of a name which doesn't fit) is only checksummed.
+            if (stream->state != YGO_CARD_STREAM_PADDING && stream->pos < sizeof(stream->record)) {
+                size_t keep = sizeof(stream->record) - stream->pos;
+                memcpy(stream->record + stream->pos, data, (take < keep) ? take : keep);
+            }
+            stream->pos += take;
+        }
+
+        data += take;
+        len -= take;
+        stream->consumed += take;
+    }
+
+    return stream->err;
+}
 
 #ifdef YGO_ENABLE_PRINT_DEBUG
 void ygo_card_print(ygo_card_t *card) {
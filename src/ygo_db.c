@@ -0,0 +1,924 @@
+#include "ygo_db.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const uint8_t _ygo_db_magic_word[] = YGO_DB_MAGIC_WORD;
+
+// Byte offsets of the header fields, see ygo_db.h.
+#define YGO_DB_OFFSET_VERSION 4
+#define YGO_DB_OFFSET_FLAGS 6
+#define YGO_DB_OFFSET_COUNT 8
+#define YGO_DB_OFFSET_INDEX 12
+#define YGO_DB_OFFSET_RECORDS 16
+#define YGO_DB_OFFSET_RECORDS_LEN 20
+#define YGO_DB_OFFSET_HASH 24
+#define YGO_DB_OFFSET_CRC 30
+
+/**
+ * Index entries are big-endian id, then offset, so comparing their bytes sorts by id first and
+ * keeps cards with the same id in the order they were given.
+ */
+static int _ygo_db_compare_entries(const void *a, const void *b) {
+    return memcmp(a, b, YGO_DB_INDEX_ENTRY_LEN);
+}
+
+/**
+ * Checksum of the header (up to the checksum itself), the index and the id hash.
+ */
+static uint16_t _ygo_db_crc(const uint8_t *data,
+                            const uint8_t *index,
+                            uint32_t count,
+                            const uint8_t *hash,
+                            size_t hash_len) {
+    uint16_t crc = ygo_bin_crc_init();
+    crc = ygo_bin_crc_update(crc, data, YGO_DB_OFFSET_CRC);
+    crc = ygo_bin_crc_update(crc, index, (size_t)count * YGO_DB_INDEX_ENTRY_LEN);
+    crc = ygo_bin_crc_update(crc, hash, hash_len);
+    return ygo_bin_crc_final(crc);
+}
+
+/**
+ * Write the id hash of the sorted index to buffer, which must hold ygo_mph_size(n) bytes.
+ * @return Size of the id hash, 0 if it couldn't be built
+ */
+static size_t _ygo_db_build_hash(uint8_t *buffer, const uint8_t *index, size_t n) {
+    uint32_t *ids = (uint32_t *)malloc((n + 1) * sizeof(uint32_t));
+    if (ids == NULL) return 0;
+
+    size_t unique = 0;
+    for (size_t pos = 0; pos < n; pos++) {
+        uint32_t id = ygo_load_be32(index + pos * YGO_DB_INDEX_ENTRY_LEN);
+        if (unique > 0 && ids[unique - 1] == id) continue;
+        ids[unique++] = id;
+    }
+    size_t written = ygo_mph_build(buffer, ids, unique);
+
+    free(ids);
+    return written;
+}
+
+/**
+ * Rearrange the sorted index so the first entry of every id sits at that id's hash slot. Entries
+ * of repeated ids follow the last slot, still in id order.
+ * @return 0 if there was no memory for it, the index is then left sorted
+ */
+static int _ygo_db_slot_order(uint8_t *index, size_t n, const uint8_t *hash, size_t hash_len) {
+    uint8_t *sorted = (uint8_t *)malloc(n * YGO_DB_INDEX_ENTRY_LEN + 1);
+    if (sorted == NULL) return 0;
+    memcpy(sorted, index, n * YGO_DB_INDEX_ENTRY_LEN);
+
+    ygo_mph_t mph = {0};
+    ygo_mph_open(&mph, hash, hash_len);
+
+    size_t repeated = mph.n;
+    for (size_t pos = 0; pos < n; pos++) {
+        const uint8_t *entry = sorted + pos * YGO_DB_INDEX_ENTRY_LEN;
+        uint32_t id = ygo_load_be32(entry);
+        int first = pos == 0 || ygo_load_be32(entry - YGO_DB_INDEX_ENTRY_LEN) != id;
+        size_t to = first ? ygo_mph_lookup(&mph, id) : repeated++;
+        memcpy(index + to * YGO_DB_INDEX_ENTRY_LEN, entry, YGO_DB_INDEX_ENTRY_LEN);
+    }
+
+    free(sorted);
+    return 1;
+}
+
+/**
+ * Complete a database whose index and records are in place: pad the records, add the id hash, put
+ * the index in slot order and write the header.
+ * @param hash Id hash of hash_len bytes to copy, NULL to build one over the index
+ * @return Size of the database
+ */
+static size_t _ygo_db_finish(uint8_t *buffer,
+                             size_t n,
+                             size_t records_len,
+                             const uint8_t *hash,
+                             size_t hash_len) {
+    size_t index_offset = YGO_DB_HEADER_LEN;
+    size_t records_offset = index_offset + n * YGO_DB_INDEX_ENTRY_LEN;
+    size_t end = records_offset + records_len;
+    while (end % 4 != 0) {
+        buffer[end++] = 0x00;
+    }
+    size_t hash_offset = end;
+    if (hash != NULL) {
+        memcpy(buffer + hash_offset, hash, hash_len);
+    } else {
+        hash_len = _ygo_db_build_hash(buffer + hash_offset, buffer + index_offset, n);
+    }
+    if (hash_len > 0 &&
+        _ygo_db_slot_order(buffer + index_offset, n, buffer + hash_offset, hash_len)) {
+        end += hash_len;
+    } else {
+        // Still a valid database, lookups fall back to searching the index.
+        hash_offset = 0;
+        end = records_offset + records_len;
+    }
+
+    ygo_bin_write_context_t header;
+    ygo_bin_begin_data_write(&header, buffer);
+    ygo_bin_write_bytes(&header, _ygo_db_magic_word, sizeof(_ygo_db_magic_word));
+    ygo_bin_write_int16(&header, YGO_DB_VERSION);
+    ygo_bin_write_int16(&header, 0x0000);
+    ygo_bin_write_int32(&header, (uint32_t)n);
+    ygo_bin_write_int32(&header, (uint32_t)index_offset);
+    ygo_bin_write_int32(&header, (uint32_t)records_offset);
+    ygo_bin_write_int32(&header, (uint32_t)records_len);
+    ygo_bin_write_int32(&header, (uint32_t)hash_offset);
+    while (header.ptr < YGO_DB_OFFSET_CRC) {
+        ygo_bin_write_int8(&header, 0x00);
+    }
+    uint16_t crc =
+        _ygo_db_crc(buffer, buffer + index_offset, (uint32_t)n, buffer + hash_offset, hash_len);
+    ygo_bin_write_int16(&header, crc);
+
+    return end;
+}
+
+size_t ygo_db_build(uint8_t *buffer, const ygo_card_t *cards, size_t n) {
+    if (cards == NULL && n > 0) return 0;
+
+    size_t index_offset = YGO_DB_HEADER_LEN;
+    size_t records_offset = index_offset + n * YGO_DB_INDEX_ENTRY_LEN;
+    if (buffer == NULL) {
+        size_t records_len = ygo_card_serialize_many(NULL, cards, n);
+        return ((records_offset + records_len + 3) & ~(size_t)3) + ygo_mph_size(n);
+    }
+
+    ygo_bin_write_context_t index;
+    ygo_bin_begin_data_write(&index, buffer + index_offset);
+    size_t records_len = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t written = ygo_card_serialize(buffer + records_offset + records_len, &cards[i]);
+
+        // Point at the record header, past the magic word, like ygo_card_deserialize() expects.
+        ygo_bin_write_int32(&index, cards[i].id);
+        ygo_bin_write_int32(&index, (uint32_t)(records_len + sizeof(_ygo_db_magic_word)));
+        records_len += written;
+    }
+
+    qsort(buffer + index_offset, n, YGO_DB_INDEX_ENTRY_LEN, _ygo_db_compare_entries);
+
+    return _ygo_db_finish(buffer, n, records_len, NULL, 0);
+}
+
+ygo_bin_errno_t ygo_db_open_memory(ygo_db_t *db, const uint8_t *data, size_t len) {
+    if (db == NULL || data == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    memset(db, 0, sizeof(*db));
+
+    if (len < YGO_DB_HEADER_LEN) return YGO_BIN_ERR_TRUNCATED;
+    if (memcmp(data, _ygo_db_magic_word, sizeof(_ygo_db_magic_word)) != 0) {
+        return YGO_BIN_ERR_BAD_MAGIC_WORD;
+    }
+    if (ygo_load_be16(data + YGO_DB_OFFSET_VERSION) != YGO_DB_VERSION) {
+        return YGO_BIN_ERR_BAD_VERSION;
+    }
+
+    // 64-bit math, so huge counts or offsets can't wrap around the bounds checks.
+    uint32_t count = ygo_load_be32(data + YGO_DB_OFFSET_COUNT);
+    uint64_t index_offset = ygo_load_be32(data + YGO_DB_OFFSET_INDEX);
+    uint64_t records_offset = ygo_load_be32(data + YGO_DB_OFFSET_RECORDS);
+    uint64_t records_len = ygo_load_be32(data + YGO_DB_OFFSET_RECORDS_LEN);
+
+    if (index_offset + (uint64_t)count * YGO_DB_INDEX_ENTRY_LEN > len) return YGO_BIN_ERR_TRUNCATED;
+    if (records_offset + records_len > len) return YGO_BIN_ERR_TRUNCATED;
+
+    uint64_t hash_offset = ygo_load_be32(data + YGO_DB_OFFSET_HASH);
+    size_t hash_len = 0;
+    ygo_mph_t mph = {0};
+    if (hash_offset != 0) {
+        if (hash_offset > len) return YGO_BIN_ERR_TRUNCATED;
+        ygo_bin_errno_t err = ygo_mph_open(&mph, data + hash_offset, len - hash_offset);
+        if (err != YGO_BIN_OK) return err;
+        if (mph.n > count) return YGO_BIN_ERR_BAD_ARGS;
+
+        hash_len = ygo_mph_size(mph.n);
+        if (hash_offset + hash_len > len) return YGO_BIN_ERR_TRUNCATED;
+    }
+
+    if (_ygo_db_crc(data, data + index_offset, count, data + hash_offset, hash_len) !=
+        ygo_load_be16(data + YGO_DB_OFFSET_CRC)) {
+        return YGO_BIN_ERR_BAD_CHECKSUM;
+    }
+
+    db->data = data;
+    db->len = len;
+    db->count = count;
+    db->index = data + index_offset;
+    db->records = data + records_offset;
+    db->records_len = (size_t)records_len;
+    db->mph = mph;
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_db_open_file(ygo_db_t *db, const char *path) {
+    if (db == NULL || path == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    memset(db, 0, sizeof(*db));
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path,
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              NULL,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              NULL);
+    if (file == INVALID_HANDLE_VALUE) return YGO_BIN_ERR_IO;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return YGO_BIN_ERR_IO;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        return YGO_BIN_ERR_TRUNCATED;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) return YGO_BIN_ERR_IO;
+
+    void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (base == NULL) {
+        CloseHandle(mapping);
+        return YGO_BIN_ERR_IO;
+    }
+    size_t len = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return YGO_BIN_ERR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return YGO_BIN_ERR_IO;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return YGO_BIN_ERR_TRUNCATED;
+    }
+
+    size_t len = (size_t)st.st_size;
+    void *base = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return YGO_BIN_ERR_IO;
+    void *mapping = NULL;
+#endif
+
+    ygo_bin_errno_t err = ygo_db_open_memory(db, (const uint8_t *)base, len);
+    db->map_base = base;
+    db->map_len = len;
+    db->map_handle = (void *)mapping;
+
+    if (err != YGO_BIN_OK) ygo_db_close(db);
+    return err;
+}
+
+void ygo_db_close(ygo_db_t *db) {
+    if (db == NULL) return;
+
+    if (db->map_base != NULL) {
+#ifdef _WIN32
+        UnmapViewOfFile(db->map_base);
+        CloseHandle((HANDLE)db->map_handle);
+#else
+        munmap(db->map_base, db->map_len);
+#endif
+    }
+
+    memset(db, 0, sizeof(*db));
+}
+
+uint32_t ygo_db_id_at(const ygo_db_t *db, size_t pos) {
+    return ygo_load_be32(db->index + pos * YGO_DB_INDEX_ENTRY_LEN);
+}
+
+ygo_bin_errno_t ygo_db_find(const ygo_db_t *db, uint32_t id, size_t *pos) {
+    if (db == NULL || pos == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    if (db->mph.n > 0) {
+        // Every id maps to some slot, the index entry there tells whether it is the one.
+        size_t slot = ygo_mph_lookup(&db->mph, id);
+        if (ygo_db_id_at(db, slot) != id) return YGO_BIN_ERR_NOT_FOUND;
+        *pos = slot;
+        return YGO_BIN_OK;
+    }
+
+    // Without the id hash the index is sorted. Lower bound, so with duplicate ids the first one is
+    // found.
+    size_t lo = 0;
+    size_t hi = db->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ygo_db_id_at(db, mid) < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == db->count || ygo_db_id_at(db, lo) != id) return YGO_BIN_ERR_NOT_FOUND;
+    *pos = lo;
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_db_find_next(const ygo_db_t *db, size_t pos, size_t *next) {
+    if (db == NULL || next == NULL || pos >= db->count) return YGO_BIN_ERR_BAD_ARGS;
+
+    uint32_t id = ygo_db_id_at(db, pos);
+    size_t lo = pos + 1;
+
+    // From a hash slot, the other prints are somewhere among the repeated entries after the last
+    // slot. Those are sorted, so the second print is their lower bound. Past it they are adjacent.
+    if (pos < db->mph.n) {
+        lo = db->mph.n;
+        size_t hi = db->count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (ygo_db_id_at(db, mid) < id) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+
+    if (lo >= db->count || ygo_db_id_at(db, lo) != id) return YGO_BIN_ERR_NOT_FOUND;
+    *next = lo;
+    return YGO_BIN_OK;
+}
+
+/**
+ * Offset of the record of the card at pos from the start of the records, checked to leave room
+ * for the magic word in front of it.
+ */
+static ygo_bin_errno_t _ygo_db_record_offset(const ygo_db_t *db, size_t pos, size_t *offset) {
+    if (db == NULL || pos >= db->count) return YGO_BIN_ERR_BAD_ARGS;
+    *offset = ygo_load_be32(db->index + pos * YGO_DB_INDEX_ENTRY_LEN + 4);
+    if (*offset < sizeof(_ygo_db_magic_word) || *offset >= db->records_len) {
+        return YGO_BIN_ERR_TRUNCATED;
+    }
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_db_view(const ygo_db_t *db, size_t pos, ygo_card_view_t *view) {
+    size_t offset;
+    ygo_bin_errno_t err = _ygo_db_record_offset(db, pos, &offset);
+    if (err != YGO_BIN_OK) return err;
+    return ygo_card_view_init(view, db->records + offset, db->records_len - offset);
+}
+
+ygo_bin_errno_t ygo_db_read_card(const ygo_db_t *db, size_t pos, ygo_card_t *card) {
+    size_t offset;
+    ygo_bin_errno_t err = _ygo_db_record_offset(db, pos, &offset);
+    if (err != YGO_BIN_OK) return err;
+
+    // The batch decoder is the one which bounds the record by the buffer and reports its status.
+    size_t image = offset - sizeof(_ygo_db_magic_word);
+    ygo_card_deserialize_many(card, &err, 1, db->records + image, db->records_len - image);
+    return err;
+}
+
+static const uint8_t _ygo_db_delta_magic_word[] = YGO_DB_DELTA_MAGIC_WORD;
+static const uint8_t _ygo_db_card_magic_word[] = YGO_CARD_DATA_MAGIC_WORD;
+
+// Byte offsets of the delta header fields, see ygo_db.h.
+#define YGO_DB_DELTA_OFFSET_VERSION 4
+#define YGO_DB_DELTA_OFFSET_BASE_COUNT 8
+#define YGO_DB_DELTA_OFFSET_BASE_CRC 12
+#define YGO_DB_DELTA_OFFSET_REMOVED 16
+#define YGO_DB_DELTA_OFFSET_RECORDS 20
+#define YGO_DB_DELTA_OFFSET_RECORDS_LEN 24
+#define YGO_DB_DELTA_OFFSET_CRC 30
+
+/**
+ * Checksum of the delta header (up to the checksum itself) and the body after it.
+ */
+static uint16_t _ygo_db_delta_crc(const uint8_t *data, size_t len) {
+    uint16_t crc = ygo_bin_crc_init();
+    crc = ygo_bin_crc_update(crc, data, YGO_DB_DELTA_OFFSET_CRC);
+    crc = ygo_bin_crc_update(crc, data + YGO_DB_DELTA_HEADER_LEN, len - YGO_DB_DELTA_HEADER_LEN);
+    return ygo_bin_crc_final(crc);
+}
+
+/**
+ * Whole image of the record of the card at pos, magic word included, as it gets copied.
+ */
+static ygo_bin_errno_t _ygo_db_image(const ygo_db_t *db,
+                                     size_t pos,
+                                     const uint8_t **image,
+                                     size_t *len) {
+    size_t offset;
+    ygo_bin_errno_t err = _ygo_db_record_offset(db, pos, &offset);
+    if (err != YGO_BIN_OK) return err;
+
+    size_t size = ygo_card_record_size(db->records + offset, db->records_len - offset);
+    if (size == 0) return YGO_BIN_ERR_TRUNCATED;
+    *image = db->records + offset - sizeof(_ygo_db_magic_word);
+    *len = size + sizeof(_ygo_db_magic_word);
+    return YGO_BIN_OK;
+}
+
+/**
+ * First position past pos holding another id.
+ */
+static size_t _ygo_db_group_end(const ygo_db_t *db, size_t pos) {
+    uint32_t id = ygo_db_id_at(db, pos);
+    while (++pos < db->count && ygo_db_id_at(db, pos) == id) {
+    }
+    return pos;
+}
+
+/**
+ * Point sorted at db with its index in id order, the order diffs and patches walk. With an id hash
+ * the index is in slot order, so sorted gets a sorted copy, freed by _ygo_db_release_sorted().
+ */
+static ygo_bin_errno_t _ygo_db_sorted(const ygo_db_t *db, ygo_db_t *sorted) {
+    *sorted = *db;
+    if (db->mph.n == 0) return YGO_BIN_OK;
+
+    size_t len = (size_t)db->count * YGO_DB_INDEX_ENTRY_LEN;
+    uint8_t *index = (uint8_t *)malloc(len + 1);
+    if (index == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    memcpy(index, db->index, len);
+    qsort(index, db->count, YGO_DB_INDEX_ENTRY_LEN, _ygo_db_compare_entries);
+
+    sorted->index = index;
+    memset(&sorted->mph, 0, sizeof(sorted->mph));
+    return YGO_BIN_OK;
+}
+
+static void _ygo_db_release_sorted(const ygo_db_t *db, ygo_db_t *sorted) {
+    if (sorted->index != db->index) free((void *)sorted->index);
+}
+
+/**
+ * Append the records of the cards at positions [pos, end) to the delta records. Only counts them
+ * when records is NULL.
+ */
+static ygo_bin_errno_t _ygo_db_diff_copy(const ygo_db_t *db,
+                                         size_t pos,
+                                         size_t end,
+                                         uint8_t *records,
+                                         uint32_t *record_count,
+                                         size_t *records_len) {
+    for (; pos < end; pos++) {
+        const uint8_t *image;
+        size_t len;
+        ygo_bin_errno_t err = _ygo_db_image(db, pos, &image, &len);
+        if (err != YGO_BIN_OK) return err;
+
+        if (records != NULL) memcpy(records + *records_len, image, len);
+        *records_len += len;
+        (*record_count)++;
+    }
+    return YGO_BIN_OK;
+}
+
+/**
+ * Walk both indexes one id at a time, collecting what differs. Only counts when the outputs are
+ * NULL.
+ */
+static ygo_bin_errno_t _ygo_db_diff_walk(const ygo_db_t *from,
+                                         const ygo_db_t *to,
+                                         ygo_bin_write_context_t *removed,
+                                         uint8_t *records,
+                                         uint32_t *removed_count,
+                                         uint32_t *record_count,
+                                         size_t *records_len) {
+    size_t i = 0;
+    size_t j = 0;
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    *removed_count = 0;
+    *record_count = 0;
+    *records_len = 0;
+
+    while (err == YGO_BIN_OK && (i < from->count || j < to->count)) {
+        uint32_t from_id = i < from->count ? ygo_db_id_at(from, i) : 0;
+        uint32_t to_id = j < to->count ? ygo_db_id_at(to, j) : 0;
+
+        if (j == to->count || (i < from->count && from_id < to_id)) {
+            if (removed != NULL) ygo_bin_write_int32(removed, from_id);
+            (*removed_count)++;
+            i = _ygo_db_group_end(from, i);
+            continue;
+        }
+
+        size_t to_end = _ygo_db_group_end(to, j);
+        if (i == from->count || to_id < from_id) {
+            err = _ygo_db_diff_copy(to, j, to_end, records, record_count, records_len);
+            j = to_end;
+            continue;
+        }
+
+        // Same id on both sides, the cards count as changed unless every record is the same.
+        size_t from_end = _ygo_db_group_end(from, i);
+        int same = (from_end - i) == (to_end - j);
+        for (size_t k = 0; same && k < to_end - j; k++) {
+            const uint8_t *a;
+            const uint8_t *b;
+            size_t a_len;
+            size_t b_len;
+            err = _ygo_db_image(from, i + k, &a, &a_len);
+            if (err == YGO_BIN_OK) err = _ygo_db_image(to, j + k, &b, &b_len);
+            if (err != YGO_BIN_OK) return err;
+            same = a_len == b_len && memcmp(a, b, a_len) == 0;
+        }
+        if (!same) err = _ygo_db_diff_copy(to, j, to_end, records, record_count, records_len);
+        i = from_end;
+        j = to_end;
+    }
+    return err;
+}
+
+/**
+ * ygo_db_diff() between two databases whose indexes are sorted.
+ */
+static size_t _ygo_db_diff_sorted(uint8_t *buffer, const ygo_db_t *from, const ygo_db_t *to) {
+    uint32_t removed_count;
+    uint32_t record_count;
+    size_t records_len;
+    if (_ygo_db_diff_walk(from, to, NULL, NULL, &removed_count, &record_count, &records_len) !=
+        YGO_BIN_OK) {
+        return 0;
+    }
+
+    size_t records_offset = YGO_DB_DELTA_HEADER_LEN + 4 * (size_t)removed_count;
+    size_t size = records_offset + records_len;
+    if (buffer == NULL) return size;
+
+    ygo_bin_write_context_t removed;
+    ygo_bin_begin_data_write(&removed, buffer + YGO_DB_DELTA_HEADER_LEN);
+    _ygo_db_diff_walk(from,
+                      to,
+                      &removed,
+                      buffer + records_offset,
+                      &removed_count,
+                      &record_count,
+                      &records_len);
+
+    ygo_bin_write_context_t header;
+    ygo_bin_begin_data_write(&header, buffer);
+    ygo_bin_write_bytes(&header, _ygo_db_delta_magic_word, sizeof(_ygo_db_delta_magic_word));
+    ygo_bin_write_int16(&header, YGO_DB_DELTA_VERSION);
+    ygo_bin_write_int16(&header, 0x0000);
+    ygo_bin_write_int32(&header, from->count);
+    ygo_bin_write_int16(&header, ygo_load_be16(from->data + YGO_DB_OFFSET_CRC));
+    ygo_bin_write_int16(&header, 0x0000);
+    ygo_bin_write_int32(&header, removed_count);
+    ygo_bin_write_int32(&header, record_count);
+    ygo_bin_write_int32(&header, (uint32_t)records_len);
+    while (header.ptr < YGO_DB_DELTA_OFFSET_CRC) {
+        ygo_bin_write_int8(&header, 0x00);
+    }
+    ygo_bin_write_int16(&header, _ygo_db_delta_crc(buffer, size));
+
+    return size;
+}
+
+size_t ygo_db_diff(uint8_t *buffer, const ygo_db_t *from, const ygo_db_t *to) {
+    if (from == NULL || to == NULL) return 0;
+
+    ygo_db_t from_sorted;
+    ygo_db_t to_sorted;
+    if (_ygo_db_sorted(from, &from_sorted) != YGO_BIN_OK) return 0;
+    size_t size = 0;
+    if (_ygo_db_sorted(to, &to_sorted) == YGO_BIN_OK) {
+        size = _ygo_db_diff_sorted(buffer, &from_sorted, &to_sorted);
+        _ygo_db_release_sorted(to, &to_sorted);
+    }
+    _ygo_db_release_sorted(from, &from_sorted);
+    return size;
+}
+
+/**
+ * Length of the delta record image at offset at of the records, and its card id.
+ */
+static size_t _ygo_db_delta_image(const ygo_db_delta_t *delta, size_t at, uint32_t *id) {
+    const uint8_t *record = delta->records + at + sizeof(_ygo_db_card_magic_word);
+    *id = ygo_load_be32(record + YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_ID);
+    return sizeof(_ygo_db_card_magic_word) +
+           ygo_card_record_size(record, delta->records_len - at - sizeof(_ygo_db_card_magic_word));
+}
+
+ygo_bin_errno_t ygo_db_delta_open(ygo_db_delta_t *delta, const uint8_t *data, size_t len) {
+    if (delta == NULL || data == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    memset(delta, 0, sizeof(*delta));
+
+    if (len < YGO_DB_DELTA_HEADER_LEN) return YGO_BIN_ERR_TRUNCATED;
+    if (memcmp(data, _ygo_db_delta_magic_word, sizeof(_ygo_db_delta_magic_word)) != 0) {
+        return YGO_BIN_ERR_BAD_MAGIC_WORD;
+    }
+    if (ygo_load_be16(data + YGO_DB_DELTA_OFFSET_VERSION) != YGO_DB_DELTA_VERSION) {
+        return YGO_BIN_ERR_BAD_VERSION;
+    }
+
+    uint32_t removed_count = ygo_load_be32(data + YGO_DB_DELTA_OFFSET_REMOVED);
+    uint32_t record_count = ygo_load_be32(data + YGO_DB_DELTA_OFFSET_RECORDS);
+    uint64_t records_offset = YGO_DB_DELTA_HEADER_LEN + 4 * (uint64_t)removed_count;
+    uint64_t size = records_offset + ygo_load_be32(data + YGO_DB_DELTA_OFFSET_RECORDS_LEN);
+    if (size > len) return YGO_BIN_ERR_TRUNCATED;
+
+    if (_ygo_db_delta_crc(data, (size_t)size) != ygo_load_be16(data + YGO_DB_DELTA_OFFSET_CRC)) {
+        return YGO_BIN_ERR_BAD_CHECKSUM;
+    }
+
+    delta->data = data;
+    delta->len = len;
+    delta->base_count = ygo_load_be32(data + YGO_DB_DELTA_OFFSET_BASE_COUNT);
+    delta->base_crc = ygo_load_be16(data + YGO_DB_DELTA_OFFSET_BASE_CRC);
+    delta->removed_count = removed_count;
+    delta->removed = data + YGO_DB_DELTA_HEADER_LEN;
+    delta->record_count = record_count;
+    delta->records = data + records_offset;
+    delta->records_len = (size_t)(size - records_offset);
+
+    for (uint32_t r = 1; r < removed_count; r++) {
+        if (ygo_load_be32(delta->removed + 4 * r) <= ygo_load_be32(delta->removed + 4 * (r - 1))) {
+            return YGO_BIN_ERR_BAD_ARGS;
+        }
+    }
+
+    // Every record must be whole, in id order, and not for a removed card.
+    size_t at = 0;
+    uint32_t r = 0;
+    uint32_t last_id = 0;
+    for (uint32_t k = 0; k < record_count; k++) {
+        const uint8_t *image = delta->records + at;
+        size_t left = delta->records_len - at;
+        ygo_card_view_t view;
+        size_t magic_len = sizeof(_ygo_db_card_magic_word);
+        if (left < magic_len || memcmp(image, _ygo_db_card_magic_word, magic_len) != 0 ||
+            ygo_card_view_init(&view, image + magic_len, left - magic_len) != YGO_BIN_OK ||
+            ygo_card_record_size(image + magic_len, left - magic_len) == 0) {
+            return YGO_BIN_ERR_BAD_ARGS;
+        }
+
+        uint32_t id;
+        at += _ygo_db_delta_image(delta, at, &id);
+        if (k > 0 && id < last_id) return YGO_BIN_ERR_BAD_ARGS;
+        while (r < removed_count && ygo_load_be32(delta->removed + 4 * r) < id) {
+            r++;
+        }
+        if (r < removed_count && ygo_load_be32(delta->removed + 4 * r) == id) {
+            return YGO_BIN_ERR_BAD_ARGS;
+        }
+        last_id = id;
+    }
+    if (at != delta->records_len) return YGO_BIN_ERR_BAD_ARGS;
+
+    return YGO_BIN_OK;
+}
+
+/**
+ * Merge the base index, minus every id the delta mentions, with the delta records, in id order.
+ * Only counts when index and records are NULL.
+ */
+static ygo_bin_errno_t _ygo_db_patch_walk(const ygo_db_t *base,
+                                          const ygo_db_delta_t *delta,
+                                          uint8_t *index,
+                                          uint8_t *records,
+                                          size_t *count,
+                                          size_t *records_len) {
+    size_t pos = 0;
+    uint32_t r = 0;
+
+    // Delta records are walked twice: ahead, to tell which base ids they replace, and to copy.
+    size_t ahead_at = 0;
+    uint32_t ahead = 0;
+    uint32_t ahead_id = 0;
+    size_t ahead_len = delta->record_count > 0 ? _ygo_db_delta_image(delta, 0, &ahead_id) : 0;
+    size_t at = 0;
+    uint32_t k = 0;
+
+    ygo_bin_write_context_t entries;
+    if (index != NULL) ygo_bin_begin_data_write(&entries, index);
+    *count = 0;
+    *records_len = 0;
+
+    for (;;) {
+        for (; pos < base->count; pos++) {
+            uint32_t id = ygo_db_id_at(base, pos);
+            while (r < delta->removed_count && ygo_load_be32(delta->removed + 4 * r) < id) {
+                r++;
+            }
+            while (ahead < delta->record_count && ahead_id < id) {
+                ahead_at += ahead_len;
+                if (++ahead < delta->record_count) {
+                    ahead_len = _ygo_db_delta_image(delta, ahead_at, &ahead_id);
+                }
+            }
+            int removed = r < delta->removed_count && ygo_load_be32(delta->removed + 4 * r) == id;
+            int replaced = ahead < delta->record_count && ahead_id == id;
+            if (!removed && !replaced) break;
+        }
+
+        const uint8_t *image = NULL;
+        size_t len = 0;
+        uint32_t id = 0;
+        if (pos < base->count) {
+            id = ygo_db_id_at(base, pos);
+            ygo_bin_errno_t err = _ygo_db_image(base, pos, &image, &len);
+            if (err != YGO_BIN_OK) return err;
+        }
+
+        uint32_t delta_id = 0;
+        size_t delta_len = k < delta->record_count ? _ygo_db_delta_image(delta, at, &delta_id) : 0;
+        if (pos < base->count && (k == delta->record_count || id < delta_id)) {
+            pos++;
+        } else if (k < delta->record_count) {
+            id = delta_id;
+            image = delta->records + at;
+            len = delta_len;
+            at += delta_len;
+            k++;
+        } else {
+            break;
+        }
+
+        if (index != NULL) {
+            ygo_bin_write_int32(&entries, id);
+            ygo_bin_write_int32(&entries, (uint32_t)(*records_len + sizeof(_ygo_db_magic_word)));
+            memcpy(records + *records_len, image, len);
+        }
+        *records_len += len;
+        (*count)++;
+    }
+    return YGO_BIN_OK;
+}
+
+/**
+ * ygo_db_patch() of a base whose index is sorted. Its id hash, if any, is still in base->data.
+ */
+static ygo_bin_errno_t _ygo_db_patch_sorted(uint8_t *buffer,
+                                            size_t *len,
+                                            const ygo_db_t *base,
+                                            uint32_t base_ids,
+                                            const ygo_db_delta_t *delta) {
+    size_t n;
+    size_t records_len;
+    ygo_bin_errno_t err = _ygo_db_patch_walk(base, delta, NULL, NULL, &n, &records_len);
+    if (err != YGO_BIN_OK) return err;
+
+    size_t records_offset = YGO_DB_HEADER_LEN + n * YGO_DB_INDEX_ENTRY_LEN;
+    if (buffer == NULL) {
+        *len = ((records_offset + records_len + 3) & ~(size_t)3) + ygo_mph_size(n);
+        return YGO_BIN_OK;
+    }
+
+    uint8_t *index = buffer + YGO_DB_HEADER_LEN;
+    _ygo_db_patch_walk(base, delta, index, buffer + records_offset, &n, &records_len);
+
+    // With the same ids, the id hash still holds and puts the new index in the same slot order.
+    int same_ids = base_ids > 0 && n == base->count;
+    for (size_t pos = 0; same_ids && pos < n; pos++) {
+        same_ids = ygo_load_be32(index + pos * YGO_DB_INDEX_ENTRY_LEN) == ygo_db_id_at(base, pos);
+    }
+
+    const uint8_t *hash = NULL;
+    size_t hash_len = 0;
+    if (same_ids) {
+        hash = base->data + ygo_load_be32(base->data + YGO_DB_OFFSET_HASH);
+        hash_len = ygo_mph_size(base_ids);
+    }
+
+    *len = _ygo_db_finish(buffer, n, records_len, hash, hash_len);
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_db_patch(uint8_t *buffer,
+                             size_t *len,
+                             const ygo_db_t *base,
+                             const ygo_db_delta_t *delta) {
+    if (len == NULL || base == NULL || base->data == NULL || delta == NULL) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    if (base->count != delta->base_count ||
+        ygo_load_be16(base->data + YGO_DB_OFFSET_CRC) != delta->base_crc) {
+        return YGO_BIN_ERR_BAD_VERSION;
+    }
+
+    ygo_db_t sorted;
+    ygo_bin_errno_t err = _ygo_db_sorted(base, &sorted);
+    if (err != YGO_BIN_OK) return err;
+    err = _ygo_db_patch_sorted(buffer, len, &sorted, base->mph.n, delta);
+    _ygo_db_release_sorted(base, &sorted);
+    return err;
+}
+
+#ifndef _WIN32
+/**
+ * Flush the directory holding path, so a rename within it survives a power loss. Filesystems
+ * which can't sync a directory (EINVAL) are taken to not need it.
+ */
+static int _ygo_db_sync_parent(const char *path) {
+    const char *slash = strrchr(path, '/');
+    char *dir = NULL;
+    if (slash != NULL) {
+        size_t dir_len = slash == path ? 1 : (size_t)(slash - path);
+        dir = (char *)malloc(dir_len + 1);
+        if (dir == NULL) return 0;
+        memcpy(dir, path, dir_len);
+        dir[dir_len] = '\0';
+    }
+
+    int fd = open(dir != NULL ? dir : ".", O_RDONLY);
+    free(dir);
+    if (fd < 0) return 0;
+    int ok = fsync(fd) == 0 || errno == EINVAL;
+    close(fd);
+    return ok;
+}
+#endif
+
+/**
+ * Write len bytes of data to path with ".tmp" appended, flush it to disk and rename it to path.
+ * On POSIX the directory is flushed too, otherwise the rename itself may not be on disk yet.
+ */
+static ygo_bin_errno_t _ygo_db_replace_file(const char *path, const uint8_t *data, size_t len) {
+    size_t path_len = strlen(path);
+    char *tmp = (char *)malloc(path_len + sizeof(".tmp"));
+    if (tmp == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    memcpy(tmp, path, path_len);
+    memcpy(tmp + path_len, ".tmp", sizeof(".tmp"));
+
+    int ok = 0;
+#ifdef _WIN32
+    HANDLE file =
+        CreateFileA(tmp, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file != INVALID_HANDLE_VALUE) {
+        ok = 1;
+        for (size_t done = 0; ok && done < len;) {
+            DWORD chunk = (len - done > 0x40000000) ? 0x40000000 : (DWORD)(len - done);
+            DWORD written = 0;
+            ok = WriteFile(file, data + done, chunk, &written, NULL) && written > 0;
+            done += written;
+        }
+        ok = ok && FlushFileBuffers(file);
+        CloseHandle(file);
+        ok = ok && MoveFileExA(tmp, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+        if (!ok) DeleteFileA(tmp);
+    }
+#else
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        ok = 1;
+        for (size_t done = 0; ok && done < len;) {
+            // Short writes continue where they stopped, a signal before anything was written
+            // retries.
+            ssize_t written = write(fd, data + done, len - done);
+            if (written < 0 && errno == EINTR) continue;
+            ok = written > 0;
+            if (ok) done += (size_t)written;
+        }
+        ok = ok && fsync(fd) == 0;
+        ok = (close(fd) == 0) && ok;
+        ok = ok && rename(tmp, path) == 0;
+        if (!ok) unlink(tmp);
+        ok = ok && _ygo_db_sync_parent(path);
+    }
+#endif
+
+    free(tmp);
+    return ok ? YGO_BIN_OK : YGO_BIN_ERR_IO;
+}
+
+ygo_bin_errno_t ygo_db_patch_file(const char *path, const uint8_t *data, size_t len) {
+    if (path == NULL || data == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    ygo_db_delta_t delta;
+    ygo_bin_errno_t err = ygo_db_delta_open(&delta, data, len);
+    if (err != YGO_BIN_OK) return err;
+
+    ygo_db_t base;
+    err = ygo_db_open_file(&base, path);
+    if (err != YGO_BIN_OK) return err;
+
+    size_t size = 0;
+    uint8_t *buffer = NULL;
+    err = ygo_db_patch(NULL, &size, &base, &delta);
+    if (err == YGO_BIN_OK) {
+        buffer = (uint8_t *)malloc(size);
+        if (buffer == NULL) err = YGO_BIN_ERR_NO_MEMORY;
+    }
+    if (err == YGO_BIN_OK) err = ygo_db_patch(buffer, &size, &base, &delta);
+
+    // Windows won't replace a file which is still mapped.
+    ygo_db_close(&base);
+
+    if (err == YGO_BIN_OK) err = _ygo_db_replace_file(path, buffer, size);
+    free(buffer);
+    return err;
+}
@@ -0,0 +1,857 @@
+/**
+ * @file ygo_ed25519.c
+ * @brief Ed25519 verification: SHA-512, field and group arithmetic, multi-scalar multiplication.
+ *
+ * Field elements are ten limbs of alternately 26 and 25 bits, as in the ref10 implementation, so
+ * that every product fits in 64 bits on a 32-bit MCU. Points are in extended coordinates on the
+ * twisted Edwards curve -x^2 + y^2 = 1 + d x^2 y^2. Everything handled here is public, so nothing
+ * needs to run in constant time.
+ */
+#include "ygo_ed25519.h"
+#include <stdlib.h>
+#include <string.h>
+
+/////
+// SHA-512, which Ed25519 hashes R || A || message with
+
+typedef struct {
+    uint64_t state[8];
+    uint64_t len; // Bytes hashed so far
+    uint8_t block[128];
+} _ygo_sha512_t;
+
+static const uint64_t _ygo_sha512_k[80] = {
+    0x428A2F98D728AE22ull, 0x7137449123EF65CDull, 0xB5C0FBCFEC4D3B2Full,
+    0xE9B5DBA58189DBBCull, 0x3956C25BF348B538ull, 0x59F111F1B605D019ull,
+    0x923F82A4AF194F9Bull, 0xAB1C5ED5DA6D8118ull, 0xD807AA98A3030242ull,
+    0x12835B0145706FBEull, 0x243185BE4EE4B28Cull, 0x550C7DC3D5FFB4E2ull,
+    0x72BE5D74F27B896Full, 0x80DEB1FE3B1696B1ull, 0x9BDC06A725C71235ull,
+    0xC19BF174CF692694ull, 0xE49B69C19EF14AD2ull, 0xEFBE4786384F25E3ull,
+    0x0FC19DC68B8CD5B5ull, 0x240CA1CC77AC9C65ull, 0x2DE92C6F592B0275ull,
+    0x4A7484AA6EA6E483ull, 0x5CB0A9DCBD41FBD4ull, 0x76F988DA831153B5ull,
+    0x983E5152EE66DFABull, 0xA831C66D2DB43210ull, 0xB00327C898FB213Full,
+    0xBF597FC7BEEF0EE4ull, 0xC6E00BF33DA88FC2ull, 0xD5A79147930AA725ull,
+    0x06CA6351E003826Full, 0x142929670A0E6E70ull, 0x27B70A8546D22FFCull,
+    0x2E1B21385C26C926ull, 0x4D2C6DFC5AC42AEDull, 0x53380D139D95B3DFull,
+    0x650A73548BAF63DEull, 0x766A0ABB3C77B2A8ull, 0x81C2C92E47EDAEE6ull,
+    0x92722C851482353Bull, 0xA2BFE8A14CF10364ull, 0xA81A664BBC423001ull,
+    0xC24B8B70D0F89791ull, 0xC76C51A30654BE30ull, 0xD192E819D6EF5218ull,
+    0xD69906245565A910ull, 0xF40E35855771202Aull, 0x106AA07032BBD1B8ull,
+    0x19A4C116B8D2D0C8ull, 0x1E376C085141AB53ull, 0x2748774CDF8EEB99ull,
+    0x34B0BCB5E19B48A8ull, 0x391C0CB3C5C95A63ull, 0x4ED8AA4AE3418ACBull,
+    0x5B9CCA4F7763E373ull, 0x682E6FF3D6B2B8A3ull, 0x748F82EE5DEFB2FCull,
+    0x78A5636F43172F60ull, 0x84C87814A1F0AB72ull, 0x8CC702081A6439ECull,
+    0x90BEFFFA23631E28ull, 0xA4506CEBDE82BDE9ull, 0xBEF9A3F7B2C67915ull,
+    0xC67178F2E372532Bull, 0xCA273ECEEA26619Cull, 0xD186B8C721C0C207ull,
+    0xEADA7DD6CDE0EB1Eull, 0xF57D4F7FEE6ED178ull, 0x06F067AA72176FBAull,
+    0x0A637DC5A2C898A6ull, 0x113F9804BEF90DAEull, 0x1B710B35131C471Bull,
+    0x28DB77F523047D84ull, 0x32CAAB7B40C72493ull, 0x3C9EBE0A15C9BEBCull,
+    0x431D67C49C100D4Cull, 0x4CC5D4BECB3E42B6ull, 0x597F299CFC657E2Aull,
+    0x5FCB6FAB3AD6FAECull, 0x6C44198C4A475817ull,
+};
+
+#define YGO_SHA512_ROTR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static inline uint64_t _ygo_ed25519_load_be64(const uint8_t *p) {
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+           ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+static void _ygo_sha512_compress(uint64_t state[8], const uint8_t *block) {
+    uint64_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = _ygo_ed25519_load_be64(block + 8 * i);
+    }
+    for (int i = 16; i < 80; i++) {
+        uint64_t x = w[i - 15], y = w[i - 2];
+        uint64_t s0 = YGO_SHA512_ROTR(x, 1) ^ YGO_SHA512_ROTR(x, 8) ^ (x >> 7);
+        uint64_t s1 = YGO_SHA512_ROTR(y, 19) ^ YGO_SHA512_ROTR(y, 61) ^ (y >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 80; i++) {
+        uint64_t s1 = YGO_SHA512_ROTR(e, 14) ^ YGO_SHA512_ROTR(e, 18) ^ YGO_SHA512_ROTR(e, 41);
+        uint64_t t1 = h + s1 + ((e & f) ^ (~e & g)) + _ygo_sha512_k[i] + w[i];
+        uint64_t s0 = YGO_SHA512_ROTR(a, 28) ^ YGO_SHA512_ROTR(a, 34) ^ YGO_SHA512_ROTR(a, 39);
+        uint64_t t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+static void _ygo_sha512_init(_ygo_sha512_t *sha) {
+    static const uint64_t iv[8] = {
+        0x6A09E667F3BCC908ull, 0xBB67AE8584CAA73Bull,
+        0x3C6EF372FE94F82Bull, 0xA54FF53A5F1D36F1ull,
+        0x510E527FADE682D1ull, 0x9B05688C2B3E6C1Full,
+        0x1F83D9ABFB41BD6Bull, 0x5BE0CD19137E2179ull,
+    };
+    memcpy(sha->state, iv, sizeof(iv));
+    sha->len = 0;
+}
+
+static void _ygo_sha512_update(_ygo_sha512_t *sha, const uint8_t *data, size_t len) {
+    size_t fill = (size_t)(sha->len % 128);
+    sha->len += len;
+    if (fill != 0) {
+        size_t take = len < 128 - fill ? len : 128 - fill;
+        memcpy(sha->block + fill, data, take);
+        data += take;
+        len -= take;
+        if (fill + take < 128) return;
+        _ygo_sha512_compress(sha->state, sha->block);
+    }
+    for (; len >= 128; data += 128, len -= 128) {
+        _ygo_sha512_compress(sha->state, data);
+    }
+    memcpy(sha->block, data, len);
+}
+
+static void _ygo_sha512_final(_ygo_sha512_t *sha, uint8_t out[64]) {
+    size_t fill = (size_t)(sha->len % 128);
+    sha->block[fill++] = 0x80;
+    if (fill > 112) {
+        memset(sha->block + fill, 0, 128 - fill);
+        _ygo_sha512_compress(sha->state, sha->block);
+        fill = 0;
+    }
+    memset(sha->block + fill, 0, 120 - fill);
+
+    // Length in bits, as 128 bits of which the top 64 are always 0 here
+    uint64_t bits = sha->len << 3;
+    for (int i = 0; i < 8; i++) {
+        sha->block[120 + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    _ygo_sha512_compress(sha->state, sha->block);
+
+    for (int i = 0; i < 64; i++) {
+        out[i] = (uint8_t)(sha->state[i / 8] >> (56 - 8 * (i % 8)));
+    }
+}
+
+/////
+// Field arithmetic modulo p = 2^255 - 19
+
+typedef struct {
+    int32_t v[10];
+} _ygo_fe_t;
+
+// Bit offset of each limb, and of the end of the last one.
+static const uint8_t _ygo_fe_offset[11] = {0, 26, 51, 77, 102, 128, 153, 179, 204, 230, 255};
+
+#define YGO_FE_WIDTH(i) (((i) & 1) ? 25 : 26)
+
+static const _ygo_fe_t _ygo_fe_one = {{1, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+static const _ygo_fe_t _ygo_fe_d = {{56195235, 13857412, 51736253, 6949390, 114729, 24766616,
+                                     60832955, 30306712, 48412415, 21499315}};
+static const _ygo_fe_t _ygo_fe_d2 = {{45281625, 27714825, 36363642, 13898781, 229458, 15978800,
+                                      54557047, 27058993, 29715967, 9444199}};
+static const _ygo_fe_t _ygo_fe_sqrtm1 = {{34513072, 25610706, 9377949, 3500415, 12389472,
+                                          33281959, 41962654, 31548777, 326685, 11406482}};
+
+/**
+ * Carry h into limbs of their width, the carry out of the top limb coming back as 19 times it
+ * into the bottom one, since 2^255 = 19 (mod p). Limbs end up non-negative and within their
+ * width, the second one at most a few bits over.
+ */
+static void _ygo_fe_carry(_ygo_fe_t *out, int64_t h[10]) {
+    for (int i = 0; i < 10; i++) {
+        int64_t carry = h[i] >> YGO_FE_WIDTH(i);
+        h[i] -= carry * ((int64_t)1 << YGO_FE_WIDTH(i));
+        if (i < 9) {
+            h[i + 1] += carry;
+        } else {
+            h[0] += carry * 19;
+        }
+    }
+    int64_t carry = h[0] >> 26;
+    h[0] -= carry * ((int64_t)1 << 26);
+    h[1] += carry;
+
+    for (int i = 0; i < 10; i++) {
+        out->v[i] = (int32_t)h[i];
+    }
+}
+
+static void _ygo_fe_add(_ygo_fe_t *out, const _ygo_fe_t *f, const _ygo_fe_t *g) {
+    int64_t h[10];
+    for (int i = 0; i < 10; i++) {
+        h[i] = (int64_t)f->v[i] + g->v[i];
+    }
+    _ygo_fe_carry(out, h);
+}
+
+static void _ygo_fe_sub(_ygo_fe_t *out, const _ygo_fe_t *f, const _ygo_fe_t *g) {
+    int64_t h[10];
+    for (int i = 0; i < 10; i++) {
+        h[i] = (int64_t)f->v[i] - g->v[i];
+    }
+    _ygo_fe_carry(out, h);
+}
+
+static void _ygo_fe_neg(_ygo_fe_t *out, const _ygo_fe_t *f) {
+    int64_t h[10];
+    for (int i = 0; i < 10; i++) {
+        h[i] = -(int64_t)f->v[i];
+    }
+    _ygo_fe_carry(out, h);
+}
+
+/**
+ * Limb i has weight 2^ceil(25.5 i), so the product of two odd limbs lands one bit short of the
+ * limb it adds to and counts twice, and products past the top limb wrap around times 19.
+ */
+static void _ygo_fe_mul(_ygo_fe_t *out, const _ygo_fe_t *f, const _ygo_fe_t *g) {
+    int64_t h[10] = {0};
+    for (int i = 0; i < 10; i++) {
+        int64_t fi = f->v[i];
+        int64_t fi_odd = (i & 1) ? 2 * fi : fi;
+        for (int j = 0; j < 10 - i; j++) {
+            h[i + j] += ((j & 1) ? fi_odd : fi) * g->v[j];
+        }
+        for (int j = 10 - i; j < 10; j++) {
+            h[i + j - 10] += ((j & 1) ? fi_odd : fi) * (19 * (int64_t)g->v[j]);
+        }
+    }
+    _ygo_fe_carry(out, h);
+}
+
+static void _ygo_fe_sq(_ygo_fe_t *out, const _ygo_fe_t *f) {
+    _ygo_fe_mul(out, f, f);
+}
+
+/**
+ * f squared n times.
+ */
+static void _ygo_fe_sqn(_ygo_fe_t *out, const _ygo_fe_t *f, int n) {
+    _ygo_fe_sq(out, f);
+    for (int i = 1; i < n; i++) {
+        _ygo_fe_sq(out, out);
+    }
+}
+
+/**
+ * Little-endian bytes, bit 255 ignored. The value may be up to 2^255 - 1, i.e. not reduced.
+ */
+static void _ygo_fe_frombytes(_ygo_fe_t *out, const uint8_t s[32]) {
+    for (int i = 0; i < 10; i++) {
+        unsigned offset = _ygo_fe_offset[i];
+        unsigned last = (_ygo_fe_offset[i + 1] - 1) / 8;
+        uint64_t bits = 0;
+        for (unsigned b = offset / 8; b <= last; b++) {
+            bits |= (uint64_t)s[b] << (8 * (b - offset / 8));
+        }
+        out->v[i] = (int32_t)((bits >> (offset % 8)) & (((uint64_t)1 << YGO_FE_WIDTH(i)) - 1));
+    }
+}
+
+/**
+ * The reduced value, below p, as little-endian bytes.
+ */
+static void _ygo_fe_tobytes(uint8_t s[32], const _ygo_fe_t *f) {
+    int64_t h[10];
+    for (int i = 0; i < 10; i++) {
+        h[i] = f->v[i];
+    }
+    _ygo_fe_t carried;
+    _ygo_fe_carry(&carried, h);
+    for (int i = 0; i < 10; i++) {
+        h[i] = carried.v[i];
+    }
+
+    // The value is now below 2p. q is 1 if adding 19 carries past bit 255, i.e. if it is p or
+    // more, and adding 19q then dropping bit 255 subtracts qp.
+    int64_t q = 19;
+    for (int i = 0; i < 10; i++) {
+        q = (h[i] + q) >> YGO_FE_WIDTH(i);
+    }
+    h[0] += 19 * q;
+    for (int i = 0; i < 9; i++) {
+        int64_t carry = h[i] >> YGO_FE_WIDTH(i);
+        h[i] -= carry * ((int64_t)1 << YGO_FE_WIDTH(i));
+        h[i + 1] += carry;
+    }
+    h[9] &= ((int64_t)1 << 25) - 1;
+
+    memset(s, 0, 32);
+    for (int i = 0; i < 10; i++) {
+        uint64_t bits = (uint64_t)h[i] << (_ygo_fe_offset[i] % 8);
+        for (unsigned b = _ygo_fe_offset[i] / 8; bits != 0; b++, bits >>= 8) {
+            s[b] |= (uint8_t)bits;
+        }
+    }
+}
+
+static int _ygo_fe_is_zero(const _ygo_fe_t *f) {
+    uint8_t s[32];
+    _ygo_fe_tobytes(s, f);
+    uint8_t any = 0;
+    for (int i = 0; i < 32; i++) {
+        any |= s[i];
+    }
+    return any == 0;
+}
+
+static int _ygo_fe_equal(const _ygo_fe_t *f, const _ygo_fe_t *g) {
+    _ygo_fe_t diff;
+    _ygo_fe_sub(&diff, f, g);
+    return _ygo_fe_is_zero(&diff);
+}
+
+static int _ygo_fe_is_negative(const _ygo_fe_t *f) {
+    uint8_t s[32];
+    _ygo_fe_tobytes(s, f);
+    return s[0] & 1;
+}
+
+/**
+ * z^((p - 5) / 8) = z^(2^252 - 3), for the square root in point decoding.
+ */
+static void _ygo_fe_pow22523(_ygo_fe_t *out, const _ygo_fe_t *z) {
+    _ygo_fe_t t0, t1, t2;
+    _ygo_fe_sq(&t0, z);           // 2
+    _ygo_fe_sqn(&t1, &t0, 2);     // 8
+    _ygo_fe_mul(&t1, z, &t1);     // 9
+    _ygo_fe_mul(&t0, &t0, &t1);   // 11
+    _ygo_fe_sq(&t0, &t0);         // 22
+    _ygo_fe_mul(&t0, &t1, &t0);   // 2^5 - 1
+    _ygo_fe_sqn(&t1, &t0, 5);     // 2^10 - 2^5
+    _ygo_fe_mul(&t0, &t1, &t0);   // 2^10 - 1
+    _ygo_fe_sqn(&t1, &t0, 10);    // 2^20 - 2^10
+    _ygo_fe_mul(&t1, &t1, &t0);   // 2^20 - 1
+    _ygo_fe_sqn(&t2, &t1, 20);    // 2^40 - 2^20
+    _ygo_fe_mul(&t1, &t2, &t1);   // 2^40 - 1
+    _ygo_fe_sqn(&t1, &t1, 10);    // 2^50 - 2^10
+    _ygo_fe_mul(&t0, &t1, &t0);   // 2^50 - 1
+    _ygo_fe_sqn(&t1, &t0, 50);    // 2^100 - 2^50
+    _ygo_fe_mul(&t1, &t1, &t0);   // 2^100 - 1
+    _ygo_fe_sqn(&t2, &t1, 100);   // 2^200 - 2^100
+    _ygo_fe_mul(&t1, &t2, &t1);   // 2^200 - 1
+    _ygo_fe_sqn(&t1, &t1, 50);    // 2^250 - 2^50
+    _ygo_fe_mul(&t0, &t1, &t0);   // 2^250 - 1
+    _ygo_fe_sqn(&t0, &t0, 2);     // 2^252 - 4
+    _ygo_fe_mul(out, &t0, z);     // 2^252 - 3
+}
+
+/////
+// Group arithmetic, with the representations of ref10:
+//   p2:     (X:Y:Z), x = X/Z, y = Y/Z
+//   p3:     (X:Y:Z:T), also XY = ZT
+//   p1p1:   ((X:Z), (Y:T)), what an addition or doubling leaves before its last multiplications
+//   cached: (Y+X, Y-X, 2Z, 2dT), what an addition needs of its second point
+
+typedef struct {
+    _ygo_fe_t X, Y, Z;
+} _ygo_ge_p2_t;
+
+typedef struct {
+    _ygo_fe_t X, Y, Z, T;
+} _ygo_ge_p3_t;
+
+typedef struct {
+    _ygo_fe_t X, Y, Z, T;
+} _ygo_ge_p1p1_t;
+
+typedef struct {
+    _ygo_fe_t YplusX, YminusX, Z2, T2d;
+} _ygo_ge_cached_t;
+
+// The base point, x then y.
+static const uint8_t _ygo_ge_base[2][32] = {
+    {0x1A, 0xD5, 0x25, 0x8F, 0x60, 0x2D, 0x56, 0xC9, 0xB2, 0xA7, 0x25, 0x95,
+     0x60, 0xC7, 0x2C, 0x69, 0x5C, 0xDC, 0xD6, 0xFD, 0x31, 0xE2, 0xA4, 0xC0,
+     0xFE, 0x53, 0x6E, 0xCD, 0xD3, 0x36, 0x69, 0x21},
+    {0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+     0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+     0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66},
+};
+
+static void _ygo_ge_base_point(_ygo_ge_p3_t *p) {
+    _ygo_fe_frombytes(&p->X, _ygo_ge_base[0]);
+    _ygo_fe_frombytes(&p->Y, _ygo_ge_base[1]);
+    p->Z = _ygo_fe_one;
+    _ygo_fe_mul(&p->T, &p->X, &p->Y);
+}
+
+/**
+ * Decode a point (RFC 8032 5.1.3), rejecting encodings of y that are not reduced.
+ * @return 1, or 0 if s is not a point
+ */
+static int _ygo_ge_frombytes(_ygo_ge_p3_t *p, const uint8_t s[32]) {
+    _ygo_fe_frombytes(&p->Y, s);
+    uint8_t check[32];
+    _ygo_fe_tobytes(check, &p->Y);
+    if (memcmp(check, s, 31) != 0 || check[31] != (s[31] & 0x7F)) return 0;
+    p->Z = _ygo_fe_one;
+
+    // x^2 = u / v with u = y^2 - 1 and v = dy^2 + 1. The candidate x = uv^3 (uv^7)^((p-5)/8) is
+    // a root of u / v or of -u / v, and in the second case times sqrt(-1) is one of u / v.
+    _ygo_fe_t u, v, v3, x, vxx;
+    _ygo_fe_sq(&u, &p->Y);
+    _ygo_fe_mul(&v, &u, &_ygo_fe_d);
+    _ygo_fe_sub(&u, &u, &_ygo_fe_one);
+    _ygo_fe_add(&v, &v, &_ygo_fe_one);
+
+    _ygo_fe_sq(&v3, &v);
+    _ygo_fe_mul(&v3, &v3, &v);
+    _ygo_fe_sq(&x, &v3);
+    _ygo_fe_mul(&x, &x, &v);
+    _ygo_fe_mul(&x, &x, &u);
+    _ygo_fe_pow22523(&x, &x);
+    _ygo_fe_mul(&x, &x, &v3);
+    _ygo_fe_mul(&x, &x, &u);
+
+    _ygo_fe_sq(&vxx, &x);
+    _ygo_fe_mul(&vxx, &vxx, &v);
+    if (!_ygo_fe_equal(&vxx, &u)) {
+        _ygo_fe_t minus_u;
+        _ygo_fe_neg(&minus_u, &u);
+        if (!_ygo_fe_equal(&vxx, &minus_u)) return 0;
+        _ygo_fe_mul(&x, &x, &_ygo_fe_sqrtm1);
+    }
+
+    int sign = s[31] >> 7;
+    if (sign && _ygo_fe_is_zero(&x)) return 0;
+    if (_ygo_fe_is_negative(&x) != sign) _ygo_fe_neg(&x, &x);
+    p->X = x;
+    _ygo_fe_mul(&p->T, &p->X, &p->Y);
+    return 1;
+}
+
+static void _ygo_ge_neg(_ygo_ge_p3_t *p) {
+    _ygo_fe_neg(&p->X, &p->X);
+    _ygo_fe_neg(&p->T, &p->T);
+}
+
+static void _ygo_ge_to_cached(_ygo_ge_cached_t *c, const _ygo_ge_p3_t *p) {
+    _ygo_fe_add(&c->YplusX, &p->Y, &p->X);
+    _ygo_fe_sub(&c->YminusX, &p->Y, &p->X);
+    _ygo_fe_add(&c->Z2, &p->Z, &p->Z);
+    _ygo_fe_mul(&c->T2d, &p->T, &_ygo_fe_d2);
+}
+
+static void _ygo_ge_p1p1_to_p2(_ygo_ge_p2_t *r, const _ygo_ge_p1p1_t *p) {
+    _ygo_fe_mul(&r->X, &p->X, &p->T);
+    _ygo_fe_mul(&r->Y, &p->Y, &p->Z);
+    _ygo_fe_mul(&r->Z, &p->Z, &p->T);
+}
+
+static void _ygo_ge_p1p1_to_p3(_ygo_ge_p3_t *r, const _ygo_ge_p1p1_t *p) {
+    _ygo_fe_mul(&r->X, &p->X, &p->T);
+    _ygo_fe_mul(&r->Y, &p->Y, &p->Z);
+    _ygo_fe_mul(&r->Z, &p->Z, &p->T);
+    _ygo_fe_mul(&r->T, &p->X, &p->Y);
+}
+
+/**
+ * 2p, dbl-2008-hwcd with a = -1.
+ */
+static void _ygo_ge_dbl(_ygo_ge_p1p1_t *r, const _ygo_ge_p2_t *p) {
+    _ygo_fe_t xx, yy, zz2, sum;
+    _ygo_fe_sq(&xx, &p->X);
+    _ygo_fe_sq(&yy, &p->Y);
+    _ygo_fe_sq(&zz2, &p->Z);
+    _ygo_fe_add(&zz2, &zz2, &zz2);
+    _ygo_fe_add(&sum, &p->X, &p->Y);
+    _ygo_fe_sq(&sum, &sum);
+
+    _ygo_fe_add(&r->Y, &yy, &xx);
+    _ygo_fe_sub(&r->Z, &yy, &xx);
+    _ygo_fe_sub(&r->X, &sum, &r->Y);
+    _ygo_fe_sub(&r->T, &zz2, &r->Z);
+}
+
+/**
+ * p + q, or p - q with sub, add-2008-hwcd-3 with a = -1.
+ */
+static void _ygo_ge_add(_ygo_ge_p1p1_t *r,
+                        const _ygo_ge_p3_t *p,
+                        const _ygo_ge_cached_t *q,
+                        int sub) {
+    _ygo_fe_t a, b, c, d;
+    _ygo_fe_sub(&a, &p->Y, &p->X);
+    _ygo_fe_mul(&a, &a, sub ? &q->YplusX : &q->YminusX);
+    _ygo_fe_add(&b, &p->Y, &p->X);
+    _ygo_fe_mul(&b, &b, sub ? &q->YminusX : &q->YplusX);
+    _ygo_fe_mul(&c, &p->T, &q->T2d);
+    _ygo_fe_mul(&d, &p->Z, &q->Z2);
+
+    _ygo_fe_sub(&r->X, &b, &a);
+    _ygo_fe_add(&r->Y, &b, &a);
+    if (sub) {
+        _ygo_fe_sub(&r->Z, &d, &c);
+        _ygo_fe_add(&r->T, &d, &c);
+    } else {
+        _ygo_fe_add(&r->Z, &d, &c);
+        _ygo_fe_sub(&r->T, &d, &c);
+    }
+}
+
+/////
+// Scalars modulo the group order L = 2^252 + 27742317777372353535851937790883648493
+
+static const int64_t _ygo_sc_l[32] = {0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58,
+                                      0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+                                      0,    0,    0,    0,    0,    0,    0,    0,
+                                      0,    0,    0,    0,    0,    0,    0,    0x10};
+
+/**
+ * Reduce 64 limbs of 8 bits, each a small signed sum of byte products, modulo L. This is the
+ * reduction of TweetNaCl: the top limbs are folded down with 2^252 = -(L - 2^252), then one last
+ * subtraction of L brings the value below it.
+ */
+static void _ygo_sc_reduce(uint8_t out[32], int64_t x[64]) {
+    for (int i = 63; i >= 32; i--) {
+        int64_t carry = 0;
+        int j;
+        for (j = i - 32; j < i - 12; j++) {
+            x[j] += carry - 16 * x[i] * _ygo_sc_l[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    int64_t carry = 0;
+    for (int j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * _ygo_sc_l[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (int j = 0; j < 32; j++) {
+        x[j] -= carry * _ygo_sc_l[j];
+    }
+    for (int i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        out[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+static void _ygo_sc_reduce64(uint8_t out[32], const uint8_t in[64]) {
+    int64_t x[64];
+    for (int i = 0; i < 64; i++) {
+        x[i] = in[i];
+    }
+    _ygo_sc_reduce(out, x);
+}
+
+/**
+ * a * b + c (mod L).
+ */
+static void _ygo_sc_muladd(uint8_t out[32],
+                           const uint8_t a[32],
+                           const uint8_t b[32],
+                           const uint8_t c[32]) {
+    int64_t x[64] = {0};
+    for (int i = 0; i < 32; i++) {
+        x[i] = c[i];
+    }
+    for (int i = 0; i < 32; i++) {
+        if (a[i] == 0) continue;
+        for (int j = 0; j < 32; j++) {
+            x[i + j] += (int64_t)a[i] * b[j];
+        }
+    }
+    _ygo_sc_reduce(out, x);
+}
+
+/**
+ * s < L, which RFC 8032 requires of the S half of a signature.
+ */
+static int _ygo_sc_is_canonical(const uint8_t s[32]) {
+    for (int i = 31; i >= 0; i--) {
+        if (s[i] != _ygo_sc_l[i]) return s[i] < _ygo_sc_l[i];
+    }
+    return 0;
+}
+
+/////
+// Multi-scalar multiplication
+
+/**
+ * A point and its scalar in signed sliding-window form: odd digits in [-15, 15], at least five
+ * zeros after each, which index the odd multiples P, 3P, ..., 15P of the table.
+ */
+typedef struct {
+    _ygo_ge_cached_t table[8];
+    int8_t digits[256];
+} _ygo_ed25519_term_t;
+
+static void _ygo_ed25519_term_init(_ygo_ed25519_term_t *term,
+                                   const _ygo_ge_p3_t *p,
+                                   const uint8_t scalar[32]) {
+    // ref10's slide(), for scalars below 2^253
+    int8_t *r = term->digits;
+    for (int i = 0; i < 256; i++) {
+        r[i] = (int8_t)(1 & (scalar[i >> 3] >> (i & 7)));
+    }
+    for (int i = 0; i < 256; i++) {
+        if (r[i] == 0) continue;
+        for (int b = 1; b <= 6 && i + b < 256; b++) {
+            if (r[i + b] == 0) continue;
+            if (r[i] + (r[i + b] << b) <= 15) {
+                r[i] = (int8_t)(r[i] + (r[i + b] << b));
+                r[i + b] = 0;
+            } else if (r[i] - (r[i + b] << b) >= -15) {
+                r[i] = (int8_t)(r[i] - (r[i + b] << b));
+                for (int k = i + b; k < 256; k++) {
+                    if (r[k] == 0) {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+
+    _ygo_ge_p2_t projective = {p->X, p->Y, p->Z};
+    _ygo_ge_p1p1_t t;
+    _ygo_ge_p3_t p2, odd;
+    _ygo_ge_dbl(&t, &projective);
+    _ygo_ge_p1p1_to_p3(&p2, &t);
+    _ygo_ge_to_cached(&term->table[0], p);
+    for (int i = 1; i < 8; i++) {
+        _ygo_ge_add(&t, &p2, &term->table[i - 1], 0);
+        _ygo_ge_p1p1_to_p3(&odd, &t);
+        _ygo_ge_to_cached(&term->table[i], &odd);
+    }
+}
+
+/**
+ * Straus' method: one chain of doublings, each term adding its digit for the bit in turn. The
+ * sum is then multiplied by the cofactor 8, which clears any small-order component.
+ * @return 1 if 8 times the sum of the terms, minus sub if given, is the neutral point
+ */
+static int _ygo_ed25519_is_neutral(const _ygo_ed25519_term_t *terms,
+                                   size_t count,
+                                   const _ygo_ge_cached_t *sub) {
+    int top = 255;
+    for (; top >= 0; top--) {
+        size_t k = 0;
+        while (k < count && terms[k].digits[top] == 0) {
+            k++;
+        }
+        if (k < count) break;
+    }
+
+    _ygo_ge_p2_t r = {{{0}}, _ygo_fe_one, _ygo_fe_one};
+    _ygo_ge_p1p1_t t;
+    _ygo_ge_p3_t u;
+    for (int i = top; i >= 0; i--) {
+        _ygo_ge_dbl(&t, &r);
+        for (size_t k = 0; k < count; k++) {
+            int digit = terms[k].digits[i];
+            if (digit == 0) continue;
+            _ygo_ge_p1p1_to_p3(&u, &t);
+            if (digit > 0) {
+                _ygo_ge_add(&t, &u, &terms[k].table[digit / 2], 0);
+            } else {
+                _ygo_ge_add(&t, &u, &terms[k].table[-digit / 2], 1);
+            }
+        }
+        _ygo_ge_p1p1_to_p2(&r, &t);
+    }
+
+    if (sub != NULL) {
+        // (X:Y:Z) is (XZ:YZ:Z^2) with T = XY
+        _ygo_ge_p3_t full;
+        _ygo_fe_mul(&full.X, &r.X, &r.Z);
+        _ygo_fe_mul(&full.Y, &r.Y, &r.Z);
+        _ygo_fe_sq(&full.Z, &r.Z);
+        _ygo_fe_mul(&full.T, &r.X, &r.Y);
+        _ygo_ge_add(&t, &full, sub, 1);
+        _ygo_ge_p1p1_to_p2(&r, &t);
+    }
+    for (int i = 0; i < 3; i++) {
+        _ygo_ge_dbl(&t, &r);
+        _ygo_ge_p1p1_to_p2(&r, &t);
+    }
+    return _ygo_fe_is_zero(&r.X) && _ygo_fe_equal(&r.Y, &r.Z);
+}
+
+/**
+ * k = SHA-512(R || A || message) mod L.
+ */
+static void _ygo_ed25519_challenge(uint8_t k[32],
+                                   const uint8_t signature[64],
+                                   const uint8_t *message,
+                                   size_t len,
+                                   const uint8_t public_key[32]) {
+    _ygo_sha512_t sha;
+    uint8_t digest[64];
+    _ygo_sha512_init(&sha);
+    _ygo_sha512_update(&sha, signature, 32);
+    _ygo_sha512_update(&sha, public_key, 32);
+    _ygo_sha512_update(&sha, message, len);
+    _ygo_sha512_final(&sha, digest);
+    _ygo_sc_reduce64(k, digest);
+}
+
+int ygo_ed25519_verify(const uint8_t signature[64],
+                       const uint8_t *message,
+                       size_t len,
+                       const uint8_t public_key[32]) {
+    if (signature == NULL || public_key == NULL || (message == NULL && len != 0)) return -1;
+    if (!_ygo_sc_is_canonical(signature + 32)) return 0;
+
+    _ygo_ge_p3_t a, r;
+    if (!_ygo_ge_frombytes(&a, public_key) || !_ygo_ge_frombytes(&r, signature)) return 0;
+    _ygo_ge_neg(&a);
+
+    uint8_t k[32];
+    _ygo_ed25519_challenge(k, signature, message, len, public_key);
+
+    // [S]B - [k]A - R
+    _ygo_ed25519_term_t terms[2];
+    _ygo_ge_p3_t base;
+    _ygo_ge_base_point(&base);
+    _ygo_ed25519_term_init(&terms[0], &base, signature + 32);
+    _ygo_ed25519_term_init(&terms[1], &a, k);
+    _ygo_ge_cached_t r_cached;
+    _ygo_ge_to_cached(&r_cached, &r);
+    return _ygo_ed25519_is_neutral(terms, 2, &r_cached);
+}
+
+/////
+// Batch verification
+
+typedef struct {
+    uint8_t k[YGO_ED25519_BATCH_MAX][32];      // Challenge of each signature
+    uint8_t z[YGO_ED25519_BATCH_MAX][32];      // Coefficient of each signature
+    uint8_t scalar[YGO_ED25519_BATCH_MAX][32]; // Sum of z k for each distinct key
+    const uint8_t *keys[YGO_ED25519_BATCH_MAX];
+    uint8_t key_of[YGO_ED25519_BATCH_MAX]; // Index in keys of each signature's key
+    _ygo_ed25519_term_t terms[];           // B, then each distinct key, then each R
+} _ygo_ed25519_batch_t;
+
+/**
+ * The coefficients z_i, 128 bits each: SHA-512 of every signature, key and challenge of the
+ * batch, then of that seed and i. Whoever made the signatures can't choose them without changing
+ * the batch, so an invalid signature can't be made to cancel out against another one.
+ */
+static void _ygo_ed25519_coefficients(_ygo_ed25519_batch_t *batch,
+                                      const uint8_t *const signatures[],
+                                      const uint8_t *const public_keys[],
+                                      size_t count) {
+    static const char domain[] = "ygo-ed25519-batch";
+    _ygo_sha512_t sha;
+    uint8_t seed[64], digest[64];
+    _ygo_sha512_init(&sha);
+    _ygo_sha512_update(&sha, (const uint8_t *)domain, sizeof(domain) - 1);
+    for (size_t i = 0; i < count; i++) {
+        _ygo_sha512_update(&sha, signatures[i], 64);
+        _ygo_sha512_update(&sha, public_keys[i], 32);
+        _ygo_sha512_update(&sha, batch->k[i], 32);
+    }
+    _ygo_sha512_final(&sha, seed);
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t index[4] = {(uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16), (uint8_t)(i >> 24)};
+        _ygo_sha512_init(&sha);
+        _ygo_sha512_update(&sha, seed, sizeof(seed));
+        _ygo_sha512_update(&sha, index, sizeof(index));
+        _ygo_sha512_final(&sha, digest);
+
+        memset(batch->z[i], 0, 32);
+        memcpy(batch->z[i], digest, 16);
+        batch->z[i][0] |= 1; // Never 0, which would let the signature through unchecked
+    }
+}
+
+/**
+ * [sum z_i S_i]B - sum [sum z_i k_i]A - sum [z_i]R_i, with the second sum over distinct keys.
+ * @return 1 if the batch is valid, 0 if not
+ */
+static int _ygo_ed25519_verify_split(_ygo_ed25519_batch_t *batch,
+                                     const uint8_t *const signatures[],
+                                     const uint8_t *const messages[],
+                                     const size_t lens[],
+                                     const uint8_t *const public_keys[],
+                                     size_t count) {
+    size_t key_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!_ygo_sc_is_canonical(signatures[i] + 32)) return 0;
+        _ygo_ed25519_challenge(batch->k[i], signatures[i], messages[i], lens[i], public_keys[i]);
+
+        size_t key = 0;
+        while (key < key_count && batch->keys[key] != public_keys[i] &&
+               memcmp(batch->keys[key], public_keys[i], 32) != 0) {
+            key++;
+        }
+        if (key == key_count) batch->keys[key_count++] = public_keys[i];
+        batch->key_of[i] = (uint8_t)key;
+    }
+    _ygo_ed25519_coefficients(batch, signatures, public_keys, count);
+
+    uint8_t base_scalar[32] = {0};
+    memset(batch->scalar, 0, sizeof(batch->scalar[0]) * key_count);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t *scalar = batch->scalar[batch->key_of[i]];
+        _ygo_sc_muladd(base_scalar, batch->z[i], signatures[i] + 32, base_scalar);
+        _ygo_sc_muladd(scalar, batch->z[i], batch->k[i], scalar);
+    }
+
+    _ygo_ge_p3_t p;
+    _ygo_ge_base_point(&p);
+    _ygo_ed25519_term_init(&batch->terms[0], &p, base_scalar);
+    for (size_t key = 0; key < key_count; key++) {
+        if (!_ygo_ge_frombytes(&p, batch->keys[key])) return 0;
+        _ygo_ge_neg(&p);
+        _ygo_ed25519_term_init(&batch->terms[1 + key], &p, batch->scalar[key]);
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!_ygo_ge_frombytes(&p, signatures[i])) return 0;
+        _ygo_ge_neg(&p);
+        _ygo_ed25519_term_init(&batch->terms[1 + key_count + i], &p, batch->z[i]);
+    }
+    return _ygo_ed25519_is_neutral(batch->terms, 1 + key_count + count, NULL);
+}
+
+int ygo_ed25519_verify_batch(const uint8_t *const signatures[],
+                             const uint8_t *const messages[],
+                             const size_t lens[],
+                             const uint8_t *const public_keys[],
+                             size_t count) {
+    if (count == 0) return 1;
+    if (signatures == NULL || messages == NULL || lens == NULL || public_keys == NULL) return -1;
+    for (size_t i = 0; i < count; i++) {
+        if (signatures[i] == NULL || public_keys[i] == NULL) return -1;
+        if (messages[i] == NULL && lens[i] != 0) return -1;
+    }
+    if (count == 1) return ygo_ed25519_verify(signatures[0], messages[0], lens[0], public_keys[0]);
+
+    size_t split = count < YGO_ED25519_BATCH_MAX ? count : YGO_ED25519_BATCH_MAX;
+    _ygo_ed25519_batch_t *batch =
+        malloc(sizeof(*batch) + (1 + 2 * split) * sizeof(_ygo_ed25519_term_t));
+    if (batch == NULL) return -1;
+
+    int valid = 1;
+    for (size_t i = 0; i < count && valid; i += split) {
+        size_t n = count - i < split ? count - i : split;
+        valid = _ygo_ed25519_verify_split(batch, signatures + i, messages + i, lens + i,
+                                          public_keys + i, n);
+    }
+    free(batch);
+    return valid;
+}
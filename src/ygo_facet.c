@@ -0,0 +1,244 @@
+/**
+ * @file ygo_facet.c
+ * @brief Per enum value row bitmaps over a card table, and facet counts over a filter.
+ *
+ * Host-only (YGO_BUILD_HOST).
+ */
+
+#include "ygo_facet.h"
+#include <stdlib.h>
+
+ENUM_IMPL(ygo_facet, YGO_FACET_DEFS);
+
+// Bit set facets store the bits themselves in the packed rows, 0 when the card has none. The
+// others store the slot, or YGO_FACET_NONE which counts into a spare slot instead of branching.
+#define YGO_FACET_IS_BITS(facet)                                                                   \
+    ((facet) == YGO_FACET_MONSTER_FLAG || (facet) == YGO_FACET_LINK_MARKER)
+#define YGO_FACET_NONE YGO_FACET_VALUES
+
+// Counting a row on its own increments about YGO_FACET_COUNT counters, which costs about as much
+// as reading this many bytes of value containers when intersecting instead.
+#define YGO_FACET_ROW_COST 16
+
+static int _ygo_facet_bit(uint32_t value) {
+    if (value == 0 || (value & (value - 1)) != 0 || value > 0x80) return -1;
+    return (int)ygo_ctz64(value);
+}
+
+int ygo_facet_slot(ygo_facet_t facet, uint32_t value) {
+    switch (facet) {
+    case YGO_FACET_CARD_TYPE:
+        if ((value & 0x0Fu) != 0) return -1;
+        if (value > YGO_CARD_TYPE_TRAP_MONSTER && value != YGO_CARD_TYPE_MONSTER) return -1;
+        return (int)(value >> 4u);
+    case YGO_FACET_ATTRIBUTE: return value <= YGO_ATTRIBUTE_TIME ? (int)value : -1;
+    case YGO_FACET_MONSTER_TYPE: return value <= YGO_MONSTER_TYPE_ZOMBIE ? (int)value : -1;
+    case YGO_FACET_SUMMON_TYPE:
+        // Both the enum values (RITUAL follows SPECIAL) and the CTYPE0 bits decoded from binary.
+        if ((value & ~0xE0u) == 0) return (int)(value >> YGO_SUMMON_TYPE_SHIFT);
+        if (value > YGO_SUMMON_TYPE_SPECIAL && value <= YGO_SUMMON_TYPE_XYZ) {
+            return (int)(value - YGO_SUMMON_TYPE_SPECIAL + 1);
+        }
+        return -1;
+    case YGO_FACET_SPELL_TYPE: return value <= YGO_SPELL_TYPE_RITUAL ? (int)value : -1;
+    case YGO_FACET_TRAP_TYPE: return value <= YGO_TRAP_TYPE_COUNTER ? (int)value : -1;
+    case YGO_FACET_MONSTER_FLAG: return (value & ~0x38u) == 0 ? _ygo_facet_bit(value) : -1;
+    case YGO_FACET_LINK_MARKER: return _ygo_facet_bit(value);
+    default: return -1;
+    }
+}
+
+/**
+ * Packed facet values of one table row.
+ */
+static void _ygo_facet_pack(const ygo_table_t *table, size_t row, uint8_t *packed) {
+    uint8_t type = (uint8_t)GET_CARD_TYPE(table->type[row]);
+    int monster = type == YGO_CARD_TYPE_MONSTER || type == YGO_CARD_TYPE_TRAP_MONSTER;
+    int slot;
+
+    memset(packed, YGO_FACET_NONE, YGO_FACET_COUNT);
+    packed[YGO_FACET_CARD_TYPE] = (uint8_t)(type >> 4u);
+
+    if (monster) {
+        slot = ygo_facet_slot(YGO_FACET_ATTRIBUTE, table->attribute[row]);
+        if (slot >= 0) packed[YGO_FACET_ATTRIBUTE] = (uint8_t)slot;
+        slot = ygo_facet_slot(YGO_FACET_MONSTER_TYPE, table->monster_type[row]);
+        if (slot >= 0) packed[YGO_FACET_MONSTER_TYPE] = (uint8_t)slot;
+        slot = ygo_facet_slot(YGO_FACET_SUMMON_TYPE, table->summon[row]);
+        if (slot >= 0) packed[YGO_FACET_SUMMON_TYPE] = (uint8_t)slot;
+    } else if (type == YGO_CARD_TYPE_SPELL) {
+        slot = ygo_facet_slot(YGO_FACET_SPELL_TYPE, table->summon[row]);
+        if (slot >= 0) packed[YGO_FACET_SPELL_TYPE] = (uint8_t)slot;
+    } else if (type == YGO_CARD_TYPE_TRAP) {
+        slot = ygo_facet_slot(YGO_FACET_TRAP_TYPE, table->summon[row]);
+        if (slot >= 0) packed[YGO_FACET_TRAP_TYPE] = (uint8_t)slot;
+    }
+
+    packed[YGO_FACET_MONSTER_FLAG] = monster ? (uint8_t)GET_MONSTER_FLAG(table->flags[row]) : 0;
+    packed[YGO_FACET_LINK_MARKER] = monster ? table->link_markers[row] : 0;
+}
+
+void ygo_facet_free(ygo_facet_index_t *index) {
+    if (index == NULL) return;
+    for (int f = 0; f < YGO_FACET_COUNT; f++) {
+        for (int s = 0; s < YGO_FACET_VALUES; s++) {
+            ygo_roaring_free(&index->values[f][s]);
+        }
+    }
+    free(index->rows);
+    index->rows = NULL;
+    index->count = 0;
+}
+
+ygo_bin_errno_t ygo_facet_build(ygo_facet_index_t *index, const ygo_table_t *table) {
+    if (index == NULL || table == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    memset(index, 0, sizeof(*index));
+    index->rows = (uint8_t *)malloc((size_t)table->count * YGO_FACET_COUNT + 1);
+    if (index->rows == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    index->count = table->count;
+
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    for (uint32_t row = 0; row < table->count && err == YGO_BIN_OK; row++) {
+        uint8_t *packed = index->rows + (size_t)row * YGO_FACET_COUNT;
+        _ygo_facet_pack(table, row, packed);
+
+        for (int f = 0; f < YGO_FACET_COUNT && err == YGO_BIN_OK; f++) {
+            if (!YGO_FACET_IS_BITS(f)) {
+                if (packed[f] == YGO_FACET_NONE) continue;
+                err = ygo_roaring_add(&index->values[f][packed[f]], row);
+                continue;
+            }
+            for (uint32_t bits = packed[f]; bits != 0 && err == YGO_BIN_OK; bits &= bits - 1) {
+                err = ygo_roaring_add(&index->values[f][ygo_ctz64(bits)], row);
+            }
+        }
+    }
+
+    // Values held by long stretches of rows, e.g. card types of a table sorted by type, as runs.
+    for (int f = 0; f < YGO_FACET_COUNT && err == YGO_BIN_OK; f++) {
+        for (int s = 0; s < YGO_FACET_VALUES && err == YGO_BIN_OK; s++) {
+            err = ygo_roaring_optimize(&index->values[f][s]);
+        }
+    }
+
+    if (err != YGO_BIN_OK) ygo_facet_free(index);
+    return err;
+}
+
+const ygo_roaring_t *ygo_facet_get(const ygo_facet_index_t *index,
+                                   ygo_facet_t facet,
+                                   uint32_t value) {
+    int slot = ygo_facet_slot(facet, value);
+    if (index == NULL || slot < 0) return NULL;
+    return &index->values[facet][slot];
+}
+
+typedef uint32_t _ygo_facet_tally_t[YGO_FACET_COUNT][YGO_FACET_VALUES + 1];
+
+/**
+ * Count one row from its packed values. Whether a card is in a facet at all is as good as random
+ * from row to row, so that doesn't branch. Most cards have no bits set in the bit set facets.
+ */
+static inline void _ygo_facet_count_row(const ygo_facet_index_t *index,
+                                        uint32_t row,
+                                        _ygo_facet_tally_t tally) {
+    const uint8_t *packed = index->rows + (size_t)row * YGO_FACET_COUNT;
+    for (int f = 0; f < YGO_FACET_COUNT; f++) {
+        if (!YGO_FACET_IS_BITS(f)) {
+            tally[f][packed[f]]++;
+            continue;
+        }
+        for (uint32_t bits = packed[f]; bits != 0; bits &= bits - 1) {
+            tally[f][ygo_ctz64(bits)]++;
+        }
+    }
+}
+
+/**
+ * Bytes of value containers an intersection with the part of the filter at key would read.
+ */
+static size_t _ygo_facet_dense_bytes(const ygo_facet_index_t *index, uint16_t key) {
+    size_t bytes = 0;
+    for (int f = 0; f < YGO_FACET_COUNT; f++) {
+        for (int s = 0; s < YGO_FACET_VALUES; s++) {
+            const ygo_roaring_t *r = &index->values[f][s];
+            for (uint32_t i = 0; i < r->n && r->containers[i].key <= key; i++) {
+                if (r->containers[i].key != key) continue;
+                if (r->containers[i].kind == YGO_ROARING_BITMAP) {
+                    bytes += YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t);
+                } else if (r->containers[i].kind == YGO_ROARING_RUN) {
+                    bytes += r->containers[i].capacity * 2 * sizeof(uint16_t);
+                } else {
+                    bytes += r->containers[i].cardinality * sizeof(uint16_t);
+                }
+            }
+        }
+    }
+    return bytes;
+}
+
+void ygo_facet_counts(const ygo_facet_index_t *index,
+                      const ygo_roaring_t *filter,
+                      uint32_t counts[YGO_FACET_COUNT][YGO_FACET_VALUES]) {
+    if (index == NULL || counts == NULL) return;
+    memset(counts, 0, sizeof(uint32_t) * YGO_FACET_COUNT * YGO_FACET_VALUES);
+
+    if (filter == NULL) {
+        for (int f = 0; f < YGO_FACET_COUNT; f++) {
+            for (int s = 0; s < YGO_FACET_VALUES; s++) {
+                counts[f][s] = (uint32_t)ygo_roaring_cardinality(&index->values[f][s]);
+            }
+        }
+        return;
+    }
+
+    _ygo_facet_tally_t tally;
+    memset(tally, 0, sizeof(tally));
+
+    for (uint32_t i = 0; i < filter->n; i++) {
+        const ygo_roaring_container_t *c = &filter->containers[i];
+        uint32_t high = (uint32_t)c->key << 16u;
+
+        if (c->kind == YGO_ROARING_ARRAY) {
+            for (uint32_t x = 0; x < c->cardinality; x++) {
+                uint32_t row = high + c->array[x];
+                if (row < index->count) _ygo_facet_count_row(index, row, tally);
+            }
+            continue;
+        }
+
+        if ((size_t)c->cardinality * YGO_FACET_ROW_COST >= _ygo_facet_dense_bytes(index, c->key)) {
+            // Intersect the part with every value, as a bitmap of its own.
+            ygo_roaring_t part = {1, 1, (ygo_roaring_container_t *)c};
+            for (int f = 0; f < YGO_FACET_COUNT; f++) {
+                for (int s = 0; s < YGO_FACET_VALUES; s++) {
+                    if (index->values[f][s].n == 0) continue;
+                    counts[f][s] +=
+                        (uint32_t)ygo_roaring_and_cardinality(&index->values[f][s], &part);
+                }
+            }
+        } else if (c->kind == YGO_ROARING_RUN) {
+            for (uint32_t x = 0; x < c->capacity; x++) {
+                for (uint32_t value = c->runs[2 * x]; value <= c->runs[2 * x + 1]; value++) {
+                    if (high + value < index->count) {
+                        _ygo_facet_count_row(index, high + value, tally);
+                    }
+                }
+            }
+        } else {
+            for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+                for (uint64_t bits = c->words[w]; bits != 0; bits &= bits - 1) {
+                    uint32_t row = high + w * 64u + ygo_ctz64(bits);
+                    if (row < index->count) _ygo_facet_count_row(index, row, tally);
+                }
+            }
+        }
+    }
+
+    for (int f = 0; f < YGO_FACET_COUNT; f++) {
+        for (int s = 0; s < YGO_FACET_VALUES; s++) {
+            counts[f][s] += tally[f][s];
+        }
+    }
+}
@@ -0,0 +1,197 @@
+/**
+ * @file ygo_json_arena.c
+ * @brief Bump allocator installed as cJSON's malloc/free.
+ *
+ * cJSON only uses realloc() with the default hooks, so with these every allocation is a bump of
+ * pos, and every free does nothing until the arena is reset.
+ */
+
+#include "ygo_json_arena.h"
+#include <cJSON.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ygo_json_arena_chunk {
+    ygo_json_arena_chunk_t *next;
+    size_t len; // Bytes after the header
+};
+
+#define ALIGN_UP(n) (((n) + (YGO_JSON_ARENA_ALIGN - 1)) & ~(size_t)(YGO_JSON_ARENA_ALIGN - 1))
+#define CHUNK_HEADER_LEN ALIGN_UP(sizeof(ygo_json_arena_chunk_t))
+
+void ygo_json_arena_init_fixed(ygo_json_arena_t *arena, void *memory, size_t len) {
+    memset(arena, 0, sizeof(*arena));
+    if (memory == NULL) return;
+
+    // The region starts aligned, so that every allocation is.
+    size_t skip = ALIGN_UP((uintptr_t)memory) - (uintptr_t)memory;
+    if (skip >= len) return;
+    arena->base = (uint8_t *)memory + skip;
+    arena->len = len - skip;
+    arena->reserved = arena->len;
+}
+
+void ygo_json_arena_init(ygo_json_arena_t *arena, size_t chunk_len) {
+    memset(arena, 0, sizeof(*arena));
+    arena->chunk_len = ALIGN_UP(chunk_len != 0 ? chunk_len : YGO_JSON_ARENA_CHUNK_LEN);
+}
+
+/**
+ * Move to the chunk after the current one, or to a new one put there if that is missing or
+ * smaller than need. Chunks passed over stay for the next parse.
+ * @return 0 in fixed mode or if malloc() failed
+ */
+static int _ygo_json_arena_next(ygo_json_arena_t *arena, size_t need) {
+    if (arena->chunk_len == 0) return 0;
+
+    ygo_json_arena_chunk_t *next = arena->chunk != NULL ? arena->chunk->next : arena->chunks;
+    if (next == NULL || next->len < need) {
+        size_t len = need > arena->chunk_len ? need : arena->chunk_len;
+        if (len > SIZE_MAX - CHUNK_HEADER_LEN) return 0;
+        ygo_json_arena_chunk_t *fresh = malloc(CHUNK_HEADER_LEN + len);
+        if (fresh == NULL) return 0;
+
+        fresh->next = next;
+        fresh->len = len;
+        if (arena->chunk != NULL) {
+            arena->chunk->next = fresh;
+        } else {
+            arena->chunks = fresh;
+        }
+        arena->reserved += len;
+        next = fresh;
+    }
+
+    arena->chunk = next;
+    arena->base = (uint8_t *)next + CHUNK_HEADER_LEN;
+    arena->len = next->len;
+    arena->pos = 0;
+    return 1;
+}
+
+void *ygo_json_arena_alloc(ygo_json_arena_t *arena, size_t len) {
+    size_t need = ALIGN_UP(len);
+    if (need < len) {
+        arena->failed++;
+        return NULL;
+    }
+
+    while (arena->len - arena->pos < need) {
+        if (!_ygo_json_arena_next(arena, need)) {
+            arena->failed++;
+            return NULL;
+        }
+    }
+
+    void *ptr = arena->base + arena->pos;
+    arena->pos += need;
+    arena->used += need;
+    arena->allocs++;
+    if (arena->used > arena->high_water) arena->high_water = arena->used;
+    return ptr;
+}
+
+void ygo_json_arena_reset(ygo_json_arena_t *arena) {
+    // A growable arena goes back to before its first chunk, and takes it on the next allocation.
+    if (arena->chunk_len != 0) {
+        arena->chunk = NULL;
+        arena->base = NULL;
+        arena->len = 0;
+    }
+    arena->pos = 0;
+    arena->used = 0;
+    arena->allocs = 0;
+}
+
+void ygo_json_arena_free(ygo_json_arena_t *arena) {
+    ygo_json_arena_chunk_t *chunk = arena->chunks;
+    while (chunk != NULL) {
+        ygo_json_arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    if (arena->chunk_len != 0) ygo_json_arena_init(arena, arena->chunk_len);
+}
+
+/////
+
+// cJSON's hooks take no context, so the installed arena is global, as the hooks are.
+static ygo_json_arena_t *_ygo_json_arena_current = NULL;
+
+static void *_ygo_json_arena_malloc(size_t len) {
+    return ygo_json_arena_alloc(_ygo_json_arena_current, len);
+}
+
+static void _ygo_json_arena_free(void *ptr) {
+    (void)ptr;
+}
+
+void ygo_json_arena_begin(ygo_json_arena_t *arena) {
+    _ygo_json_arena_current = arena;
+    cJSON_Hooks hooks = {_ygo_json_arena_malloc, _ygo_json_arena_free};
+    cJSON_InitHooks(&hooks);
+}
+
+void ygo_json_arena_end(ygo_json_arena_t *arena) {
+    cJSON_InitHooks(NULL);
+    _ygo_json_arena_current = NULL;
+    ygo_json_arena_reset(arena);
+}
+
+/**
+ * Parse within an arena which is already installed. A NULL tree is a syntax error, unless the
+ * arena refused an allocation meanwhile.
+ */
+static ygo_json_err_t _ygo_json_arena_parse(ygo_json_arena_t *arena,
+                                            const char *json,
+                                            size_t len,
+                                            cJSON **root) {
+    size_t failed = arena->failed;
+    *root = cJSON_ParseWithLength(json, len);
+    if (*root != NULL) return YGO_JSON_OK;
+    return arena->failed != failed ? YGO_JSON_ERR_NO_MEMORY : YGO_JSON_ERR_SYNTAX;
+}
+
+ygo_json_err_t ygo_json_arena_parse_card(ygo_json_arena_t *arena,
+                                         const char *json,
+                                         size_t len,
+                                         ygo_card_t *card) {
+    if (arena == NULL || json == NULL || card == NULL) return YGO_JSON_ERR_NULL_INPUT;
+
+    ygo_json_arena_begin(arena);
+    cJSON *root;
+    ygo_json_err_t err = _ygo_json_arena_parse(arena, json, len, &root);
+    if (err == YGO_JSON_OK) {
+        memset(card, 0, sizeof(*card));
+        err = ygo_json_to_card(root, card);
+    }
+    ygo_json_arena_end(arena);
+    return err;
+}
+
+ygo_json_err_t ygo_json_arena_parse_cards(ygo_json_arena_t *arena,
+                                          const char *json,
+                                          size_t len,
+                                          ygo_json_arena_card_fn fn,
+                                          void *ctx) {
+    if (arena == NULL || json == NULL || fn == NULL) return YGO_JSON_ERR_NULL_INPUT;
+
+    ygo_json_arena_begin(arena);
+    cJSON *root;
+    ygo_json_err_t err = _ygo_json_arena_parse(arena, json, len, &root);
+    if (err == YGO_JSON_OK) {
+        const cJSON *data = cJSON_IsArray(root) ? root
+                                                : cJSON_GetObjectItemCaseSensitive(root, "data");
+        const cJSON *element;
+        if (cJSON_IsArray(data)) {
+            cJSON_ArrayForEach(element, data) {
+                ygo_card_t card;
+                memset(&card, 0, sizeof(card));
+                fn(ctx, &card, ygo_json_to_card(element, &card));
+            }
+        }
+    }
+    ygo_json_arena_end(arena);
+    return err;
+}
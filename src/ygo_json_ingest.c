@@ -0,0 +1,664 @@
+/**
+ * @file ygo_json_ingest.c
+ * @brief Multi-threaded conversion of a whole cardinfo dump, see ygo_json_ingest.h.
+ *
+ * Tasks are numbered, and every worker starts with an equal share of the numbers. A worker takes
+ * its own tasks from the front and, once they are gone, steals the back half of another worker's.
+ * The locks are only contended while stealing, and a worker whose thread couldn't be started
+ * simply has its share stolen by the others.
+ */
+
+#include "ygo_json_ingest.h"
+#include "ygo_json_stream.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define YGO_JSON_INGEST_HAVE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && !defined(__AARCH64EB__)
+#define YGO_JSON_INGEST_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef _WIN32
+typedef SRWLOCK _ygo_json_ingest_lock_t;
+#define _ygo_json_ingest_lock_init(l) InitializeSRWLock(l)
+#define _ygo_json_ingest_lock_destroy(l) (void)(l)
+#define _ygo_json_ingest_lock(l) AcquireSRWLockExclusive(l)
+#define _ygo_json_ingest_unlock(l) ReleaseSRWLockExclusive(l)
+typedef HANDLE _ygo_json_ingest_thread_t;
+#else
+typedef pthread_mutex_t _ygo_json_ingest_lock_t;
+#define _ygo_json_ingest_lock_init(l) pthread_mutex_init(l, NULL)
+#define _ygo_json_ingest_lock_destroy(l) pthread_mutex_destroy(l)
+#define _ygo_json_ingest_lock(l) pthread_mutex_lock(l)
+#define _ygo_json_ingest_unlock(l) pthread_mutex_unlock(l)
+typedef pthread_t _ygo_json_ingest_thread_t;
+#endif
+
+typedef void (*_ygo_json_ingest_task_fn)(void *ctx, size_t task);
+
+typedef struct {
+    _ygo_json_ingest_lock_t lock;
+    size_t next; // Taken by the owner
+    size_t end;  // Lowered by thieves
+} _ygo_json_ingest_queue_t;
+
+typedef struct _ygo_json_ingest_pool _ygo_json_ingest_pool_t;
+
+typedef struct {
+    _ygo_json_ingest_pool_t *pool;
+    unsigned self;
+} _ygo_json_ingest_worker_t;
+
+struct _ygo_json_ingest_pool {
+    unsigned workers;
+    _ygo_json_ingest_queue_t *queues;
+    _ygo_json_ingest_worker_t *worker;
+    _ygo_json_ingest_thread_t *threads;
+    uint8_t *started;
+
+    _ygo_json_ingest_task_fn task;
+    void *ctx;
+};
+
+/**
+ * Next task for a worker, its own or a stolen one.
+ * @return 0 once every queue is empty
+ */
+static int _ygo_json_ingest_take(_ygo_json_ingest_pool_t *pool, unsigned self, size_t *task) {
+    _ygo_json_ingest_queue_t *own = &pool->queues[self];
+
+    _ygo_json_ingest_lock(&own->lock);
+    if (own->next < own->end) {
+        *task = own->next++;
+        _ygo_json_ingest_unlock(&own->lock);
+        return 1;
+    }
+    _ygo_json_ingest_unlock(&own->lock);
+
+    for (unsigned i = 1; i < pool->workers; i++) {
+        _ygo_json_ingest_queue_t *victim = &pool->queues[(self + i) % pool->workers];
+
+        _ygo_json_ingest_lock(&victim->lock);
+        size_t left = victim->end - victim->next;
+        if (left == 0) {
+            _ygo_json_ingest_unlock(&victim->lock);
+            continue;
+        }
+        size_t from = victim->end - (left + 1) / 2;
+        size_t end = victim->end;
+        victim->end = from;
+        _ygo_json_ingest_unlock(&victim->lock);
+
+        // Nobody but the owner refills a queue, so it is still empty.
+        _ygo_json_ingest_lock(&own->lock);
+        own->next = from + 1;
+        own->end = end;
+        _ygo_json_ingest_unlock(&own->lock);
+
+        *task = from;
+        return 1;
+    }
+    return 0;
+}
+
+static void _ygo_json_ingest_work(_ygo_json_ingest_worker_t *worker) {
+    size_t task;
+    while (_ygo_json_ingest_take(worker->pool, worker->self, &task)) {
+        worker->pool->task(worker->pool->ctx, task);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI _ygo_json_ingest_thread(LPVOID arg) {
+    _ygo_json_ingest_work((_ygo_json_ingest_worker_t *)arg);
+    return 0;
+}
+#else
+static void *_ygo_json_ingest_thread(void *arg) {
+    _ygo_json_ingest_work((_ygo_json_ingest_worker_t *)arg);
+    return NULL;
+}
+#endif
+
+static unsigned _ygo_json_ingest_cpus(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned)n : 1;
+#endif
+}
+
+static int _ygo_json_ingest_pool_init(_ygo_json_ingest_pool_t *pool, unsigned workers) {
+    memset(pool, 0, sizeof(*pool));
+    pool->queues = (_ygo_json_ingest_queue_t *)malloc(workers * sizeof(*pool->queues));
+    pool->worker = (_ygo_json_ingest_worker_t *)malloc(workers * sizeof(*pool->worker));
+    pool->threads = (_ygo_json_ingest_thread_t *)malloc(workers * sizeof(*pool->threads));
+    pool->started = (uint8_t *)malloc(workers);
+    if (pool->queues == NULL || pool->worker == NULL || pool->threads == NULL ||
+        pool->started == NULL) {
+        free(pool->queues);
+        free(pool->worker);
+        free(pool->threads);
+        free(pool->started);
+        return 0;
+    }
+
+    pool->workers = workers;
+    for (unsigned i = 0; i < workers; i++) {
+        _ygo_json_ingest_lock_init(&pool->queues[i].lock);
+        pool->worker[i].pool = pool;
+        pool->worker[i].self = i;
+    }
+    return 1;
+}
+
+static void _ygo_json_ingest_pool_free(_ygo_json_ingest_pool_t *pool) {
+    for (unsigned i = 0; i < pool->workers; i++) {
+        _ygo_json_ingest_lock_destroy(&pool->queues[i].lock);
+    }
+    free(pool->queues);
+    free(pool->worker);
+    free(pool->threads);
+    free(pool->started);
+}
+
+/**
+ * Run task(ctx, 0) to task(ctx, tasks - 1) over the pool, the calling thread being worker 0.
+ */
+static void _ygo_json_ingest_run(_ygo_json_ingest_pool_t *pool,
+                                 size_t tasks,
+                                 _ygo_json_ingest_task_fn task,
+                                 void *ctx) {
+    unsigned workers = pool->workers;
+    if (tasks < workers) workers = (unsigned)tasks;
+    if (workers == 0) return;
+
+    unsigned all = pool->workers;
+    pool->workers = workers;
+    pool->task = task;
+    pool->ctx = ctx;
+    for (unsigned i = 0; i < workers; i++) {
+        pool->queues[i].next = tasks * i / workers;
+        pool->queues[i].end = tasks * (i + 1) / workers;
+    }
+
+    for (unsigned i = 1; i < workers; i++) {
+#ifdef _WIN32
+        pool->threads[i] =
+            CreateThread(NULL, 0, _ygo_json_ingest_thread, &pool->worker[i], 0, NULL);
+        pool->started[i] = pool->threads[i] != NULL;
+#else
+        pool->started[i] =
+            pthread_create(&pool->threads[i], NULL, _ygo_json_ingest_thread, &pool->worker[i]) == 0;
+#endif
+    }
+
+    _ygo_json_ingest_work(&pool->worker[0]);
+
+    for (unsigned i = 1; i < workers; i++) {
+        if (!pool->started[i]) continue;
+#ifdef _WIN32
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+    pool->workers = all;
+}
+
+/**
+ * One block of text in the split passes.
+ */
+typedef struct {
+    // Pass 1, for a block starting outside a string [0] and inside one [1].
+    uint8_t quotes; // Parity of unescaped quotes
+    ptrdiff_t depth[2];
+
+    // Pass 2.
+    uint8_t in_string;
+    ptrdiff_t start_depth;
+
+    // Pass 3, offsets in the array text.
+    size_t *commas;
+    size_t comma_count;
+    size_t comma_capacity;
+    size_t end; // Closing bracket of data[], SIZE_MAX if not in this block
+    uint8_t failed;
+} _ygo_json_ingest_block_t;
+
+typedef struct {
+    const char *text; // data[] without its opening bracket
+    size_t len;
+    _ygo_json_ingest_block_t *blocks;
+
+    // Conversion.
+    size_t *commas; // Between elements, then the closing bracket
+    size_t elements;
+    ygo_card_t *cards;
+    uint8_t *errs;  // ygo_json_err_t per element
+    uint64_t *keys; // Per run: id << 32 | element of its cards, sorted, then UINT64_MAX
+    size_t *syntax; // Per run: offset of a syntax error, SIZE_MAX if none
+} _ygo_json_ingest_ctx_t;
+
+/**
+ * A run of backslashes escapes the byte after it if odd. Backslashes only occur in strings, so
+ * the run before a block tells whether its first byte is escaped wherever the block starts.
+ */
+static int _ygo_json_ingest_escaped(const char *text, size_t start) {
+    int escaped = 0;
+    for (size_t i = start; i > 0 && text[i - 1] == '\\'; i--) {
+        escaped ^= 1;
+    }
+    return escaped;
+}
+
+/**
+ * The split passes only stop at quotes, backslashes, brackets and commas. OR-ing 0x20 folds '['
+ * and ']' onto '{' and '}', and nothing else onto either.
+ */
+static inline int _ygo_json_ingest_is_special(char c) {
+    char folded = (char)(c | 0x20);
+    return folded == '{' || folded == '}' || c == '"' || c == '\\' || c == ',';
+}
+
+/**
+ * Offset of the first special byte from i on, end if there is none.
+ */
+static size_t _ygo_json_ingest_skip(const char *text, size_t i, size_t end) {
+#if defined(YGO_JSON_INGEST_HAVE_SSE2)
+    const __m128i fold = _mm_set1_epi8(0x20);
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i comma = _mm_set1_epi8(',');
+    for (; i + 16 <= end; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(text + i));
+        __m128i folded = _mm_or_si128(bytes, fold);
+        __m128i brackets =
+            _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close));
+        __m128i strings =
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash));
+        __m128i hit = _mm_or_si128(_mm_or_si128(brackets, strings), _mm_cmpeq_epi8(bytes, comma));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+        if (mask != 0) return i + ygo_ctz64(mask);
+    }
+#elif defined(YGO_JSON_INGEST_HAVE_NEON)
+    for (; i + 16 <= end; i += 16) {
+        uint8x16_t bytes = vld1q_u8((const uint8_t *)text + i);
+        uint8x16_t folded = vorrq_u8(bytes, vdupq_n_u8(0x20));
+        uint8x16_t brackets =
+            vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')), vceqq_u8(folded, vdupq_n_u8('}')));
+        uint8x16_t strings =
+            vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('"')), vceqq_u8(bytes, vdupq_n_u8('\\')));
+        uint8x16_t hit = vorrq_u8(vorrq_u8(brackets, strings), vceqq_u8(bytes, vdupq_n_u8(',')));
+
+        // Four bits per byte.
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(hit), 4);
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+        if (mask != 0) return i + ygo_ctz64(mask) / 4;
+    }
+#endif
+    while (i < end && !_ygo_json_ingest_is_special(text[i])) {
+        i++;
+    }
+    return i;
+}
+
+static void _ygo_json_ingest_count(void *arg, size_t task) {
+    _ygo_json_ingest_ctx_t *ctx = (_ygo_json_ingest_ctx_t *)arg;
+    _ygo_json_ingest_block_t *block = &ctx->blocks[task];
+    size_t start = task * YGO_JSON_INGEST_BLOCK_LEN;
+    size_t end = start + YGO_JSON_INGEST_BLOCK_LEN;
+    if (end > ctx->len) end = ctx->len;
+    const char *text = ctx->text;
+
+    // Quoted as seen from outside a string, brackets count towards depth[quoted] since that's
+    // the start which puts them outside.
+    int quoted = 0;
+    ptrdiff_t depth[2] = {0, 0};
+    size_t i = start + (size_t)_ygo_json_ingest_escaped(text, start);
+    while ((i = _ygo_json_ingest_skip(text, i, end)) < end) {
+        switch (text[i]) {
+        case '\\': i++; break;
+        case '"': quoted ^= 1; break;
+        case '{':
+        case '[': depth[quoted]++; break;
+        case '}':
+        case ']': depth[quoted]--; break;
+        default: break;
+        }
+        i++;
+    }
+
+    block->quotes = (uint8_t)quoted;
+    block->depth[0] = depth[0];
+    block->depth[1] = depth[1];
+}
+
+static int _ygo_json_ingest_add_comma(_ygo_json_ingest_block_t *block, size_t offset) {
+    if (block->comma_count == block->comma_capacity) {
+        size_t capacity = block->comma_capacity ? block->comma_capacity * 2 : 64;
+        size_t *commas = (size_t *)realloc(block->commas, capacity * sizeof(size_t));
+        if (commas == NULL) return 0;
+        block->commas = commas;
+        block->comma_capacity = capacity;
+    }
+    block->commas[block->comma_count++] = offset;
+    return 1;
+}
+
+static void _ygo_json_ingest_split(void *arg, size_t task) {
+    _ygo_json_ingest_ctx_t *ctx = (_ygo_json_ingest_ctx_t *)arg;
+    _ygo_json_ingest_block_t *block = &ctx->blocks[task];
+    size_t start = task * YGO_JSON_INGEST_BLOCK_LEN;
+    size_t end = start + YGO_JSON_INGEST_BLOCK_LEN;
+    if (end > ctx->len) end = ctx->len;
+    const char *text = ctx->text;
+
+    int quoted = block->in_string;
+    ptrdiff_t depth = block->start_depth;
+    block->end = SIZE_MAX;
+
+    size_t i = start + (size_t)_ygo_json_ingest_escaped(text, start);
+    for (; (i = _ygo_json_ingest_skip(text, i, end)) < end; i++) {
+        char c = text[i];
+        if (c == '\\') {
+            i++;
+        } else if (c == '"') {
+            quoted ^= 1;
+        } else if (quoted) {
+            continue;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (--depth < 0) {
+                block->end = i;
+                return;
+            }
+        } else if (depth == 0) {
+            if (!_ygo_json_ingest_add_comma(block, i)) {
+                block->failed = 1;
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * Cards first, by id then position, skipped elements last.
+ */
+static int _ygo_json_ingest_compare_keys(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void _ygo_json_ingest_convert(void *arg, size_t task) {
+    _ygo_json_ingest_ctx_t *ctx = (_ygo_json_ingest_ctx_t *)arg;
+    size_t first = task * YGO_JSON_INGEST_RUN_LEN;
+    size_t last = first + YGO_JSON_INGEST_RUN_LEN;
+    if (last > ctx->elements) last = ctx->elements;
+    size_t start = first == 0 ? 0 : ctx->commas[first - 1] + 1;
+    size_t end = ctx->commas[last - 1];
+    ctx->syntax[task] = SIZE_MAX;
+
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_slice(&stream, ctx->text + start, end - start);
+
+    uint64_t *keys = ctx->keys + first + task;
+    size_t count = 0;
+    ygo_json_err_t err = YGO_JSON_OK;
+    for (size_t i = first; i < last; i++) {
+        err = ygo_json_stream_next(&stream, &ctx->cards[i]);
+        if (err == YGO_JSON_ERR_SYNTAX || err == YGO_JSON_ERR_END_OF_DATA) break;
+
+        ctx->errs[i] = (uint8_t)err;
+        if (err == YGO_JSON_OK) keys[count++] = (uint64_t)ctx->cards[i].id << 32 | i;
+    }
+
+    // Exactly the elements between the commas found, nothing after the last one.
+    if (err != YGO_JSON_ERR_SYNTAX && err != YGO_JSON_ERR_END_OF_DATA) {
+        ygo_card_t extra;
+        err = ygo_json_stream_next(&stream, &extra);
+        if (err == YGO_JSON_ERR_END_OF_DATA) {
+            qsort(keys, count, sizeof(uint64_t), _ygo_json_ingest_compare_keys);
+            keys[count] = UINT64_MAX;
+            return;
+        }
+    }
+    ctx->syntax[task] = start + ygo_json_stream_offset(&stream);
+}
+
+/**
+ * Sift the heap entry at i down, heap being run indices ordered by their current key.
+ */
+static void _ygo_json_ingest_sift(const uint64_t *const *heads, size_t *heap, size_t n, size_t i) {
+    for (;;) {
+        size_t least = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < n && *heads[heap[left]] < *heads[heap[least]]) least = left;
+        if (right < n && *heads[heap[right]] < *heads[heap[least]]) least = right;
+        if (least == i) return;
+
+        size_t swap = heap[i];
+        heap[i] = heap[least];
+        heap[least] = swap;
+        i = least;
+    }
+}
+
+/**
+ * Merge the sorted runs into the final card list.
+ */
+static ygo_json_err_t _ygo_json_ingest_merge(_ygo_json_ingest_ctx_t *ctx,
+                                             size_t runs,
+                                             ygo_json_ingest_t *ingest) {
+    size_t count = 0;
+    for (size_t i = 0; i < ctx->elements; i++) {
+        if (ctx->errs[i] == YGO_JSON_OK) count++;
+    }
+
+    ingest->cards = (ygo_card_t *)malloc((count + 1) * sizeof(ygo_card_t));
+    ingest->errors = (ygo_json_ingest_error_t *)malloc(
+        (ctx->elements - count + 1) * sizeof(ygo_json_ingest_error_t));
+    const uint64_t **heads = (const uint64_t **)malloc((runs + 1) * sizeof(*heads));
+    size_t *heap = (size_t *)malloc((runs + 1) * sizeof(size_t));
+    if (ingest->cards == NULL || ingest->errors == NULL || heads == NULL || heap == NULL) {
+        free(heads);
+        free(heap);
+        return YGO_JSON_ERR_NO_MEMORY;
+    }
+
+    for (size_t i = 0; i < ctx->elements; i++) {
+        if (ctx->errs[i] == YGO_JSON_OK) continue;
+        ygo_json_ingest_error_t *error = &ingest->errors[ingest->error_count++];
+        error->element = (uint32_t)i;
+        error->err = (ygo_json_err_t)ctx->errs[i];
+    }
+
+    size_t n = 0;
+    for (size_t run = 0; run < runs; run++) {
+        heads[run] = ctx->keys + run * YGO_JSON_INGEST_RUN_LEN + run;
+        if (*heads[run] != UINT64_MAX) heap[n++] = run;
+    }
+    for (size_t i = n / 2; i-- > 0;) {
+        _ygo_json_ingest_sift(heads, heap, n, i);
+    }
+
+    while (n > 0) {
+        uint64_t key = *heads[heap[0]]++;
+        ingest->cards[ingest->count++] = ctx->cards[(uint32_t)key];
+        if (*heads[heap[0]] == UINT64_MAX) heap[0] = heap[--n];
+        _ygo_json_ingest_sift(heads, heap, n, 0);
+    }
+
+    free(heads);
+    free(heap);
+    return YGO_JSON_OK;
+}
+
+/**
+ * Find the commas between the elements of data[] and its closing bracket.
+ * @return YGO_JSON_OK, YGO_JSON_ERR_SYNTAX or YGO_JSON_ERR_NO_MEMORY
+ */
+static ygo_json_err_t _ygo_json_ingest_find_elements(_ygo_json_ingest_ctx_t *ctx,
+                                                     _ygo_json_ingest_pool_t *pool,
+                                                     size_t *offset) {
+    size_t count = ctx->len / YGO_JSON_INGEST_BLOCK_LEN + 1;
+    ctx->blocks = (_ygo_json_ingest_block_t *)calloc(count, sizeof(_ygo_json_ingest_block_t));
+    if (ctx->blocks == NULL) return YGO_JSON_ERR_NO_MEMORY;
+
+    _ygo_json_ingest_run(pool, count, _ygo_json_ingest_count, ctx);
+
+    int in_string = 0;
+    ptrdiff_t depth = 0;
+    for (size_t i = 0; i < count; i++) {
+        ctx->blocks[i].in_string = (uint8_t)in_string;
+        ctx->blocks[i].start_depth = depth;
+        depth += ctx->blocks[i].depth[in_string];
+        in_string ^= ctx->blocks[i].quotes;
+    }
+
+    _ygo_json_ingest_run(pool, count, _ygo_json_ingest_split, ctx);
+
+    // Blocks past the closing bracket may hold commas of other arrays.
+    size_t last = 0;
+    size_t commas = 0;
+    while (last < count && ctx->blocks[last].end == SIZE_MAX) {
+        if (ctx->blocks[last].failed) return YGO_JSON_ERR_NO_MEMORY;
+        commas += ctx->blocks[last++].comma_count;
+    }
+    if (last == count || ctx->text[ctx->blocks[last].end] != ']') {
+        *offset = last == count ? ctx->len : ctx->blocks[last].end;
+        return YGO_JSON_ERR_SYNTAX;
+    }
+    if (ctx->blocks[last].failed) return YGO_JSON_ERR_NO_MEMORY;
+    commas += ctx->blocks[last].comma_count;
+
+    ctx->commas = (size_t *)malloc((commas + 1) * sizeof(size_t));
+    if (ctx->commas == NULL) return YGO_JSON_ERR_NO_MEMORY;
+    for (size_t i = 0; i <= last; i++) {
+        if (ctx->blocks[i].comma_count == 0) continue;
+        memcpy(ctx->commas + ctx->elements, ctx->blocks[i].commas,
+               ctx->blocks[i].comma_count * sizeof(size_t));
+        ctx->elements += ctx->blocks[i].comma_count;
+    }
+    size_t end = ctx->blocks[last].end;
+    ctx->commas[ctx->elements++] = end;
+
+    // An empty array, which has no element rather than one which is blank. White space is every
+    // byte up to 0x20, as ygo_json_stream has it.
+    if (ctx->elements == 1) {
+        size_t i = 0;
+        while (i < end && (unsigned char)ctx->text[i] <= ' ') {
+            i++;
+        }
+        if (i == end) ctx->elements = 0;
+    }
+    if (ctx->elements > UINT32_MAX) return YGO_JSON_ERR_NO_MEMORY;
+    return YGO_JSON_OK;
+}
+
+static ygo_json_err_t _ygo_json_ingest_convert_all(_ygo_json_ingest_ctx_t *ctx,
+                                                   _ygo_json_ingest_pool_t *pool,
+                                                   ygo_json_ingest_t *ingest) {
+    size_t runs = (ctx->elements + YGO_JSON_INGEST_RUN_LEN - 1) / YGO_JSON_INGEST_RUN_LEN;
+    ctx->cards = (ygo_card_t *)malloc((ctx->elements + 1) * sizeof(ygo_card_t));
+    ctx->errs = (uint8_t *)calloc(ctx->elements + 1, 1);
+    ctx->keys = (uint64_t *)malloc((ctx->elements + runs + 1) * sizeof(uint64_t));
+    ctx->syntax = (size_t *)malloc((runs + 1) * sizeof(size_t));
+    if (ctx->cards == NULL || ctx->errs == NULL || ctx->keys == NULL || ctx->syntax == NULL) {
+        return YGO_JSON_ERR_NO_MEMORY;
+    }
+
+    _ygo_json_ingest_run(pool, runs, _ygo_json_ingest_convert, ctx);
+
+    // The first broken run, whichever thread found it first.
+    for (size_t run = 0; run < runs; run++) {
+        if (ctx->syntax[run] != SIZE_MAX) {
+            ingest->offset = ctx->syntax[run];
+            return YGO_JSON_ERR_SYNTAX;
+        }
+    }
+    return _ygo_json_ingest_merge(ctx, runs, ingest);
+}
+
+ygo_json_err_t ygo_json_ingest(ygo_json_ingest_t *ingest,
+                               const char *json,
+                               size_t len,
+                               unsigned threads) {
+    if (ingest == NULL) return YGO_JSON_ERR_NULL_INPUT;
+    memset(ingest, 0, sizeof(*ingest));
+    if (json == NULL) return YGO_JSON_ERR_NULL_INPUT;
+
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, json, len);
+    ygo_json_err_t err = ygo_json_stream_find_cards(&stream);
+    if (err == YGO_JSON_ERR_END_OF_DATA) return YGO_JSON_OK;
+    if (err != YGO_JSON_OK) {
+        ingest->offset = ygo_json_stream_offset(&stream);
+        return err;
+    }
+
+    ingest->threads = threads != 0 ? threads : _ygo_json_ingest_cpus();
+    _ygo_json_ingest_pool_t pool;
+    if (!_ygo_json_ingest_pool_init(&pool, ingest->threads)) return YGO_JSON_ERR_NO_MEMORY;
+
+    size_t start = ygo_json_stream_offset(&stream);
+    _ygo_json_ingest_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.text = json + start;
+    ctx.len = len - start;
+
+    err = _ygo_json_ingest_find_elements(&ctx, &pool, &ingest->offset);
+    if (err == YGO_JSON_OK) {
+        ingest->elements = ctx.elements;
+        err = _ygo_json_ingest_convert_all(&ctx, &pool, ingest);
+    }
+    if (err == YGO_JSON_ERR_SYNTAX) ingest->offset += start;
+
+    if (ctx.blocks != NULL) {
+        for (size_t i = 0; i <= ctx.len / YGO_JSON_INGEST_BLOCK_LEN; i++) {
+            free(ctx.blocks[i].commas);
+        }
+    }
+    free(ctx.blocks);
+    free(ctx.commas);
+    free(ctx.cards);
+    free(ctx.errs);
+    free(ctx.keys);
+    free(ctx.syntax);
+    _ygo_json_ingest_pool_free(&pool);
+
+    if (err != YGO_JSON_OK) {
+        ygo_json_ingest_t failed = *ingest;
+        ygo_json_ingest_free(ingest);
+        ingest->elements = failed.elements;
+        ingest->threads = failed.threads;
+        ingest->offset = failed.offset;
+    }
+    return err;
+}
+
+void ygo_json_ingest_free(ygo_json_ingest_t *ingest) {
+    if (ingest == NULL) return;
+    free(ingest->cards);
+    free(ingest->errors);
+    memset(ingest, 0, sizeof(*ingest));
+}
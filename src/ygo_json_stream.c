@@ -0,0 +1,482 @@
+/**
+ * @file ygo_json_stream.c
+ * @brief Streaming reader for the YGOPRODeck cardinfo dump.
+ *
+ * A pull parser over one byte at a time: every value which isn't one of a card's fields is
+ * skipped as it is read, so only the fields of the current card are ever held. Parsing follows
+ * cJSON where it is lenient or strict, so text ygo_json_to_card() reads is read the same way.
+ */
+
+#include "ygo_json_stream.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    YGO_JSON_STREAM_START = 0,
+    YGO_JSON_STREAM_FIRST,      // Inside the array, before its first element
+    YGO_JSON_STREAM_ARRAY,      // Inside the array, after an element
+    YGO_JSON_STREAM_SLICE,      // Inside a slice of the array, before its first element
+    YGO_JSON_STREAM_SLICE_NEXT, // Inside a slice of the array, after an element
+};
+
+#define YGO_JSON_BIT(key) (1u << (key))
+
+static int _ygo_json_peek(ygo_json_stream_t *s) {
+    if (s->pos == s->input_len) {
+        if (s->read == NULL) return -1;
+        s->base += s->input_len;
+        s->input = s->chunk;
+        s->input_len = s->read(s->read_ctx, s->chunk, sizeof(s->chunk));
+        s->pos = 0;
+        if (s->input_len == 0) return -1;
+    }
+    return (uint8_t)s->input[s->pos];
+}
+
+static int _ygo_json_next(ygo_json_stream_t *s) {
+    int c = _ygo_json_peek(s);
+    if (c >= 0) s->pos++;
+    return c;
+}
+
+/**
+ * Skip white space, which is every byte up to 0x20 as cJSON has it, control characters included.
+ * @return The character after it, not consumed, or -1 at the end of the input
+ */
+static int _ygo_json_skip_ws(ygo_json_stream_t *s) {
+    int c = _ygo_json_peek(s);
+    while (c >= 0 && c <= ' ') {
+        s->pos++;
+        c = _ygo_json_peek(s);
+    }
+    return c;
+}
+
+static int _ygo_json_expect(ygo_json_stream_t *s, char expected) {
+    if (_ygo_json_skip_ws(s) != expected) return 0;
+    s->pos++;
+    return 1;
+}
+
+static int _ygo_json_hex4(ygo_json_stream_t *s, uint32_t *value) {
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+        int c = _ygo_json_next(s);
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = (uint32_t)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = (uint32_t)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = (uint32_t)(c - 'A' + 10);
+        } else {
+            return 0;
+        }
+        *value = (*value << 4) | digit;
+    }
+    return 1;
+}
+
+/**
+ * Read the rest of a string whose opening quote was consumed, escapes decoded to UTF-8. The first
+ * len - 1 bytes are kept in dest, null terminated, the rest is dropped. dest may be NULL.
+ * @return 1, or 0 if the string is malformed
+ */
+static int _ygo_json_read_string(ygo_json_stream_t *s, char *dest, size_t len) {
+    size_t n = 0;
+    for (;;) {
+        int c = _ygo_json_next(s);
+        if (c < 0) return 0;
+        if (c == '"') break;
+
+        uint8_t bytes[4];
+        size_t count = 1;
+        bytes[0] = (uint8_t)c;
+
+        if (c == '\\') {
+            c = _ygo_json_next(s);
+            switch (c) {
+            case '"':
+            case '\\':
+            case '/': bytes[0] = (uint8_t)c; break;
+            case 'b': bytes[0] = '\b'; break;
+            case 'f': bytes[0] = '\f'; break;
+            case 'n': bytes[0] = '\n'; break;
+            case 'r': bytes[0] = '\r'; break;
+            case 't': bytes[0] = '\t'; break;
+            case 'u': {
+                uint32_t code;
+                if (!_ygo_json_hex4(s, &code)) return 0;
+                if (code >= 0xDC00 && code <= 0xDFFF) return 0;
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    // A high surrogate must be followed by the low one.
+                    uint32_t low;
+                    if (_ygo_json_next(s) != '\\' || _ygo_json_next(s) != 'u') return 0;
+                    if (!_ygo_json_hex4(s, &low) || low < 0xDC00 || low > 0xDFFF) return 0;
+                    code = 0x10000 + (((code & 0x3FF) << 10) | (low & 0x3FF));
+                }
+
+                if (code < 0x80) {
+                    bytes[0] = (uint8_t)code;
+                } else if (code < 0x800) {
+                    bytes[0] = (uint8_t)(0xC0 | (code >> 6));
+                    bytes[1] = (uint8_t)(0x80 | (code & 0x3F));
+                    count = 2;
+                } else if (code < 0x10000) {
+                    bytes[0] = (uint8_t)(0xE0 | (code >> 12));
+                    bytes[1] = (uint8_t)(0x80 | ((code >> 6) & 0x3F));
+                    bytes[2] = (uint8_t)(0x80 | (code & 0x3F));
+                    count = 3;
+                } else {
+                    bytes[0] = (uint8_t)(0xF0 | (code >> 18));
+                    bytes[1] = (uint8_t)(0x80 | ((code >> 12) & 0x3F));
+                    bytes[2] = (uint8_t)(0x80 | ((code >> 6) & 0x3F));
+                    bytes[3] = (uint8_t)(0x80 | (code & 0x3F));
+                    count = 4;
+                }
+                break;
+            }
+            default: return 0;
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            if (dest != NULL && n + 1 < len) dest[n++] = (char)bytes[i];
+        }
+    }
+
+    if (dest != NULL && len > 0) dest[n] = '\0';
+    return 1;
+}
+
+/**
+ * Read a number whose first character ('-' or a digit) is next, the way cJSON does: the run of
+ * number characters has to be a whole strtod() number.
+ */
+static int _ygo_json_read_number(ygo_json_stream_t *s, double *value) {
+    char text[64];
+    size_t n = 0;
+    for (;;) {
+        int c = _ygo_json_peek(s);
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' ||
+              c == 'E')) {
+            break;
+        }
+        if (n + 1 == sizeof(text)) return 0;
+        text[n++] = (char)c;
+        s->pos++;
+    }
+    text[n] = '\0';
+
+    char *end = NULL;
+    *value = strtod(text, &end);
+    return n > 0 && end == text + n;
+}
+
+/**
+ * cJSON's valueint: the number saturated to the range of an int.
+ */
+static int _ygo_json_valueint(double number) {
+    if (number >= INT_MAX) return INT_MAX;
+    if (number <= (double)INT_MIN) return INT_MIN;
+    return (int)number;
+}
+
+static int _ygo_json_literal(ygo_json_stream_t *s, const char *literal) {
+    for (; *literal != '\0'; literal++) {
+        if (_ygo_json_next(s) != (uint8_t)*literal) return 0;
+    }
+    return 1;
+}
+
+/**
+ * Read past one value of any kind, checking its syntax.
+ */
+static int _ygo_json_skip_value(ygo_json_stream_t *s, int depth) {
+    int c = _ygo_json_skip_ws(s);
+    double number;
+
+    switch (c) {
+    case '"': s->pos++; return _ygo_json_read_string(s, NULL, 0);
+    case 't': return _ygo_json_literal(s, "true");
+    case 'f': return _ygo_json_literal(s, "false");
+    case 'n': return _ygo_json_literal(s, "null");
+    case '[':
+    case '{': {
+        char close = (c == '[') ? ']' : '}';
+        if (depth >= YGO_JSON_STREAM_MAX_DEPTH) return 0;
+        s->pos++;
+        if (_ygo_json_skip_ws(s) == close) {
+            s->pos++;
+            return 1;
+        }
+        for (;;) {
+            if (close == '}') {
+                if (!_ygo_json_expect(s, '"') || !_ygo_json_read_string(s, NULL, 0)) return 0;
+                if (!_ygo_json_expect(s, ':')) return 0;
+            }
+            if (!_ygo_json_skip_value(s, depth + 1)) return 0;
+            _ygo_json_skip_ws(s);
+            c = _ygo_json_next(s);
+            if (c == close) return 1;
+            if (c != ',') return 0;
+        }
+    }
+    default:
+        if (c == '-' || (c >= '0' && c <= '9')) return _ygo_json_read_number(s, &number);
+        return 0;
+    }
+}
+
+/**
+ * Read the value of a card key, keeping it if it has the type the mapping wants.
+ */
+static int _ygo_json_read_field(ygo_json_stream_t *s, int key) {
+    int c = _ygo_json_skip_ws(s);
+
+    if (key <= YGO_JSON_KEY_LINK_MARKERS_ID) {
+        if (c != '-' && !(c >= '0' && c <= '9')) return _ygo_json_skip_value(s, 0);
+        double number;
+        if (!_ygo_json_read_number(s, &number)) return 0;
+        if (key == YGO_JSON_KEY_ID) s->id = number;
+        s->numbers[key] = _ygo_json_valueint(number);
+        s->valid |= YGO_JSON_BIT(key);
+        return 1;
+    }
+
+    if (key == YGO_JSON_KEY_LINKMARKERS) {
+        if (c != '[') return _ygo_json_skip_value(s, 0);
+        s->pos++;
+        s->valid |= YGO_JSON_BIT(key);
+        if (_ygo_json_skip_ws(s) == ']') {
+            s->pos++;
+            return 1;
+        }
+        for (;;) {
+            if (_ygo_json_skip_ws(s) == '"') {
+                s->pos++;
+                if (!_ygo_json_read_string(s, s->scratch, sizeof(s->scratch))) return 0;
+                s->link_markers |= ygo_json_parse_link_marker(s->scratch);
+            } else if (!_ygo_json_skip_value(s, 1)) {
+                return 0;
+            }
+            _ygo_json_skip_ws(s);
+            c = _ygo_json_next(s);
+            if (c == ']') return 1;
+            if (c != ',') return 0;
+        }
+    }
+
+    if (c != '"') return _ygo_json_skip_value(s, 0);
+    s->pos++;
+    s->valid |= YGO_JSON_BIT(key);
+    switch (key) {
+    case YGO_JSON_KEY_NAME: return _ygo_json_read_string(s, s->name, sizeof(s->name));
+    case YGO_JSON_KEY_TYPE: return _ygo_json_read_string(s, s->type, sizeof(s->type));
+    case YGO_JSON_KEY_RACE: return _ygo_json_read_string(s, s->race, sizeof(s->race));
+    default: return _ygo_json_read_string(s, s->attribute, sizeof(s->attribute));
+    }
+}
+
+/**
+ * Map the fields read into card, in the same order and with the same early returns as
+ * ygo_json_to_card().
+ */
+static ygo_json_err_t _ygo_json_map_card(const ygo_json_stream_t *s, ygo_card_t *card) {
+#define HAS(key) ((s->valid & YGO_JSON_BIT(YGO_JSON_KEY_##key)) != 0)
+#define NUMBER(key) (s->numbers[YGO_JSON_KEY_##key])
+
+    memset(card, 0, sizeof(*card));
+
+    if (!HAS(ID)) return YGO_JSON_ERR_MISSING_ID;
+    card->id = (uint32_t)s->id;
+
+    if (!HAS(NAME)) return YGO_JSON_ERR_MISSING_NAME;
+    memcpy(card->name, s->name, strlen(s->name));
+
+    if (HAS(TYPE_ID)) {
+        card->type = (ygo_card_type_t)NUMBER(TYPE_ID);
+        if (HAS(FLAGS_ID)) card->flags = (ygo_monster_flag_t)NUMBER(FLAGS_ID);
+        if (HAS(ABILITY_ID)) card->ability = (ygo_monster_ability_t)NUMBER(ABILITY_ID);
+        if (HAS(SUMMON_ID)) card->summon = (ygo_summon_type_t)NUMBER(SUMMON_ID);
+        if (HAS(MONSTER_TYPE_ID)) card->monster_type = (ygo_monster_type_t)NUMBER(MONSTER_TYPE_ID);
+    } else {
+        if (!HAS(TYPE)) return YGO_JSON_ERR_MISSING_TYPE;
+        ygo_json_err_t err = ygo_json_parse_type_string(
+            s->type, &card->type, &card->flags, &card->ability, &card->summon);
+        if (err != YGO_JSON_OK) return err;
+        if (HAS(RACE)) card->monster_type = ygo_monster_type_from_str(s->race);
+    }
+
+    if (HAS(ATTRIBUTE_ID)) {
+        card->attribute = (ygo_attribute_t)NUMBER(ATTRIBUTE_ID);
+    } else if (HAS(ATTRIBUTE)) {
+        card->attribute = ygo_attribute_from_str(s->attribute);
+    }
+
+    if (HAS(ATK)) card->atk = (uint16_t)NUMBER(ATK);
+    if (HAS(DEF)) card->def = (uint16_t)NUMBER(DEF);
+    if (HAS(LEVEL)) card->level = (uint8_t)NUMBER(LEVEL);
+    if (HAS(SCALE)) card->scale = (uint8_t)NUMBER(SCALE);
+    if (HAS(LINKVAL)) card->link_value = (uint8_t)NUMBER(LINKVAL);
+
+    if (HAS(LINK_MARKERS_ID)) {
+        card->link_markers = (ygo_card_link_markers_t)NUMBER(LINK_MARKERS_ID);
+    } else if (HAS(LINKMARKERS)) {
+        card->link_markers = s->link_markers;
+    }
+
+    return YGO_JSON_OK;
+
+#undef HAS
+#undef NUMBER
+}
+
+/**
+ * Read one element of the card array.
+ */
+static ygo_json_err_t _ygo_json_read_card(ygo_json_stream_t *s, ygo_card_t *card) {
+    s->seen = 0;
+    s->valid = 0;
+    s->link_markers = 0;
+    s->count++;
+
+    // Not an object, so it has no id, like cJSON_GetObjectItemCaseSensitive() finds.
+    if (_ygo_json_skip_ws(s) != '{') {
+        if (!_ygo_json_skip_value(s, 1)) return YGO_JSON_ERR_SYNTAX;
+        memset(card, 0, sizeof(*card));
+        return YGO_JSON_ERR_MISSING_ID;
+    }
+    s->pos++;
+
+    if (_ygo_json_skip_ws(s) == '}') {
+        s->pos++;
+        return _ygo_json_map_card(s, card);
+    }
+
+    for (;;) {
+        if (!_ygo_json_expect(s, '"') ||
+            !_ygo_json_read_string(s, s->scratch, sizeof(s->scratch)) ||
+            !_ygo_json_expect(s, ':')) {
+            return YGO_JSON_ERR_SYNTAX;
+        }
+
+        ygo_json_key_t key = ygo_json_key_from_str(s->scratch);
+
+        // Only the first of repeated keys counts, whatever it holds.
+        int ok;
+        if (key >= YGO_JSON_KEY_COUNT || (s->seen & YGO_JSON_BIT(key)) != 0) {
+            ok = _ygo_json_skip_value(s, 1);
+        } else {
+            s->seen |= YGO_JSON_BIT(key);
+            ok = _ygo_json_read_field(s, key);
+        }
+        if (!ok) return YGO_JSON_ERR_SYNTAX;
+
+        _ygo_json_skip_ws(s);
+        int c = _ygo_json_next(s);
+        if (c == '}') break;
+        if (c != ',') return YGO_JSON_ERR_SYNTAX;
+    }
+
+    return _ygo_json_map_card(s, card);
+}
+
+/**
+ * Find the card array: the top level value itself, or the "data" member of a top level object.
+ */
+static ygo_json_err_t _ygo_json_find_array(ygo_json_stream_t *s) {
+    int c = _ygo_json_skip_ws(s);
+    if (c == '[') {
+        s->pos++;
+        return YGO_JSON_OK;
+    }
+    if (c != '{') return YGO_JSON_ERR_SYNTAX;
+    s->pos++;
+
+    if (_ygo_json_skip_ws(s) == '}') return YGO_JSON_ERR_END_OF_DATA;
+    for (;;) {
+        if (!_ygo_json_expect(s, '"') ||
+            !_ygo_json_read_string(s, s->scratch, sizeof(s->scratch)) ||
+            !_ygo_json_expect(s, ':')) {
+            return YGO_JSON_ERR_SYNTAX;
+        }
+        if (strcmp(s->scratch, "data") == 0 && _ygo_json_skip_ws(s) == '[') {
+            s->pos++;
+            return YGO_JSON_OK;
+        }
+        if (!_ygo_json_skip_value(s, 1)) return YGO_JSON_ERR_SYNTAX;
+
+        _ygo_json_skip_ws(s);
+        c = _ygo_json_next(s);
+        if (c == '}') return YGO_JSON_ERR_END_OF_DATA;
+        if (c != ',') return YGO_JSON_ERR_SYNTAX;
+    }
+}
+
+void ygo_json_stream_init_buffer(ygo_json_stream_t *stream, const char *json, size_t len) {
+    if (stream == NULL) return;
+    memset(stream, 0, sizeof(*stream));
+    stream->input = json;
+    stream->input_len = json != NULL ? len : 0;
+}
+
+void ygo_json_stream_init_reader(ygo_json_stream_t *stream, ygo_json_read_fn read, void *ctx) {
+    if (stream == NULL) return;
+    memset(stream, 0, sizeof(*stream));
+    stream->input = stream->chunk;
+    stream->read = read;
+    stream->read_ctx = ctx;
+}
+
+void ygo_json_stream_init_slice(ygo_json_stream_t *stream, const char *json, size_t len) {
+    if (stream == NULL) return;
+    ygo_json_stream_init_buffer(stream, json, len);
+    stream->state = YGO_JSON_STREAM_SLICE;
+}
+
+ygo_json_err_t ygo_json_stream_find_cards(ygo_json_stream_t *stream) {
+    if (stream == NULL) return YGO_JSON_ERR_NULL_INPUT;
+    if (stream->err != YGO_JSON_OK) return stream->err;
+
+    if (stream->state == YGO_JSON_STREAM_START) {
+        stream->err = _ygo_json_find_array(stream);
+        if (stream->err != YGO_JSON_OK) return stream->err;
+        stream->state = YGO_JSON_STREAM_FIRST;
+    }
+    return YGO_JSON_OK;
+}
+
+ygo_json_err_t ygo_json_stream_next(ygo_json_stream_t *stream, ygo_card_t *card) {
+    if (stream == NULL || card == NULL) return YGO_JSON_ERR_NULL_INPUT;
+    if (stream->err != YGO_JSON_OK) return stream->err;
+
+    if (ygo_json_stream_find_cards(stream) != YGO_JSON_OK) return stream->err;
+
+    int c = _ygo_json_skip_ws(stream);
+    if (stream->state >= YGO_JSON_STREAM_SLICE) {
+        // No brackets around a slice, its elements go on up to the end of the text.
+        if (c < 0) return stream->err = YGO_JSON_ERR_END_OF_DATA;
+        if (stream->state == YGO_JSON_STREAM_SLICE_NEXT) {
+            stream->pos++;
+            if (c != ',') return stream->err = YGO_JSON_ERR_SYNTAX;
+        }
+        stream->state = YGO_JSON_STREAM_SLICE_NEXT;
+    } else {
+        if (c < 0) return stream->err = YGO_JSON_ERR_SYNTAX;
+        if (stream->state == YGO_JSON_STREAM_ARRAY) {
+            stream->pos++;
+            if (c == ']') return stream->err = YGO_JSON_ERR_END_OF_DATA;
+            if (c != ',') return stream->err = YGO_JSON_ERR_SYNTAX;
+        } else if (c == ']') {
+            stream->pos++;
+            return stream->err = YGO_JSON_ERR_END_OF_DATA;
+        }
+        stream->state = YGO_JSON_STREAM_ARRAY;
+    }
+
+    ygo_json_err_t err = _ygo_json_read_card(stream, card);
+    if (err == YGO_JSON_ERR_SYNTAX) stream->err = err;
+    return err;
+}
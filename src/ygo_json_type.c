@@ -0,0 +1,159 @@
+/**
+ * @file ygo_json_type.c
+ * @brief String mappings shared by the cJSON and streaming JSON readers.
+ *
+ * Nothing here needs cJSON, so the streaming reader (ygo_json_stream.c) maps fields through the
+ * same code as ygo_json_to_card() without pulling it in.
+ */
+
+#include "ygo_json.h"
+#include <string.h>
+
+ENUM_IMPL(ygo_json_key, YGO_JSON_KEY_DEFS);
+
+// Only this much of a type string is read, longer ones are cut short.
+#define TYPE_STR_BUF_SIZE 128
+
+// Output a type string token goes to.
+enum {
+    YGO_JSON_TOKEN_TYPE,
+    YGO_JSON_TOKEN_FLAG,
+    YGO_JSON_TOKEN_ABILITY,
+    YGO_JSON_TOKEN_SUMMON,
+};
+
+/**
+ * Words of a type string, what they set, and to which value. "Normal" sets the ability, which
+ * reads as the Normal subtype on Spell and Trap cards. Spell and Trap subtypes go in the summon
+ * field.
+ */
+#define YGO_JSON_TYPE_TOKEN_DEFS(T)                                                                \
+    T(YGO_JSON_TOKEN_TYPE, "Monster", YGO_CARD_TYPE_MONSTER)                                       \
+    T(YGO_JSON_TOKEN_TYPE, "Spell", YGO_CARD_TYPE_SPELL)                                           \
+    T(YGO_JSON_TOKEN_TYPE, "Trap", YGO_CARD_TYPE_TRAP)                                             \
+    T(YGO_JSON_TOKEN_TYPE, "Token", YGO_CARD_TYPE_TOKEN)                                           \
+    T(YGO_JSON_TOKEN_TYPE, "Skill", YGO_CARD_TYPE_SKILL)                                           \
+    T(YGO_JSON_TOKEN_FLAG, "Effect", YGO_MONSTER_FLAG_EFFECT)                                      \
+    T(YGO_JSON_TOKEN_FLAG, "Tuner", YGO_MONSTER_FLAG_TUNER)                                        \
+    T(YGO_JSON_TOKEN_FLAG, "Pendulum", YGO_MONSTER_FLAG_PENDULUM)                                  \
+    T(YGO_JSON_TOKEN_ABILITY, "Normal", YGO_MONSTER_ABILITY_NORMAL)                                \
+    T(YGO_JSON_TOKEN_ABILITY, "Flip", YGO_MONSTER_ABILITY_FLIP)                                    \
+    T(YGO_JSON_TOKEN_ABILITY, "Gemini", YGO_MONSTER_ABILITY_GEMINI)                                \
+    T(YGO_JSON_TOKEN_ABILITY, "Spirit", YGO_MONSTER_ABILITY_SPIRIT)                                \
+    T(YGO_JSON_TOKEN_ABILITY, "Toon", YGO_MONSTER_ABILITY_TOON)                                    \
+    T(YGO_JSON_TOKEN_ABILITY, "Union", YGO_MONSTER_ABILITY_UNION)                                  \
+    T(YGO_JSON_TOKEN_SUMMON, "Fusion", YGO_SUMMON_TYPE_FUSION)                                     \
+    T(YGO_JSON_TOKEN_SUMMON, "Ritual", YGO_SUMMON_TYPE_RITUAL)                                     \
+    T(YGO_JSON_TOKEN_SUMMON, "Synchro", YGO_SUMMON_TYPE_SYNCHRO)                                   \
+    T(YGO_JSON_TOKEN_SUMMON, "Xyz", YGO_SUMMON_TYPE_XYZ)                                           \
+    T(YGO_JSON_TOKEN_SUMMON, "XYZ", YGO_SUMMON_TYPE_XYZ)                                           \
+    T(YGO_JSON_TOKEN_SUMMON, "Link", YGO_SUMMON_TYPE_LINK)                                         \
+    T(YGO_JSON_TOKEN_SUMMON, "Continuous", YGO_SPELL_TYPE_CONTINUOUS)                              \
+    T(YGO_JSON_TOKEN_SUMMON, "Equip", YGO_SPELL_TYPE_EQUIP)                                        \
+    T(YGO_JSON_TOKEN_SUMMON, "Field", YGO_SPELL_TYPE_FIELD)                                        \
+    T(YGO_JSON_TOKEN_SUMMON, "Quick-Play", YGO_SPELL_TYPE_QUICK_PLAY)                              \
+    T(YGO_JSON_TOKEN_SUMMON, "Counter", YGO_TRAP_TYPE_COUNTER)
+
+#define YGO_JSON_TOKEN_ENTRY(output, name, value)                                                  \
+    {name, (uint8_t)(sizeof(name) - 1), (uint8_t)(value)},
+#define YGO_JSON_TOKEN_OUTPUT(output, name, value) output,
+
+static const ygo_enum_entry_t _ygo_json_type_tokens[] YGO_FLASH = {
+    YGO_JSON_TYPE_TOKEN_DEFS(YGO_JSON_TOKEN_ENTRY)};
+static const uint8_t _ygo_json_type_token_outputs[] YGO_FLASH = {
+    YGO_JSON_TYPE_TOKEN_DEFS(YGO_JSON_TOKEN_OUTPUT)};
+
+/**
+ * Parse a single token from the type string and update the output enums accordingly.
+ * Returns 1 if the token was recognized, 0 otherwise.
+ */
+static int _process_type_token(const char *token,
+                               size_t len,
+                               ygo_card_type_t *out_type,
+                               ygo_monster_flag_t *out_flags,
+                               ygo_monster_ability_t *out_ability,
+                               ygo_summon_type_t *out_summon) {
+    size_t n = sizeof(_ygo_json_type_tokens) / sizeof(_ygo_json_type_tokens[0]);
+    int i = ygo_enum_lookup(_ygo_json_type_tokens, n, token, len);
+
+    // Unknown token - not necessarily an error, just ignore
+    if (i < 0) return 0;
+
+    uint8_t value = ygo_flash_read_byte(&_ygo_json_type_tokens[i].value);
+    switch (ygo_flash_read_byte(&_ygo_json_type_token_outputs[i])) {
+    case YGO_JSON_TOKEN_TYPE: *out_type = (ygo_card_type_t)value; break;
+    case YGO_JSON_TOKEN_FLAG: *out_flags |= (ygo_monster_flag_t)value; break;
+    case YGO_JSON_TOKEN_ABILITY: *out_ability = (ygo_monster_ability_t)value; break;
+    default: *out_summon = (ygo_summon_type_t)value; break;
+    }
+    return 1;
+}
+
+ygo_json_err_t ygo_json_parse_type_string(const char *type_str,
+                                          ygo_card_type_t *out_type,
+                                          ygo_monster_flag_t *out_flags,
+                                          ygo_monster_ability_t *out_ability,
+                                          ygo_summon_type_t *out_summon) {
+    if (!type_str || !out_type || !out_flags || !out_ability || !out_summon) {
+        return YGO_JSON_ERR_NULL_INPUT;
+    }
+
+    // Initialize outputs
+    *out_type = YGO_CARD_TYPE_TOKEN; // Default, will be overwritten
+    *out_flags = 0;
+    *out_ability = YGO_MONSTER_ABILITY_NORMAL;
+    *out_summon = YGO_SUMMON_TYPE_NORMAL;
+
+    size_t len = 0;
+    while (len < TYPE_STR_BUF_SIZE - 1 && type_str[len] != '\0') {
+        len++;
+    }
+
+    // Tokenize by space, in place
+    const char *end = type_str + len;
+    int found_any = 0;
+    for (const char *p = type_str; p < end;) {
+        if (*p == ' ') {
+            p++;
+            continue;
+        }
+        const char *token = p;
+        while (p < end && *p != ' ') {
+            p++;
+        }
+        if (_process_type_token(token, (size_t)(p - token), out_type, out_flags, out_ability,
+                                out_summon)) {
+            found_any = 1;
+        }
+    }
+
+    if (!found_any) {
+        return YGO_JSON_ERR_INVALID_TYPE;
+    }
+
+    return YGO_JSON_OK;
+}
+
+ygo_card_link_markers_t ygo_json_parse_link_marker(const char *s) {
+    // The API spells them both "Top-Right" and "Top Right", the lookup takes either.
+    ygo_card_link_markers_t marker = ygo_card_link_markers_from_str(s);
+    return marker != (ygo_card_link_markers_t)-1 ? marker : 0;
+}
+
+const char *ygo_json_err_str(ygo_json_err_t err) {
+    switch (err) {
+    case YGO_JSON_OK: return "OK";
+    case YGO_JSON_ERR_NULL_INPUT: return "Null input";
+    case YGO_JSON_ERR_MISSING_ID: return "Missing 'id' field";
+    case YGO_JSON_ERR_MISSING_NAME: return "Missing 'name' field";
+    case YGO_JSON_ERR_MISSING_TYPE: return "Missing 'type' field";
+    case YGO_JSON_ERR_INVALID_TYPE: return "Invalid type string";
+    case YGO_JSON_ERR_NAME_TOO_LONG: return "Name too long";
+    case YGO_JSON_ERR_UNKNOWN_ATTRIBUTE: return "Unknown attribute";
+    case YGO_JSON_ERR_UNKNOWN_RACE: return "Unknown race";
+    case YGO_JSON_ERR_SYNTAX: return "Malformed JSON";
+    case YGO_JSON_ERR_END_OF_DATA: return "End of data";
+    case YGO_JSON_ERR_NO_MEMORY: return "Out of memory";
+    default: return "Unknown error";
+    }
+}
@@ -0,0 +1,244 @@
+/**
+ * @file ygo_json_write.c
+ * @brief Card to JSON, without cJSON and without allocating.
+ *
+ * Each card is formatted into a YGO_JSON_CARD_MAX_LEN stack buffer with no bounds checks, the
+ * fields being bounded, then copied out as far as the caller's buffer goes. A catalog export is
+ * one pass of plain stores and a memcpy per card.
+ */
+
+#include "ygo_json.h"
+#include <string.h>
+
+ENUM_IMPL(ygo_json_schema, YGO_JSON_SCHEMA_DEFS);
+
+typedef struct {
+    char *buffer;
+    size_t len;
+    size_t pos; // Bytes of the whole text so far, written or not
+} _ygo_json_out_t;
+
+static void _ygo_json_out(_ygo_json_out_t *out, const char *text, size_t len) {
+    if (out->pos < out->len) {
+        size_t room = out->len - out->pos;
+        memcpy(out->buffer + out->pos, text, len < room ? len : room);
+    }
+    out->pos += len;
+}
+
+/**
+ * NUL after the text, or after as much of it as fits.
+ */
+static size_t _ygo_json_out_end(_ygo_json_out_t *out) {
+    if (out->len > 0) out->buffer[out->pos < out->len ? out->pos : out->len - 1] = '\0';
+    return out->pos;
+}
+
+static char *_ygo_json_put(char *p, const char *text) {
+    size_t len = strlen(text);
+    memcpy(p, text, len);
+    return p + len;
+}
+
+// Literals are copied with their length known at compile time, the keys being most of the text.
+#define PUT_LITERAL(p, text) (memcpy((p), (text), sizeof(text) - 1), (p) + sizeof(text) - 1)
+#define PUT_NUMBER(p, key, value) _ygo_json_put_uint(PUT_LITERAL(p, ",\"" key "\":"), (value))
+#define PUT_STRING(p, key, value)                                                                  \
+    _ygo_json_put_string(PUT_LITERAL(p, ",\"" key "\":"), (value), strlen(value))
+
+static char *_ygo_json_put_uint(char *p, uint32_t value) {
+    char digits[10];
+    size_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+
+/**
+ * A JSON string of up to len bytes of text, stopping at a NUL. Bytes from 0x80 up are UTF-8 and
+ * go through as they are.
+ */
+static char *_ygo_json_put_string(char *p, const char *text, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+
+    *p++ = '"';
+    for (size_t i = 0; i < len && text[i] != '\0'; i++) {
+        uint8_t c = (uint8_t)text[i];
+        if (c == '"' || c == '\\') {
+            *p++ = '\\';
+            *p++ = (char)c;
+        } else if (c >= 0x20) {
+            *p++ = (char)c;
+        } else if (c == '\n') {
+            p = PUT_LITERAL(p, "\\n");
+        } else if (c == '\t') {
+            p = PUT_LITERAL(p, "\\t");
+        } else if (c == '\r') {
+            p = PUT_LITERAL(p, "\\r");
+        } else {
+            p = PUT_LITERAL(p, "\\u00");
+            *p++ = hex[c >> 4];
+            *p++ = hex[c & 0xF];
+        }
+    }
+    *p++ = '"';
+    return p;
+}
+
+/**
+ * A word of the compound type and a space, unless the table has no name for it.
+ */
+static char *_ygo_json_put_word(char *p, const char *word) {
+    if (word[0] == '\0' || strcmp(word, "???") == 0) return p;
+    p = _ygo_json_put(p, word);
+    *p++ = ' ';
+    return p;
+}
+
+/**
+ * The API's compound type, e.g. "Synchro Pendulum Tuner Effect Monster", which
+ * ygo_json_parse_type_string() reads back to the same fields. Special Summon is not one of its
+ * words, so it doesn't appear.
+ */
+static char *_ygo_json_put_type(char *p, const ygo_card_t *card) {
+    *p++ = '"';
+    switch (card->type) {
+    case YGO_CARD_TYPE_MONSTER: {
+        int main_deck = card->summon == YGO_SUMMON_TYPE_NORMAL ||
+                        card->summon == YGO_SUMMON_TYPE_SPECIAL;
+        int effect = card->flags & YGO_MONSTER_FLAG_EFFECT;
+        if (main_deck && !effect && card->ability == YGO_MONSTER_ABILITY_NORMAL) {
+            p = PUT_LITERAL(p, "Normal ");
+        }
+        if (!main_deck) p = _ygo_json_put_word(p, ygo_summon_type_to_str(card->summon));
+        if (card->flags & YGO_MONSTER_FLAG_PENDULUM) p = PUT_LITERAL(p, "Pendulum ");
+        if (card->flags & YGO_MONSTER_FLAG_TUNER) p = PUT_LITERAL(p, "Tuner ");
+        p = _ygo_json_put_word(p, ygo_monster_ability_to_str(card->ability));
+        if (effect) p = PUT_LITERAL(p, "Effect ");
+        p = PUT_LITERAL(p, "Monster");
+        break;
+    }
+    case YGO_CARD_TYPE_SPELL: p = PUT_LITERAL(p, "Spell Card"); break;
+    case YGO_CARD_TYPE_TRAP: p = PUT_LITERAL(p, "Trap Card"); break;
+    case YGO_CARD_TYPE_SKILL: p = PUT_LITERAL(p, "Skill Card"); break;
+    default: p = _ygo_json_put(p, ygo_card_type_to_str(card->type)); break;
+    }
+    *p++ = '"';
+    return p;
+}
+
+static char *_ygo_json_put_api(char *p, const ygo_card_t *card) {
+    p = PUT_LITERAL(p, ",\"type\":");
+    p = _ygo_json_put_type(p, card);
+
+    const char *race = "???";
+    if (card->type == YGO_CARD_TYPE_SPELL) {
+        race = ygo_spell_type_to_str(card->spell_type);
+    } else if (card->type == YGO_CARD_TYPE_TRAP) {
+        race = ygo_trap_type_to_str(card->trap_type);
+    } else if (card->type == YGO_CARD_TYPE_MONSTER || card->type == YGO_CARD_TYPE_TRAP_MONSTER) {
+        race = ygo_monster_type_to_str(card->monster_type);
+    }
+    if (strcmp(race, "???") != 0) p = PUT_STRING(p, "race", race);
+
+    if (card->type != YGO_CARD_TYPE_MONSTER && card->type != YGO_CARD_TYPE_TRAP_MONSTER) return p;
+
+    const char *attribute = ygo_attribute_to_str(card->attribute);
+    if (strcmp(attribute, "???") != 0) p = PUT_STRING(p, "attribute", attribute);
+
+    p = PUT_NUMBER(p, "atk", card->atk);
+    if (card->summon == YGO_SUMMON_TYPE_LINK) {
+        p = PUT_NUMBER(p, "linkval", card->link_value);
+        p = PUT_LITERAL(p, ",\"linkmarkers\":[");
+        for (unsigned bit = 0; bit < 8; bit++) {
+            ygo_card_link_markers_t marker = (ygo_card_link_markers_t)(1u << bit);
+            if ((card->link_markers & marker) == 0) continue;
+            const char *name = ygo_card_link_markers_to_str(marker);
+            p = _ygo_json_put_string(p, name, strlen(name));
+            *p++ = ',';
+        }
+        // Over the last comma, or after the bracket if there is no marker
+        if (p[-1] == ',') p--;
+        *p++ = ']';
+        return p;
+    }
+
+    p = PUT_NUMBER(p, "def", card->def);
+    p = PUT_NUMBER(p, "level", card->level);
+    if (card->flags & YGO_MONSTER_FLAG_PENDULUM) p = PUT_NUMBER(p, "scale", card->scale);
+    return p;
+}
+
+static char *_ygo_json_put_numeric(char *p, const ygo_card_t *card) {
+    p = PUT_NUMBER(p, "type_id", card->type);
+    p = PUT_NUMBER(p, "flags_id", card->flags);
+    p = PUT_NUMBER(p, "ability_id", card->ability);
+    p = PUT_NUMBER(p, "summon_id", card->summon);
+    p = PUT_NUMBER(p, "monster_type_id", card->monster_type);
+    p = PUT_NUMBER(p, "attribute_id", card->attribute);
+    p = PUT_NUMBER(p, "atk", card->atk);
+    p = PUT_NUMBER(p, "def", card->def);
+    p = PUT_NUMBER(p, "level", card->level);
+    if (card->summon == YGO_SUMMON_TYPE_LINK) {
+        p = PUT_NUMBER(p, "linkval", card->link_value);
+    } else {
+        p = PUT_NUMBER(p, "scale", card->scale);
+    }
+    return PUT_NUMBER(p, "link_markers_id", card->link_markers);
+}
+
+/**
+ * The whole object into text, which holds YGO_JSON_CARD_MAX_LEN bytes.
+ * @return Its length
+ */
+static size_t _ygo_json_format(const ygo_card_t *card, ygo_json_schema_t schema, char *text) {
+    char *p = PUT_LITERAL(text, "{\"id\":");
+    p = _ygo_json_put_uint(p, card->id);
+    p = PUT_LITERAL(p, ",\"name\":");
+    p = _ygo_json_put_string(p, card->name, YGO_CARD_NAME_MAX_LEN);
+    p = schema == YGO_JSON_SCHEMA_NUMERIC ? _ygo_json_put_numeric(p, card)
+                                          : _ygo_json_put_api(p, card);
+    *p++ = '}';
+    return (size_t)(p - text);
+}
+
+size_t ygo_card_to_json(const ygo_card_t *card,
+                        ygo_json_schema_t schema,
+                        char *buffer,
+                        size_t len) {
+    if (card == NULL) return 0;
+    _ygo_json_out_t out = {buffer, buffer != NULL ? len : 0, 0};
+
+    char text[YGO_JSON_CARD_MAX_LEN];
+    _ygo_json_out(&out, text, _ygo_json_format(card, schema, text));
+    return _ygo_json_out_end(&out);
+}
+
+size_t ygo_cards_to_json(const ygo_card_t *cards,
+                         size_t count,
+                         ygo_json_schema_t schema,
+                         char *buffer,
+                         size_t len) {
+    if (cards == NULL && count > 0) return 0;
+    _ygo_json_out_t out = {buffer, buffer != NULL ? len : 0, 0};
+
+    // A leading comma on every card but the first, so each is one copy.
+    char text[YGO_JSON_CARD_MAX_LEN + 1];
+    _ygo_json_out(&out, "{\"data\":[", 9);
+    for (size_t i = 0; i < count; i++) {
+        text[0] = ',';
+        size_t n = _ygo_json_format(&cards[i], schema, text + 1);
+        _ygo_json_out(&out, i == 0 ? text + 1 : text, i == 0 ? n : n + 1);
+    }
+    _ygo_json_out(&out, "]}", 2);
+    return _ygo_json_out_end(&out);
+}
+
+#undef PUT_STRING
+#undef PUT_NUMBER
+#undef PUT_LITERAL
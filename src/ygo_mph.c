@@ -0,0 +1,195 @@
+#include "ygo_mph.h"
+#include <stdlib.h>
+
+// Seeds tried before giving up. With 16-bit pilots the first one practically always works.
+#define YGO_MPH_MAX_SEEDS 16
+#define YGO_MPH_MAX_PILOT 0xFFFFu
+
+/**
+ * Scratch space of one build, sized for n keys.
+ */
+typedef struct {
+    uint64_t *hashes;  // Per key
+    uint32_t *order;   // Key indices, grouped by bucket
+    uint32_t *start;   // Where each bucket starts in order, buckets + 1 entries
+    uint32_t *buckets; // Bucket numbers, largest bucket first
+    uint8_t *taken;    // One bit per slot of the range
+    uint32_t *slots;   // Slots of the bucket being placed
+} ygo_mph_scratch_t;
+
+static void _ygo_mph_free(ygo_mph_scratch_t *s) {
+    free(s->hashes);
+    free(s->order);
+    free(s->start);
+    free(s->buckets);
+    free(s->taken);
+    free(s->slots);
+}
+
+/**
+ * Group keys by bucket for this seed, and order the buckets largest first (the big ones are the
+ * hardest to place, so they go while the table is still empty).
+ * @return Size of the largest bucket, or 0 if two keys are equal
+ */
+static uint32_t _ygo_mph_group(ygo_mph_scratch_t *s,
+                               const uint32_t *keys,
+                               uint32_t n,
+                               uint32_t buckets,
+                               uint32_t seed) {
+    memset(s->start, 0, ((size_t)buckets + 1) * sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < n; i++) {
+        s->hashes[i] = ygo_mph_mix(((uint64_t)seed << 32u) | keys[i]);
+        s->start[ygo_mph_reduce((uint32_t)(s->hashes[i] >> 32u), buckets) + 1]++;
+    }
+
+    uint32_t max_size = 0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        if (s->start[b + 1] > max_size) max_size = s->start[b + 1];
+        s->start[b + 1] += s->start[b];
+    }
+
+    // Counting sort of the keys by bucket, borrowing buckets[] for the fill pointers.
+    uint32_t *fill = s->buckets;
+    memcpy(fill, s->start, (size_t)buckets * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++) {
+        s->order[fill[ygo_mph_reduce((uint32_t)(s->hashes[i] >> 32u), buckets)]++] = i;
+    }
+
+    // Equal keys hash equally under every seed, no point in trying others.
+    for (uint32_t b = 0; b < buckets; b++) {
+        for (uint32_t i = s->start[b]; i < s->start[b + 1]; i++) {
+            for (uint32_t j = i + 1; j < s->start[b + 1]; j++) {
+                if (keys[s->order[i]] == keys[s->order[j]]) return 0;
+            }
+        }
+    }
+
+    // Counting sort of the buckets by size, largest first.
+    uint32_t *count = (uint32_t *)calloc((size_t)max_size + 2, sizeof(uint32_t));
+    if (count == NULL) return 0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        count[max_size - (s->start[b + 1] - s->start[b]) + 1]++;
+    }
+    for (uint32_t k = 0; k <= max_size; k++) {
+        count[k + 1] += count[k];
+    }
+    for (uint32_t b = 0; b < buckets; b++) {
+        s->buckets[count[max_size - (s->start[b + 1] - s->start[b])]++] = b;
+    }
+    free(count);
+
+    return max_size;
+}
+
+/**
+ * Find a pilot for every bucket, so all keys land on free slots.
+ * @return 1 on success, 0 if some bucket couldn't be placed
+ */
+static int _ygo_mph_place(ygo_mph_scratch_t *s,
+                          uint16_t *pilots,
+                          uint32_t range,
+                          uint32_t buckets,
+                          uint32_t seed) {
+    memset(s->taken, 0, ((size_t)range + 7) / 8);
+
+    for (uint32_t k = 0; k < buckets; k++) {
+        uint32_t b = s->buckets[k];
+        uint32_t size = s->start[b + 1] - s->start[b];
+        const uint32_t *members = s->order + s->start[b];
+        pilots[b] = 0;
+        if (size == 0) continue;
+
+        uint32_t pilot = 0;
+        for (; pilot <= YGO_MPH_MAX_PILOT; pilot++) {
+            uint32_t pilot_hash = ygo_mph_pilot_hash(seed, (uint16_t)pilot);
+            uint32_t placed = 0;
+
+            for (; placed < size; placed++) {
+                uint32_t h = (uint32_t)s->hashes[members[placed]];
+                uint32_t slot = ygo_mph_reduce(h ^ pilot_hash, range);
+                if (s->taken[slot / 8] & (1u << (slot % 8))) break;
+
+                // Keys of the same bucket can't share a slot either.
+                uint32_t j = 0;
+                while (j < placed && s->slots[j] != slot) {
+                    j++;
+                }
+                if (j < placed) break;
+                s->slots[placed] = slot;
+            }
+
+            if (placed == size) break;
+        }
+
+        if (pilot > YGO_MPH_MAX_PILOT) return 0;
+
+        pilots[b] = (uint16_t)pilot;
+        for (uint32_t i = 0; i < size; i++) {
+            s->taken[s->slots[i] / 8] |= (uint8_t)(1u << (s->slots[i] % 8));
+        }
+    }
+
+    return 1;
+}
+
+size_t ygo_mph_build(uint8_t *buffer, const uint32_t *keys, size_t n) {
+    if (buffer == NULL || (keys == NULL && n > 0) || n >= UINT32_MAX / 2) return 0;
+    uint32_t buckets = (uint32_t)ygo_mph_buckets(n);
+    uint32_t range = (uint32_t)ygo_mph_range(n);
+
+    ygo_mph_scratch_t s;
+    s.hashes = (uint64_t *)malloc((n + 1) * sizeof(uint64_t));
+    s.order = (uint32_t *)malloc((n + 1) * sizeof(uint32_t));
+    s.start = (uint32_t *)malloc(((size_t)buckets + 1) * sizeof(uint32_t));
+    s.buckets = (uint32_t *)malloc(((size_t)buckets + 1) * sizeof(uint32_t));
+    s.taken = (uint8_t *)malloc((ygo_mph_range(n) + 7) / 8 + 1);
+    s.slots = NULL;
+    uint16_t *pilots = (uint16_t *)malloc(((size_t)buckets + 1) * sizeof(uint16_t));
+
+    size_t written = 0;
+    int allocated = s.hashes != NULL && s.order != NULL && s.start != NULL && s.buckets != NULL &&
+                    s.taken != NULL && pilots != NULL;
+
+    for (uint32_t attempt = 0; allocated && attempt < YGO_MPH_MAX_SEEDS; attempt++) {
+        uint32_t seed = (uint32_t)ygo_mph_mix(attempt + 1);
+        uint32_t max_size = _ygo_mph_group(&s, keys, (uint32_t)n, buckets, seed);
+        if (max_size == 0 && n > 0) break;
+
+        free(s.slots);
+        s.slots = (uint32_t *)malloc(((size_t)max_size + 1) * sizeof(uint32_t));
+        if (s.slots == NULL) break;
+        if (!_ygo_mph_place(&s, pilots, range, buckets, seed)) continue;
+
+        ygo_bin_write_context_t ctx;
+        ygo_bin_begin_data_write(&ctx, buffer);
+        ygo_bin_write_int32(&ctx, (uint32_t)n);
+        ygo_bin_write_int32(&ctx, buckets);
+        ygo_bin_write_int32(&ctx, seed);
+        for (uint32_t b = 0; b < buckets; b++) {
+            ygo_bin_write_int16(&ctx, pilots[b]);
+        }
+        while (ctx.ptr % 4 != 0) {
+            ygo_bin_write_int8(&ctx, 0x00);
+        }
+
+        // There are exactly as many keys past n as free slots below it, pair them up in order.
+        uint32_t free_slot = 0;
+        for (uint32_t slot = (uint32_t)n; slot < range; slot++) {
+            uint32_t target = 0;
+            if (s.taken[slot / 8] & (1u << (slot % 8))) {
+                while (s.taken[free_slot / 8] & (1u << (free_slot % 8))) {
+                    free_slot++;
+                }
+                target = free_slot++;
+            }
+            ygo_bin_write_int32(&ctx, target);
+        }
+        written = ctx.ptr;
+        break;
+    }
+
+    _ygo_mph_free(&s);
+    free(pilots);
+    return written;
+}
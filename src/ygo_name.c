@@ -0,0 +1,246 @@
+#include "ygo_name.h"
+
+/**
+ * The dictionary, in code order: the first entry is 0x80, the last one 0xFF. Picked from the most
+ * frequent words and archetype prefixes in card names, with a few common letter pairs to fill in
+ * between them. This is part of the BASIC record format, entries must never be changed or moved.
+ *
+ * tools/gen_name_dict.py builds this block from a cardinfo dump, and with --evaluate reports how
+ * it compares to the one below on the same names. A regenerated table goes in as a new data
+ * version next to this one, see the script.
+ */
+#define YGO_NAME_WORD_DEFS(X)                                                                      \
+    X(SP_DRAGON, " Dragon")                                                                        \
+    X(DRAGON, "Dragon")                                                                            \
+    X(SP_OF_THE_SP, " of the ")                                                                    \
+    X(BLUE_EYES_SP, "Blue-Eyes ")                                                                  \
+    X(RED_EYES_SP, "Red-Eyes ")                                                                    \
+    X(ELEMENTAL_HERO_SP, "Elemental HERO ")                                                        \
+    X(DESTINY_HERO_SP, "Destiny HERO - ")                                                          \
+    X(EVIL_HERO_SP, "Evil HERO ")                                                                  \
+    X(MASKED_HERO_SP, "Masked HERO ")                                                              \
+    X(MAGICIAN, "Magician")                                                                        \
+    X(DARK_SP, "Dark ")                                                                            \
+    X(CYBER, "Cyber")                                                                              \
+    X(WARRIOR, "Warrior")                                                                          \
+    X(KNIGHT, "Knight")                                                                            \
+    X(BLACK, "Black")                                                                              \
+    X(WHITE, "White")                                                                              \
+    X(NUMBER_SP, "Number ")                                                                        \
+    X(PERFORMAPAL_SP, "Performapal ")                                                              \
+    X(ODD_EYES_SP, "Odd-Eyes ")                                                                    \
+    X(GALAXY_EYES_SP, "Galaxy-Eyes ")                                                              \
+    X(BLACKWING_SP, "Blackwing - ")                                                                \
+    X(GLADIATOR_BEAST_SP, "Gladiator Beast ")                                                      \
+    X(LIGHTSWORN_SP, "Lightsworn ")                                                                \
+    X(SIX_SAMURAI, "Six Samurai")                                                                  \
+    X(SHADDOLL_SP, "Shaddoll ")                                                                    \
+    X(SKY_STRIKER_SP, "Sky Striker ")                                                              \
+    X(RAIDRAPTOR_SP, "Raidraptor - ")                                                              \
+    X(GEM_KNIGHT_SP, "Gem-Knight ")                                                                \
+    X(ANCIENT_SP, "Ancient ")                                                                      \
+    X(GEAR, "Gear")                                                                                \
+    X(MACHINE, "Machine")                                                                          \
+    X(FIEND, "Fiend")                                                                              \
+    X(BEAST, "Beast")                                                                              \
+    X(SPIRIT, "Spirit")                                                                            \
+    X(LORD, "Lord")                                                                                \
+    X(KING, "King")                                                                                \
+    X(FUSION, "Fusion")                                                                            \
+    X(RITUAL_SP, "Ritual ")                                                                        \
+    X(SYNCHRO, "Synchro")                                                                          \
+    X(XYZ_SP, "Xyz ")                                                                              \
+    X(LINK, "Link")                                                                                \
+    X(PENDULUM, "Pendulum")                                                                        \
+    X(CHAOS, "Chaos")                                                                              \
+    X(PHOTON, "Photon")                                                                            \
+    X(STAR, "Star")                                                                                \
+    X(DUST, "Dust")                                                                                \
+    X(CRYSTAL, "Crystal")                                                                          \
+    X(SHADOW, "Shadow")                                                                            \
+    X(MYSTIC, "Mystic")                                                                            \
+    X(MAGICAL_SP, "Magical ")                                                                      \
+    X(MAGIC, "Magic")                                                                              \
+    X(HOLE, "Hole")                                                                                \
+    X(TRAP, "Trap")                                                                                \
+    X(SPELL, "Spell")                                                                              \
+    X(MONSTER, "Monster")                                                                          \
+    X(STORM, "Storm")                                                                              \
+    X(FIRE, "Fire")                                                                                \
+    X(WATER, "Water")                                                                              \
+    X(WIND, "Wind")                                                                                \
+    X(EARTH, "Earth")                                                                              \
+    X(LIGHT, "Light")                                                                              \
+    X(THUNDER, "Thunder")                                                                          \
+    X(POWER, "Power")                                                                              \
+    X(SWORD, "Sword")                                                                              \
+    X(SOUL, "Soul")                                                                                \
+    X(ARMOR, "Armor")                                                                              \
+    X(GOLD, "Gold")                                                                                \
+    X(SACRED, "Sacred")                                                                            \
+    X(PHOENIX, "Phoenix")                                                                          \
+    X(WING, "Wing")                                                                                \
+    X(GUARDIAN, "Guardian")                                                                        \
+    X(SOLDIER, "Soldier")                                                                          \
+    X(FORCE, "Force")                                                                              \
+    X(CALL, "Call")                                                                                \
+    X(BURNING, "Burning")                                                                          \
+    X(ABYSS, "Abyss")                                                                              \
+    X(GHOST, "Ghost")                                                                              \
+    X(KAIJU, "Kaiju")                                                                              \
+    X(DINO, "Dino")                                                                                \
+    X(MONARCH, "Monarch")                                                                          \
+    X(SUPER, "Super")                                                                              \
+    X(DIMENSION, "Dimension")                                                                      \
+    X(HEAVY, "Heavy")                                                                              \
+    X(GREAT, "Great")                                                                              \
+    X(DESTRUCTION, "Destruction")                                                                  \
+    X(HARPIE, "Harpie")                                                                            \
+    X(BLADE, "Blade")                                                                              \
+    X(GIRL, "Girl")                                                                                \
+    X(MIRROR, "Mirror")                                                                            \
+    X(JUDGMENT, "Judgment")                                                                        \
+    X(RULER, "Ruler")                                                                              \
+    X(SOLEMN, "Solemn")                                                                            \
+    X(CYCLONE, "Cyclone")                                                                          \
+    X(SARCOPHAGUS, "Sarcophagus")                                                                  \
+    X(LADY, "Lady")                                                                                \
+    X(JUNK, "Junk")                                                                                \
+    X(EMPEROR, "Emperor")                                                                          \
+    X(ULTIMATE, "Ultimate")                                                                        \
+    X(SPELLBOOK, "Spellbook")                                                                      \
+    X(BURIAL, "Burial")                                                                            \
+    X(TALKER, "Talker")                                                                            \
+    X(KNIGHTMARE, "Knightmare")                                                                    \
+    X(SP_THE_SP, " the ")                                                                          \
+    X(SP_OF_SP, " of ")                                                                            \
+    X(AMP, " & ")                                                                                  \
+    X(DASH, " - ")                                                                                 \
+    X(COMMA, ", ")                                                                                 \
+    X(TION, "tion")                                                                                \
+    X(ING, "ing")                                                                                  \
+    X(ER_SP, "er ")                                                                                \
+    X(ER, "er")                                                                                    \
+    X(THE_SP, "the ")                                                                              \
+    X(AN, "an")                                                                                    \
+    X(AR, "ar")                                                                                    \
+    X(ON, "on")                                                                                    \
+    X(IN, "in")                                                                                    \
+    X(RE, "re")                                                                                    \
+    X(OR, "or")                                                                                    \
+    X(EN, "en")                                                                                    \
+    X(ST, "st")                                                                                    \
+    X(LL, "ll")                                                                                    \
+    X(RA, "ra")                                                                                    \
+    X(CH, "ch")                                                                                    \
+    X(AL, "al")                                                                                    \
+    X(OU, "ou")                                                                                    \
+    X(SH, "Sh")                                                                                    \
+    X(ES, "es")                                                                                    \
+    X(LE, "le")
+
+
+#define _YGO_NAME_WORD_STR(id, str) static const char _ygo_name_word_##id[] YGO_FLASH = str;
+#define _YGO_NAME_WORD_PTR(id, str) _ygo_name_word_##id,
+#define _YGO_NAME_WORD_LEN(id, str) sizeof(str) - 1,
+
+YGO_NAME_WORD_DEFS(_YGO_NAME_WORD_STR)
+
+static const char *const _ygo_name_words[] YGO_FLASH = {YGO_NAME_WORD_DEFS(_YGO_NAME_WORD_PTR)};
+static const uint8_t _ygo_name_word_len[] YGO_FLASH = {YGO_NAME_WORD_DEFS(_YGO_NAME_WORD_LEN)};
+
+#define YGO_NAME_WORD_COUNT (sizeof(_ygo_name_word_len))
+#define YGO_NAME_ESCAPE 0x00
+#define YGO_NAME_WORD_BASE 0x80
+
+static_assert(YGO_NAME_WORD_COUNT == 0x100 - YGO_NAME_WORD_BASE, "dictionary must fill 0x80-0xFF");
+
+// Marks a position which is encoded as a literal rather than a word.
+#define YGO_NAME_LITERAL 0xFF
+
+size_t ygo_name_pack(uint8_t *dest, size_t dest_len, const char *name, size_t max_len) {
+    if (name == NULL) return 0;
+    if (max_len > YGO_CARD_NAME_MAX_LEN) max_len = YGO_CARD_NAME_MAX_LEN;
+
+    size_t n = 0;
+    while (n < max_len && name[n] != '\0') {
+        n++;
+    }
+
+    // Shortest encoding of name[i..n] is cost[i] bytes, starting with choice[i]. Filled in from
+    // the end, so each position only has to look at the ones after it.
+    uint8_t cost[YGO_CARD_NAME_MAX_LEN + 1];
+    uint8_t choice[YGO_CARD_NAME_MAX_LEN];
+    cost[n] = 0;
+
+    for (size_t i = n; i-- > 0;) {
+        uint8_t c = (uint8_t)name[i];
+        cost[i] = (uint8_t)(((c < YGO_NAME_WORD_BASE) ? 1 : 2) + cost[i + 1]);
+        choice[i] = YGO_NAME_LITERAL;
+
+        for (uint8_t k = 0; k < YGO_NAME_WORD_COUNT; k++) {
+            const char *word = (const char *)ygo_flash_read_ptr(&_ygo_name_words[k]);
+            size_t word_len = ygo_flash_read_byte(&_ygo_name_word_len[k]);
+
+            if (word_len > n - i || 1 + cost[i + word_len] >= cost[i]) continue;
+            if ((char)ygo_flash_read_byte(word) != name[i]) continue;
+            if (ygo_flash_memcmp(name + i, word, word_len) != 0) continue;
+
+            cost[i] = (uint8_t)(1 + cost[i + word_len]);
+            choice[i] = k;
+        }
+    }
+
+    if (dest == NULL || cost[0] > dest_len) return cost[0];
+
+    size_t ptr = 0;
+    for (size_t i = 0; i < n;) {
+        uint8_t c = (uint8_t)name[i];
+        if (choice[i] != YGO_NAME_LITERAL) {
+            dest[ptr++] = (uint8_t)(YGO_NAME_WORD_BASE + choice[i]);
+            i += ygo_flash_read_byte(&_ygo_name_word_len[choice[i]]);
+            continue;
+        }
+
+        if (c >= YGO_NAME_WORD_BASE) dest[ptr++] = YGO_NAME_ESCAPE;
+        dest[ptr++] = c;
+        i++;
+    }
+
+    return ptr;
+}
+
+ygo_bin_errno_t ygo_name_unpack(char *name, size_t len, const uint8_t *src, size_t n) {
+    if (name == NULL || (src == NULL && n > 0)) return YGO_BIN_ERR_BAD_ARGS;
+
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    size_t ptr = 0;
+
+    // Anything past len is dropped, same as ygo_bin_read_lstr() does.
+    for (size_t i = 0; i < n && ptr < len; i++) {
+        uint8_t c = src[i];
+
+        if (c >= YGO_NAME_WORD_BASE) {
+            uint8_t k = (uint8_t)(c - YGO_NAME_WORD_BASE);
+            const char *word = (const char *)ygo_flash_read_ptr(&_ygo_name_words[k]);
+            size_t word_len = ygo_flash_read_byte(&_ygo_name_word_len[k]);
+            if (word_len > len - ptr) word_len = len - ptr;
+
+            ygo_flash_memcpy(name + ptr, word, word_len);
+            ptr += word_len;
+            continue;
+        }
+
+        if (c == YGO_NAME_ESCAPE) {
+            if (++i == n) {
+                err = YGO_BIN_ERR_TRUNCATED;
+                break;
+            }
+            c = src[i];
+        }
+        name[ptr++] = (char)c;
+    }
+
+    memset(name + ptr, 0, len - ptr);
+    return err;
+}
@@ -0,0 +1,765 @@
+/**
+ * @file ygo_roaring.c
+ * @brief Roaring-style compressed bitmaps: array, bitmap and run containers, set operations.
+ *
+ * Host-only (YGO_BUILD_HOST). Binary operations walk both container lists by key like a merge and
+ * build the result in a fresh bitmap, which only replaces dest once complete, so dest may be one
+ * of the operands and is never left half-written.
+ */
+
+#include "ygo_roaring.h"
+#include <stdlib.h>
+
+typedef enum {
+    YGO_ROARING_OP_AND,
+    YGO_ROARING_OP_OR,
+    YGO_ROARING_OP_ANDNOT,
+} _ygo_roaring_op_t;
+
+void ygo_roaring_init(ygo_roaring_t *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+void ygo_roaring_free(ygo_roaring_t *r) {
+    if (r == NULL) return;
+    for (uint32_t i = 0; i < r->n; i++) {
+        // All kinds share the pointer.
+        free(r->containers[i].array);
+    }
+    free(r->containers);
+    ygo_roaring_init(r);
+}
+
+/**
+ * Position of the container with key, or where it would have to be inserted.
+ */
+static uint32_t _ygo_roaring_find(const ygo_roaring_t *r, uint16_t key, int *found) {
+    uint32_t lo = 0;
+    uint32_t hi = r->n;
+
+    // Rows mostly come in ascending order, which lands past the last container.
+    if (r->n > 0 && r->containers[r->n - 1].key < key) lo = r->n;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (r->containers[mid].key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *found = lo < r->n && r->containers[lo].key == key;
+    return lo;
+}
+
+/**
+ * Insert an empty ARRAY container for key at pos.
+ * @return The container, or NULL if there is no memory for it
+ */
+static ygo_roaring_container_t *_ygo_roaring_insert(ygo_roaring_t *r, uint32_t pos, uint16_t key) {
+    if (r->n == r->capacity) {
+        uint32_t capacity = r->capacity > 0 ? 2 * r->capacity : 4;
+        ygo_roaring_container_t *containers = (ygo_roaring_container_t *)realloc(
+            r->containers, capacity * sizeof(ygo_roaring_container_t));
+        if (containers == NULL) return NULL;
+        r->containers = containers;
+        r->capacity = capacity;
+    }
+
+    ygo_roaring_container_t *c = &r->containers[pos];
+    memmove(c + 1, c, (r->n - pos) * sizeof(ygo_roaring_container_t));
+    r->n++;
+
+    memset(c, 0, sizeof(*c));
+    c->key = key;
+    c->kind = YGO_ROARING_ARRAY;
+    return c;
+}
+
+static inline int _ygo_roaring_test(const uint64_t *words, uint16_t value) {
+    return (int)((words[value / 64] >> (value % 64)) & 1u);
+}
+
+static inline void _ygo_roaring_set(uint64_t *words, uint16_t value) {
+    words[value / 64] |= 1ull << (value % 64);
+}
+
+static ygo_bin_errno_t _ygo_roaring_to_bitmap(ygo_roaring_container_t *c) {
+    uint64_t *words = (uint64_t *)calloc(YGO_ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if (words == NULL) return YGO_BIN_ERR_NO_MEMORY;
+
+    for (uint32_t i = 0; i < c->cardinality; i++) {
+        _ygo_roaring_set(words, c->array[i]);
+    }
+    free(c->array);
+    c->words = words;
+    c->kind = YGO_ROARING_BITMAP;
+    c->capacity = 0;
+    return YGO_BIN_OK;
+}
+
+/**
+ * Set the values first to last, both included.
+ */
+static void _ygo_roaring_set_range(uint64_t *words, uint32_t first, uint32_t last) {
+    uint64_t head = ~0ull << (first % 64);
+    uint64_t tail = ~0ull >> (63 - last % 64);
+    if (first / 64 == last / 64) {
+        words[first / 64] |= head & tail;
+        return;
+    }
+    words[first / 64] |= head;
+    for (uint32_t w = first / 64 + 1; w < last / 64; w++) {
+        words[w] = ~0ull;
+    }
+    words[last / 64] |= tail;
+}
+
+/**
+ * Runs of an ARRAY or BITMAP container, written to runs as first and last value unless it is NULL.
+ * @return Number of runs
+ */
+static uint32_t _ygo_roaring_find_runs(const ygo_roaring_container_t *c, uint16_t *runs) {
+    uint32_t n = 0;
+    if (c->kind == YGO_ROARING_ARRAY) {
+        for (uint32_t i = 0; i < c->cardinality; i++) {
+            if (i > 0 && c->array[i] == c->array[i - 1] + 1) {
+                if (runs != NULL) runs[2 * n - 1] = c->array[i];
+                continue;
+            }
+            if (runs != NULL) runs[2 * n] = runs[2 * n + 1] = c->array[i];
+            n++;
+        }
+        return n;
+    }
+
+    // A run starts at a set bit whose lower neighbour is clear, and ends at one whose upper
+    // neighbour is clear. Starts and ends alternate, so they are written as they come.
+    uint32_t ends = 0;
+    for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+        uint64_t word = c->words[w];
+        uint64_t below = w > 0 ? c->words[w - 1] >> 63 : 0;
+        uint64_t above = w + 1 < YGO_ROARING_BITMAP_WORDS ? c->words[w + 1] << 63 : 0;
+        uint64_t starts = word & ~((word << 1) | below);
+        if (runs == NULL) {
+            n += ygo_popcount64(starts);
+            continue;
+        }
+        for (uint64_t bits = starts; bits != 0; bits &= bits - 1) {
+            runs[2 * n++] = (uint16_t)(w * 64 + ygo_ctz64(bits));
+        }
+        for (uint64_t bits = word & ~((word >> 1) | above); bits != 0; bits &= bits - 1) {
+            runs[2 * ends++ + 1] = (uint16_t)(w * 64 + ygo_ctz64(bits));
+        }
+    }
+    return n;
+}
+
+/**
+ * Turn a RUN container back into an ARRAY, or a BITMAP if it holds too many values.
+ */
+static ygo_bin_errno_t _ygo_roaring_from_runs(ygo_roaring_container_t *c) {
+    if (c->cardinality > YGO_ROARING_ARRAY_MAX) {
+        uint64_t *words = (uint64_t *)calloc(YGO_ROARING_BITMAP_WORDS, sizeof(uint64_t));
+        if (words == NULL) return YGO_BIN_ERR_NO_MEMORY;
+        for (uint32_t i = 0; i < c->capacity; i++) {
+            _ygo_roaring_set_range(words, c->runs[2 * i], c->runs[2 * i + 1]);
+        }
+        free(c->runs);
+        c->words = words;
+        c->kind = YGO_ROARING_BITMAP;
+        c->capacity = 0;
+        return YGO_BIN_OK;
+    }
+
+    uint16_t *array = (uint16_t *)malloc((c->cardinality + 1) * sizeof(uint16_t));
+    if (array == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < c->capacity; i++) {
+        for (uint32_t value = c->runs[2 * i]; value <= c->runs[2 * i + 1]; value++) {
+            array[n++] = (uint16_t)value;
+        }
+    }
+    free(c->runs);
+    c->array = array;
+    c->kind = YGO_ROARING_ARRAY;
+    c->capacity = c->cardinality;
+    return YGO_BIN_OK;
+}
+
+/**
+ * A container as it is, or a RUN read into a BITMAP view whose words are tmp.
+ */
+static const ygo_roaring_container_t *_ygo_roaring_view(const ygo_roaring_container_t *c,
+                                                        ygo_roaring_container_t *view,
+                                                        uint64_t *tmp) {
+    if (c->kind != YGO_ROARING_RUN) return c;
+
+    memset(tmp, 0, YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    for (uint32_t i = 0; i < c->capacity; i++) {
+        _ygo_roaring_set_range(tmp, c->runs[2 * i], c->runs[2 * i + 1]);
+    }
+    *view = *c;
+    view->kind = YGO_ROARING_BITMAP;
+    view->capacity = 0;
+    view->words = tmp;
+    return view;
+}
+
+/**
+ * Lower bound of value in a sorted array.
+ */
+static uint32_t _ygo_roaring_search(const uint16_t *array, uint32_t n, uint16_t value) {
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (array[mid] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+ygo_bin_errno_t ygo_roaring_add(ygo_roaring_t *r, uint32_t row) {
+    if (r == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    uint16_t key = (uint16_t)(row >> 16u);
+    uint16_t value = (uint16_t)row;
+
+    int found;
+    uint32_t pos = _ygo_roaring_find(r, key, &found);
+    ygo_roaring_container_t *c = found ? &r->containers[pos] : _ygo_roaring_insert(r, pos, key);
+    if (c == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    if (c->kind == YGO_ROARING_RUN) {
+        ygo_bin_errno_t err = _ygo_roaring_from_runs(c);
+        if (err != YGO_BIN_OK) return err;
+    }
+
+    if (c->kind == YGO_ROARING_ARRAY) {
+        uint32_t at = c->cardinality > 0 && c->array[c->cardinality - 1] < value
+                          ? c->cardinality
+                          : _ygo_roaring_search(c->array, c->cardinality, value);
+        if (at < c->cardinality && c->array[at] == value) return YGO_BIN_OK;
+
+        if (c->cardinality == YGO_ROARING_ARRAY_MAX) {
+            ygo_bin_errno_t err = _ygo_roaring_to_bitmap(c);
+            if (err != YGO_BIN_OK) return err;
+        } else {
+            if (c->cardinality == c->capacity) {
+                uint32_t capacity = c->capacity > 0 ? 2 * c->capacity : 4;
+                if (capacity > YGO_ROARING_ARRAY_MAX) capacity = YGO_ROARING_ARRAY_MAX;
+                uint16_t *array = (uint16_t *)realloc(c->array, capacity * sizeof(uint16_t));
+                if (array == NULL) return YGO_BIN_ERR_NO_MEMORY;
+                c->array = array;
+                c->capacity = capacity;
+            }
+            memmove(c->array + at + 1, c->array + at, (c->cardinality - at) * sizeof(uint16_t));
+            c->array[at] = value;
+            c->cardinality++;
+            return YGO_BIN_OK;
+        }
+    }
+
+    if (!_ygo_roaring_test(c->words, value)) {
+        _ygo_roaring_set(c->words, value);
+        c->cardinality++;
+    }
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_roaring_optimize(ygo_roaring_t *r) {
+    if (r == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    for (uint32_t i = 0; i < r->n; i++) {
+        ygo_roaring_container_t *c = &r->containers[i];
+        if (c->kind == YGO_ROARING_RUN) continue;
+
+        uint32_t n = _ygo_roaring_find_runs(c, NULL);
+        size_t size = c->kind == YGO_ROARING_ARRAY ? c->cardinality * sizeof(uint16_t)
+                                                   : YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        if (n * 2 * sizeof(uint16_t) >= size) continue;
+
+        uint16_t *runs = (uint16_t *)malloc(n * 2 * sizeof(uint16_t));
+        if (runs == NULL) return YGO_BIN_ERR_NO_MEMORY;
+        _ygo_roaring_find_runs(c, runs);
+        free(c->array);
+        c->runs = runs;
+        c->kind = YGO_ROARING_RUN;
+        c->capacity = n;
+    }
+    return YGO_BIN_OK;
+}
+
+int ygo_roaring_contains(const ygo_roaring_t *r, uint32_t row) {
+    if (r == NULL) return 0;
+    int found;
+    uint32_t pos = _ygo_roaring_find(r, (uint16_t)(row >> 16u), &found);
+    if (!found) return 0;
+
+    const ygo_roaring_container_t *c = &r->containers[pos];
+    uint16_t value = (uint16_t)row;
+    if (c->kind == YGO_ROARING_BITMAP) return _ygo_roaring_test(c->words, value);
+    if (c->kind == YGO_ROARING_RUN) {
+        // The last run starting at or before value.
+        uint32_t lo = 0, hi = c->capacity;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (c->runs[2 * mid] <= value) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo > 0 && value <= c->runs[2 * lo - 1];
+    }
+
+    uint32_t at = _ygo_roaring_search(c->array, c->cardinality, value);
+    return at < c->cardinality && c->array[at] == value;
+}
+
+size_t ygo_roaring_cardinality(const ygo_roaring_t *r) {
+    size_t cardinality = 0;
+    for (uint32_t i = 0; r != NULL && i < r->n; i++) {
+        cardinality += r->containers[i].cardinality;
+    }
+    return cardinality;
+}
+
+/////
+
+/**
+ * Append a container for key holding n values of a malloc'd sorted array, which it takes over.
+ * Empty results are dropped, too many values become a BITMAP.
+ */
+static ygo_bin_errno_t _ygo_roaring_push_array(ygo_roaring_t *r,
+                                               uint16_t key,
+                                               uint16_t *array,
+                                               uint32_t n) {
+    ygo_roaring_container_t *c = n > 0 ? _ygo_roaring_insert(r, r->n, key) : NULL;
+    if (c == NULL) {
+        free(array);
+        return n > 0 ? YGO_BIN_ERR_NO_MEMORY : YGO_BIN_OK;
+    }
+
+    c->array = array;
+    c->cardinality = n;
+    c->capacity = n;
+    return n > YGO_ROARING_ARRAY_MAX ? _ygo_roaring_to_bitmap(c) : YGO_BIN_OK;
+}
+
+/**
+ * Append a container for key from malloc'd BITMAP words, which it takes over. Sparse results are
+ * turned into an ARRAY.
+ */
+static ygo_bin_errno_t _ygo_roaring_push_words(ygo_roaring_t *r, uint16_t key, uint64_t *words) {
+    uint32_t n = 0;
+    for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+        n += ygo_popcount64(words[w]);
+    }
+
+    if (n <= YGO_ROARING_ARRAY_MAX) {
+        uint16_t *array = n > 0 ? (uint16_t *)malloc(n * sizeof(uint16_t)) : NULL;
+        if (n > 0 && array == NULL) {
+            free(words);
+            return YGO_BIN_ERR_NO_MEMORY;
+        }
+
+        uint32_t i = 0;
+        for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                array[i++] = (uint16_t)(w * 64 + ygo_ctz64(bits));
+            }
+        }
+        free(words);
+        return _ygo_roaring_push_array(r, key, array, n);
+    }
+
+    ygo_roaring_container_t *c = _ygo_roaring_insert(r, r->n, key);
+    if (c == NULL) {
+        free(words);
+        return YGO_BIN_ERR_NO_MEMORY;
+    }
+    c->kind = YGO_ROARING_BITMAP;
+    c->words = words;
+    c->cardinality = n;
+    return YGO_BIN_OK;
+}
+
+static ygo_bin_errno_t _ygo_roaring_push_copy(ygo_roaring_t *r, const ygo_roaring_container_t *c) {
+    if (c->kind == YGO_ROARING_RUN) {
+        uint16_t *runs = (uint16_t *)malloc(c->capacity * 2 * sizeof(uint16_t));
+        if (runs == NULL) return YGO_BIN_ERR_NO_MEMORY;
+        memcpy(runs, c->runs, c->capacity * 2 * sizeof(uint16_t));
+        ygo_roaring_container_t *copy = _ygo_roaring_insert(r, r->n, c->key);
+        if (copy == NULL) {
+            free(runs);
+            return YGO_BIN_ERR_NO_MEMORY;
+        }
+        copy->kind = YGO_ROARING_RUN;
+        copy->runs = runs;
+        copy->cardinality = c->cardinality;
+        copy->capacity = c->capacity;
+        return YGO_BIN_OK;
+    }
+    if (c->kind == YGO_ROARING_BITMAP) {
+        uint64_t *words = (uint64_t *)malloc(YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        if (words == NULL) return YGO_BIN_ERR_NO_MEMORY;
+        memcpy(words, c->words, YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        return _ygo_roaring_push_words(r, c->key, words);
+    }
+
+    uint16_t *array = (uint16_t *)malloc((c->cardinality + 1) * sizeof(uint16_t));
+    if (array == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    memcpy(array, c->array, c->cardinality * sizeof(uint16_t));
+    return _ygo_roaring_push_array(r, c->key, array, c->cardinality);
+}
+
+/**
+ * Words of a container, expanded into tmp if it is an ARRAY.
+ */
+static const uint64_t *_ygo_roaring_words(const ygo_roaring_container_t *c, uint64_t *tmp) {
+    if (c->kind == YGO_ROARING_BITMAP) return c->words;
+
+    memset(tmp, 0, YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    for (uint32_t i = 0; i < c->cardinality; i++) {
+        _ygo_roaring_set(tmp, c->array[i]);
+    }
+    return tmp;
+}
+
+/**
+ * Merge two sorted arrays into out, which must have room for the result.
+ * @return Number of values written
+ */
+static uint32_t _ygo_roaring_merge(const uint16_t *a,
+                                   uint32_t na,
+                                   const uint16_t *b,
+                                   uint32_t nb,
+                                   _ygo_roaring_op_t op,
+                                   uint16_t *out) {
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            if (op != YGO_ROARING_OP_AND) out[n++] = a[i];
+            i++;
+        } else if (b[j] < a[i]) {
+            if (op == YGO_ROARING_OP_OR) out[n++] = b[j];
+            j++;
+        } else {
+            if (op != YGO_ROARING_OP_ANDNOT) out[n++] = a[i];
+            i++;
+            j++;
+        }
+    }
+
+    if (op != YGO_ROARING_OP_AND) {
+        while (i < na) {
+            out[n++] = a[i++];
+        }
+    }
+    if (op == YGO_ROARING_OP_OR) {
+        while (j < nb) {
+            out[n++] = b[j++];
+        }
+    }
+    return n;
+}
+
+static ygo_bin_errno_t _ygo_roaring_op_containers(ygo_roaring_t *out,
+                                                  const ygo_roaring_container_t *a,
+                                                  const ygo_roaring_container_t *b,
+                                                  _ygo_roaring_op_t op) {
+    uint64_t tmp_a[YGO_ROARING_BITMAP_WORDS];
+    uint64_t tmp_b[YGO_ROARING_BITMAP_WORDS];
+    ygo_roaring_container_t view_a, view_b;
+    a = _ygo_roaring_view(a, &view_a, tmp_a);
+    b = _ygo_roaring_view(b, &view_b, tmp_b);
+
+    // Array results which can only be smaller than the array going in.
+    int a_array = a->kind == YGO_ROARING_ARRAY;
+    int b_array = b->kind == YGO_ROARING_ARRAY;
+
+    if ((a_array && b_array) || (a_array && op != YGO_ROARING_OP_OR) ||
+        (b_array && op == YGO_ROARING_OP_AND)) {
+        uint32_t max = a_array ? a->cardinality : 0;
+        if (op == YGO_ROARING_OP_OR) max += b->cardinality;
+        if (op == YGO_ROARING_OP_AND && b_array && (!a_array || b->cardinality < max)) {
+            max = b->cardinality;
+        }
+
+        uint16_t *array = (uint16_t *)malloc((max + 1) * sizeof(uint16_t));
+        if (array == NULL) return YGO_BIN_ERR_NO_MEMORY;
+
+        uint32_t n = 0;
+        if (a_array && b_array) {
+            n = _ygo_roaring_merge(a->array, a->cardinality, b->array, b->cardinality, op, array);
+        } else {
+            // One side is a BITMAP, keep the array's values it (doesn't) have.
+            const ygo_roaring_container_t *list = a_array ? a : b;
+            const uint64_t *words = a_array ? b->words : a->words;
+            int keep = op == YGO_ROARING_OP_AND;
+            for (uint32_t i = 0; i < list->cardinality; i++) {
+                if (_ygo_roaring_test(words, list->array[i]) == keep) array[n++] = list->array[i];
+            }
+        }
+        return _ygo_roaring_push_array(out, a->key, array, n);
+    }
+
+    // A RUN view is a BITMAP already, so tmp_a and tmp_b are only reused for arrays.
+    const uint64_t *wa = _ygo_roaring_words(a, tmp_a);
+    const uint64_t *wb = _ygo_roaring_words(b, tmp_b);
+
+    uint64_t *words = (uint64_t *)malloc(YGO_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (words == NULL) return YGO_BIN_ERR_NO_MEMORY;
+
+    for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+        switch (op) {
+        case YGO_ROARING_OP_AND: words[w] = wa[w] & wb[w]; break;
+        case YGO_ROARING_OP_OR: words[w] = wa[w] | wb[w]; break;
+        default: words[w] = wa[w] & ~wb[w]; break;
+        }
+    }
+    return _ygo_roaring_push_words(out, a->key, words);
+}
+
+static ygo_bin_errno_t _ygo_roaring_op(ygo_roaring_t *dest,
+                                       const ygo_roaring_t *a,
+                                       const ygo_roaring_t *b,
+                                       _ygo_roaring_op_t op) {
+    if (dest == NULL || a == NULL || b == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    ygo_roaring_t out;
+    ygo_roaring_init(&out);
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    uint32_t i = 0, j = 0;
+
+    while (err == YGO_BIN_OK && (i < a->n || (j < b->n && op == YGO_ROARING_OP_OR))) {
+        const ygo_roaring_container_t *ca = i < a->n ? &a->containers[i] : NULL;
+        const ygo_roaring_container_t *cb = j < b->n ? &b->containers[j] : NULL;
+
+        if (cb == NULL || (ca != NULL && ca->key < cb->key)) {
+            if (op != YGO_ROARING_OP_AND) err = _ygo_roaring_push_copy(&out, ca);
+            i++;
+        } else if (ca == NULL || cb->key < ca->key) {
+            if (op == YGO_ROARING_OP_OR) err = _ygo_roaring_push_copy(&out, cb);
+            j++;
+        } else {
+            err = _ygo_roaring_op_containers(&out, ca, cb, op);
+            i++;
+            j++;
+        }
+    }
+
+    // Only now, dest may be one of the operands.
+    ygo_roaring_free(dest);
+    if (err != YGO_BIN_OK) {
+        ygo_roaring_free(&out);
+        return err;
+    }
+    *dest = out;
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_roaring_and(ygo_roaring_t *dest,
+                                const ygo_roaring_t *a,
+                                const ygo_roaring_t *b) {
+    return _ygo_roaring_op(dest, a, b, YGO_ROARING_OP_AND);
+}
+
+ygo_bin_errno_t ygo_roaring_or(ygo_roaring_t *dest,
+                               const ygo_roaring_t *a,
+                               const ygo_roaring_t *b) {
+    return _ygo_roaring_op(dest, a, b, YGO_ROARING_OP_OR);
+}
+
+ygo_bin_errno_t ygo_roaring_andnot(ygo_roaring_t *dest,
+                                   const ygo_roaring_t *a,
+                                   const ygo_roaring_t *b) {
+    return _ygo_roaring_op(dest, a, b, YGO_ROARING_OP_ANDNOT);
+}
+
+/**
+ * Number of values of a RUN container also in another container of any kind.
+ */
+static size_t _ygo_roaring_run_and_cardinality(const ygo_roaring_container_t *run,
+                                               const ygo_roaring_container_t *c) {
+    size_t n = 0;
+    if (c->kind == YGO_ROARING_BITMAP) {
+        for (uint32_t i = 0; i < run->capacity; i++) {
+            uint32_t first = run->runs[2 * i], last = run->runs[2 * i + 1];
+            uint64_t head = ~0ull << (first % 64);
+            uint64_t tail = ~0ull >> (63 - last % 64);
+            if (first / 64 == last / 64) {
+                n += ygo_popcount64(c->words[first / 64] & head & tail);
+                continue;
+            }
+            n += ygo_popcount64(c->words[first / 64] & head);
+            for (uint32_t w = first / 64 + 1; w < last / 64; w++) {
+                n += ygo_popcount64(c->words[w]);
+            }
+            n += ygo_popcount64(c->words[last / 64] & tail);
+        }
+    } else if (c->kind == YGO_ROARING_ARRAY) {
+        uint32_t i = 0;
+        for (uint32_t x = 0; x < c->cardinality && i < run->capacity; x++) {
+            while (i < run->capacity && run->runs[2 * i + 1] < c->array[x]) i++;
+            n += i < run->capacity && run->runs[2 * i] <= c->array[x];
+        }
+    } else {
+        // Overlaps of two lists of runs, stepping past whichever ends first.
+        uint32_t i = 0, j = 0;
+        while (i < run->capacity && j < c->capacity) {
+            uint32_t first = run->runs[2 * i] > c->runs[2 * j] ? run->runs[2 * i] : c->runs[2 * j];
+            uint32_t last_i = run->runs[2 * i + 1], last_j = c->runs[2 * j + 1];
+            uint32_t last = last_i < last_j ? last_i : last_j;
+            if (first <= last) n += last - first + 1;
+            i += last_i <= last_j;
+            j += last_j <= last_i;
+        }
+    }
+    return n;
+}
+
+size_t ygo_roaring_and_cardinality(const ygo_roaring_t *a, const ygo_roaring_t *b) {
+    if (a == NULL || b == NULL) return 0;
+    size_t n = 0;
+    uint32_t i = 0, j = 0;
+
+    while (i < a->n && j < b->n) {
+        const ygo_roaring_container_t *ca = &a->containers[i];
+        const ygo_roaring_container_t *cb = &b->containers[j];
+        if (ca->key != cb->key) {
+            if (ca->key < cb->key) {
+                i++;
+            } else {
+                j++;
+            }
+            continue;
+        }
+
+        if (ca->kind == YGO_ROARING_RUN || cb->kind == YGO_ROARING_RUN) {
+            n += ca->kind == YGO_ROARING_RUN ? _ygo_roaring_run_and_cardinality(ca, cb)
+                                             : _ygo_roaring_run_and_cardinality(cb, ca);
+        } else if (ca->kind == YGO_ROARING_BITMAP && cb->kind == YGO_ROARING_BITMAP) {
+            for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+                n += ygo_popcount64(ca->words[w] & cb->words[w]);
+            }
+        } else if (ca->kind == YGO_ROARING_ARRAY && cb->kind == YGO_ROARING_ARRAY) {
+            uint32_t x = 0, y = 0;
+            while (x < ca->cardinality && y < cb->cardinality) {
+                uint16_t va = ca->array[x], vb = cb->array[y];
+                n += va == vb;
+                x += va <= vb;
+                y += vb <= va;
+            }
+        } else {
+            const ygo_roaring_container_t *list = ca->kind == YGO_ROARING_ARRAY ? ca : cb;
+            const uint64_t *words = ca->kind == YGO_ROARING_ARRAY ? cb->words : ca->words;
+            for (uint32_t x = 0; x < list->cardinality; x++) {
+                n += (size_t)_ygo_roaring_test(words, list->array[x]);
+            }
+        }
+        i++;
+        j++;
+    }
+    return n;
+}
+
+/////
+
+ygo_bin_errno_t ygo_roaring_from_words(ygo_roaring_t *r, const uint64_t *words, size_t count) {
+    if (r == NULL || (words == NULL && count > 0) || count > (size_t)UINT32_MAX + 1) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    ygo_roaring_free(r);
+
+    size_t total = (count + 63) / 64;
+    for (size_t start = 0; start < total; start += YGO_ROARING_BITMAP_WORDS) {
+        size_t n = total - start;
+        if (n > YGO_ROARING_BITMAP_WORDS) n = YGO_ROARING_BITMAP_WORDS;
+
+        uint64_t *chunk = (uint64_t *)calloc(YGO_ROARING_BITMAP_WORDS, sizeof(uint64_t));
+        if (chunk == NULL) {
+            ygo_roaring_free(r);
+            return YGO_BIN_ERR_NO_MEMORY;
+        }
+        memcpy(chunk, words + start, n * sizeof(uint64_t));
+        if (start + n == total && count % 64 != 0) chunk[n - 1] &= (1ull << (count % 64)) - 1;
+
+        uint16_t key = (uint16_t)(start / YGO_ROARING_BITMAP_WORDS);
+        ygo_bin_errno_t err = _ygo_roaring_push_words(r, key, chunk);
+        if (err != YGO_BIN_OK) {
+            ygo_roaring_free(r);
+            return err;
+        }
+    }
+    return YGO_BIN_OK;
+}
+
+void ygo_roaring_to_words(const ygo_roaring_t *r, uint64_t *words, size_t count) {
+    if (r == NULL || words == NULL) return;
+    size_t total = (count + 63) / 64;
+    memset(words, 0, total * sizeof(uint64_t));
+
+    for (uint32_t i = 0; i < r->n; i++) {
+        const ygo_roaring_container_t *c = &r->containers[i];
+        size_t start = (size_t)c->key * YGO_ROARING_BITMAP_WORDS;
+        if (start >= total) break;
+
+        if (c->kind == YGO_ROARING_BITMAP) {
+            size_t n = total - start;
+            if (n > YGO_ROARING_BITMAP_WORDS) n = YGO_ROARING_BITMAP_WORDS;
+            memcpy(words + start, c->words, n * sizeof(uint64_t));
+        } else if (c->kind == YGO_ROARING_RUN) {
+            for (uint32_t x = 0; x < c->capacity; x++) {
+                size_t first = ((size_t)c->key << 16u) | c->runs[2 * x];
+                size_t last = ((size_t)c->key << 16u) | c->runs[2 * x + 1];
+                if (first >= total * 64) break;
+                if (last >= total * 64) last = total * 64 - 1;
+                _ygo_roaring_set_range(words + start, (uint32_t)(first - start * 64),
+                                       (uint32_t)(last - start * 64));
+            }
+        } else {
+            for (uint32_t x = 0; x < c->cardinality; x++) {
+                size_t row = ((size_t)c->key << 16u) | c->array[x];
+                if (row >= total * 64) break;
+                words[row / 64] |= 1ull << (row % 64);
+            }
+        }
+    }
+
+    if (count % 64 != 0) words[total - 1] &= (1ull << (count % 64)) - 1;
+}
+
+size_t ygo_roaring_to_array(const ygo_roaring_t *r, uint32_t *rows) {
+    if (r == NULL || rows == NULL) return 0;
+    size_t n = 0;
+
+    for (uint32_t i = 0; i < r->n; i++) {
+        const ygo_roaring_container_t *c = &r->containers[i];
+        uint32_t high = (uint32_t)c->key << 16u;
+
+        if (c->kind == YGO_ROARING_ARRAY) {
+            for (uint32_t x = 0; x < c->cardinality; x++) {
+                rows[n++] = high | c->array[x];
+            }
+            continue;
+        }
+        if (c->kind == YGO_ROARING_RUN) {
+            for (uint32_t x = 0; x < c->capacity; x++) {
+                for (uint32_t value = c->runs[2 * x]; value <= c->runs[2 * x + 1]; value++) {
+                    rows[n++] = high | value;
+                }
+            }
+            continue;
+        }
+        for (uint32_t w = 0; w < YGO_ROARING_BITMAP_WORDS; w++) {
+            for (uint64_t bits = c->words[w]; bits != 0; bits &= bits - 1) {
+                rows[n++] = high | (w * 64 + ygo_ctz64(bits));
+            }
+        }
+    }
+    return n;
+}
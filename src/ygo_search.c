@@ -0,0 +1,627 @@
+/**
+ * @file ygo_search.c
+ * @brief Card name search index: folding, building, and trigram filtered fuzzy queries.
+ *
+ * Host-only (YGO_BUILD_HOST). A query counts, per entry, how many of its trigrams the entry's name
+ * has, keeps the entries with enough of them, and scores those with Myers' bit-parallel edit
+ * distance, which treats the whole query (up to 64 bytes) as one machine word per name byte.
+ */
+
+#include "ygo_search.h"
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define YGO_SEARCH_HAVE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && !defined(__AARCH64EB__)
+#define YGO_SEARCH_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+ENUM_IMPL(ygo_search_match, YGO_SEARCH_MATCH_DEFS);
+
+static const uint8_t _ygo_search_magic_word[] = YGO_SEARCH_MAGIC_WORD;
+
+// Byte offsets of the header fields, see ygo_search.h.
+#define YGO_SEARCH_OFFSET_VERSION 4
+#define YGO_SEARCH_OFFSET_FLAGS 6
+#define YGO_SEARCH_OFFSET_COUNT 8
+#define YGO_SEARCH_OFFSET_TEXT 12
+#define YGO_SEARCH_OFFSET_TEXT_LEN 16
+#define YGO_SEARCH_OFFSET_PREFIX 20
+#define YGO_SEARCH_OFFSET_PREFIX_COUNT 24
+#define YGO_SEARCH_OFFSET_TRIGRAMS 28
+#define YGO_SEARCH_OFFSET_TRIGRAM_COUNT 32
+#define YGO_SEARCH_OFFSET_POSTINGS 36
+#define YGO_SEARCH_OFFSET_POSTING_COUNT 40
+#define YGO_SEARCH_OFFSET_CRC 46
+
+#define YGO_SEARCH_GRAM 3
+#define YGO_SEARCH_MAX_ENTRIES (1u << 24)
+
+// U+00C0 - U+00FF (C3 80 - C3 BF in UTF-8) without accents, 0 for the two which aren't letters.
+static const char _ygo_search_latin1[64] = "aaaaaaaceeeeiiiidnooooo\0ouuuuyts"
+                                           "aaaaaaaceeeeiiiidnooooo\0ouuuuyty";
+
+size_t ygo_search_fold(char *dest, size_t dest_len, const char *name, size_t max_len) {
+    if (dest == NULL || name == NULL) return 0;
+    size_t n = 0;
+    int separate = 0;
+
+    for (size_t i = 0; i < max_len && name[i] != '\0'; i++) {
+        uint8_t c = (uint8_t)name[i];
+        uint8_t next = i + 1 < max_len ? (uint8_t)name[i + 1] : 0x00;
+        char out = 0;
+
+        if (c >= 'A' && c <= 'Z') {
+            out = (char)(c - 'A' + 'a');
+        } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            out = (char)c;
+        } else if (c == '\'') {
+            continue;
+        } else if (c == 0xE2 && next == 0x80 && i + 2 < max_len &&
+                   (name[i + 2] == '\x98' || name[i + 2] == '\x99')) {
+            i += 2; // Typographic apostrophes, U+2018 and U+2019
+            continue;
+        } else if (c == 0xC3 && next >= 0x80 && next <= 0xBF) {
+            out = _ygo_search_latin1[next - 0x80];
+            i++;
+        } else if (c >= 0x80) {
+            out = (char)c;
+        }
+
+        if (out == 0) {
+            separate = n > 0;
+            continue;
+        }
+        if (separate) {
+            if (n >= dest_len) break;
+            dest[n++] = ' ';
+            separate = 0;
+        }
+        if (n >= dest_len) break;
+        dest[n++] = out;
+    }
+    return n;
+}
+
+/**
+ * Distinct trigrams of text padded with a space on each side, ascending.
+ * @return Number of trigrams, at most len
+ */
+static size_t _ygo_search_trigrams(const char *text, size_t len, uint32_t *out) {
+    uint8_t padded[YGO_SEARCH_MAX_LEN + 2];
+    padded[0] = ' ';
+    memcpy(padded + 1, text, len);
+    padded[len + 1] = ' ';
+
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t trigram =
+            ((uint32_t)padded[i] << 16) | ((uint32_t)padded[i + 1] << 8) | padded[i + 2];
+        size_t pos = n;
+        while (pos > 0 && out[pos - 1] > trigram) {
+            pos--;
+        }
+        if (pos > 0 && out[pos - 1] == trigram) continue;
+        memmove(out + pos + 1, out + pos, (n - pos) * sizeof(uint32_t));
+        out[pos] = trigram;
+        n++;
+    }
+    return n;
+}
+
+typedef struct {
+    uint32_t id;
+    uint8_t len;
+    char text[YGO_SEARCH_MAX_LEN];
+} _ygo_search_name_t;
+
+typedef struct {
+    const char *text;
+    uint32_t len;
+    uint32_t value;
+} _ygo_search_word_t;
+
+static int _ygo_search_compare_names(const void *a, const void *b) {
+    const _ygo_search_name_t *x = (const _ygo_search_name_t *)a;
+    const _ygo_search_name_t *y = (const _ygo_search_name_t *)b;
+    if (x->id != y->id) return x->id < y->id ? -1 : 1;
+    if (x->len != y->len) return x->len < y->len ? -1 : 1;
+    return memcmp(x->text, y->text, x->len);
+}
+
+/**
+ * By the text from the word on, a word which is a prefix of another first, then by entry.
+ */
+static int _ygo_search_compare_words(const void *a, const void *b) {
+    const _ygo_search_word_t *x = (const _ygo_search_word_t *)a;
+    const _ygo_search_word_t *y = (const _ygo_search_word_t *)b;
+    int cmp = memcmp(x->text, y->text, x->len < y->len ? x->len : y->len);
+    if (cmp != 0) return cmp;
+    if (x->len != y->len) return x->len < y->len ? -1 : 1;
+    return x->value < y->value ? -1 : x->value > y->value;
+}
+
+static int _ygo_search_compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * Checksum of the header (up to the checksum itself) and of the sections, which end at end.
+ */
+static uint16_t _ygo_search_crc(const uint8_t *data, size_t end) {
+    uint16_t crc = ygo_bin_crc_init();
+    crc = ygo_bin_crc_update(crc, data, YGO_SEARCH_OFFSET_CRC);
+    crc = ygo_bin_crc_update(crc, data + YGO_SEARCH_HEADER_LEN, end - YGO_SEARCH_HEADER_LEN);
+    return ygo_bin_crc_final(crc);
+}
+
+size_t ygo_search_build(uint8_t *buffer, const ygo_card_t *cards, size_t n) {
+    if ((cards == NULL && n > 0) || n >= YGO_SEARCH_MAX_ENTRIES) return 0;
+
+    _ygo_search_name_t *names = (_ygo_search_name_t *)malloc((n + 1) * sizeof(*names));
+    _ygo_search_word_t *words = (_ygo_search_word_t *)malloc((n + 1) * sizeof(*words));
+    uint64_t *pairs = (uint64_t *)malloc((n + 1) * sizeof(*pairs));
+    size_t size = 0;
+    if (names == NULL || words == NULL || pairs == NULL) goto done;
+
+    for (size_t i = 0; i < n; i++) {
+        names[i].id = cards[i].id;
+        names[i].len = (uint8_t)ygo_search_fold(
+            names[i].text, YGO_SEARCH_MAX_LEN, cards[i].name, YGO_CARD_NAME_MAX_LEN);
+    }
+    qsort(names, n, sizeof(*names), _ygo_search_compare_names);
+
+    size_t count = 0, text_len = 0, word_count = 0, pair_count = 0;
+    size_t word_capacity = n + 1, pair_capacity = n + 1;
+    for (size_t i = 0; i < n; i++) {
+        if (count > 0 && _ygo_search_compare_names(&names[count - 1], &names[i]) == 0) continue;
+        _ygo_search_name_t *name = &names[count];
+        if (count != i) *name = names[i];
+        text_len += name->len;
+
+        for (size_t start = 0; start < name->len; start++) {
+            if (start > 0 && name->text[start - 1] != ' ') continue;
+            if (word_count == word_capacity) {
+                word_capacity *= 2;
+                void *grown = realloc(words, word_capacity * sizeof(*words));
+                if (grown == NULL) goto done;
+                words = (_ygo_search_word_t *)grown;
+            }
+            _ygo_search_word_t word = {name->text + start,
+                                       (uint32_t)(name->len - start),
+                                       (uint32_t)(count << 8 | start)};
+            words[word_count++] = word;
+        }
+
+        uint32_t trigrams[YGO_SEARCH_MAX_LEN];
+        size_t trigram_count = _ygo_search_trigrams(name->text, name->len, trigrams);
+        if (pair_count + trigram_count > pair_capacity) {
+            pair_capacity = 2 * pair_capacity + trigram_count;
+            void *grown = realloc(pairs, pair_capacity * sizeof(*pairs));
+            if (grown == NULL) goto done;
+            pairs = (uint64_t *)grown;
+        }
+        for (size_t t = 0; t < trigram_count; t++) {
+            pairs[pair_count++] = ((uint64_t)trigrams[t] << 32) | count;
+        }
+        count++;
+    }
+
+    // Pairs of one name are distinct already, so sorting leaves every posting list ascending.
+    qsort(pairs, pair_count, sizeof(*pairs), _ygo_search_compare_u64);
+    size_t distinct = 0;
+    for (size_t i = 0; i < pair_count; i++) {
+        distinct += i == 0 || (pairs[i] >> 32) != (pairs[i - 1] >> 32);
+    }
+
+    size_t prefix_offset = YGO_SEARCH_HEADER_LEN + count * YGO_SEARCH_ENTRY_LEN;
+    size_t trigrams_offset = prefix_offset + word_count * 4;
+    size_t postings_offset = trigrams_offset + distinct * YGO_SEARCH_TRIGRAM_LEN;
+    size_t text_offset = postings_offset + pair_count * 4;
+    size = text_offset + text_len;
+    if (size > UINT32_MAX) {
+        size = 0;
+        goto done;
+    }
+    if (buffer == NULL) goto done;
+
+    ygo_bin_write_context_t ctx;
+    ygo_bin_begin_data_write(&ctx, buffer);
+    ygo_bin_write_bytes(&ctx, _ygo_search_magic_word, sizeof(_ygo_search_magic_word));
+    ygo_bin_write_int16(&ctx, YGO_SEARCH_VERSION);
+    ygo_bin_write_int16(&ctx, 0x0000);
+    ygo_bin_write_int32(&ctx, (uint32_t)count);
+    ygo_bin_write_int32(&ctx, (uint32_t)text_offset);
+    ygo_bin_write_int32(&ctx, (uint32_t)text_len);
+    ygo_bin_write_int32(&ctx, (uint32_t)prefix_offset);
+    ygo_bin_write_int32(&ctx, (uint32_t)word_count);
+    ygo_bin_write_int32(&ctx, (uint32_t)trigrams_offset);
+    ygo_bin_write_int32(&ctx, (uint32_t)distinct);
+    ygo_bin_write_int32(&ctx, (uint32_t)postings_offset);
+    ygo_bin_write_int32(&ctx, (uint32_t)pair_count);
+    ygo_bin_write_int16(&ctx, 0x0000);
+    ygo_bin_write_int16(&ctx, 0x0000); // Checksum, written last
+
+    size_t text_pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        ygo_bin_write_int32(&ctx, names[i].id);
+        ygo_bin_write_int32(&ctx, (uint32_t)text_pos);
+        memcpy(buffer + text_offset + text_pos, names[i].text, names[i].len);
+        text_pos += names[i].len;
+    }
+
+    // Words point into names, which no longer moves.
+    qsort(words, word_count, sizeof(*words), _ygo_search_compare_words);
+    for (size_t i = 0; i < word_count; i++) {
+        ygo_bin_write_int32(&ctx, words[i].value);
+    }
+
+    for (size_t i = 0; i < pair_count; i++) {
+        if (i > 0 && (pairs[i] >> 32) == (pairs[i - 1] >> 32)) continue;
+        ygo_bin_write_int32(&ctx, (uint32_t)(pairs[i] >> 32));
+        ygo_bin_write_int32(&ctx, (uint32_t)i);
+    }
+    for (size_t i = 0; i < pair_count; i++) {
+        ygo_bin_write_int32(&ctx, (uint32_t)pairs[i]);
+    }
+
+    ctx.ptr = YGO_SEARCH_OFFSET_CRC;
+    ygo_bin_write_int16(&ctx, _ygo_search_crc(buffer, size));
+
+done:
+    free(names);
+    free(words);
+    free(pairs);
+    return size;
+}
+
+static uint32_t _ygo_search_id(const ygo_search_t *index, uint32_t entry) {
+    return ygo_load_be32(index->entries + (size_t)entry * YGO_SEARCH_ENTRY_LEN);
+}
+
+static uint32_t _ygo_search_name_offset(const ygo_search_t *index, uint32_t entry) {
+    if (entry >= index->count) return index->text_len;
+    return ygo_load_be32(index->entries + (size_t)entry * YGO_SEARCH_ENTRY_LEN + 4);
+}
+
+ygo_bin_errno_t ygo_search_open_memory(ygo_search_t *index, const uint8_t *data, size_t len) {
+    if (index == NULL || data == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    memset(index, 0, sizeof(*index));
+
+    if (len < YGO_SEARCH_HEADER_LEN) return YGO_BIN_ERR_TRUNCATED;
+    if (memcmp(data, _ygo_search_magic_word, sizeof(_ygo_search_magic_word)) != 0) {
+        return YGO_BIN_ERR_BAD_MAGIC_WORD;
+    }
+    if (ygo_load_be16(data + YGO_SEARCH_OFFSET_VERSION) != YGO_SEARCH_VERSION) {
+        return YGO_BIN_ERR_BAD_VERSION;
+    }
+
+    // 64-bit math, so huge counts or offsets can't wrap around the bounds checks.
+    uint64_t count = ygo_load_be32(data + YGO_SEARCH_OFFSET_COUNT);
+    uint64_t text_offset = ygo_load_be32(data + YGO_SEARCH_OFFSET_TEXT);
+    uint64_t text_len = ygo_load_be32(data + YGO_SEARCH_OFFSET_TEXT_LEN);
+    uint64_t prefix_offset = ygo_load_be32(data + YGO_SEARCH_OFFSET_PREFIX);
+    uint64_t prefix_count = ygo_load_be32(data + YGO_SEARCH_OFFSET_PREFIX_COUNT);
+    uint64_t trigrams_offset = ygo_load_be32(data + YGO_SEARCH_OFFSET_TRIGRAMS);
+    uint64_t trigram_count = ygo_load_be32(data + YGO_SEARCH_OFFSET_TRIGRAM_COUNT);
+    uint64_t postings_offset = ygo_load_be32(data + YGO_SEARCH_OFFSET_POSTINGS);
+    uint64_t posting_count = ygo_load_be32(data + YGO_SEARCH_OFFSET_POSTING_COUNT);
+
+    uint64_t ends[] = {YGO_SEARCH_HEADER_LEN + count * YGO_SEARCH_ENTRY_LEN,
+                       text_offset + text_len,
+                       prefix_offset + prefix_count * 4,
+                       trigrams_offset + trigram_count * YGO_SEARCH_TRIGRAM_LEN,
+                       postings_offset + posting_count * 4};
+    uint64_t end = 0;
+    for (size_t i = 0; i < sizeof(ends) / sizeof(ends[0]); i++) {
+        if (ends[i] > len) return YGO_BIN_ERR_TRUNCATED;
+        if (ends[i] > end) end = ends[i];
+    }
+    if (_ygo_search_crc(data, (size_t)end) != ygo_load_be16(data + YGO_SEARCH_OFFSET_CRC)) {
+        return YGO_BIN_ERR_BAD_CHECKSUM;
+    }
+    if (count >= YGO_SEARCH_MAX_ENTRIES) return YGO_BIN_ERR_BAD_ARGS;
+
+    index->data = data;
+    index->len = len;
+    index->count = (uint32_t)count;
+    index->entries = data + YGO_SEARCH_HEADER_LEN;
+    index->text = data + text_offset;
+    index->text_len = (uint32_t)text_len;
+    index->prefix = data + prefix_offset;
+    index->prefix_count = (uint32_t)prefix_count;
+    index->trigrams = data + trigrams_offset;
+    index->trigram_count = (uint32_t)trigram_count;
+    index->postings = data + postings_offset;
+    index->posting_count = (uint32_t)posting_count;
+
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    for (uint32_t entry = 0; entry < count && err == YGO_BIN_OK; entry++) {
+        uint32_t start = _ygo_search_name_offset(index, entry);
+        uint32_t next = _ygo_search_name_offset(index, entry + 1);
+        if (start > next || next - start > YGO_SEARCH_MAX_LEN) err = YGO_BIN_ERR_BAD_ARGS;
+    }
+    for (uint32_t i = 0; i < prefix_count && err == YGO_BIN_OK; i++) {
+        uint32_t word = ygo_load_be32(index->prefix + 4 * (size_t)i);
+        uint32_t entry = word >> 8;
+        if (entry >= count) {
+            err = YGO_BIN_ERR_BAD_ARGS;
+        } else if ((word & 0xFFu) >= _ygo_search_name_offset(index, entry + 1) -
+                                         _ygo_search_name_offset(index, entry)) {
+            err = YGO_BIN_ERR_BAD_ARGS;
+        }
+    }
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < trigram_count && err == YGO_BIN_OK; i++) {
+        uint32_t next = ygo_load_be32(index->trigrams + (size_t)i * YGO_SEARCH_TRIGRAM_LEN + 4);
+        if (next < first || next > posting_count) err = YGO_BIN_ERR_BAD_ARGS;
+        first = next;
+    }
+    for (uint32_t i = 0; i < posting_count && err == YGO_BIN_OK; i++) {
+        if (ygo_load_be32(index->postings + 4 * (size_t)i) >= count) err = YGO_BIN_ERR_BAD_ARGS;
+    }
+
+    if (err != YGO_BIN_OK) memset(index, 0, sizeof(*index));
+    return err;
+}
+
+const char *ygo_search_name(const ygo_search_t *index, uint32_t entry, size_t *len) {
+    if (index == NULL || entry >= index->count) return NULL;
+    uint32_t start = _ygo_search_name_offset(index, entry);
+    if (len != NULL) *len = _ygo_search_name_offset(index, entry + 1) - start;
+    return (const char *)index->text + start;
+}
+
+/**
+ * Returns 1 if hit a ranks before hit b.
+ */
+static int _ygo_search_before(const ygo_search_t *index,
+                              const ygo_search_hit_t *a,
+                              const ygo_search_hit_t *b) {
+    if (a->match != b->match) return a->match < b->match;
+    if (a->distance != b->distance) return a->distance < b->distance;
+    size_t len_a = 0, len_b = 0;
+    ygo_search_name(index, a->entry, &len_a);
+    ygo_search_name(index, b->entry, &len_b);
+    if (len_a != len_b) return len_a < len_b;
+    return a->entry < b->entry;
+}
+
+/**
+ * Insert a hit into the found best ones so far, if it is good enough.
+ */
+static void _ygo_search_offer(const ygo_search_t *index,
+                              ygo_search_hit_t *hits,
+                              size_t max_hits,
+                              size_t *found,
+                              const ygo_search_hit_t *hit) {
+    size_t pos = *found;
+    if (pos == max_hits) {
+        if (!_ygo_search_before(index, hit, &hits[pos - 1])) return;
+        pos--;
+    } else {
+        (*found)++;
+    }
+    while (pos > 0 && _ygo_search_before(index, hit, &hits[pos - 1])) {
+        hits[pos] = hits[pos - 1];
+        pos--;
+    }
+    hits[pos] = *hit;
+}
+
+/**
+ * How the m bytes of query occur in a name as they are, FUZZY if they don't.
+ */
+static ygo_search_match_t _ygo_search_classify(const char *name,
+                                               size_t len,
+                                               const char *query,
+                                               size_t m) {
+    if (len < m) return YGO_SEARCH_MATCH_FUZZY;
+    if (memcmp(name, query, m) == 0) {
+        return len == m ? YGO_SEARCH_MATCH_EXACT : YGO_SEARCH_MATCH_PREFIX;
+    }
+    ygo_search_match_t match = YGO_SEARCH_MATCH_FUZZY;
+    for (size_t start = 1; start + m <= len; start++) {
+        if (name[start] != query[0] || memcmp(name + start + 1, query + 1, m - 1) != 0) continue;
+        if (name[start - 1] == ' ') return YGO_SEARCH_MATCH_WORD;
+        match = YGO_SEARCH_MATCH_INFIX;
+    }
+    return match;
+}
+
+/**
+ * Fewest edits turning the query (m bytes, its bit masks per byte value in peq) into some
+ * substring of text. Myers' algorithm: one column of the edit distance matrix is kept as bit
+ * vectors of +1/-1 steps, and each text byte updates all m rows with a dozen word operations.
+ */
+static size_t _ygo_search_distance(const uint64_t *peq,
+                                   size_t m,
+                                   const uint8_t *text,
+                                   size_t len) {
+    uint64_t pv = ~0ull, mv = 0;
+    uint64_t last = 1ull << (m - 1);
+    size_t score = m, best = m;
+
+    for (size_t j = 0; j < len && best > 0; j++) {
+        uint64_t eq = peq[text[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        if (ph & last) {
+            score++;
+        } else if (mh & last) {
+            score--;
+        }
+        // A match may start anywhere in the text, so the top row stays 0: nothing shifts in.
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (score < best) best = score;
+    }
+    return best;
+}
+
+/**
+ * Bit i set if counts[i] >= threshold, for 16 counts.
+ */
+static inline uint32_t _ygo_search_mask16(const uint16_t *counts, uint16_t threshold) {
+#if defined(YGO_SEARCH_HAVE_SSE2)
+    __m128i below = _mm_set1_epi16((short)(threshold - 1));
+    __m128i lo = _mm_cmpgt_epi16(_mm_loadu_si128((const __m128i *)counts), below);
+    __m128i hi = _mm_cmpgt_epi16(_mm_loadu_si128((const __m128i *)(counts + 8)), below);
+    return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(lo, hi));
+#elif defined(YGO_SEARCH_HAVE_NEON)
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint16x8_t t = vdupq_n_u16(threshold);
+    uint8x16_t ge = vcombine_u8(vmovn_u16(vcgeq_u16(vld1q_u16(counts), t)),
+                                vmovn_u16(vcgeq_u16(vld1q_u16(counts + 8), t)));
+    uint8x16_t bits = vandq_u8(ge, vld1q_u8(weights));
+    return (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 16; i++) {
+        mask |= (uint32_t)(counts[i] >= threshold) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Position of the first word start whose text from there on is not less than the m bytes of
+ * query, or which starts with them.
+ */
+static uint32_t _ygo_search_lower_bound(const ygo_search_t *index, const char *query, size_t m) {
+    uint32_t lo = 0, hi = index->prefix_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t word = ygo_load_be32(index->prefix + 4 * (size_t)mid);
+        size_t len = 0;
+        const char *name = ygo_search_name(index, word >> 8, &len);
+        size_t start = word & 0xFFu;
+        size_t n = len - start < m ? len - start : m;
+        int cmp = memcmp(name + start, query, n);
+        if (cmp < 0 || (cmp == 0 && n < m)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static size_t _ygo_search_prefix(const ygo_search_t *index,
+                                 const char *query,
+                                 size_t m,
+                                 ygo_search_hit_t *hits,
+                                 size_t max_hits,
+                                 uint16_t *seen) {
+    size_t found = 0;
+    for (uint32_t i = _ygo_search_lower_bound(index, query, m); i < index->prefix_count; i++) {
+        uint32_t word = ygo_load_be32(index->prefix + 4 * (size_t)i);
+        uint32_t entry = word >> 8;
+        size_t len = 0, start = word & 0xFFu;
+        const char *name = ygo_search_name(index, entry, &len);
+        if (len - start < m || memcmp(name + start, query, m) != 0) break;
+        if (seen[entry]) continue;
+        seen[entry] = 1;
+
+        ygo_search_hit_t hit = {_ygo_search_id(index, entry),
+                                entry,
+                                0,
+                                _ygo_search_classify(name, len, query, m)};
+        _ygo_search_offer(index, hits, max_hits, &found, &hit);
+    }
+    return found;
+}
+
+/**
+ * Postings of a trigram, as a range of posting positions.
+ */
+static int _ygo_search_postings(const ygo_search_t *index,
+                                uint32_t trigram,
+                                uint32_t *first,
+                                uint32_t *last) {
+    uint32_t lo = 0, hi = index->trigram_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t value = ygo_load_be32(index->trigrams + (size_t)mid * YGO_SEARCH_TRIGRAM_LEN);
+        if (value < trigram) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    const uint8_t *at = index->trigrams + (size_t)lo * YGO_SEARCH_TRIGRAM_LEN;
+    if (lo == index->trigram_count || ygo_load_be32(at) != trigram) return 0;
+
+    *first = ygo_load_be32(at + 4);
+    *last = lo + 1 < index->trigram_count ? ygo_load_be32(at + YGO_SEARCH_TRIGRAM_LEN + 4)
+                                          : index->posting_count;
+    return 1;
+}
+
+size_t ygo_search_query(const ygo_search_t *index,
+                        const char *query,
+                        uint8_t max_distance,
+                        ygo_search_hit_t *hits,
+                        size_t max_hits,
+                        uint16_t *scratch) {
+    if (index == NULL || query == NULL || hits == NULL || max_hits == 0 || scratch == NULL) {
+        return 0;
+    }
+    char q[YGO_SEARCH_MAX_LEN];
+    size_t m = ygo_search_fold(q, sizeof(q), query, SIZE_MAX);
+    if (m == 0) return 0;
+
+    memset(scratch, 0, ygo_search_scratch_len(index) * sizeof(uint16_t));
+    if (m < YGO_SEARCH_GRAM) return _ygo_search_prefix(index, q, m, hits, max_hits, scratch);
+
+    uint32_t trigrams[YGO_SEARCH_MAX_LEN];
+    size_t trigram_count = _ygo_search_trigrams(q, m, trigrams);
+    // With k edits, at least this many of the query's trigrams are left in the name: each edit
+    // breaks up to 3, and the padded first and last ones only match at word boundaries. k is
+    // capped so that it's 2 or more; names sharing a single trigram are too many to score.
+    size_t k = trigram_count >= 4 ? (trigram_count - 4) / 3 : 0;
+    if (k > max_distance) k = max_distance;
+    uint16_t threshold = (uint16_t)(trigram_count > 3 * k + 2 ? trigram_count - 3 * k - 2 : 1);
+
+    for (size_t t = 0; t < trigram_count; t++) {
+        uint32_t first, last;
+        if (!_ygo_search_postings(index, trigrams[t], &first, &last)) continue;
+        for (uint32_t p = first; p < last; p++) {
+            scratch[ygo_load_be32(index->postings + 4 * (size_t)p)]++;
+        }
+    }
+
+    uint64_t peq[256] = {0};
+    for (size_t i = 0; i < m; i++) {
+        peq[(uint8_t)q[i]] |= 1ull << i;
+    }
+
+    size_t found = 0;
+    for (uint32_t block = 0; block < index->count; block += 16) {
+        for (uint32_t mask = _ygo_search_mask16(scratch + block, threshold); mask != 0;
+             mask &= mask - 1) {
+            uint32_t entry = block + ygo_ctz64(mask);
+            size_t len = 0;
+            const char *name = ygo_search_name(index, entry, &len);
+            // Most candidates hold the query as it is, only the others need the edit distance.
+            ygo_search_match_t match = _ygo_search_classify(name, len, q, m);
+            size_t distance = 0;
+            if (match == YGO_SEARCH_MATCH_FUZZY) {
+                if (k == 0) continue;
+                distance = _ygo_search_distance(peq, m, (const uint8_t *)name, len);
+                if (distance > k) continue;
+            }
+            ygo_search_hit_t hit = {_ygo_search_id(index, entry), entry, (uint8_t)distance, match};
+            _ygo_search_offer(index, hits, max_hits, &found, &hit);
+        }
+    }
+    return found;
+}
@@ -0,0 +1,571 @@
+/**
+ * @file ygo_sha256.c
+ * @brief SHA-256 engines: portable C, SHA-NI and 8-lane AVX2, with runtime dispatch.
+ *
+ * The portable engine is always built and is the only one on AVR and the ESP32. The x86 ones are
+ * compiled with YGO_USE_FAST_SHA256 and picked by CPUID, each checked against the portable one
+ * before it is selected.
+ */
+
+#include "ygo_sha256.h"
+#include <string.h>
+
+#if defined(YGO_USE_FAST_SHA256) && (defined(__x86_64__) || defined(_M_X64))
+#define YGO_SHA256_HAVE_X86
+#include <immintrin.h>
+#include <stdatomic.h>
+#if defined(__GNUC__) || defined(__clang__)
+#include <cpuid.h>
+#define _target_shani_ __attribute__((target("sha,sse4.1")))
+#define _target_avx2_ __attribute__((target("avx2")))
+#else
+#include <intrin.h>
+#define _target_shani_ /* nothing */
+#define _target_avx2_  /* nothing */
+#endif
+#endif
+
+ENUM_IMPL(ygo_sha256_engine, YGO_SHA256_ENGINE_DEFS);
+
+static const uint32_t _ygo_sha256_k[64] YGO_FLASH = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+static const uint32_t _ygo_sha256_iv[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+/**
+ * Compress n consecutive 64 byte blocks into state.
+ */
+typedef void (*_ygo_sha256_kernel_t)(uint32_t state[8], const uint8_t *blocks, size_t n);
+
+/////
+// Portable
+
+#define YGO_SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define YGO_SHA256_SUM0(x) (YGO_SHA256_ROTR(x, 2) ^ YGO_SHA256_ROTR(x, 13) ^ YGO_SHA256_ROTR(x, 22))
+#define YGO_SHA256_SUM1(x) (YGO_SHA256_ROTR(x, 6) ^ YGO_SHA256_ROTR(x, 11) ^ YGO_SHA256_ROTR(x, 25))
+
+static void _ygo_sha256_portable(uint32_t state[8], const uint8_t *blocks, size_t n) {
+    for (; n > 0; n--, blocks += YGO_SHA256_BLOCK_LEN) {
+        // The schedule is kept as a ring of the last 16 words, which is all a round looks back.
+        uint32_t w[16];
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (unsigned i = 0; i < 64; i++) {
+            uint32_t wi;
+            if (i < 16) {
+                wi = w[i] = ygo_load_be32(blocks + 4 * i);
+            } else {
+                uint32_t w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+                uint32_t s0 = YGO_SHA256_ROTR(w15, 7) ^ YGO_SHA256_ROTR(w15, 18) ^ (w15 >> 3);
+                uint32_t s1 = YGO_SHA256_ROTR(w2, 17) ^ YGO_SHA256_ROTR(w2, 19) ^ (w2 >> 10);
+                wi = w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+            }
+
+            uint32_t k;
+            ygo_flash_memcpy(&k, &_ygo_sha256_k[i], sizeof(k));
+            uint32_t t1 = h + YGO_SHA256_SUM1(e) + ((e & f) ^ (~e & g)) + k + wi;
+            uint32_t t2 = YGO_SHA256_SUM0(a) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+/**
+ * The padded end of a message of len bytes, whose last len % 64 bytes are at rest: those, the
+ * 0x80 marker, zeros and the length in bits, into one or two blocks of tail.
+ * @return Number of blocks
+ */
+static size_t _ygo_sha256_pad(uint8_t tail[2 * YGO_SHA256_BLOCK_LEN],
+                              const uint8_t *rest,
+                              uint64_t len) {
+    size_t rest_len = (size_t)(len % YGO_SHA256_BLOCK_LEN);
+    size_t tail_len = rest_len + 9 <= YGO_SHA256_BLOCK_LEN ? YGO_SHA256_BLOCK_LEN
+                                                           : 2 * YGO_SHA256_BLOCK_LEN;
+    memmove(tail, rest, rest_len);
+    tail[rest_len] = 0x80;
+    memset(tail + rest_len + 1, 0, tail_len - rest_len - 1);
+
+    uint64_t bits = len << 3;
+    for (unsigned i = 0; i < 8; i++) {
+        tail[tail_len - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    return tail_len / YGO_SHA256_BLOCK_LEN;
+}
+
+static void _ygo_sha256_digest(const uint32_t state[8], uint8_t digest[YGO_SHA256_LEN]) {
+    for (unsigned i = 0; i < YGO_SHA256_LEN; i++) {
+        digest[i] = (uint8_t)(state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+}
+
+/**
+ * Hash len bytes of data with kernel: the whole blocks in place, then the padded tail.
+ */
+static void _ygo_sha256_oneshot(_ygo_sha256_kernel_t kernel,
+                                const uint8_t *data,
+                                size_t len,
+                                uint8_t digest[YGO_SHA256_LEN]) {
+    uint32_t state[8];
+    uint8_t tail[2 * YGO_SHA256_BLOCK_LEN];
+    memcpy(state, _ygo_sha256_iv, sizeof(state));
+
+    size_t blocks = len / YGO_SHA256_BLOCK_LEN;
+    if (blocks > 0) kernel(state, data, blocks);
+    kernel(state, tail, _ygo_sha256_pad(tail, data + blocks * YGO_SHA256_BLOCK_LEN, len));
+    _ygo_sha256_digest(state, digest);
+}
+
+/////
+// x86
+
+#ifdef YGO_SHA256_HAVE_X86
+
+/**
+ * Four rounds with the message words w. Along the way next, the words four after w, gets its
+ * sigma1 part from w and prev, and prev, four groups ahead, its sigma0 part from w.
+ */
+#define YGO_SHA256_NI_QUAD(i, w, next, prev, schedule_next, schedule_prev)                         \
+    do {                                                                                           \
+        __m128i m = _mm_add_epi32(w, _mm_loadu_si128((const __m128i *)&_ygo_sha256_k[4 * (i)]));   \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, m);                                         \
+        if (schedule_next) {                                                                       \
+            next = _mm_add_epi32(next, _mm_alignr_epi8(w, prev, 4));                               \
+            next = _mm_sha256msg2_epu32(next, w);                                                  \
+        }                                                                                          \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(m, 0x0E));                \
+        if (schedule_prev) prev = _mm_sha256msg1_epu32(prev, w);                                   \
+    } while (0)
+
+_target_shani_ static void _ygo_sha256_shani(uint32_t state[8], const uint8_t *blocks, size_t n) {
+    const __m128i bswap = _mm_set_epi64x(0x0C0D0E0F08090A0Bll, 0x0405060700010203ll);
+
+    // The rounds instruction wants the state as ABEF and CDGH.
+    __m128i dcba = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i hgfe = _mm_loadu_si128((const __m128i *)&state[4]);
+    __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i state1 = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+    for (; n > 0; n--, blocks += YGO_SHA256_BLOCK_LEN) {
+        __m128i save0 = state0, save1 = state1;
+        __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)blocks), bswap);
+        __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), bswap);
+        __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), bswap);
+        __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), bswap);
+
+        YGO_SHA256_NI_QUAD(0, w0, w1, w3, 0, 0);
+        YGO_SHA256_NI_QUAD(1, w1, w2, w0, 0, 1);
+        YGO_SHA256_NI_QUAD(2, w2, w3, w1, 0, 1);
+        YGO_SHA256_NI_QUAD(3, w3, w0, w2, 1, 1);
+        for (int i = 4; i < 12; i += 4) {
+            YGO_SHA256_NI_QUAD(i, w0, w1, w3, 1, 1);
+            YGO_SHA256_NI_QUAD(i + 1, w1, w2, w0, 1, 1);
+            YGO_SHA256_NI_QUAD(i + 2, w2, w3, w1, 1, 1);
+            YGO_SHA256_NI_QUAD(i + 3, w3, w0, w2, 1, 1);
+        }
+        YGO_SHA256_NI_QUAD(12, w0, w1, w3, 1, 1);
+        YGO_SHA256_NI_QUAD(13, w1, w2, w0, 1, 0);
+        YGO_SHA256_NI_QUAD(14, w2, w3, w1, 1, 0);
+        YGO_SHA256_NI_QUAD(15, w3, w0, w2, 0, 0);
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    __m128i feba = _mm_shuffle_epi32(state0, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#undef YGO_SHA256_NI_QUAD
+
+static int _ygo_sha256_shani_supported(void) {
+#if defined(__GNUC__) || defined(__clang__)
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, NULL) < 7) return 0;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    (void)eax;
+    (void)edx;
+    __builtin_cpu_init();
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+#else
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return 0;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 29)) != 0;
+#endif
+}
+
+static int _ygo_sha256_avx2_supported(void) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return 0;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+
+#define YGO_SHA256_LANES 8
+
+// Rotations and the round functions on eight lanes at once.
+#define YGO_SHA256_V_ROTR(x, n)                                                                    \
+    _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define YGO_SHA256_V_XOR3(a, b, c) _mm256_xor_si256(_mm256_xor_si256(a, b), c)
+
+/**
+ * Transpose rows r[0..7], eight words of each lane, into r[0..7], word i of the eight lanes.
+ */
+_target_avx2_ static inline void _ygo_sha256_transpose(__m256i r[8]) {
+    __m256i t[8], u[8];
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++) {
+        r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+/**
+ * Compress one block of each lane, blocks[l], into the lanes of s which active has set.
+ */
+_target_avx2_ static void _ygo_sha256_avx2_block(__m256i s[8],
+                                                 const uint8_t *const blocks[YGO_SHA256_LANES],
+                                                 __m256i active) {
+    const __m256i bswap = _mm256_set_epi64x(0x0C0D0E0F08090A0Bll, 0x0405060700010203ll,
+                                            0x0C0D0E0F08090A0Bll, 0x0405060700010203ll);
+    __m256i w[16];
+    for (int half = 0; half < 2; half++) {
+        for (int l = 0; l < YGO_SHA256_LANES; l++) {
+            w[8 * half + l] = _mm256_loadu_si256((const __m256i *)(blocks[l] + 32 * half));
+        }
+        _ygo_sha256_transpose(w + 8 * half);
+    }
+    for (int i = 0; i < 16; i++) {
+        w[i] = _mm256_shuffle_epi8(w[i], bswap);
+    }
+
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int i = 0; i < 64; i++) {
+        __m256i wi = w[i & 15];
+        if (i >= 16) {
+            __m256i w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+            __m256i s0 = YGO_SHA256_V_XOR3(YGO_SHA256_V_ROTR(w15, 7), YGO_SHA256_V_ROTR(w15, 18),
+                                           _mm256_srli_epi32(w15, 3));
+            __m256i s1 = YGO_SHA256_V_XOR3(YGO_SHA256_V_ROTR(w2, 17), YGO_SHA256_V_ROTR(w2, 19),
+                                           _mm256_srli_epi32(w2, 10));
+            wi = _mm256_add_epi32(_mm256_add_epi32(wi, s0), _mm256_add_epi32(w[(i - 7) & 15], s1));
+            w[i & 15] = wi;
+        }
+
+        __m256i sigma1 = YGO_SHA256_V_XOR3(YGO_SHA256_V_ROTR(e, 6), YGO_SHA256_V_ROTR(e, 11),
+                                           YGO_SHA256_V_ROTR(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(ch, wi));
+        t1 = _mm256_add_epi32(t1, _mm256_set1_epi32((int)_ygo_sha256_k[i]));
+        __m256i sigma0 = YGO_SHA256_V_XOR3(YGO_SHA256_V_ROTR(a, 2), YGO_SHA256_V_ROTR(a, 13),
+                                           YGO_SHA256_V_ROTR(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                      _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(sigma0, maj));
+    }
+
+    __m256i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; i++) {
+        s[i] = _mm256_blendv_epi8(s[i], _mm256_add_epi32(s[i], out[i]), active);
+    }
+}
+
+#undef YGO_SHA256_V_XOR3
+#undef YGO_SHA256_V_ROTR
+
+/**
+ * Hash eight buffers, one per lane. Each lane reads its whole blocks in place, then its padded
+ * tail, one or two blocks, from a copy; lanes with fewer blocks sit out the last rounds.
+ */
+_target_avx2_ static void _ygo_sha256_avx2_lanes(const uint8_t *const *buffers,
+                                                 const size_t *sizes,
+                                                 uint8_t (*digests)[YGO_SHA256_LEN]) {
+    static const uint8_t idle[YGO_SHA256_BLOCK_LEN] = {0};
+    uint8_t tails[YGO_SHA256_LANES][2 * YGO_SHA256_BLOCK_LEN];
+    size_t full[YGO_SHA256_LANES], total[YGO_SHA256_LANES], rounds = 0;
+
+    for (int l = 0; l < YGO_SHA256_LANES; l++) {
+        full[l] = sizes[l] / YGO_SHA256_BLOCK_LEN;
+        const uint8_t *rest = buffers[l] + full[l] * YGO_SHA256_BLOCK_LEN;
+        total[l] = full[l] + _ygo_sha256_pad(tails[l], rest, sizes[l]);
+        if (total[l] > rounds) rounds = total[l];
+    }
+
+    __m256i s[8];
+    for (int i = 0; i < 8; i++) {
+        s[i] = _mm256_set1_epi32((int)_ygo_sha256_iv[i]);
+    }
+    for (size_t r = 0; r < rounds; r++) {
+        const uint8_t *blocks[YGO_SHA256_LANES];
+        int32_t active[YGO_SHA256_LANES];
+        for (int l = 0; l < YGO_SHA256_LANES; l++) {
+            if (r < full[l]) {
+                blocks[l] = buffers[l] + r * YGO_SHA256_BLOCK_LEN;
+            } else if (r < total[l]) {
+                blocks[l] = tails[l] + (r - full[l]) * YGO_SHA256_BLOCK_LEN;
+            } else {
+                blocks[l] = idle;
+            }
+            active[l] = r < total[l] ? -1 : 0;
+        }
+        _ygo_sha256_avx2_block(s, blocks, _mm256_loadu_si256((const __m256i *)active));
+    }
+
+    uint32_t words[8][YGO_SHA256_LANES];
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i *)words[i], s[i]);
+    }
+    for (int l = 0; l < YGO_SHA256_LANES; l++) {
+        uint32_t state[8];
+        for (int i = 0; i < 8; i++) {
+            state[i] = words[i][l];
+        }
+        _ygo_sha256_digest(state, digests[l]);
+    }
+}
+#else
+static int _ygo_sha256_shani_supported(void) {
+    return 0;
+}
+
+static int _ygo_sha256_avx2_supported(void) {
+    return 0;
+}
+#endif
+
+/////
+// Dispatch
+
+typedef struct {
+    ygo_sha256_engine_t engine;
+    _ygo_sha256_kernel_t kernel; // For single messages
+} _ygo_sha256_dispatch_t;
+
+static const _ygo_sha256_dispatch_t _ygo_sha256_dispatch_tab[] = {
+    [YGO_SHA256_ENGINE_PORTABLE] = {YGO_SHA256_ENGINE_PORTABLE, _ygo_sha256_portable},
+#ifdef YGO_SHA256_HAVE_X86
+    [YGO_SHA256_ENGINE_SHANI] = {YGO_SHA256_ENGINE_SHANI, _ygo_sha256_shani},
+    // The lanes only pay off in ygo_sha256_many(), single messages stay portable.
+    [YGO_SHA256_ENGINE_AVX2] = {YGO_SHA256_ENGINE_AVX2, _ygo_sha256_portable},
+#endif
+};
+
+#ifdef YGO_SHA256_HAVE_X86
+// The selected engine and its kernel, published as one pointer into the table above so a reader
+// never sees the one without the other. NULL until the first hash or ygo_sha256_select_engine().
+// Builds without the x86 engines have nothing to select and skip the atomics, which AVR lacks.
+static _Atomic(const _ygo_sha256_dispatch_t *) _ygo_sha256_dispatch = NULL;
+#endif
+
+static const _ygo_sha256_dispatch_t *_ygo_sha256_dispatch_for(ygo_sha256_engine_t engine) {
+    size_t n = sizeof(_ygo_sha256_dispatch_tab) / sizeof(_ygo_sha256_dispatch_tab[0]);
+    if ((size_t)engine >= n || _ygo_sha256_dispatch_tab[engine].kernel == NULL) {
+        engine = YGO_SHA256_ENGINE_PORTABLE;
+    }
+    return &_ygo_sha256_dispatch_tab[engine];
+}
+
+/**
+ * Hash eight lengths of a fixed pattern at a time, up to a few blocks, with the engine and the
+ * portable kernel. An engine that disagrees is never selected.
+ */
+static int _ygo_sha256_self_check(ygo_sha256_engine_t engine) {
+    _ygo_sha256_kernel_t kernel = _ygo_sha256_dispatch_for(engine)->kernel;
+    uint8_t pattern[200];
+    for (size_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 31u + 7u);
+    }
+
+    const uint8_t *buffers[8];
+    size_t sizes[8];
+    uint8_t digests[8][YGO_SHA256_LEN], expected[8][YGO_SHA256_LEN];
+    for (size_t len = 0; len + 8 + 12 <= sizeof(pattern); len += 8) {
+        for (size_t l = 0; l < 8; l++) {
+            buffers[l] = pattern + l;
+            sizes[l] = len + l * 7 % 13;
+            _ygo_sha256_oneshot(_ygo_sha256_portable, buffers[l], sizes[l], expected[l]);
+        }
+
+#ifdef YGO_SHA256_HAVE_X86
+        if (engine == YGO_SHA256_ENGINE_AVX2) {
+            _ygo_sha256_avx2_lanes(buffers, sizes, digests);
+            if (memcmp(digests, expected, sizeof(digests)) != 0) return 0;
+            continue;
+        }
+#endif
+        for (size_t l = 0; l < 8; l++) {
+            _ygo_sha256_oneshot(kernel, buffers[l], sizes[l], digests[l]);
+        }
+        if (memcmp(digests, expected, sizeof(digests)) != 0) return 0;
+    }
+    return 1;
+}
+
+int ygo_sha256_engine_available(ygo_sha256_engine_t engine) {
+    switch (engine) {
+    case YGO_SHA256_ENGINE_AUTO:
+    case YGO_SHA256_ENGINE_PORTABLE: return 1;
+    case YGO_SHA256_ENGINE_SHANI: return _ygo_sha256_shani_supported();
+    case YGO_SHA256_ENGINE_AVX2: return _ygo_sha256_avx2_supported();
+    default: return 0;
+    }
+}
+
+/**
+ * Detect (for AUTO) and check an engine, then publish it. Racing first calls may all get here,
+ * each store is a whole entry so readers see either one.
+ */
+static const _ygo_sha256_dispatch_t *_ygo_sha256_select(ygo_sha256_engine_t engine) {
+    if (engine == YGO_SHA256_ENGINE_AUTO) {
+        if (ygo_sha256_engine_available(YGO_SHA256_ENGINE_SHANI)) {
+            engine = YGO_SHA256_ENGINE_SHANI;
+        } else if (ygo_sha256_engine_available(YGO_SHA256_ENGINE_AVX2)) {
+            engine = YGO_SHA256_ENGINE_AVX2;
+        } else {
+            engine = YGO_SHA256_ENGINE_PORTABLE;
+        }
+    }
+
+    if (!ygo_sha256_engine_available(engine) || !_ygo_sha256_self_check(engine)) {
+        LOGD("SHA-256 engine %s unavailable, using portable\n", ygo_sha256_engine_to_str(engine));
+        engine = YGO_SHA256_ENGINE_PORTABLE;
+    }
+
+    const _ygo_sha256_dispatch_t *dispatch = _ygo_sha256_dispatch_for(engine);
+#ifdef YGO_SHA256_HAVE_X86
+    atomic_store_explicit(&_ygo_sha256_dispatch, dispatch, memory_order_release);
+#endif
+    return dispatch;
+}
+
+static const _ygo_sha256_dispatch_t *_ygo_sha256_active(void) {
+#ifdef YGO_SHA256_HAVE_X86
+    const _ygo_sha256_dispatch_t *dispatch =
+        atomic_load_explicit(&_ygo_sha256_dispatch, memory_order_acquire);
+    return dispatch != NULL ? dispatch : _ygo_sha256_select(YGO_SHA256_ENGINE_AUTO);
+#else
+    return _ygo_sha256_dispatch_for(YGO_SHA256_ENGINE_PORTABLE);
+#endif
+}
+
+ygo_sha256_engine_t ygo_sha256_select_engine(ygo_sha256_engine_t engine) {
+    return _ygo_sha256_select(engine)->engine;
+}
+
+ygo_sha256_engine_t ygo_sha256_active_engine(void) {
+    return _ygo_sha256_active()->engine;
+}
+
+/////
+// Hashing
+
+void ygo_sha256_init(ygo_sha256_t *sha) {
+    memcpy(sha->state, _ygo_sha256_iv, sizeof(sha->state));
+    sha->len = 0;
+}
+
+void ygo_sha256_update(ygo_sha256_t *sha, const uint8_t *data, size_t len) {
+    _ygo_sha256_kernel_t kernel = _ygo_sha256_active()->kernel;
+
+    size_t fill = (size_t)(sha->len % YGO_SHA256_BLOCK_LEN);
+    sha->len += len;
+    if (fill != 0) {
+        size_t take = YGO_SHA256_BLOCK_LEN - fill;
+        if (len < take) take = len;
+        memcpy(sha->block + fill, data, take);
+        data += take;
+        len -= take;
+        if (fill + take < YGO_SHA256_BLOCK_LEN) return;
+        kernel(sha->state, sha->block, 1);
+    }
+
+    // Whole blocks straight from data
+    size_t blocks = len / YGO_SHA256_BLOCK_LEN;
+    if (blocks > 0) kernel(sha->state, data, blocks);
+    memcpy(sha->block, data + blocks * YGO_SHA256_BLOCK_LEN, len % YGO_SHA256_BLOCK_LEN);
+}
+
+void ygo_sha256_final(ygo_sha256_t *sha, uint8_t digest[YGO_SHA256_LEN]) {
+    uint8_t tail[2 * YGO_SHA256_BLOCK_LEN];
+    _ygo_sha256_active()->kernel(sha->state, tail, _ygo_sha256_pad(tail, sha->block, sha->len));
+    _ygo_sha256_digest(sha->state, digest);
+}
+
+void ygo_sha256(const uint8_t *data, size_t len, uint8_t digest[YGO_SHA256_LEN]) {
+    _ygo_sha256_oneshot(_ygo_sha256_active()->kernel, data, len, digest);
+}
+
+void ygo_sha256_many(const uint8_t *const *buffers,
+                     const size_t *sizes,
+                     uint8_t (*digests)[YGO_SHA256_LEN],
+                     size_t n) {
+    if (buffers == NULL || sizes == NULL || digests == NULL) return;
+    size_t i = 0;
+
+#ifdef YGO_SHA256_HAVE_X86
+    if (ygo_sha256_active_engine() == YGO_SHA256_ENGINE_AVX2) {
+        for (; i + YGO_SHA256_LANES <= n; i += YGO_SHA256_LANES) {
+            _ygo_sha256_avx2_lanes(buffers + i, sizes + i, digests + i);
+        }
+    }
+#endif
+
+    // Whatever is left, one by one with the single buffer kernel
+    for (; i < n; i++) {
+        ygo_sha256(buffers[i], sizes[i], digests[i]);
+    }
+}
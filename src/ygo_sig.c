@@ -1,6 +1,18 @@
 #include "ygo_sig.h"
+#include <stdlib.h>
 #include <string.h>
 
+// A serialized card: magic word, the BASIC record with the name's length byte, padded to 4 byte
+// blocks, and the checksum trailer.
+#define YGO_SIG_IMAGE_MAX_LEN (4 + ((YGO_CARD_BASIC_BLOCK_LEN + 1 + 3) & ~3) + 4)
+
+// Cards hashed together by ygo_sig_build_payloads(), one per lane of the AVX2 engine.
+#define YGO_SIG_HASH_GROUP 8
+
+#ifdef YGO_USE_ED25519
+#include "ygo_ed25519.h"
+#endif
+
 ygo_bin_errno_t ygo_sig_read(ygo_bin_read_context_t *ctx, ygo_card_signature_t *sig) {
     if (ctx == NULL || sig == NULL) return YGO_BIN_ERR_BAD_ARGS;
 
@@ -83,14 +95,14 @@ void ygo_sig_write(ygo_bin_write_context_t *ctx, const ygo_card_signature_t *sig
     ygo_bin_write_bytes(ctx, sig->signature, 64);
 }
 
-int ygo_sig_build_payload(const ygo_card_t *card,
-                          const ygo_card_signature_t *sigmeta,
-                          uint8_t *payload_out,
-                          size_t *payload_len) {
-    if (card == NULL || sigmeta == NULL || payload_out == NULL || payload_len == NULL) {
-        return -1;
-    }
-
+/**
+ * Write the canonical payload of sigmeta for a card whose hash is given.
+ * @return Its length
+ */
+static size_t _ygo_sig_put_payload(const ygo_card_t *card,
+                                   const ygo_card_signature_t *sigmeta,
+                                   const uint8_t hash[YGO_SHA256_LEN],
+                                   uint8_t *payload_out) {
     size_t offset = 0;
 
     // Domain tag: "CYBSIGv1" (8 bytes)
@@ -104,11 +116,9 @@ int ygo_sig_build_payload(const ygo_card_t *card,
     payload_out[offset++] = (card->id >> 8) & 0xFF;
     payload_out[offset++] = card->id & 0xFF;
 
-    // Card hash (32 bytes) - TODO: implement SHA-256 of serialized BASIC record
-    // For now, use placeholder zeros; proper implementation requires SHA-256
-    // on cybermat-core or signing tool
-    memset(payload_out + offset, 0, 32);
-    offset += 32;
+    // Card hash (32 bytes)
+    memcpy(payload_out + offset, hash, YGO_SHA256_LEN);
+    offset += YGO_SHA256_LEN;
 
     // Flags (1 byte)
     payload_out[offset++] = sigmeta->flags;
@@ -141,7 +151,65 @@ int ygo_sig_build_payload(const ygo_card_t *card,
     memcpy(payload_out + offset, sigmeta->authority_id, 8);
     offset += 8;
 
-    *payload_len = offset;
+    return offset;
+}
+
+/**
+ * Serialize card into image, which holds YGO_SIG_IMAGE_MAX_LEN bytes, in the canonical encoding.
+ * @return The BASIC record within image, past the magic word, and its length in len
+ */
+static const uint8_t *_ygo_sig_record(const ygo_card_t *card, uint8_t *image, size_t *len) {
+    *len = ygo_card_serialize_plain(image, card) - 4;
+    return image + 4;
+}
+
+void ygo_sig_card_hash(const ygo_card_t *card, uint8_t hash[YGO_SHA256_LEN]) {
+    uint8_t image[YGO_SIG_IMAGE_MAX_LEN];
+    size_t len;
+    const uint8_t *record = _ygo_sig_record(card, image, &len);
+    ygo_sha256(record, len, hash);
+}
+
+int ygo_sig_build_payload(const ygo_card_t *card,
+                          const ygo_card_signature_t *sigmeta,
+                          uint8_t *payload_out,
+                          size_t *payload_len) {
+    if (card == NULL || sigmeta == NULL || payload_out == NULL || payload_len == NULL) {
+        return -1;
+    }
+
+    uint8_t hash[YGO_SHA256_LEN];
+    ygo_sig_card_hash(card, hash);
+    *payload_len = _ygo_sig_put_payload(card, sigmeta, hash, payload_out);
+    return 0;
+}
+
+int ygo_sig_build_payloads(const ygo_card_t *cards,
+                           const ygo_card_signature_t *sigmetas,
+                           size_t n,
+                           uint8_t (*payloads)[YGO_SIG_PAYLOAD_MAX_LEN],
+                           size_t *payload_lens) {
+    if (n == 0) return 0;
+    if (cards == NULL || sigmetas == NULL || payloads == NULL || payload_lens == NULL) return -1;
+
+    // Records are serialized and hashed a group at a time, so that ygo_sha256_many() can run
+    // them side by side.
+    uint8_t images[YGO_SIG_HASH_GROUP][YGO_SIG_IMAGE_MAX_LEN];
+    const uint8_t *records[YGO_SIG_HASH_GROUP];
+    size_t lens[YGO_SIG_HASH_GROUP];
+    uint8_t hashes[YGO_SIG_HASH_GROUP][YGO_SHA256_LEN];
+
+    for (size_t i = 0; i < n; i += YGO_SIG_HASH_GROUP) {
+        size_t group = n - i < YGO_SIG_HASH_GROUP ? n - i : YGO_SIG_HASH_GROUP;
+        for (size_t k = 0; k < group; k++) {
+            records[k] = _ygo_sig_record(&cards[i + k], images[k], &lens[k]);
+        }
+        ygo_sha256_many(records, lens, hashes, group);
+        for (size_t k = 0; k < group; k++) {
+            payload_lens[i + k] =
+                _ygo_sig_put_payload(&cards[i + k], &sigmetas[i + k], hashes[k], payloads[i + k]);
+        }
+    }
     return 0;
 }
 
@@ -165,6 +233,86 @@ size_t ygo_sig_calc_size(uint8_t flags) {
     return size;
 }
 
+#ifdef YGO_USE_ED25519
+
+// Payloads of one batch of ygo_ed25519_verify_batch(), and what it takes of them
+typedef struct {
+    uint8_t payload[YGO_ED25519_BATCH_MAX][YGO_SIG_PAYLOAD_MAX_LEN];
+    size_t payload_lens[YGO_ED25519_BATCH_MAX];
+    const uint8_t *messages[YGO_ED25519_BATCH_MAX];
+    size_t lens[YGO_ED25519_BATCH_MAX];
+    const uint8_t *signatures[YGO_ED25519_BATCH_MAX];
+    const uint8_t *keys[YGO_ED25519_BATCH_MAX];
+    size_t index[YGO_ED25519_BATCH_MAX];
+} _ygo_sig_batch_t;
+
+int ygo_sig_verify(const ygo_card_t *card,
+                   const ygo_card_signature_t *sig,
+                   const uint8_t pubkey[32]) {
+    if (card == NULL || sig == NULL || pubkey == NULL) return -1;
+    if (sig->algorithm != YGO_SIG_ALG_ED25519) return -1;
+
+    uint8_t payload[YGO_SIG_PAYLOAD_MAX_LEN];
+    size_t payload_len;
+    if (ygo_sig_build_payload(card, sig, payload, &payload_len) != 0) return -1;
+    return ygo_ed25519_verify(sig->signature, payload, payload_len, pubkey);
+}
+
+int ygo_sig_verify_batch(const ygo_card_t *cards,
+                         const ygo_card_signature_t *sigs,
+                         const uint8_t *const pubkeys[],
+                         size_t count,
+                         int *results) {
+    if (count == 0) return 1;
+    if (cards == NULL || sigs == NULL || pubkeys == NULL) return -1;
+
+    _ygo_sig_batch_t *batch = malloc(sizeof(*batch));
+    if (batch == NULL) return -1;
+
+    int valid = 1;
+    for (size_t i = 0; i < count; i += YGO_ED25519_BATCH_MAX) {
+        size_t m = count - i < YGO_ED25519_BATCH_MAX ? count - i : YGO_ED25519_BATCH_MAX;
+        ygo_sig_build_payloads(cards + i, sigs + i, m, batch->payload, batch->payload_lens);
+
+        // Signatures which can't be checked are left out, and fail the whole call.
+        size_t n = 0;
+        for (size_t k = 0; k < m; k++) {
+            if (pubkeys[i + k] == NULL || sigs[i + k].algorithm != YGO_SIG_ALG_ED25519) {
+                if (results != NULL) results[i + k] = -1;
+                valid = 0;
+                continue;
+            }
+            batch->messages[n] = batch->payload[k];
+            batch->lens[n] = batch->payload_lens[k];
+            batch->signatures[n] = sigs[i + k].signature;
+            batch->keys[n] = pubkeys[i + k];
+            batch->index[n++] = i + k;
+        }
+
+        int batch_valid = ygo_ed25519_verify_batch(batch->signatures, batch->messages, batch->lens,
+                                                   batch->keys, n);
+        if (batch_valid < 0) {
+            free(batch);
+            return -1;
+        }
+        if (batch_valid == 0) valid = 0;
+        if (results == NULL) continue;
+
+        for (size_t k = 0; k < n; k++) {
+            results[batch->index[k]] = batch_valid ? 1
+                                                   : ygo_ed25519_verify(batch->signatures[k],
+                                                                        batch->messages[k],
+                                                                        batch->lens[k],
+                                                                        batch->keys[k]);
+        }
+    }
+
+    free(batch);
+    return valid;
+}
+
+#else
+
 int ygo_sig_verify(const ygo_card_t *card,
                    const ygo_card_signature_t *sig,
                    const uint8_t pubkey[32]) {
@@ -176,3 +324,19 @@ int ygo_sig_verify(const ygo_card_t *card,
     (void)pubkey;
     return -1;
 }
+
+int ygo_sig_verify_batch(const ygo_card_t *cards,
+                         const ygo_card_signature_t *sigs,
+                         const uint8_t *const pubkeys[],
+                         size_t count,
+                         int *results) {
+    (void)cards;
+    (void)sigs;
+    (void)pubkeys;
+    for (size_t i = 0; results != NULL && i < count; i++) {
+        results[i] = -1;
+    }
+    return -1;
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "ygo_slim.h"
+
+/**
+ * FNV-1a over the len bytes of str.
+ */
+static uint32_t _ygo_strpool_hash(const char *str, size_t len) {
+    uint32_t hash = 0x811C9DC5u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)str[i]) * 0x01000193u;
+    }
+    return hash;
+}
+
+ygo_bin_errno_t ygo_strpool_init(ygo_strpool_t *pool,
+                                 char *data,
+                                 size_t capacity,
+                                 uint32_t *slots,
+                                 size_t slot_count) {
+    if (pool == NULL || (data == NULL && capacity > 0)) return YGO_BIN_ERR_BAD_ARGS;
+    if (capacity > UINT32_MAX - 1) return YGO_BIN_ERR_BAD_ARGS;
+    if (slots != NULL && (slot_count == 0 || (slot_count & (slot_count - 1)) != 0)) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    if (slot_count > UINT32_MAX / 4) return YGO_BIN_ERR_BAD_ARGS;
+
+    pool->data = data;
+    pool->len = 0;
+    pool->capacity = (uint32_t)capacity;
+    pool->slots = slots;
+    pool->slot_count = slots != NULL ? (uint32_t)slot_count : 0;
+    pool->count = 0;
+    if (slots != NULL) memset(slots, 0, slot_count * sizeof(uint32_t));
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_strpool_open(ygo_strpool_t *pool, const char *data, size_t len) {
+    if (pool == NULL || (data == NULL && len > 0) || len > UINT32_MAX - 1) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+    if (len > 0 && data[len - 1] != '\0') return YGO_BIN_ERR_BAD_ARGS;
+
+    memset(pool, 0, sizeof(*pool));
+    pool->data = (char *)data; // Never written, the pool is full
+    pool->len = (uint32_t)len;
+    pool->capacity = (uint32_t)len;
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_strpool_intern(ygo_strpool_t *pool,
+                                   const char *str,
+                                   size_t max_len,
+                                   uint32_t *offset) {
+    if (pool == NULL || str == NULL || offset == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    size_t len = 0;
+    while (len < max_len && str[len] != '\0') {
+        len++;
+    }
+
+    uint32_t slot = 0;
+    if (pool->slots != NULL) {
+        uint32_t mask = pool->slot_count - 1;
+        for (slot = _ygo_strpool_hash(str, len) & mask; pool->slots[slot] != 0;
+             slot = (slot + 1) & mask) {
+            const char *held = pool->data + pool->slots[slot] - 1;
+            if (strncmp(held, str, len) == 0 && held[len] == '\0') {
+                *offset = pool->slots[slot] - 1;
+                return YGO_BIN_OK;
+            }
+        }
+        if (pool->count + 1 > pool->slot_count / 4 * 3) return YGO_BIN_ERR_TRUNCATED;
+    }
+
+    if (len + 1 > pool->capacity - pool->len) return YGO_BIN_ERR_TRUNCATED;
+    *offset = pool->len;
+    memcpy(pool->data + pool->len, str, len);
+    pool->data[pool->len + len] = '\0';
+    pool->len += (uint32_t)len + 1;
+    pool->count++;
+    if (pool->slots != NULL) pool->slots[slot] = *offset + 1;
+    return YGO_BIN_OK;
+}
+
+const char *ygo_strpool_get(const ygo_strpool_t *pool, uint32_t offset) {
+    if (pool == NULL || offset >= pool->len) return NULL;
+    return pool->data + offset;
+}
+
+ygo_bin_errno_t ygo_card_slim_from_card(ygo_card_slim_t *slim,
+                                        const ygo_card_t *card,
+                                        ygo_strpool_t *pool) {
+    if (slim == NULL || card == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    uint32_t name = 0;
+    ygo_bin_errno_t err = ygo_strpool_intern(pool, card->name, YGO_CARD_NAME_MAX_LEN, &name);
+    if (err != YGO_BIN_OK) return err;
+
+    slim->id = card->id;
+    slim->name = name;
+    slim->atk = card->atk;
+    slim->def = card->def;
+    slim->type = (uint8_t)card->type;
+    slim->traits = (uint8_t)(GET_MONSTER_FLAG(card->flags) | GET_ABILITY(card->ability));
+    slim->monster_type = (uint8_t)card->monster_type;
+    slim->summon = (uint8_t)card->summon;
+    slim->attribute = (uint8_t)card->attribute;
+    slim->level = card->level;
+    slim->scale = card->scale;
+    slim->link_markers = (uint8_t)card->link_markers;
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_card_slim_to_card(ygo_card_t *card,
+                                      const ygo_card_slim_t *slim,
+                                      const ygo_strpool_t *pool) {
+    if (card == NULL || slim == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    const char *name = ygo_strpool_get(pool, slim->name);
+    if (name == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    card->id = slim->id;
+    card->type = ygo_card_slim_type(slim);
+    card->flags = ygo_card_slim_flags(slim);
+    card->monster_type = ygo_card_slim_monster_type(slim);
+    card->ability = ygo_card_slim_ability(slim);
+    card->summon = ygo_card_slim_summon(slim);
+    card->attribute = ygo_card_slim_attribute(slim);
+    card->atk = slim->atk;
+    card->def = slim->def;
+    card->level = slim->level;
+    card->scale = slim->scale;
+    card->link_markers = ygo_card_slim_link_markers(slim);
+
+    // The pool keeps the null character, so this stops within it.
+    size_t len = 0;
+    while (len < YGO_CARD_NAME_MAX_LEN && name[len] != '\0') {
+        len++;
+    }
+    memcpy(card->name, name, len);
+    memset(card->name + len, 0, YGO_CARD_NAME_MAX_LEN - len);
+    return YGO_BIN_OK;
+}
@@ -0,0 +1,720 @@
+/**
+ * @file ygo_table.c
+ * @brief Columnar card table and its predicate scan kernels, with runtime dispatch.
+ *
+ * Host-only (YGO_BUILD_HOST). Every predicate is brought into one form, lo <= (x & mask) <= hi,
+ * which each kernel evaluates as ((x & mask) - lo) <= (hi - lo) with wrapping, unsigned
+ * arithmetic of the column width: an and, a subtract and one unsigned compare per vector.
+ */
+
+#include "ygo_table.h"
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define YGO_TABLE_HAVE_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define _target_avx2_ __attribute__((target("avx2")))
+#else
+#include <intrin.h>
+#define _target_avx2_ /* nothing */
+#endif
+#elif defined(__aarch64__) && !defined(__AARCH64EB__)
+#define YGO_TABLE_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+ENUM_IMPL(ygo_table_column, YGO_TABLE_COLUMN_DEFS);
+ENUM_IMPL(ygo_table_op, YGO_TABLE_OP_DEFS);
+ENUM_IMPL(ygo_table_engine, YGO_TABLE_ENGINE_DEFS);
+
+// Rows are stored in whole blocks, so every kernel reads 64 rows at a time without a tail.
+static size_t _ygo_table_padded_rows(size_t capacity) {
+    return ygo_table_bitmap_words(capacity) * YGO_TABLE_BLOCK_ROWS;
+}
+
+size_t ygo_table_size(size_t capacity) {
+    // id, atk, def, then 9 byte columns. Every column is a multiple of 64 bytes long, so aligning
+    // the first one aligns them all.
+    return YGO_TABLE_ALIGN - 1 + _ygo_table_padded_rows(capacity) * (4 + 2 + 2 + 9);
+}
+
+ygo_bin_errno_t ygo_table_init(ygo_table_t *table, void *memory, size_t capacity) {
+    if (table == NULL || memory == NULL || capacity > UINT32_MAX - YGO_TABLE_BLOCK_ROWS) {
+        return YGO_BIN_ERR_BAD_ARGS;
+    }
+
+    // The padding rows are scanned along with the others, give them a defined value.
+    memset(memory, 0, ygo_table_size(capacity));
+
+    uintptr_t base = ((uintptr_t)memory + YGO_TABLE_ALIGN - 1) & ~(uintptr_t)(YGO_TABLE_ALIGN - 1);
+    uint8_t *ptr = (uint8_t *)memory + (base - (uintptr_t)memory);
+    size_t rows = _ygo_table_padded_rows(capacity);
+
+    table->count = 0;
+    table->capacity = (uint32_t)capacity;
+    table->id = (uint32_t *)ptr;
+    ptr += rows * 4;
+    table->atk = (uint16_t *)ptr;
+    ptr += rows * 2;
+    table->def = (uint16_t *)ptr;
+    ptr += rows * 2;
+
+    uint8_t **bytes[] = {&table->type,
+                         &table->flags,
+                         &table->monster_type,
+                         &table->ability,
+                         &table->summon,
+                         &table->attribute,
+                         &table->level,
+                         &table->scale,
+                         &table->link_markers};
+    for (size_t i = 0; i < sizeof(bytes) / sizeof(bytes[0]); i++) {
+        *bytes[i] = ptr;
+        ptr += rows;
+    }
+
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_table_append(ygo_table_t *table, const ygo_card_t *card) {
+    if (table == NULL || card == NULL) return YGO_BIN_ERR_BAD_ARGS;
+    if (table->count >= table->capacity) return YGO_BIN_ERR_TRUNCATED;
+
+    uint32_t row = table->count++;
+    table->id[row] = card->id;
+    table->atk[row] = card->atk;
+    table->def[row] = card->def;
+    table->type[row] = (uint8_t)card->type;
+    table->flags[row] = (uint8_t)card->flags;
+    table->monster_type[row] = (uint8_t)card->monster_type;
+    table->ability[row] = (uint8_t)card->ability;
+    table->summon[row] = (uint8_t)card->summon;
+    table->attribute[row] = (uint8_t)card->attribute;
+    table->level[row] = card->level;
+    table->scale[row] = card->scale;
+    table->link_markers[row] = (uint8_t)card->link_markers;
+    return YGO_BIN_OK;
+}
+
+/**
+ * Column data and width in bytes, NULL for an unknown column.
+ */
+static const void *_ygo_table_column(const ygo_table_t *table,
+                                     ygo_table_column_t column,
+                                     size_t *width) {
+    *width = 1;
+    switch (column) {
+    case YGO_TABLE_COLUMN_ID: *width = 4; return table->id;
+    case YGO_TABLE_COLUMN_ATK: *width = 2; return table->atk;
+    case YGO_TABLE_COLUMN_DEF: *width = 2; return table->def;
+    case YGO_TABLE_COLUMN_TYPE: return table->type;
+    case YGO_TABLE_COLUMN_FLAGS: return table->flags;
+    case YGO_TABLE_COLUMN_MONSTER_TYPE: return table->monster_type;
+    case YGO_TABLE_COLUMN_ABILITY: return table->ability;
+    case YGO_TABLE_COLUMN_SUMMON: return table->summon;
+    case YGO_TABLE_COLUMN_ATTRIBUTE: return table->attribute;
+    case YGO_TABLE_COLUMN_LEVEL: return table->level;
+    case YGO_TABLE_COLUMN_SCALE: return table->scale;
+    case YGO_TABLE_COLUMN_LINK_MARKERS: return table->link_markers;
+    default: return NULL;
+    }
+}
+
+uint32_t ygo_table_get(const ygo_table_t *table, ygo_table_column_t column, size_t row) {
+    size_t width;
+    const void *data = _ygo_table_column(table, column, &width);
+    if (data == NULL || row >= table->count) return 0;
+
+    switch (width) {
+    case 4: return ((const uint32_t *)data)[row];
+    case 2: return ((const uint16_t *)data)[row];
+    default: return ((const uint8_t *)data)[row];
+    }
+}
+
+/////
+
+/**
+ * A predicate in kernel form: a row matches if ((x & mask) - lo) <= span, in the column width,
+ * with the result flipped when invert is all ones.
+ */
+typedef struct {
+    uint32_t mask;
+    uint32_t lo;
+    uint32_t span;
+    uint64_t invert;
+} _ygo_table_range_t;
+
+static int _ygo_table_compile(const ygo_table_pred_t *pred, size_t width, _ygo_table_range_t *r) {
+    uint32_t max = width == 4 ? UINT32_MAX : (1u << (8 * width)) - 1;
+    uint32_t v = pred->value;
+
+    // Matches nothing: (0 - 1) wraps to max, which is above a span of 0.
+    _ygo_table_range_t none = {0, 1, 0, 0};
+    _ygo_table_range_t all = {0, 0, max, 0};
+
+    r->mask = max;
+    r->invert = 0;
+
+    switch (pred->op) {
+    case YGO_TABLE_OP_EQ:
+    case YGO_TABLE_OP_NE:
+        if (v > max) {
+            *r = none;
+        } else {
+            r->lo = v;
+            r->span = 0;
+        }
+        if (pred->op == YGO_TABLE_OP_NE) r->invert = ~0ull;
+        return 1;
+    case YGO_TABLE_OP_LT:
+        if (v == 0) {
+            *r = none;
+        } else if (v > max) {
+            *r = all;
+        } else {
+            r->lo = 0;
+            r->span = v - 1;
+        }
+        return 1;
+    case YGO_TABLE_OP_LE:
+        *r = all;
+        if (v < max) r->span = v;
+        r->mask = max;
+        return 1;
+    case YGO_TABLE_OP_GT:
+        if (v >= max) {
+            *r = none;
+        } else {
+            r->lo = v + 1;
+            r->span = max - v - 1;
+        }
+        return 1;
+    case YGO_TABLE_OP_GE:
+        if (v > max) {
+            *r = none;
+        } else {
+            r->lo = v;
+            r->span = max - v;
+        }
+        return 1;
+    case YGO_TABLE_OP_ALL:
+        if (v > max) {
+            *r = none;
+        } else {
+            r->mask = v;
+            r->lo = v;
+            r->span = 0;
+        }
+        return 1;
+    case YGO_TABLE_OP_ANY:
+        r->mask = v & max;
+        r->lo = 0;
+        r->span = 0;
+        r->invert = ~0ull;
+        return 1;
+    default: return 0;
+    }
+}
+
+/**
+ * Kernel signature: AND the matches of one predicate over blocks [0, words) into bitmap, or
+ * overwrite it for the first predicate. Blocks which are already empty are skipped.
+ */
+typedef void (*_ygo_table_kernel_t)(const void *column,
+                                    const _ygo_table_range_t *r,
+                                    uint64_t *bitmap,
+                                    size_t words,
+                                    int first);
+
+#define YGO_TABLE_SCAN_LOOP(block)                                                                 \
+    for (size_t w = 0; w < words; w++) {                                                           \
+        if (!first && bitmap[w] == 0) continue;                                                    \
+        uint64_t bits = (block) ^ r->invert;                                                       \
+        bitmap[w] = first ? bits : bitmap[w] & bits;                                               \
+    }
+
+static uint64_t _ygo_table_block8_scalar(const uint8_t *x, const _ygo_table_range_t *r) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i++) {
+        uint8_t d = (uint8_t)((x[i] & r->mask) - r->lo);
+        bits |= (uint64_t)(d <= r->span) << i;
+    }
+    return bits;
+}
+
+static uint64_t _ygo_table_block16_scalar(const uint16_t *x, const _ygo_table_range_t *r) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i++) {
+        uint16_t d = (uint16_t)((x[i] & r->mask) - r->lo);
+        bits |= (uint64_t)(d <= r->span) << i;
+    }
+    return bits;
+}
+
+static uint64_t _ygo_table_block32_scalar(const uint32_t *x, const _ygo_table_range_t *r) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i++) {
+        uint32_t d = (x[i] & r->mask) - r->lo;
+        bits |= (uint64_t)(d <= r->span) << i;
+    }
+    return bits;
+}
+
+static void _ygo_table_scan8_scalar(const void *column,
+                                    const _ygo_table_range_t *r,
+                                    uint64_t *bitmap,
+                                    size_t words,
+                                    int first) {
+    const uint8_t *x = (const uint8_t *)column;
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block8_scalar(x + w * YGO_TABLE_BLOCK_ROWS, r));
+}
+
+static void _ygo_table_scan16_scalar(const void *column,
+                                     const _ygo_table_range_t *r,
+                                     uint64_t *bitmap,
+                                     size_t words,
+                                     int first) {
+    const uint16_t *x = (const uint16_t *)column;
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block16_scalar(x + w * YGO_TABLE_BLOCK_ROWS, r));
+}
+
+// Ids are looked up rather than filtered on, every engine scans them with the scalar loop.
+static void _ygo_table_scan32_scalar(const void *column,
+                                     const _ygo_table_range_t *r,
+                                     uint64_t *bitmap,
+                                     size_t words,
+                                     int first) {
+    const uint32_t *x = (const uint32_t *)column;
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block32_scalar(x + w * YGO_TABLE_BLOCK_ROWS, r));
+}
+
+#ifdef YGO_TABLE_HAVE_X86
+// Unsigned d <= span is a saturating subtract which comes out zero.
+static inline uint64_t _ygo_table_block8_sse2(const uint8_t *x,
+                                              __m128i mask,
+                                              __m128i lo,
+                                              __m128i span) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i += 16) {
+        __m128i v = _mm_load_si128((const __m128i *)(x + i));
+        __m128i d = _mm_sub_epi8(_mm_and_si128(v, mask), lo);
+        __m128i in = _mm_cmpeq_epi8(_mm_subs_epu8(d, span), _mm_setzero_si128());
+        bits |= (uint64_t)(uint16_t)_mm_movemask_epi8(in) << i;
+    }
+    return bits;
+}
+
+static inline uint64_t _ygo_table_block16_sse2(const uint16_t *x,
+                                               __m128i mask,
+                                               __m128i lo,
+                                               __m128i span) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i += 16) {
+        __m128i v0 = _mm_load_si128((const __m128i *)(x + i));
+        __m128i v1 = _mm_load_si128((const __m128i *)(x + i + 8));
+        __m128i d0 = _mm_sub_epi16(_mm_and_si128(v0, mask), lo);
+        __m128i d1 = _mm_sub_epi16(_mm_and_si128(v1, mask), lo);
+        __m128i in0 = _mm_cmpeq_epi16(_mm_subs_epu16(d0, span), _mm_setzero_si128());
+        __m128i in1 = _mm_cmpeq_epi16(_mm_subs_epu16(d1, span), _mm_setzero_si128());
+
+        // Saturating pack keeps 0xFFFF / 0x0000 as 0xFF / 0x00, one byte per row.
+        bits |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_packs_epi16(in0, in1)) << i;
+    }
+    return bits;
+}
+
+static void _ygo_table_scan8_sse2(const void *column,
+                                  const _ygo_table_range_t *r,
+                                  uint64_t *bitmap,
+                                  size_t words,
+                                  int first) {
+    const uint8_t *x = (const uint8_t *)column;
+    __m128i mask = _mm_set1_epi8((char)r->mask);
+    __m128i lo = _mm_set1_epi8((char)r->lo);
+    __m128i span = _mm_set1_epi8((char)r->span);
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block8_sse2(x + w * YGO_TABLE_BLOCK_ROWS, mask, lo, span));
+}
+
+static void _ygo_table_scan16_sse2(const void *column,
+                                   const _ygo_table_range_t *r,
+                                   uint64_t *bitmap,
+                                   size_t words,
+                                   int first) {
+    const uint16_t *x = (const uint16_t *)column;
+    __m128i mask = _mm_set1_epi16((short)r->mask);
+    __m128i lo = _mm_set1_epi16((short)r->lo);
+    __m128i span = _mm_set1_epi16((short)r->span);
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block16_sse2(x + w * YGO_TABLE_BLOCK_ROWS, mask, lo, span));
+}
+
+_target_avx2_ static inline uint64_t _ygo_table_block8_avx2(const uint8_t *x,
+                                                            __m256i mask,
+                                                            __m256i lo,
+                                                            __m256i span) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i += 32) {
+        __m256i v = _mm256_load_si256((const __m256i *)(x + i));
+        __m256i d = _mm256_sub_epi8(_mm256_and_si256(v, mask), lo);
+        __m256i in = _mm256_cmpeq_epi8(_mm256_subs_epu8(d, span), _mm256_setzero_si256());
+        bits |= (uint64_t)(uint32_t)_mm256_movemask_epi8(in) << i;
+    }
+    return bits;
+}
+
+_target_avx2_ static inline uint64_t _ygo_table_block16_avx2(const uint16_t *x,
+                                                             __m256i mask,
+                                                             __m256i lo,
+                                                             __m256i span) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i += 32) {
+        __m256i v0 = _mm256_load_si256((const __m256i *)(x + i));
+        __m256i v1 = _mm256_load_si256((const __m256i *)(x + i + 16));
+        __m256i d0 = _mm256_sub_epi16(_mm256_and_si256(v0, mask), lo);
+        __m256i d1 = _mm256_sub_epi16(_mm256_and_si256(v1, mask), lo);
+        __m256i in0 = _mm256_cmpeq_epi16(_mm256_subs_epu16(d0, span), _mm256_setzero_si256());
+        __m256i in1 = _mm256_cmpeq_epi16(_mm256_subs_epu16(d1, span), _mm256_setzero_si256());
+
+        // The pack works per 128-bit lane, put the four quarters back in row order.
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(in0, in1), 0xD8);
+        bits |= (uint64_t)(uint32_t)_mm256_movemask_epi8(packed) << i;
+    }
+    return bits;
+}
+
+_target_avx2_ static void _ygo_table_scan8_avx2(const void *column,
+                                                const _ygo_table_range_t *r,
+                                                uint64_t *bitmap,
+                                                size_t words,
+                                                int first) {
+    const uint8_t *x = (const uint8_t *)column;
+    __m256i mask = _mm256_set1_epi8((char)r->mask);
+    __m256i lo = _mm256_set1_epi8((char)r->lo);
+    __m256i span = _mm256_set1_epi8((char)r->span);
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block8_avx2(x + w * YGO_TABLE_BLOCK_ROWS, mask, lo, span));
+}
+
+_target_avx2_ static void _ygo_table_scan16_avx2(const void *column,
+                                                 const _ygo_table_range_t *r,
+                                                 uint64_t *bitmap,
+                                                 size_t words,
+                                                 int first) {
+    const uint16_t *x = (const uint16_t *)column;
+    __m256i mask = _mm256_set1_epi16((short)r->mask);
+    __m256i lo = _mm256_set1_epi16((short)r->lo);
+    __m256i span = _mm256_set1_epi16((short)r->span);
+    YGO_TABLE_SCAN_LOOP(_ygo_table_block16_avx2(x + w * YGO_TABLE_BLOCK_ROWS, mask, lo, span));
+}
+
+static int _ygo_table_avx2_supported(void) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    int info[4];
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return 0; // OSXSAVE, AVX
+    if ((_xgetbv(0) & 0x6) != 0x6) return 0;                                // XMM and YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+#elif defined(YGO_TABLE_HAVE_NEON)
+// NEON has no movemask: weight each lane's 0xFF by its bit and add up each half.
+static inline uint64_t _ygo_table_movemask_neon(uint8x16_t in) {
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(in, vld1q_u8(weights));
+    return (uint64_t)vaddv_u8(vget_low_u8(bits)) | ((uint64_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+static void _ygo_table_scan8_neon(const void *column,
+                                  const _ygo_table_range_t *r,
+                                  uint64_t *bitmap,
+                                  size_t words,
+                                  int first) {
+    const uint8_t *x = (const uint8_t *)column;
+    uint8x16_t mask = vdupq_n_u8((uint8_t)r->mask);
+    uint8x16_t lo = vdupq_n_u8((uint8_t)r->lo);
+    uint8x16_t span = vdupq_n_u8((uint8_t)r->span);
+
+    for (size_t w = 0; w < words; w++) {
+        if (!first && bitmap[w] == 0) continue;
+        const uint8_t *block = x + w * YGO_TABLE_BLOCK_ROWS;
+        uint64_t bits = 0;
+        for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i += 16) {
+            uint8x16_t d = vsubq_u8(vandq_u8(vld1q_u8(block + i), mask), lo);
+            bits |= _ygo_table_movemask_neon(vcleq_u8(d, span)) << i;
+        }
+        bits ^= r->invert;
+        bitmap[w] = first ? bits : bitmap[w] & bits;
+    }
+}
+
+static void _ygo_table_scan16_neon(const void *column,
+                                   const _ygo_table_range_t *r,
+                                   uint64_t *bitmap,
+                                   size_t words,
+                                   int first) {
+    const uint16_t *x = (const uint16_t *)column;
+    uint16x8_t mask = vdupq_n_u16((uint16_t)r->mask);
+    uint16x8_t lo = vdupq_n_u16((uint16_t)r->lo);
+    uint16x8_t span = vdupq_n_u16((uint16_t)r->span);
+
+    for (size_t w = 0; w < words; w++) {
+        if (!first && bitmap[w] == 0) continue;
+        const uint16_t *block = x + w * YGO_TABLE_BLOCK_ROWS;
+        uint64_t bits = 0;
+        for (unsigned i = 0; i < YGO_TABLE_BLOCK_ROWS; i += 16) {
+            uint16x8_t d0 = vsubq_u16(vandq_u16(vld1q_u16(block + i), mask), lo);
+            uint16x8_t d1 = vsubq_u16(vandq_u16(vld1q_u16(block + i + 8), mask), lo);
+            uint8x16_t in = vcombine_u8(vmovn_u16(vcleq_u16(d0, span)),
+                                        vmovn_u16(vcleq_u16(d1, span)));
+            bits |= _ygo_table_movemask_neon(in) << i;
+        }
+        bits ^= r->invert;
+        bitmap[w] = first ? bits : bitmap[w] & bits;
+    }
+}
+#endif
+
+static ygo_table_engine_t _ygo_table_engine = YGO_TABLE_ENGINE_AUTO;
+
+int ygo_table_engine_available(ygo_table_engine_t engine) {
+    switch (engine) {
+    case YGO_TABLE_ENGINE_AUTO:
+    case YGO_TABLE_ENGINE_SCALAR: return 1;
+#ifdef YGO_TABLE_HAVE_X86
+    case YGO_TABLE_ENGINE_SSE2: return 1;
+    case YGO_TABLE_ENGINE_AVX2: return _ygo_table_avx2_supported();
+#elif defined(YGO_TABLE_HAVE_NEON)
+    case YGO_TABLE_ENGINE_NEON: return 1;
+#endif
+    default: return 0;
+    }
+}
+
+ygo_table_engine_t ygo_table_select_engine(ygo_table_engine_t engine) {
+    if (engine == YGO_TABLE_ENGINE_AUTO) {
+        if (ygo_table_engine_available(YGO_TABLE_ENGINE_AVX2)) {
+            engine = YGO_TABLE_ENGINE_AVX2;
+        } else if (ygo_table_engine_available(YGO_TABLE_ENGINE_SSE2)) {
+            engine = YGO_TABLE_ENGINE_SSE2;
+        } else if (ygo_table_engine_available(YGO_TABLE_ENGINE_NEON)) {
+            engine = YGO_TABLE_ENGINE_NEON;
+        } else {
+            engine = YGO_TABLE_ENGINE_SCALAR;
+        }
+    }
+
+    if (!ygo_table_engine_available(engine)) {
+        LOGD("Table engine %s unavailable, using scalar\n", ygo_table_engine_to_str(engine));
+        engine = YGO_TABLE_ENGINE_SCALAR;
+    }
+
+    // Racing first calls all store the same value, so there is no need for a lock here.
+    _ygo_table_engine = engine;
+    return engine;
+}
+
+ygo_table_engine_t ygo_table_active_engine(void) {
+    if (_ygo_table_engine == YGO_TABLE_ENGINE_AUTO) ygo_table_select_engine(YGO_TABLE_ENGINE_AUTO);
+    return _ygo_table_engine;
+}
+
+static _ygo_table_kernel_t _ygo_table_kernel_for(ygo_table_engine_t engine, size_t width) {
+    if (width == 4) return _ygo_table_scan32_scalar;
+
+    switch (engine) {
+#ifdef YGO_TABLE_HAVE_X86
+    case YGO_TABLE_ENGINE_SSE2: return width == 1 ? _ygo_table_scan8_sse2 : _ygo_table_scan16_sse2;
+    case YGO_TABLE_ENGINE_AVX2: return width == 1 ? _ygo_table_scan8_avx2 : _ygo_table_scan16_avx2;
+#elif defined(YGO_TABLE_HAVE_NEON)
+    case YGO_TABLE_ENGINE_NEON: return width == 1 ? _ygo_table_scan8_neon : _ygo_table_scan16_neon;
+#endif
+    default: return width == 1 ? _ygo_table_scan8_scalar : _ygo_table_scan16_scalar;
+    }
+}
+
+size_t ygo_table_select(const ygo_table_t *table,
+                        const ygo_table_pred_t *preds,
+                        size_t n,
+                        uint64_t *bitmap) {
+    if (table == NULL || bitmap == NULL || (preds == NULL && n > 0)) return 0;
+    size_t words = ygo_table_bitmap_words(table->count);
+    ygo_table_engine_t engine = ygo_table_active_engine();
+
+    if (n == 0) memset(bitmap, 0xFF, words * sizeof(uint64_t));
+
+    for (size_t i = 0; i < n; i++) {
+        size_t width;
+        _ygo_table_range_t range;
+        const void *column = _ygo_table_column(table, preds[i].column, &width);
+
+        if (column == NULL || !_ygo_table_compile(&preds[i], width, &range)) {
+            memset(bitmap, 0, words * sizeof(uint64_t));
+            return 0;
+        }
+        _ygo_table_kernel_for(engine, width)(column, &range, bitmap, words, i == 0);
+    }
+
+    // Padding rows past the last card may match too.
+    if (table->count % YGO_TABLE_BLOCK_ROWS != 0) {
+        bitmap[words - 1] &= (1ull << (table->count % YGO_TABLE_BLOCK_ROWS)) - 1;
+    }
+
+    size_t selected = 0;
+    for (size_t w = 0; w < words; w++) {
+        selected += ygo_popcount64(bitmap[w]);
+    }
+    return selected;
+}
+
+void ygo_table_foreach(const ygo_table_t *table,
+                       const uint64_t *bitmap,
+                       void (*fn)(const ygo_table_t *table, size_t row, void *ctx),
+                       void *ctx) {
+    if (table == NULL || bitmap == NULL || fn == NULL) return;
+
+    for (size_t w = 0; w < ygo_table_bitmap_words(table->count); w++) {
+        // Clearing the lowest set bit each round visits only the selected rows.
+        for (uint64_t bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+            fn(table, w * YGO_TABLE_BLOCK_ROWS + ygo_ctz64(bits), ctx);
+        }
+    }
+}
+
+/////
+
+#define YGO_TABLE_COLUMNS (YGO_TABLE_COLUMN_LINK_MARKERS + 1)
+
+typedef struct {
+    struct ArrowSchema *pointers[YGO_TABLE_COLUMNS];
+    struct ArrowSchema children[YGO_TABLE_COLUMNS];
+} _ygo_table_schema_private_t;
+
+typedef struct {
+    struct ArrowArray *pointers[YGO_TABLE_COLUMNS];
+    struct ArrowArray children[YGO_TABLE_COLUMNS];
+    const void *buffers[YGO_TABLE_COLUMNS + 1][2];
+} _ygo_table_array_private_t;
+
+// Children are released by their parent, which owns their memory.
+static void _ygo_table_release_child_schema(struct ArrowSchema *schema) {
+    schema->release = NULL;
+}
+
+static void _ygo_table_release_child_array(struct ArrowArray *array) {
+    array->release = NULL;
+}
+
+static void _ygo_table_release_schema(struct ArrowSchema *schema) {
+    for (int64_t i = 0; i < schema->n_children; i++) {
+        struct ArrowSchema *child = schema->children[i];
+        if (child->release != NULL) child->release(child);
+    }
+    free(schema->private_data);
+    schema->release = NULL;
+}
+
+static void _ygo_table_release_array(struct ArrowArray *array) {
+    for (int64_t i = 0; i < array->n_children; i++) {
+        struct ArrowArray *child = array->children[i];
+        if (child->release != NULL) child->release(child);
+    }
+    free(array->private_data);
+    array->release = NULL;
+}
+
+static void _ygo_table_fill_schema(struct ArrowSchema *schema,
+                                   const char *format,
+                                   const char *name,
+                                   void (*release)(struct ArrowSchema *)) {
+    memset(schema, 0, sizeof(*schema));
+    schema->format = format;
+    schema->name = name;
+    schema->release = release;
+}
+
+static void _ygo_table_fill_array(struct ArrowArray *array,
+                                  size_t length,
+                                  const void **buffers,
+                                  void (*release)(struct ArrowArray *)) {
+    memset(array, 0, sizeof(*array));
+    array->length = (int64_t)length;
+    array->n_buffers = 2;
+    array->buffers = buffers;
+    array->release = release;
+}
+
+ygo_bin_errno_t ygo_table_export_arrow(const ygo_table_t *table,
+                                       struct ArrowSchema *schema,
+                                       struct ArrowArray *array) {
+    if (table == NULL || schema == NULL || array == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    _ygo_table_schema_private_t *schemas =
+        (_ygo_table_schema_private_t *)malloc(sizeof(_ygo_table_schema_private_t));
+    _ygo_table_array_private_t *arrays =
+        (_ygo_table_array_private_t *)malloc(sizeof(_ygo_table_array_private_t));
+    if (schemas == NULL || arrays == NULL) {
+        free(schemas);
+        free(arrays);
+        return YGO_BIN_ERR_NO_MEMORY;
+    }
+
+    for (int c = 0; c < YGO_TABLE_COLUMNS; c++) {
+        size_t width;
+        const void *data = _ygo_table_column(table, (ygo_table_column_t)c, &width);
+        const char *format = width == 4 ? "I" : width == 2 ? "S" : "C";
+
+        // No nulls, so no validity buffer.
+        arrays->buffers[c][0] = NULL;
+        arrays->buffers[c][1] = data;
+
+        _ygo_table_fill_schema(&schemas->children[c],
+                               format,
+                               ygo_table_column_to_str((ygo_table_column_t)c),
+                               _ygo_table_release_child_schema);
+        _ygo_table_fill_array(&arrays->children[c],
+                              table->count,
+                              arrays->buffers[c],
+                              _ygo_table_release_child_array);
+        schemas->pointers[c] = &schemas->children[c];
+        arrays->pointers[c] = &arrays->children[c];
+    }
+
+    _ygo_table_fill_schema(schema, "+s", "", _ygo_table_release_schema);
+    schema->n_children = YGO_TABLE_COLUMNS;
+    schema->children = schemas->pointers;
+    schema->private_data = schemas;
+
+    arrays->buffers[YGO_TABLE_COLUMNS][0] = NULL;
+    _ygo_table_fill_array(array,
+                          table->count,
+                          arrays->buffers[YGO_TABLE_COLUMNS],
+                          _ygo_table_release_array);
+    array->n_buffers = 1;
+    array->n_children = YGO_TABLE_COLUMNS;
+    array->children = arrays->pointers;
+    array->private_data = arrays;
+
+    return YGO_BIN_OK;
+}
+
+ygo_bin_errno_t ygo_table_export_selection(const uint64_t *bitmap,
+                                           size_t count,
+                                           struct ArrowSchema *schema,
+                                           struct ArrowArray *array) {
+    if (bitmap == NULL || schema == NULL || array == NULL) return YGO_BIN_ERR_BAD_ARGS;
+
+    const void **buffers = (const void **)malloc(2 * sizeof(const void *));
+    if (buffers == NULL) return YGO_BIN_ERR_NO_MEMORY;
+    buffers[0] = NULL;
+    buffers[1] = bitmap;
+
+    _ygo_table_fill_schema(schema, "b", "selected", _ygo_table_release_child_schema);
+    _ygo_table_fill_array(array, count, buffers, _ygo_table_release_array);
+    array->private_data = (void *)buffers;
+    return YGO_BIN_OK;
+}
@@ -0,0 +1,94 @@
+#include "ygo_tag.h"
+
+/**
+ * What a page holds, in the order pages are written. Higher roles are written later.
+ */
+enum ygo_tag_page_role {
+    YGO_TAG_PAGE_DATA = 0x00,
+    YGO_TAG_PAGE_CHECKSUM,
+    YGO_TAG_PAGE_HEADER,
+    YGO_TAG_PAGE_MAGIC,
+};
+
+/**
+ * Role of a page in an image, found by walking its records. Anything which doesn't parse as
+ * records (e.g. a blank tag) is just data.
+ */
+static enum ygo_tag_page_role _ygo_tag_page_role(const uint8_t *image, size_t len, size_t page) {
+    if (image == NULL || page * YGO_TAG_PAGE_SIZE >= len) return YGO_TAG_PAGE_DATA;
+
+    ygo_bin_cursor_t cur;
+    ygo_bin_record_view_t view;
+    if (ygo_bin_cursor_begin(&cur, image, len) != YGO_BIN_OK) return YGO_TAG_PAGE_DATA;
+
+    // The magic word is the first page, it decides whether there is anything to read at all.
+    if (page == 0) return YGO_TAG_PAGE_MAGIC;
+
+    while (ygo_bin_cursor_next(&cur, &view) == YGO_BIN_OK) {
+        size_t header = (size_t)(view.record - image);
+        size_t trailer = header + view.header.record_length;
+
+        if (page == header / YGO_TAG_PAGE_SIZE) return YGO_TAG_PAGE_HEADER;
+
+        // The checksum is 2 bytes, it only spans two pages if the record isn't padded.
+        if (page == trailer / YGO_TAG_PAGE_SIZE || page == (trailer + 1) / YGO_TAG_PAGE_SIZE) {
+            return YGO_TAG_PAGE_CHECKSUM;
+        }
+    }
+
+    return YGO_TAG_PAGE_DATA;
+}
+
+/**
+ * Copy a page out of an image, zero-filling whatever lies past its end.
+ */
+static void _ygo_tag_read_page(uint8_t *dest, const uint8_t *image, size_t len, size_t page) {
+    size_t offset = page * YGO_TAG_PAGE_SIZE;
+    for (size_t i = 0; i < YGO_TAG_PAGE_SIZE; i++) {
+        dest[i] = (image != NULL && offset + i < len) ? image[offset + i] : 0x00;
+    }
+}
+
+size_t ygo_tag_diff(ygo_tag_page_write_t *writes,
+                    size_t max_writes,
+                    const uint8_t *old_image,
+                    size_t old_len,
+                    const uint8_t *new_image,
+                    size_t new_len) {
+    size_t len = (old_len > new_len) ? old_len : new_len;
+    size_t pages = (len + YGO_TAG_PAGE_SIZE - 1) / YGO_TAG_PAGE_SIZE;
+    size_t n = 0;
+
+    // One pass per role, so all data pages go out before any checksum, those before headers, and
+    // the magic word last.
+    for (unsigned role = YGO_TAG_PAGE_DATA; role <= YGO_TAG_PAGE_MAGIC; role++) {
+        for (size_t page = 0; page < pages; page++) {
+            uint8_t old_page[YGO_TAG_PAGE_SIZE];
+            uint8_t new_page[YGO_TAG_PAGE_SIZE];
+            _ygo_tag_read_page(old_page, old_image, old_len, page);
+            _ygo_tag_read_page(new_page, new_image, new_len, page);
+            if (memcmp(old_page, new_page, YGO_TAG_PAGE_SIZE) == 0) continue;
+
+            enum ygo_tag_page_role old_role = _ygo_tag_page_role(old_image, old_len, page);
+            enum ygo_tag_page_role new_role = _ygo_tag_page_role(new_image, new_len, page);
+            if ((unsigned)((old_role > new_role) ? old_role : new_role) != role) continue;
+
+            if (writes != NULL && n < max_writes) {
+                writes[n].page = (uint16_t)page;
+                memcpy(writes[n].data, new_page, YGO_TAG_PAGE_SIZE);
+            }
+            n++;
+        }
+    }
+
+    return n;
+}
+
+void ygo_tag_apply(uint8_t *image, const ygo_tag_page_write_t *writes, size_t n) {
+    if (image == NULL || writes == NULL) return;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(image + (size_t)writes[i].page * YGO_TAG_PAGE_SIZE,
+               writes[i].data,
+               YGO_TAG_PAGE_SIZE);
+    }
+}
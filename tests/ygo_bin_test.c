@@ -0,0 +1,193 @@
+/**
+ * @file ygo_bin_test.c
+ * @brief ygo_bin_cursor over a tag image cut short at every length, and over records whose
+ * lengths claim more than the buffer holds: whole records are returned, the first one running
+ * past the end stops the walk, and nothing is read past len.
+ *
+ * Every cut is copied into a heap buffer of exactly its length, so a sanitizer build catches any
+ * read past the end, as well as the checks below.
+ */
+
+#include "ygo_bin.h"
+#include "ygo_card.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_RECORDS 3
+
+static int failures = 0;
+
+static uint8_t *_exact_copy(const uint8_t *data, size_t len) {
+    uint8_t *copy = (uint8_t *)malloc(len > 0 ? len : 1);
+    if (copy != NULL && len > 0) memcpy(copy, data, len);
+    return copy;
+}
+
+/**
+ * Three BASIC records after one magic word, as a tag holding a card and two more records would.
+ * @return Length of the image, and in ends where each record stops
+ */
+static size_t _make_image(uint8_t *image, size_t *ends) {
+    ygo_card_t cards[TEST_RECORDS];
+    memset(cards, 0, sizeof(cards));
+    static const char *const names[] = {"Dark Magician", "Kuriboh", "Jinzo"};
+    uint8_t one[4 + YGO_CARD_BASIC_MAX_LEN];
+    size_t len = 0;
+    for (size_t i = 0; i < TEST_RECORDS; i++) {
+        cards[i].id = 46986414u + (uint32_t)i;
+        cards[i].type = YGO_CARD_TYPE_MONSTER;
+        cards[i].atk = 2500;
+        strcpy(cards[i].name, names[i]);
+
+        // Each record of its own image, less its magic word.
+        size_t n = ygo_card_serialize(one, &cards[i]);
+        if (i == 0) {
+            memcpy(image, one, n);
+            len = n;
+        } else {
+            memcpy(image + len, one + 4, n - 4);
+            len += n - 4;
+        }
+        ends[i] = len;
+    }
+    return len;
+}
+
+static void _check_cuts(void) {
+    uint8_t image[TEST_RECORDS * (4 + YGO_CARD_BASIC_MAX_LEN)];
+    size_t ends[TEST_RECORDS];
+    size_t len = _make_image(image, ends);
+
+    for (size_t cut = 0; cut <= len; cut++) {
+        uint8_t *buffer = _exact_copy(image, cut);
+        ygo_bin_cursor_t cur;
+        ygo_bin_errno_t err = ygo_bin_cursor_begin(&cur, buffer, cut);
+        if (cut < 4) {
+            CHECK(err == YGO_BIN_ERR_TRUNCATED);
+            ygo_bin_record_view_t view;
+            CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_ERR_TRUNCATED);
+            free(buffer);
+            continue;
+        }
+        CHECK(err == YGO_BIN_OK);
+
+        // Whole records, then END_OF_DATA if what is left can't hold a header, else TRUNCATED.
+        size_t whole = 0, start = 4;
+        while (whole < TEST_RECORDS && ends[whole] <= cut) start = ends[whole++];
+        ygo_bin_errno_t expected =
+            cut - start < 4 ? YGO_BIN_ERR_END_OF_DATA : YGO_BIN_ERR_TRUNCATED;
+
+        size_t n = 0;
+        ygo_bin_record_view_t view;
+        while ((err = ygo_bin_cursor_next(&cur, &view)) == YGO_BIN_OK) {
+            CHECK(view.header.record_type == BIN_RECORD_CARD_BASIC);
+            CHECK(view.payload + view.payload_len + 2 <= buffer + cut);
+            CHECK(ygo_bin_record_check_crc(&view) == YGO_BIN_OK);
+            n++;
+        }
+        if (n != whole || err != expected) {
+            fprintf(stderr, "cut at %zu of %zu: %zu records then %d, expected %zu then %d\n", cut,
+                    len, n, err, whole, expected);
+            failures++;
+        }
+
+        // The cursor stays stopped.
+        CHECK(ygo_bin_cursor_next(&cur, &view) == expected);
+        CHECK(ygo_bin_cursor_find(&cur, BIN_RECORD_CARD_BASIC, &view) == expected);
+        free(buffer);
+    }
+}
+
+/**
+ * A record_length claiming more than the buffer holds, by one byte and by the most a header can
+ * claim, and one too short to be a record.
+ */
+static void _check_lengths(void) {
+    uint8_t image[TEST_RECORDS * (4 + YGO_CARD_BASIC_MAX_LEN)];
+    size_t ends[TEST_RECORDS];
+    size_t len = _make_image(image, ends);
+    static const uint16_t lengths[] = {0, 3, 4, 0xFFFF};
+
+    for (size_t k = 0; k < sizeof(lengths) / sizeof(lengths[0]) + 1; k++) {
+        // The last record's length, then the bytes left after its header and trailer.
+        uint16_t length = k < sizeof(lengths) / sizeof(lengths[0])
+                              ? lengths[k]
+                              : (uint16_t)(len - ends[TEST_RECORDS - 2] - 4 + 1);
+        uint8_t *buffer = _exact_copy(image, len);
+        buffer[ends[TEST_RECORDS - 2] + 2] = (uint8_t)(length >> 8u);
+        buffer[ends[TEST_RECORDS - 2] + 3] = (uint8_t)length;
+
+        ygo_bin_cursor_t cur;
+        ygo_bin_record_view_t view;
+        CHECK(ygo_bin_cursor_begin(&cur, buffer, len) == YGO_BIN_OK);
+        for (size_t i = 0; i + 1 < TEST_RECORDS; i++) {
+            CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_OK);
+        }
+        // Shorter than a header reads as unwritten memory. A bare header still fits.
+        ygo_bin_errno_t err = ygo_bin_cursor_next(&cur, &view);
+        if (length < 4) {
+            CHECK(err == YGO_BIN_ERR_END_OF_DATA);
+        } else if (length == 4) {
+            CHECK(err == YGO_BIN_OK && view.payload_len == 0);
+        } else {
+            CHECK(err == YGO_BIN_ERR_TRUNCATED);
+        }
+        free(buffer);
+    }
+
+    // A first record claiming the most, in a buffer of just its header.
+    uint8_t *buffer = _exact_copy(image, 8);
+    buffer[6] = 0xFF;
+    buffer[7] = 0xFF;
+    ygo_bin_cursor_t cur;
+    ygo_bin_record_view_t view;
+    CHECK(ygo_bin_cursor_begin(&cur, buffer, 8) == YGO_BIN_OK);
+    CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_ERR_TRUNCATED);
+    free(buffer);
+}
+
+static void _check_begin(void) {
+    uint8_t image[TEST_RECORDS * (4 + YGO_CARD_BASIC_MAX_LEN)];
+    size_t ends[TEST_RECORDS];
+    size_t len = _make_image(image, ends);
+    ygo_bin_cursor_t cur;
+    ygo_bin_record_view_t view;
+
+    // A wrong magic word stops the cursor before any record.
+    image[1] ^= 0xFF;
+    CHECK(ygo_bin_cursor_begin(&cur, image, len) == YGO_BIN_ERR_BAD_MAGIC_WORD);
+    CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_ERR_BAD_MAGIC_WORD);
+    image[1] ^= 0xFF;
+
+    // Zeroed memory after the records ends the walk.
+    uint8_t blank[TEST_RECORDS * (4 + YGO_CARD_BASIC_MAX_LEN) + 64] = {0};
+    memcpy(blank, image, ends[0]);
+    CHECK(ygo_bin_cursor_begin(&cur, blank, sizeof(blank)) == YGO_BIN_OK);
+    CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_OK);
+    CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_ERR_END_OF_DATA);
+
+    // Other types are skipped.
+    CHECK(ygo_bin_cursor_begin(&cur, image, len) == YGO_BIN_OK);
+    CHECK(ygo_bin_cursor_find(&cur, BIN_RECORD_CARD_SIGNATURE, &view) == YGO_BIN_ERR_END_OF_DATA);
+
+    CHECK(ygo_bin_cursor_begin(&cur, NULL, 16) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_bin_cursor_next(&cur, &view) == YGO_BIN_ERR_BAD_ARGS);
+}
+
+int main(void) {
+    _check_cuts();
+    _check_lengths();
+    _check_begin();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file ygo_cache_test.c
+ * @brief ygo_cache against the SipHash-2-4 reference vectors and a model of CLOCK: hits, misses
+ * and evictions over random reads, images which share a home slot found and dropped without
+ * losing each other, and images which don't decode left out.
+ */
+
+#include "ygo_cache.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_IMAGES 64
+#define TEST_IMAGE_LEN (4 + YGO_CARD_BASIC_MAX_LEN)
+#define TEST_CAPACITY 8
+#define TEST_SLOTS 16
+#define TEST_READS 5000
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+static const uint8_t _key[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+
+static ygo_card_t _cards[TEST_IMAGES];
+static uint8_t _images[TEST_IMAGES][TEST_IMAGE_LEN];
+static size_t _lens[TEST_IMAGES];
+
+static void _make_images(void) {
+    memset(_cards, 0, sizeof(_cards));
+    for (size_t i = 0; i < TEST_IMAGES; i++) {
+        _cards[i].id = 10000000u + (uint32_t)i;
+        _cards[i].type = YGO_CARD_TYPE_MONSTER;
+        _cards[i].atk = (uint16_t)(_rng() % 5000);
+        _cards[i].level = (uint8_t)(1 + _rng() % 12);
+        snprintf(_cards[i].name, sizeof(_cards[i].name), "Card %zu", i);
+        _lens[i] = ygo_card_serialize(_images[i], &_cards[i]);
+    }
+}
+
+static int _same_card(const ygo_cache_entry_t *entry, size_t image) {
+    if (entry == NULL) return 0;
+    const ygo_card_t *card = &_cards[image];
+    return entry->card.id == card->id && entry->card.atk == card->atk &&
+           strcmp(entry->card.name, card->name) == 0;
+}
+
+static void _check_hash(void) {
+    // The reference vectors of the SipHash paper: key 00..0F, messages 00, 00 01, ... 00..0E.
+    static const uint64_t expected[] = {0x726FDB47DD0E0E31ull, 0x74F839C593DC67FDull,
+                                        0x0D6C8009D9A94F5Aull, 0x85676696D7FB7E2Dull,
+                                        0xCF2794E0277187B7ull, 0x18765564CD99A68Dull,
+                                        0xCBC9466E58FEE3CEull, 0xAB0200F58B01D137ull,
+                                        0x93F5F5799A932462ull, 0x9E0082DF0BA9E4B0ull,
+                                        0x7A5DBBC594DDB9F3ull, 0xF4B32F46226BADA7ull,
+                                        0x751E8FBC860EE5FBull, 0x14EA5627C0843D90ull,
+                                        0xF723CA908E7AF2EEull, 0xA129CA6149BE45E5ull};
+    ygo_cache_t cache;
+    ygo_cache_entry_t entries[1];
+    uint32_t slots[2];
+    CHECK(ygo_cache_init(&cache, entries, 1, slots, 2, _key) == YGO_BIN_OK);
+    uint8_t message[16];
+    for (size_t i = 0; i < sizeof(message); i++) message[i] = (uint8_t)i;
+    for (size_t len = 0; len < 16; len++) {
+        CHECK(ygo_cache_hash(&cache, message, len) == expected[len]);
+    }
+}
+
+static void _check_hit_miss(void) {
+    ygo_cache_t cache;
+    ygo_cache_entry_t entries[TEST_CAPACITY];
+    uint32_t slots[TEST_SLOTS];
+    ygo_cache_entry_t *entry = NULL;
+    CHECK(ygo_cache_init(&cache, entries, TEST_CAPACITY, slots, TEST_SLOTS, _key) == YGO_BIN_OK);
+
+    // A miss decodes and starts unverified, a hit is the same entry with what was set on it.
+    CHECK(ygo_cache_decode(&cache, _images[0], _lens[0], &entry) == YGO_BIN_OK);
+    CHECK(_same_card(entry, 0) && entry->verify == YGO_CACHE_VERIFY_UNKNOWN);
+    CHECK(cache.misses == 1 && cache.hits == 0 && cache.count == 1);
+    ygo_cache_entry_t *first = entry;
+    first->verify = YGO_CACHE_VERIFY_VALID;
+    CHECK(ygo_cache_decode(&cache, _images[0], _lens[0], &entry) == YGO_BIN_OK);
+    CHECK(entry == first && entry->verify == YGO_CACHE_VERIFY_VALID);
+    CHECK(cache.misses == 1 && cache.hits == 1);
+
+    // The same card with a record after it, as a new signature would be, is an entry of its own.
+    uint8_t signed_image[TEST_IMAGE_LEN + 8];
+    memcpy(signed_image, _images[0], _lens[0]);
+    memset(signed_image + _lens[0], 0x5A, 8);
+    CHECK(ygo_cache_decode(&cache, signed_image, _lens[0] + 8, &entry) == YGO_BIN_OK);
+    CHECK(entry != first && _same_card(entry, 0) && entry->verify == YGO_CACHE_VERIFY_UNKNOWN);
+    CHECK(cache.misses == 2 && cache.count == 2);
+
+    // An image which doesn't decode is reported and left out.
+    uint8_t broken[TEST_IMAGE_LEN];
+    memcpy(broken, _images[1], _lens[1]);
+    broken[0] ^= 0xFF;
+    CHECK(ygo_cache_decode(&cache, broken, _lens[1], &entry) != YGO_BIN_OK && entry == NULL);
+    CHECK(ygo_cache_decode(&cache, _images[1], _lens[1] - 1, &entry) != YGO_BIN_OK);
+    CHECK(entry == NULL && cache.count == 2);
+
+    ygo_cache_clear(&cache);
+    CHECK(cache.count == 0 && cache.hits == 0 && cache.misses == 0);
+    CHECK(ygo_cache_decode(&cache, _images[0], _lens[0], &entry) == YGO_BIN_OK);
+    CHECK(cache.misses == 1 && cache.count == 1);
+
+    CHECK(ygo_cache_init(&cache, entries, TEST_CAPACITY, slots, 12, _key) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_cache_init(&cache, entries, TEST_CAPACITY, slots, 8, _key) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_cache_decode(&cache, NULL, 4, &entry) == YGO_BIN_ERR_BAD_ARGS && entry == NULL);
+}
+
+/**
+ * Random reads, mostly of a few images, against a model of the entries and the CLOCK hand.
+ */
+static void _check_clock(void) {
+    ygo_cache_t cache;
+    ygo_cache_entry_t entries[TEST_CAPACITY];
+    uint32_t slots[TEST_SLOTS];
+    CHECK(ygo_cache_init(&cache, entries, TEST_CAPACITY, slots, TEST_SLOTS, _key) == YGO_BIN_OK);
+
+    size_t held[TEST_CAPACITY];
+    int referenced[TEST_CAPACITY];
+    uint32_t count = 0, hand = 0, hits = 0, misses = 0, evictions = 0;
+    for (size_t r = 0; r < TEST_READS; r++) {
+        size_t image = _rng() % 2 == 0 ? (size_t)(_rng() % 6) : (size_t)(_rng() % 24);
+
+        uint32_t index = TEST_CAPACITY;
+        for (uint32_t i = 0; i < count; i++) {
+            if (held[i] == image) index = i;
+        }
+        if (index < TEST_CAPACITY) {
+            referenced[index] = 1;
+            hits++;
+        } else {
+            if (count < TEST_CAPACITY) {
+                index = count++;
+            } else {
+                while (referenced[hand]) {
+                    referenced[hand] = 0;
+                    hand = (hand + 1) % TEST_CAPACITY;
+                }
+                index = hand;
+                hand = (hand + 1) % TEST_CAPACITY;
+                evictions++;
+            }
+            held[index] = image;
+            referenced[index] = 0;
+            misses++;
+        }
+
+        ygo_cache_entry_t *entry = NULL;
+        CHECK(ygo_cache_decode(&cache, _images[image], _lens[image], &entry) == YGO_BIN_OK);
+        if (entry != &entries[index] || !_same_card(entry, image)) {
+            fprintf(stderr, "read %zu of image %zu: wrong entry\n", r, image);
+            failures++;
+            return;
+        }
+    }
+    CHECK(cache.hits == hits && cache.misses == misses && cache.evictions == evictions);
+    CHECK(hits > TEST_READS / 4 && evictions > TEST_READS / 4);
+}
+
+/**
+ * Images whose hashes land on the same slot: each is found with its own card, and dropping the
+ * one sitting in the home slot leaves the others reachable.
+ */
+static void _check_collisions(void) {
+    ygo_cache_t cache;
+    ygo_cache_entry_t entries[4];
+    uint32_t slots[TEST_SLOTS];
+    CHECK(ygo_cache_init(&cache, entries, 4, slots, TEST_SLOTS, _key) == YGO_BIN_OK);
+
+    // Three images of one home slot, and one of another.
+    size_t same[3], other = TEST_IMAGES, n = 0;
+    uint32_t home = (uint32_t)ygo_cache_hash(&cache, _images[0], _lens[0]) % TEST_SLOTS;
+    for (size_t i = 0; i < TEST_IMAGES; i++) {
+        uint32_t slot = (uint32_t)ygo_cache_hash(&cache, _images[i], _lens[i]) % TEST_SLOTS;
+        if (slot == home && n < 3) {
+            same[n++] = i;
+        } else if (slot != home && other == TEST_IMAGES) {
+            other = i;
+        }
+    }
+    CHECK(n == 3 && other < TEST_IMAGES);
+    if (n < 3 || other == TEST_IMAGES) return;
+
+    ygo_cache_entry_t *entry = NULL;
+    for (size_t i = 0; i < 3; i++) {
+        CHECK(ygo_cache_decode(&cache, _images[same[i]], _lens[same[i]], &entry) == YGO_BIN_OK);
+        CHECK(_same_card(entry, same[i]));
+    }
+    CHECK(cache.misses == 3);
+    for (size_t i = 0; i < 3; i++) {
+        CHECK(ygo_cache_decode(&cache, _images[same[i]], _lens[same[i]], &entry) == YGO_BIN_OK);
+        CHECK(_same_card(entry, same[i]));
+    }
+    CHECK(cache.hits == 3 && cache.misses == 3);
+
+    // Fill the cache and mark every entry: the hand goes round once, then takes the first of the
+    // three, which sits in their home slot.
+    CHECK(ygo_cache_decode(&cache, _images[other], _lens[other], &entry) == YGO_BIN_OK);
+    CHECK(ygo_cache_decode(&cache, _images[other], _lens[other], &entry) == YGO_BIN_OK);
+    size_t evict = 1;
+    while (evict == same[0] || evict == same[1] || evict == same[2] || evict == other) evict++;
+    CHECK(ygo_cache_decode(&cache, _images[evict], _lens[evict], &entry) == YGO_BIN_OK);
+    CHECK(cache.evictions == 1 && entry == &entries[0] && _same_card(entry, evict));
+
+    // The two left of the slot are still hits, the one dropped is a miss.
+    uint32_t misses = cache.misses;
+    for (size_t i = 1; i < 3; i++) {
+        CHECK(ygo_cache_decode(&cache, _images[same[i]], _lens[same[i]], &entry) == YGO_BIN_OK);
+        CHECK(_same_card(entry, same[i]));
+    }
+    CHECK(ygo_cache_decode(&cache, _images[other], _lens[other], &entry) == YGO_BIN_OK);
+    CHECK(_same_card(entry, other) && cache.misses == misses);
+    CHECK(ygo_cache_decode(&cache, _images[same[0]], _lens[same[0]], &entry) == YGO_BIN_OK);
+    CHECK(_same_card(entry, same[0]) && cache.misses == misses + 1);
+}
+
+int main(void) {
+    _make_images();
+    _check_hash();
+    _check_hit_miss();
+    _check_clock();
+    _check_collisions();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file ygo_card_test.c
+ * @brief BASIC records whose length fields claim more than the record can hold, a version 0x00
+ * record as the original writer laid it out, and the plain encoding signatures hash.
+ *
+ * Records are decoded from heap buffers of exactly their size, so a sanitizer build catches any
+ * read past the end, as well as the checks below.
+ */
+
+#include "ygo_card.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static int failures = 0;
+
+/**
+ * Copy len bytes into a heap buffer of exactly that size.
+ */
+static uint8_t *_exact_copy(const uint8_t *data, size_t len) {
+    uint8_t *copy = (uint8_t *)malloc(len);
+    if (copy != NULL) memcpy(copy, data, len);
+    return copy;
+}
+
+/**
+ * Blue-Eyes White Dragon as the version 0x00 writer emitted it: the 64 byte name field, its null
+ * character and the padding make record_length 0x58.
+ */
+static const uint8_t _fixed_name_image[] = {
+    0x0E, 0x59, 0x47, 0x4F, 0x00, 0x00, 0x00, 0x58, 0x05, 0x57, 0xA9, 0xA3, 0x80, 0x07, 0x00, 0x00,
+    0x0B, 0xB8, 0x09, 0xC4, 0x08, 0x04, 0x00, 0x00, 0x42, 0x6C, 0x75, 0x65, 0x2D, 0x45, 0x79, 0x65,
+    0x73, 0x20, 0x57, 0x68, 0x69, 0x74, 0x65, 0x20, 0x44, 0x72, 0x61, 0x67, 0x6F, 0x6E, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x4D, 0x00, 0x00,
+};
+
+static void _check_fixed_name(void) {
+    size_t image_len = sizeof(_fixed_name_image);
+    size_t size = image_len - 4;
+    uint8_t *record = _exact_copy(_fixed_name_image + 4, size);
+    CHECK(record != NULL);
+
+    ygo_card_t out;
+    CHECK(ygo_card_deserialize(&out, record) == size);
+    CHECK(out.id == 89631139);
+    CHECK(out.monster_type == YGO_MONSTER_TYPE_DRAGON);
+    CHECK(out.attribute == YGO_ATTRIBUTE_LIGHT);
+    CHECK(out.atk == 3000 && out.def == 2500 && out.level == 8);
+    CHECK(strcmp(out.name, "Blue-Eyes White Dragon") == 0);
+    CHECK(ygo_card_record_size(record, size) == size);
+    free(record);
+
+    uint8_t *image = _exact_copy(_fixed_name_image, image_len);
+    CHECK(image != NULL);
+    ygo_bin_errno_t status;
+    CHECK(ygo_card_deserialize_many(&out, &status, 1, image, image_len) == image_len);
+    CHECK(status == YGO_BIN_OK);
+
+    // One byte at a time, so the decoder sees the name field arrive in pieces.
+    ygo_card_stream_t stream;
+    ygo_card_stream_begin(&stream, &out);
+    ygo_bin_errno_t err = YGO_BIN_OK;
+    for (size_t i = 0; i < image_len && err == YGO_BIN_OK; i++) {
+        err = ygo_card_stream_update(&stream, image + i, 1);
+    }
+    CHECK(err == YGO_BIN_OK);
+    CHECK(stream.state == YGO_CARD_STREAM_DONE && stream.consumed == image_len);
+    CHECK(out.id == 89631139 && strcmp(out.name, "Blue-Eyes White Dragon") == 0);
+    free(image);
+}
+
+static void _set_record_length(uint8_t *record, uint16_t len) {
+    record[2] = (uint8_t)(len >> 8u);
+    record[3] = (uint8_t)len;
+}
+
+int main(void) {
+    ygo_card_t card = {
+        .id = 46986414,
+        .type = YGO_CARD_TYPE_MONSTER,
+        .attribute = YGO_ATTRIBUTE_DARK,
+        .atk = 2500,
+        .def = 2100,
+        .level = 7,
+    };
+    // A full length name, so the record is as long as a valid one gets.
+    memset(card.name, 'q', YGO_CARD_NAME_MAX_LEN);
+
+    uint8_t image[4 + YGO_CARD_BASIC_MAX_LEN + 16];
+    size_t image_len = ygo_card_serialize(image, &card);
+    size_t size = image_len - 4;
+    CHECK(size <= YGO_CARD_BASIC_MAX_LEN);
+
+    ygo_card_t out;
+    uint8_t *record = _exact_copy(image + 4, size);
+    CHECK(record != NULL);
+    CHECK(ygo_card_deserialize(&out, record) == size);
+    CHECK(memcmp(out.name, card.name, YGO_CARD_NAME_MAX_LEN) == 0);
+    CHECK(ygo_card_record_size(record, size) == size);
+
+    // record_length far past the end of the buffer, and just past the longest valid record.
+    const uint16_t bad_lengths[] = {0xFFFF, 0x1000, YGO_CARD_BASIC_MAX_LEN};
+    for (size_t i = 0; i < sizeof(bad_lengths) / sizeof(bad_lengths[0]); i++) {
+        _set_record_length(record, bad_lengths[i]);
+        memset(&out, 0x5A, sizeof(out));
+        CHECK(ygo_card_deserialize(&out, record) == 0);
+        CHECK(out.id == 0x5A5A5A5Au);
+        CHECK(ygo_card_record_size(record, size) == 0);
+    }
+    free(record);
+
+    // A name length byte past YGO_CARD_NAME_MAX_LEN, with an otherwise plausible record_length.
+    record = _exact_copy(image + 4, size);
+    CHECK(record != NULL);
+    record[YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME] = 200;
+    CHECK(ygo_card_deserialize(&out, record) == 0);
+    free(record);
+
+    // The batch decoder stops at the record and reports why. The buffer has room for what the
+    // header claims, so the cursor accepts it and the size check has to catch it.
+    uint8_t many[2 * sizeof(image)] = {0};
+    memcpy(many, image, image_len);
+    memcpy(many + image_len, image, image_len);
+    _set_record_length(many + image_len + 4, YGO_CARD_BASIC_MAX_LEN);
+    ygo_card_t cards[2];
+    ygo_bin_errno_t status[2];
+    CHECK(ygo_card_deserialize_many(cards, status, 2, many, sizeof(many)) == image_len);
+    CHECK(status[0] == YGO_BIN_OK);
+    CHECK(status[1] == YGO_BIN_ERR_BAD_LENGTH);
+
+    // The streaming decoder fails as soon as the name length is in.
+    ygo_card_stream_t stream;
+    ygo_card_stream_begin(&stream, &out);
+    _set_record_length(image + 4, 0xFFFF);
+    CHECK(ygo_card_stream_update(&stream, image, image_len) == YGO_BIN_ERR_BAD_LENGTH);
+
+    _check_fixed_name();
+
+    // The plain encoding keeps version 0x01 for a name the dictionary would shorten.
+    ygo_card_t dragon = card;
+    memset(dragon.name, 0, YGO_CARD_NAME_MAX_LEN);
+    memcpy(dragon.name, "Blue-Eyes White Dragon", 22);
+    uint8_t packed_image[4 + YGO_CARD_BASIC_MAX_LEN];
+    uint8_t plain_image[4 + YGO_CARD_BASIC_MAX_LEN];
+    ygo_card_serialize(packed_image, &dragon);
+    size_t plain_len = ygo_card_serialize_plain(plain_image, &dragon);
+    CHECK(packed_image[4 + 1] == YGO_CARD_DATA_VERSION_PACKED_NAME);
+    CHECK(plain_image[4 + 1] == YGO_CARD_DATA_VERSION_SHORT_NAME);
+    CHECK(ygo_card_deserialize(&out, plain_image + 4) == plain_len - 4);
+    CHECK(memcmp(out.name, dragon.name, YGO_CARD_NAME_MAX_LEN) == 0);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file ygo_card_view_test.c
+ * @brief Every ygo_card_view_t getter against the field ygo_card_deserialize() stores, for
+ * records of versions 0x00, 0x01 and 0x02 with random bytes in all of their fixed fields.
+ *
+ * Records are viewed in heap buffers of exactly their size, so a sanitizer build catches any read
+ * past the end, as well as the checks below.
+ */
+
+#include "ygo_card_view.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_RECORDS 3000
+
+// Magic word, header, fixed fields, the 64 byte name, its null character and padding, trailer.
+#define TEST_FIXED_NAME_LEN (4 + YGO_CARD_BASIC_BLOCK_LEN + 4 + 4)
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * A name of dictionary words, so some records get version 0x02, and random letters, up to the
+ * full YGO_CARD_NAME_MAX_LEN without a null character.
+ */
+static void _random_name(char *name) {
+    static const char *const words[] = {"Blue-Eyes ", "Dark ", "Magician", " Dragon", " of the ",
+                                        "Cyber",      "Knight", "Elemental HERO "};
+    size_t max = 1 + (size_t)(_rng() % YGO_CARD_NAME_MAX_LEN);
+    size_t len = 0;
+    memset(name, 0, YGO_CARD_NAME_MAX_LEN);
+    while (len < max) {
+        if (_rng() % 2 == 0) {
+            const char *word = words[_rng() % (sizeof(words) / sizeof(words[0]))];
+            for (size_t i = 0; word[i] != '\0' && len < max; i++) name[len++] = word[i];
+        } else {
+            name[len++] = (char)('a' + _rng() % 26);
+        }
+    }
+}
+
+/**
+ * A record of the given version for a random card, its fixed fields then overwritten with random
+ * bytes and the checksum redone.
+ * @return Length of the image, magic word included
+ */
+static size_t _random_image(uint8_t *image, int version) {
+    ygo_card_t card;
+    memset(&card, 0, sizeof(card));
+    card.id = (uint32_t)_rng();
+    _random_name(card.name);
+
+    size_t len;
+    if (version == YGO_CARD_DATA_VERSION_FIXED_NAME) {
+        // As the version 0x00 writer laid it out, there is no serializer for it any more.
+        len = TEST_FIXED_NAME_LEN;
+        memset(image, 0, len);
+        ygo_card_serialize_plain(image, &card);
+        image[5] = YGO_CARD_DATA_VERSION_FIXED_NAME;
+        image[6] = 0x00;
+        image[7] = (uint8_t)(len - 8);
+        memcpy(image + 8 + YGO_CARD_BASIC_OFFSET_NAME, card.name, YGO_CARD_NAME_MAX_LEN);
+        memset(image + 8 + YGO_CARD_BASIC_OFFSET_NAME + YGO_CARD_NAME_MAX_LEN, 0, 8);
+    } else if (version == YGO_CARD_DATA_VERSION_SHORT_NAME) {
+        len = ygo_card_serialize_plain(image, &card);
+    } else {
+        len = ygo_card_serialize(image, &card);
+    }
+
+    for (size_t i = 0; i < YGO_CARD_BASIC_FIXED_LEN; i++) image[8 + i] = (uint8_t)_rng();
+
+    uint8_t *record = image + 4;
+    uint16_t record_length = (uint16_t)((record[2] << 8u) | record[3]);
+    uint16_t crc = ygo_bin_calculate_crc(record, record_length);
+    record[record_length] = (uint8_t)(crc >> 8u);
+    record[record_length + 1] = (uint8_t)crc;
+    return len;
+}
+
+static void _check_view(const uint8_t *image, size_t len) {
+    // Exactly the record and its trailer, as a cursor would hand it over.
+    uint8_t *record = (uint8_t *)malloc(len - 4);
+    memcpy(record, image + 4, len - 4);
+
+    ygo_card_t card;
+    memset(&card, 0xA5, sizeof(card));
+    CHECK(ygo_card_deserialize(&card, record) == len - 4);
+
+    ygo_card_view_t view;
+    CHECK(ygo_card_view_init(&view, record, len - 4) == YGO_BIN_OK);
+    CHECK(view.data_version == image[5]);
+    CHECK(ygo_card_view_id(&view) == card.id);
+    CHECK(ygo_card_view_type(&view) == card.type);
+    CHECK(ygo_card_view_flags(&view) == card.flags);
+    CHECK(ygo_card_view_ability(&view) == card.ability);
+    CHECK(ygo_card_view_summon(&view) == card.summon);
+    CHECK(ygo_card_view_monster_type(&view) == card.monster_type);
+    CHECK(ygo_card_view_atk(&view) == card.atk);
+    CHECK(ygo_card_view_def(&view) == card.def);
+    CHECK(ygo_card_view_level(&view) == card.level);
+    CHECK(ygo_card_view_attribute(&view) == card.attribute);
+    CHECK(ygo_card_view_scale(&view) == card.scale);
+    CHECK(ygo_card_view_link_value(&view) == card.scale);
+    CHECK(ygo_card_view_link_markers(&view) == card.link_markers);
+
+    char name[YGO_CARD_NAME_MAX_LEN];
+    memset(name, 0xA5, sizeof(name));
+    CHECK(ygo_card_view_copy_name(&view, name, sizeof(name)) == YGO_BIN_OK);
+    CHECK(memcmp(name, card.name, sizeof(name)) == 0);
+
+    // In place only for the plain versions, and without the null character.
+    size_t name_len = 1;
+    const char *plain = ygo_card_view_name(&view, &name_len);
+    if (view.data_version == YGO_CARD_DATA_VERSION_PACKED_NAME) {
+        CHECK(plain == NULL && name_len == 0);
+    } else {
+        size_t card_len = 0;
+        while (card_len < YGO_CARD_NAME_MAX_LEN && card.name[card_len] != '\0') card_len++;
+        CHECK(plain != NULL && name_len == card_len);
+        CHECK(plain != NULL && memcmp(plain, card.name, name_len) == 0);
+    }
+
+    // Any shorter and the name doesn't fit. The trailer isn't needed.
+    size_t end;
+    if (view.data_version == YGO_CARD_DATA_VERSION_FIXED_NAME) {
+        end = YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME + YGO_CARD_NAME_MAX_LEN;
+    } else {
+        end = YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME + 1 +
+              record[YGO_CARD_BASIC_HEADER_LEN + YGO_CARD_BASIC_OFFSET_NAME];
+    }
+    CHECK(ygo_card_view_init(&view, record, end) == YGO_BIN_OK);
+    CHECK(ygo_card_view_init(&view, record, end - 1) == YGO_BIN_ERR_TRUNCATED);
+    free(record);
+}
+
+int main(void) {
+    static const int versions[] = {YGO_CARD_DATA_VERSION_FIXED_NAME,
+                                   YGO_CARD_DATA_VERSION_SHORT_NAME,
+                                   YGO_CARD_DATA_VERSION_PACKED_NAME};
+    uint8_t image[TEST_FIXED_NAME_LEN + YGO_CARD_BASIC_MAX_LEN];
+    size_t seen[3] = {0};
+
+    for (size_t k = 0; k < TEST_RECORDS; k++) {
+        // The packed form is only written when it is shorter, so version 0x02 asks for it.
+        int version = versions[k % 3];
+        size_t len = _random_image(image, version);
+        if (image[5] < 3) seen[image[5]]++;
+        _check_view(image, len);
+    }
+    for (size_t v = 0; v < 3; v++) CHECK(seen[v] > TEST_RECORDS / 10);
+
+    // Other records, versions and lengths are refused.
+    size_t len = _random_image(image, YGO_CARD_DATA_VERSION_SHORT_NAME);
+    ygo_card_view_t view;
+    CHECK(ygo_card_view_init(&view, image + 4, YGO_CARD_BASIC_HEADER_LEN) ==
+          YGO_BIN_ERR_TRUNCATED);
+    image[5] = 0x03;
+    CHECK(ygo_card_view_init(&view, image + 4, len - 4) == YGO_BIN_ERR_BAD_VERSION);
+    image[4] = BIN_RECORD_CARD_DESCRIPTION;
+    CHECK(ygo_card_view_init(&view, image + 4, len - 4) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_card_view_init(&view, NULL, len - 4) == YGO_BIN_ERR_BAD_ARGS);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
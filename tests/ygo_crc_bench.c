@@ -0,0 +1,78 @@
+/**
+ * @file ygo_crc_bench.c
+ * @brief Throughput of each CRC-16 engine, single buffers by size and batches of card records.
+ *
+ * Not part of ctest, the numbers depend on the machine. Run ygo_crc_bench from the build tree.
+ */
+
+#include "ygo_bin.h"
+#include "ygo_crc.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_BYTES (64u * 1024u * 1024u) // Hashed per engine and size
+#define BENCH_RECORDS 4096
+#define BENCH_RECORD_LEN 88 // A BASIC record with a long name, up to its checksum
+
+static double _now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    static const size_t sizes[] = {16, BENCH_RECORD_LEN, 256, 4096, 65536};
+    static uint8_t buffer[65536];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(i * 31u + 7u);
+    }
+
+    // Keeps the compiler from dropping the loops.
+    volatile uint16_t sink = 0;
+
+    printf("%-8s", "GB/s");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        printf("%10zu", sizes[s]);
+    }
+    printf("%14s\n", "records/s");
+
+    for (int e = YGO_CRC_ENGINE_BITWISE; e <= YGO_CRC_ENGINE_CLMUL; e++) {
+        ygo_crc_engine_t engine = (ygo_crc_engine_t)e;
+        if (!ygo_crc16_engine_available(engine)) continue;
+        printf("%-8s", ygo_crc_engine_to_str(engine));
+
+        // The bitwise reference is far slower, a sixteenth of the data is plenty.
+        size_t total = engine == YGO_CRC_ENGINE_BITWISE ? BENCH_BYTES / 16 : BENCH_BYTES;
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            size_t rounds = total / sizes[s];
+            double start = _now();
+            for (size_t r = 0; r < rounds; r++) {
+                sink ^= ygo_crc16_update_engine(engine, 0x01, buffer, sizes[s]);
+            }
+            double elapsed = _now() - start;
+            printf("%10.2f", (double)(rounds * sizes[s]) / elapsed / 1e9);
+        }
+
+        // Checksums of a batch of records, as ygo_card_serialize_many() computes them.
+        ygo_crc16_select_engine(engine);
+        const uint8_t *records[BENCH_RECORDS];
+        size_t lengths[BENCH_RECORDS];
+        uint16_t crcs[BENCH_RECORDS];
+        for (size_t i = 0; i < BENCH_RECORDS; i++) {
+            records[i] = buffer + (i * BENCH_RECORD_LEN) % (sizeof(buffer) - BENCH_RECORD_LEN);
+            lengths[i] = BENCH_RECORD_LEN;
+        }
+
+        size_t batches = total / (BENCH_RECORDS * BENCH_RECORD_LEN);
+        double start = _now();
+        for (size_t b = 0; b < batches; b++) {
+            ygo_bin_calculate_crc_many(records, lengths, crcs, BENCH_RECORDS);
+            sink ^= crcs[b % BENCH_RECORDS];
+        }
+        double elapsed = _now() - start;
+        printf("%14.0f\n", (double)(batches * BENCH_RECORDS) / elapsed);
+    }
+
+    ygo_crc16_select_engine(YGO_CRC_ENGINE_AUTO);
+    return 0;
+}
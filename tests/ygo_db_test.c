@@ -0,0 +1,238 @@
+/**
+ * @file ygo_db_test.c
+ * @brief Id lookups through the slot ordered index, and diffs and patches walking it in id order,
+ * in memory and on a file.
+ */
+
+#include "ygo_db.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define CARD_COUNT 3000
+
+static int failures = 0;
+
+/**
+ * Cards in id order. Every tenth id has an alternate print right after it, every thirtieth two,
+ * told apart by their ATK.
+ */
+static size_t _make_cards(ygo_card_t *cards, uint32_t first_id) {
+    size_t n = 0;
+    uint32_t id = first_id;
+    for (size_t i = 0; n < CARD_COUNT; i++) {
+        id += 1 + (uint32_t)(i * 7919 % 97);
+        int prints = i % 30 == 0 ? 3 : i % 10 == 0 ? 2 : 1;
+        for (int print = 0; print < prints && n < CARD_COUNT; print++) {
+            ygo_card_t *card = &cards[n++];
+            memset(card, 0, sizeof(*card));
+            card->id = id;
+            card->type = YGO_CARD_TYPE_MONSTER;
+            card->atk = (uint16_t)(100 * print);
+            card->level = 4;
+            snprintf(card->name, sizeof(card->name), "Card %u", (unsigned)id);
+        }
+    }
+    return n;
+}
+
+static uint8_t *_build(const ygo_card_t *cards, size_t n, size_t *len) {
+    uint8_t *buffer = (uint8_t *)malloc(ygo_db_build(NULL, cards, n));
+    if (buffer != NULL) *len = ygo_db_build(buffer, cards, n);
+    return buffer;
+}
+
+/**
+ * Every print of every id through ygo_db_find() and ygo_db_find_next(), in the order given.
+ */
+static void _check_prints(const ygo_db_t *db, const ygo_card_t *cards, size_t n) {
+    for (size_t i = 0; i < n;) {
+        size_t pos = db->count;
+        CHECK(ygo_db_find(db, cards[i].id, &pos) == YGO_BIN_OK);
+
+        size_t first = i;
+        ygo_bin_errno_t err = YGO_BIN_OK;
+        for (; i < n && cards[i].id == cards[first].id && err == YGO_BIN_OK; i++) {
+            CHECK(ygo_db_id_at(db, pos) == cards[i].id);
+            if (db->records != NULL) {
+                ygo_card_t card;
+                CHECK(ygo_db_read_card(db, pos, &card) == YGO_BIN_OK);
+                CHECK(card.atk == cards[i].atk);
+            } else {
+                CHECK(pos == i);
+            }
+            err = ygo_db_find_next(db, pos, &pos);
+        }
+        if (err != YGO_BIN_ERR_NOT_FOUND || (i < n && cards[i].id == cards[first].id)) {
+            fprintf(stderr, "id %u: %zu prints found, then %d\n", (unsigned)cards[first].id,
+                    i - first, err);
+            failures++;
+            while (i < n && cards[i].id == cards[first].id) i++;
+        }
+    }
+
+    size_t next;
+    CHECK(ygo_db_find_next(db, db->count, &next) == YGO_BIN_ERR_BAD_ARGS);
+}
+
+static void _check_lookups(const ygo_db_t *db, const ygo_card_t *cards, size_t n) {
+    CHECK(db->mph.n > 0);
+    for (size_t i = 0; i < n; i++) {
+        size_t pos = db->count;
+        CHECK(ygo_db_find(db, cards[i].id, &pos) == YGO_BIN_OK);
+        CHECK(pos < db->mph.n);
+
+        // The first print is the one found.
+        ygo_card_t card;
+        CHECK(ygo_db_read_card(db, pos, &card) == YGO_BIN_OK);
+        CHECK(card.id == cards[i].id);
+        size_t first = i;
+        while (first > 0 && cards[first - 1].id == cards[i].id) first--;
+        CHECK(card.atk == cards[first].atk);
+    }
+
+    size_t pos;
+    CHECK(ygo_db_find(db, 0, &pos) == YGO_BIN_ERR_NOT_FOUND);
+    CHECK(ygo_db_find(db, cards[n - 1].id + 1, &pos) == YGO_BIN_ERR_NOT_FOUND);
+    _check_prints(db, cards, n);
+}
+
+/**
+ * Diff from into to, patch from with it and compare against building to directly.
+ */
+static void _check_patch(const uint8_t *from_data,
+                         size_t from_len,
+                         const uint8_t *to_data,
+                         size_t to_len) {
+    ygo_db_t from;
+    ygo_db_t to;
+    CHECK(ygo_db_open_memory(&from, from_data, from_len) == YGO_BIN_OK);
+    CHECK(ygo_db_open_memory(&to, to_data, to_len) == YGO_BIN_OK);
+
+    size_t delta_len = ygo_db_diff(NULL, &from, &to);
+    uint8_t *delta_data = (uint8_t *)malloc(delta_len);
+    CHECK(delta_data != NULL && ygo_db_diff(delta_data, &from, &to) == delta_len);
+
+    ygo_db_delta_t delta;
+    CHECK(ygo_db_delta_open(&delta, delta_data, delta_len) == YGO_BIN_OK);
+
+    size_t len = 0;
+    CHECK(ygo_db_patch(NULL, &len, &from, &delta) == YGO_BIN_OK);
+    uint8_t *patched = (uint8_t *)malloc(len);
+    CHECK(patched != NULL && ygo_db_patch(patched, &len, &from, &delta) == YGO_BIN_OK);
+    CHECK(len == to_len && memcmp(patched, to_data, len) == 0);
+
+    free(patched);
+    free(delta_data);
+}
+
+/**
+ * Write from to a file, patch it there into to and check the file reopens as to. A delta for
+ * another generation must leave the file as it is.
+ */
+static void _check_patch_file(const uint8_t *from_data,
+                              size_t from_len,
+                              const uint8_t *to_data,
+                              size_t to_len) {
+    const char *path = "ygo_db_test.ygodb";
+    FILE *file = fopen(path, "wb");
+    CHECK(file != NULL);
+    if (file == NULL) return;
+    CHECK(fwrite(from_data, 1, from_len, file) == from_len);
+    CHECK(fclose(file) == 0);
+
+    ygo_db_t from;
+    ygo_db_t to;
+    CHECK(ygo_db_open_memory(&from, from_data, from_len) == YGO_BIN_OK);
+    CHECK(ygo_db_open_memory(&to, to_data, to_len) == YGO_BIN_OK);
+    size_t delta_len = ygo_db_diff(NULL, &from, &to);
+    uint8_t *delta_data = (uint8_t *)malloc(delta_len);
+    CHECK(delta_data != NULL && ygo_db_diff(delta_data, &from, &to) == delta_len);
+
+    CHECK(ygo_db_patch_file(path, delta_data, delta_len) == YGO_BIN_OK);
+    ygo_db_t db;
+    CHECK(ygo_db_open_file(&db, path) == YGO_BIN_OK);
+    CHECK(db.len == to_len && memcmp(db.data, to_data, to_len) == 0);
+    ygo_db_close(&db);
+
+    // The temporary file is gone, and the same delta again is for the wrong generation.
+    file = fopen("ygo_db_test.ygodb.tmp", "rb");
+    CHECK(file == NULL);
+    if (file != NULL) fclose(file);
+    CHECK(ygo_db_patch_file(path, delta_data, delta_len) == YGO_BIN_ERR_BAD_VERSION);
+    CHECK(ygo_db_open_file(&db, path) == YGO_BIN_OK);
+    CHECK(db.len == to_len && memcmp(db.data, to_data, to_len) == 0);
+    ygo_db_close(&db);
+
+    free(delta_data);
+    remove(path);
+}
+
+int main(void) {
+    static ygo_card_t cards[CARD_COUNT];
+    static ygo_card_t changed[CARD_COUNT];
+    static ygo_card_t moved[CARD_COUNT];
+    size_t n = _make_cards(cards, 1000);
+    _make_cards(changed, 1000);
+    _make_cards(moved, 5000);
+    for (size_t i = 0; i < n; i += 50) {
+        changed[i].atk += 1;
+    }
+
+    size_t len = 0;
+    uint8_t *data = _build(cards, n, &len);
+    CHECK(data != NULL);
+
+    ygo_db_t db;
+    CHECK(ygo_db_open_memory(&db, data, len) == YGO_BIN_OK);
+    _check_lookups(&db, cards, n);
+
+    // Without an id hash, an index sorted by id whose offsets are the card numbers. No records, so
+    // only positions are checked.
+    static uint8_t sorted[CARD_COUNT * YGO_DB_INDEX_ENTRY_LEN];
+    for (size_t i = 0; i < n; i++) {
+        uint8_t *entry = sorted + i * YGO_DB_INDEX_ENTRY_LEN;
+        for (int b = 0; b < 4; b++) {
+            entry[b] = (uint8_t)(cards[i].id >> (24 - 8 * b));
+            entry[4 + b] = (uint8_t)(i >> (24 - 8 * b));
+        }
+    }
+    ygo_db_t unhashed = {0};
+    unhashed.count = (uint32_t)n;
+    unhashed.index = sorted;
+    _check_prints(&unhashed, cards, n);
+
+    // Nothing but the perfect hash follows the records (hash_offset is at byte 24 of the header).
+    size_t hash_offset = ygo_load_be32(data + 24);
+    CHECK(hash_offset != 0 && len - hash_offset == ygo_mph_size(db.mph.n));
+
+    // Same ids with some records changed, so the patch carries the hash over. Then a generation
+    // whose ids mostly moved, so the patch builds it again.
+    size_t changed_len = 0;
+    size_t moved_len = 0;
+    uint8_t *changed_data = _build(changed, n, &changed_len);
+    uint8_t *moved_data = _build(moved, n, &moved_len);
+    CHECK(changed_data != NULL && moved_data != NULL);
+    _check_patch(data, len, changed_data, changed_len);
+    _check_patch(data, len, moved_data, moved_len);
+    _check_patch(moved_data, moved_len, data, len);
+    _check_patch_file(data, len, moved_data, moved_len);
+
+    ygo_db_t moved_db;
+    CHECK(ygo_db_open_memory(&moved_db, moved_data, moved_len) == YGO_BIN_OK);
+    _check_lookups(&moved_db, moved, n);
+
+    free(moved_data);
+    free(changed_data);
+    free(data);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
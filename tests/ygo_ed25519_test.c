@@ -0,0 +1,264 @@
+/**
+ * @file ygo_ed25519_test.c
+ * @brief Checks the Ed25519 verifier against the RFC 8032 vectors and signatures tampered with in
+ * each part, then card signatures through ygo_sig_verify() and ygo_sig_verify_batch().
+ *
+ * The card signatures were made with the secret keys of RFC 8032 tests 1 and 2 over the payloads
+ * ygo_sig_build_payload() gives for the cards below.
+ */
+
+#include "ygo_ed25519.h"
+#include "ygo_sig.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+// More than one split of a batch, with the bad signature in the second.
+#define TEST_BATCH (YGO_ED25519_BATCH_MAX + 8)
+#define TEST_BAD_ENTRY (YGO_ED25519_BATCH_MAX + 5)
+
+static int failures = 0;
+
+typedef struct {
+    uint8_t public_key[32];
+    uint8_t message[2];
+    size_t len;
+    uint8_t signature[64];
+} _vector_t;
+
+// RFC 8032, section 7.1, tests 1 to 3
+static const _vector_t _vectors[] = {
+    {{0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3,
+      0xc9, 0x64, 0x07, 0x3a, 0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25,
+      0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a},
+     {0},
+     0,
+     {0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2, 0xcc,
+      0x80, 0x6e, 0x82, 0x8a, 0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74,
+      0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55, 0x5f, 0xb8, 0x82, 0x15,
+      0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+      0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24, 0x65, 0x51, 0x41, 0x43,
+      0x8e, 0x7a, 0x10, 0x0b}},
+    {{0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a, 0x92, 0xb7, 0x0a, 0xa7,
+      0x4d, 0x1b, 0x7e, 0xbc, 0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c,
+      0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c},
+     {0x72},
+     1,
+     {0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8, 0x72, 0x0e, 0x82, 0x0b,
+      0x5f, 0x64, 0x25, 0x40, 0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f,
+      0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda, 0x08, 0x5a, 0xc1, 0xe4,
+      0x3e, 0x15, 0x99, 0x6e, 0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+      0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee, 0xb0, 0x0d, 0x29, 0x16,
+      0x12, 0xbb, 0x0c, 0x00}},
+    {{0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3, 0x8d, 0xa4, 0x7e, 0xd0,
+      0x02, 0x30, 0xf0, 0x58, 0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac,
+      0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25},
+     {0xaf, 0x82},
+     2,
+     {0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02, 0x48, 0x27, 0xe6, 0x9c,
+      0x3a, 0xbe, 0x01, 0xa3, 0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44,
+      0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac, 0x18, 0xff, 0x9b, 0x53,
+      0x8d, 0x16, 0xf2, 0x90, 0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+      0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d, 0xc0, 0x27, 0xbe, 0xce,
+      0xea, 0x1e, 0xc4, 0x0a}},
+};
+
+#define VECTOR_COUNT (sizeof(_vectors) / sizeof(_vectors[0]))
+
+// The group order L, little endian
+static const uint8_t _order[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+// Signatures of the cards of _make_card() 0 to 2, by the keys of vectors 0, 1 and 0.
+static const uint8_t _card_signatures[3][64] = {
+    {0x99, 0x72, 0x97, 0x3b, 0xdc, 0x39, 0xbb, 0x30, 0x1c, 0x6b, 0x41, 0x6e,
+     0xae, 0x65, 0x14, 0x06, 0x4a, 0x3d, 0xdc, 0x8b, 0x2b, 0x1c, 0x50, 0x63,
+     0xa8, 0xed, 0x05, 0x8a, 0xda, 0xaf, 0x4b, 0x2c, 0xa6, 0x50, 0x4f, 0xb9,
+     0xfe, 0x1e, 0xea, 0x15, 0x47, 0x27, 0x53, 0xbb, 0xce, 0x90, 0xcd, 0x72,
+     0x56, 0xf4, 0x8c, 0x0e, 0x28, 0x52, 0x41, 0x1c, 0x29, 0x83, 0xc3, 0x05,
+     0xd1, 0x8f, 0x22, 0x0a},
+    {0x57, 0x1d, 0x73, 0x24, 0xb7, 0x0a, 0xc3, 0x1d, 0x70, 0xe6, 0x6d, 0x4d,
+     0xd3, 0x91, 0xb3, 0xa1, 0xe9, 0x24, 0xe7, 0x86, 0x36, 0xe3, 0xcd, 0xc0,
+     0x82, 0xb3, 0x9c, 0x5f, 0x5d, 0xfd, 0xe4, 0x04, 0xb2, 0x72, 0xfd, 0xbd,
+     0xf8, 0x79, 0xf0, 0x27, 0xe6, 0xea, 0x6f, 0xd6, 0x8f, 0xfd, 0xfa, 0x93,
+     0xe0, 0x2f, 0x9a, 0x3a, 0xd2, 0x03, 0x9d, 0x59, 0x6c, 0xed, 0x9d, 0xe3,
+     0x47, 0x39, 0x85, 0x0c},
+    {0xd1, 0xf6, 0x85, 0xc3, 0xe9, 0xff, 0xd8, 0xd9, 0xcb, 0x02, 0x1a, 0x72,
+     0x7c, 0x9a, 0x72, 0x9c, 0xfc, 0xa6, 0x0a, 0xd7, 0x7f, 0x01, 0x63, 0x00,
+     0x6c, 0xdf, 0x05, 0xf9, 0xb9, 0x0b, 0x35, 0x22, 0xfe, 0xab, 0x73, 0x0c,
+     0xd7, 0x71, 0xc0, 0xd6, 0x35, 0x0f, 0x42, 0x69, 0x02, 0x7c, 0x16, 0x61,
+     0x66, 0x83, 0x1c, 0x20, 0xe2, 0xd3, 0xa1, 0xf5, 0xaa, 0x4b, 0xda, 0x3c,
+     0x27, 0x14, 0xbe, 0x08},
+};
+
+static void _make_card(size_t i, ygo_card_t *card, ygo_card_signature_t *sig) {
+    memset(card, 0, sizeof(*card));
+    memset(sig, 0, sizeof(*sig));
+    sig->version = 1;
+    sig->algorithm = YGO_SIG_ALG_ED25519;
+    sig->timestamp = 1767225600;
+    memcpy(sig->authority_id, "TESTAUTH", 8);
+    memcpy(sig->signature, _card_signatures[i % 3], 64);
+
+    switch (i % 3) {
+    case 0:
+        card->id = 89631139;
+        card->type = YGO_CARD_TYPE_MONSTER;
+        card->monster_type = YGO_MONSTER_TYPE_DRAGON;
+        card->attribute = YGO_ATTRIBUTE_LIGHT;
+        card->atk = 3000;
+        card->def = 2500;
+        card->level = 8;
+        strcpy(card->name, "Blue-Eyes White Dragon");
+        break;
+    case 1:
+        card->id = 46986414;
+        card->type = YGO_CARD_TYPE_MONSTER;
+        card->monster_type = YGO_MONSTER_TYPE_SPELLCASTER;
+        card->attribute = YGO_ATTRIBUTE_DARK;
+        card->atk = 2500;
+        card->def = 2100;
+        card->level = 7;
+        strcpy(card->name, "Dark Magician");
+        sig->flags = YGO_SIG_FLAG_BOUND_DUELIST;
+        memset(sig->duelist_id, 0xD1, sizeof(sig->duelist_id));
+        break;
+    default:
+        card->id = 55144522;
+        card->type = YGO_CARD_TYPE_SPELL;
+        card->spell_type = YGO_SPELL_TYPE_NORMAL;
+        strcpy(card->name, "Pot of Greed");
+        sig->flags = YGO_SIG_FLAG_HAS_EXPIRY;
+        sig->expiry = 1798761600;
+        break;
+    }
+}
+
+static const uint8_t *_card_key(size_t i) {
+    return _vectors[i % 3 == 1 ? 1 : 0].public_key;
+}
+
+static void _check_vectors(void) {
+    for (size_t i = 0; i < VECTOR_COUNT; i++) {
+        const _vector_t *v = &_vectors[i];
+        CHECK(ygo_ed25519_verify(v->signature, v->message, v->len, v->public_key) == 1);
+
+        // A different message: the last byte flipped, or one byte for the empty one.
+        uint8_t message[2] = {0};
+        memcpy(message, v->message, v->len);
+        size_t len = v->len > 0 ? v->len : 1;
+        message[len - 1] ^= 0x01;
+        CHECK(ygo_ed25519_verify(v->signature, message, len, v->public_key) == 0);
+
+        // A bit flipped in R, then in S.
+        uint8_t signature[64];
+        memcpy(signature, v->signature, 64);
+        signature[3] ^= 0x10;
+        CHECK(ygo_ed25519_verify(signature, v->message, v->len, v->public_key) == 0);
+        memcpy(signature, v->signature, 64);
+        signature[32 + 3] ^= 0x10;
+        CHECK(ygo_ed25519_verify(signature, v->message, v->len, v->public_key) == 0);
+
+        // S + L satisfies the equation as well, but isn't the canonical S.
+        memcpy(signature, v->signature, 64);
+        unsigned carry = 0;
+        for (size_t k = 0; k < 32; k++) {
+            carry += (unsigned)signature[32 + k] + _order[k];
+            signature[32 + k] = (uint8_t)carry;
+            carry >>= 8;
+        }
+        CHECK(ygo_ed25519_verify(signature, v->message, v->len, v->public_key) == 0);
+
+        // S = L
+        memcpy(signature + 32, _order, 32);
+        CHECK(ygo_ed25519_verify(signature, v->message, v->len, v->public_key) == 0);
+    }
+
+    CHECK(ygo_ed25519_verify(NULL, NULL, 0, _vectors[0].public_key) == -1);
+}
+
+/**
+ * The vectors over and over in one batch, first all valid, then with one signature changed.
+ */
+static void _check_vector_batch(void) {
+    static uint8_t bad[64];
+    const uint8_t *signatures[TEST_BATCH];
+    const uint8_t *messages[TEST_BATCH];
+    size_t lens[TEST_BATCH];
+    const uint8_t *keys[TEST_BATCH];
+    for (size_t i = 0; i < TEST_BATCH; i++) {
+        const _vector_t *v = &_vectors[i % VECTOR_COUNT];
+        signatures[i] = v->signature;
+        messages[i] = v->message;
+        lens[i] = v->len;
+        keys[i] = v->public_key;
+    }
+
+    CHECK(ygo_ed25519_verify_batch(signatures, messages, lens, keys, VECTOR_COUNT) == 1);
+    CHECK(ygo_ed25519_verify_batch(signatures, messages, lens, keys, TEST_BATCH) == 1);
+
+    memcpy(bad, signatures[TEST_BAD_ENTRY], 64);
+    bad[40] ^= 0x01;
+    signatures[TEST_BAD_ENTRY] = bad;
+    CHECK(ygo_ed25519_verify_batch(signatures, messages, lens, keys, TEST_BATCH) == 0);
+    CHECK(ygo_ed25519_verify_batch(signatures, messages, lens, keys, YGO_ED25519_BATCH_MAX) == 1);
+}
+
+static void _check_cards(void) {
+    ygo_card_t cards[TEST_BATCH];
+    ygo_card_signature_t sigs[TEST_BATCH];
+    const uint8_t *keys[TEST_BATCH];
+    for (size_t i = 0; i < TEST_BATCH; i++) {
+        _make_card(i, &cards[i], &sigs[i]);
+        keys[i] = _card_key(i);
+    }
+
+    for (size_t i = 0; i < 3; i++) {
+        CHECK(ygo_sig_verify(&cards[i], &sigs[i], keys[i]) == 1);
+        CHECK(ygo_sig_verify(&cards[i], &sigs[i], _vectors[2].public_key) == 0);
+    }
+
+    // Anything the payload covers, changed after signing.
+    ygo_card_t card = cards[0];
+    card.atk = 3100;
+    CHECK(ygo_sig_verify(&card, &sigs[0], keys[0]) == 0);
+    ygo_card_signature_t sig = sigs[1];
+    sig.duelist_id[15] ^= 0x01;
+    CHECK(ygo_sig_verify(&cards[1], &sig, keys[1]) == 0);
+    sig = sigs[2];
+    sig.expiry += 1;
+    CHECK(ygo_sig_verify(&cards[2], &sig, keys[2]) == 0);
+
+    int results[TEST_BATCH];
+    memset(results, 0x5A, sizeof(results));
+    CHECK(ygo_sig_verify_batch(cards, sigs, keys, TEST_BATCH, results) == 1);
+    for (size_t i = 0; i < TEST_BATCH; i++) {
+        CHECK(results[i] == 1);
+    }
+
+    sigs[TEST_BAD_ENTRY].signature[40] ^= 0x01;
+    memset(results, 0x5A, sizeof(results));
+    CHECK(ygo_sig_verify_batch(cards, sigs, keys, TEST_BATCH, results) == 0);
+    for (size_t i = 0; i < TEST_BATCH; i++) {
+        CHECK(results[i] == (i == TEST_BAD_ENTRY ? 0 : 1));
+    }
+    CHECK(ygo_sig_verify_batch(cards, sigs, keys, TEST_BATCH, NULL) == 0);
+}
+
+int main(void) {
+    _check_vectors();
+    _check_vector_batch();
+    _check_cards();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
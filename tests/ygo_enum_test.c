@@ -0,0 +1,108 @@
+/**
+ * @file ygo_enum_test.c
+ * @brief ygo_enum_lookup() over a small table and through the generated *_from_str() functions:
+ * exact names, hyphens and spaces swapped, the wrong case, prefixes and unknown strings.
+ */
+
+#include "internals.h"
+#include "ygo_card.h"
+#include <stdio.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_LONG_NAME "A Name Longer Than The Swap Buffer Of Lookups"
+
+static int failures = 0;
+
+static const ygo_enum_entry_t _entries[] = {
+    {"Beast", 5, 0},
+    {"Beast Warrior", 13, 1},
+    {"Quick-Play", 10, 2},
+    {"Top Right", 9, 3},
+    {"Half-Way There", 14, 4},
+    {TEST_LONG_NAME, (uint8_t)(sizeof(TEST_LONG_NAME) - 1), 5},
+    {"Beastly", 7, 6},
+};
+
+static int _lookup(const char *str) {
+    return ygo_enum_lookup(_entries, sizeof(_entries) / sizeof(_entries[0]), str, strlen(str));
+}
+
+static void _check_table(void) {
+    // Exact names.
+    CHECK(_lookup("Beast") == 0);
+    CHECK(_lookup("Beast Warrior") == 1);
+    CHECK(_lookup("Quick-Play") == 2);
+    CHECK(_lookup("Half-Way There") == 4);
+    CHECK(_lookup(TEST_LONG_NAME) == 5);
+    CHECK(_lookup("Beastly") == 6);
+
+    // Hyphens and spaces stand for each other, all of them at once.
+    CHECK(_lookup("Beast-Warrior") == 1);
+    CHECK(_lookup("Quick Play") == 2);
+    CHECK(_lookup("Top-Right") == 3);
+    CHECK(_lookup("Half Way-There") == 4);
+    CHECK(_lookup("Half-Way-There") == -1);
+    CHECK(_lookup("Half Way There") == -1);
+    CHECK(_lookup("Beast_Warrior") == -1);
+
+    // Past YGO_ENUM_NAME_MAX only the exact spelling matches.
+    CHECK(sizeof(TEST_LONG_NAME) - 1 > YGO_ENUM_NAME_MAX);
+    CHECK(_lookup("A-Name-Longer-Than-The-Swap-Buffer-Of-Lookups") == -1);
+
+    // The case counts.
+    CHECK(_lookup("beast") == -1);
+    CHECK(_lookup("BEAST WARRIOR") == -1);
+    CHECK(_lookup("quick-play") == -1);
+
+    // A prefix of a name, or a name with more after it, is the wrong length.
+    const char *text = "Beast Warrior, Beastly";
+    CHECK(ygo_enum_lookup(_entries, 7, text, 5) == 0);
+    CHECK(ygo_enum_lookup(_entries, 7, text, 13) == 1);
+    CHECK(ygo_enum_lookup(_entries, 7, text, 6) == -1);
+    CHECK(ygo_enum_lookup(_entries, 7, text, 12) == -1);
+    CHECK(ygo_enum_lookup(_entries, 7, text + 15, 7) == 6);
+    CHECK(_lookup("Beas") == -1);
+    CHECK(_lookup("Beasts") == -1);
+    CHECK(_lookup("Top Righ") == -1);
+
+    // Unknown strings, and nothing at all.
+    CHECK(_lookup("Galaxy") == -1);
+    CHECK(_lookup("Bxast") == -1);
+    CHECK(_lookup("") == -1);
+    CHECK(ygo_enum_lookup(_entries, 0, "Beast", 5) == -1);
+}
+
+static void _check_from_str(void) {
+    CHECK(ygo_monster_type_from_str("Winged Beast") == YGO_MONSTER_TYPE_WINGED_BEAST);
+    CHECK(ygo_monster_type_from_str("Winged-Beast") == YGO_MONSTER_TYPE_WINGED_BEAST);
+    CHECK(ygo_monster_type_from_str("Sea-Serpent") == YGO_MONSTER_TYPE_SEA_SERPENT);
+    CHECK(ygo_monster_type_from_str("Beast") == YGO_MONSTER_TYPE_BEAST);
+    CHECK(ygo_monster_type_from_str("Beast-") == _ygo_monster_type_invalid);
+    CHECK(ygo_monster_type_from_str("dragon") == _ygo_monster_type_invalid);
+    CHECK(ygo_monster_type_from_str("Galaxy") == _ygo_monster_type_invalid);
+    CHECK(ygo_monster_type_from_str(NULL) == _ygo_monster_type_invalid);
+
+    CHECK(ygo_spell_type_from_str("Quick-Play") == YGO_SPELL_TYPE_QUICK_PLAY);
+    CHECK(ygo_attribute_from_str("LIGHT") == YGO_ATTRIBUTE_LIGHT);
+    CHECK(ygo_attribute_from_str("Light") == _ygo_attribute_invalid);
+
+    CHECK(ygo_card_link_markers_from_str("Bottom-Left") == YGO_CARD_LINK_BOTTOM_LEFT);
+    CHECK(ygo_card_link_markers_from_str("Bottom Left") == YGO_CARD_LINK_BOTTOM_LEFT);
+    CHECK(ygo_card_link_markers_from_str("Bottom") == YGO_CARD_LINK_BOTTOM);
+    CHECK(ygo_card_link_markers_from_str("Middle") == (ygo_card_link_markers_t)-1);
+}
+
+int main(void) {
+    _check_table();
+    _check_from_str();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
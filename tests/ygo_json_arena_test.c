@@ -0,0 +1,132 @@
+/**
+ * @file ygo_json_arena_test.c
+ * @brief Parses the cardinfo fixture with cJSON through the arena hooks, in a fixed region and in
+ * growable chunks, and checks the cards against a parse with cJSON's own allocator.
+ */
+
+#include "ygo_json_arena.h"
+#include "ygo_json_fixture.h"
+#include <cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static int failures = 0;
+
+typedef struct {
+    ygo_card_t cards[YGO_JSON_FIXTURE_CARDS + 1];
+    ygo_json_err_t errs[YGO_JSON_FIXTURE_CARDS + 1];
+    size_t count;
+} _collected_t;
+
+static void _collect(void *ctx, const ygo_card_t *card, ygo_json_err_t err) {
+    _collected_t *collected = (_collected_t *)ctx;
+    if (collected->count > YGO_JSON_FIXTURE_CARDS) return;
+    collected->cards[collected->count] = *card;
+    collected->errs[collected->count++] = err;
+}
+
+/**
+ * The fixture parsed with cJSON's default allocator, which the arena must not change.
+ */
+static size_t _expected(ygo_card_t *cards) {
+    cJSON *root = cJSON_Parse(ygo_json_fixture);
+    CHECK(root != NULL);
+    size_t n = 0;
+    const cJSON *element;
+    cJSON_ArrayForEach(element, cJSON_GetObjectItemCaseSensitive(root, "data")) {
+        if (n == YGO_JSON_FIXTURE_CARDS) break;
+        memset(&cards[n], 0, sizeof(cards[n]));
+        CHECK(ygo_json_to_card(element, &cards[n]) == YGO_JSON_OK);
+        n++;
+    }
+    cJSON_Delete(root);
+    return n;
+}
+
+static void _check_collected(const _collected_t *collected, const ygo_card_t *expected, size_t n) {
+    CHECK(collected->count == n);
+    for (size_t i = 0; i < collected->count && i < n; i++) {
+        CHECK(collected->errs[i] == YGO_JSON_OK);
+        CHECK(ygo_json_fixture_same_card(&collected->cards[i], &expected[i]));
+    }
+}
+
+static void _check_fixed(const ygo_card_t *expected, size_t n) {
+    static uint8_t memory[64 * 1024];
+    ygo_json_arena_t arena;
+    ygo_json_arena_init_fixed(&arena, memory, sizeof(memory));
+
+    _collected_t collected = {0};
+    size_t len = sizeof(ygo_json_fixture) - 1;
+    CHECK(ygo_json_arena_parse_cards(&arena, ygo_json_fixture, len, _collect, &collected) ==
+          YGO_JSON_OK);
+    _check_collected(&collected, expected, n);
+    CHECK(arena.high_water > 0 && arena.high_water <= arena.reserved);
+    CHECK(arena.used == 0 && arena.allocs == 0 && arena.failed == 0);
+
+    // One card on its own.
+    const char *card = "{\"id\":89631139,\"name\":\"Blue-Eyes White Dragon\",\"type\":\"Normal "
+                       "Monster\",\"atk\":3000,\"def\":2500,\"level\":8,\"race\":\"Dragon\"}";
+    ygo_card_t out;
+    ygo_card_t dragon = expected[1];
+    dragon.attribute = 0;
+    CHECK(ygo_json_arena_parse_card(&arena, card, strlen(card), &out) == YGO_JSON_OK);
+    CHECK(ygo_json_fixture_same_card(&out, &dragon));
+    CHECK(ygo_json_arena_parse_card(&arena, card, strlen(card) - 1, &out) == YGO_JSON_ERR_SYNTAX);
+
+    // A region too small for the dump fails the parse, and no card is passed on.
+    ygo_json_arena_init_fixed(&arena, memory, 512);
+    memset(&collected, 0, sizeof(collected));
+    CHECK(ygo_json_arena_parse_cards(&arena, ygo_json_fixture, len, _collect, &collected) ==
+          YGO_JSON_ERR_NO_MEMORY);
+    CHECK(collected.count == 0 && arena.failed > 0);
+}
+
+static void _check_growable(const ygo_card_t *expected, size_t n) {
+    ygo_json_arena_t arena;
+    ygo_json_arena_init(&arena, 1024);
+
+    // Chunks of the first parse are kept, so the second one allocates nothing.
+    size_t len = sizeof(ygo_json_fixture) - 1;
+    size_t reserved = 0;
+    for (int round = 0; round < 2; round++) {
+        _collected_t collected = {0};
+        CHECK(ygo_json_arena_parse_cards(&arena, ygo_json_fixture, len, _collect, &collected) ==
+              YGO_JSON_OK);
+        _check_collected(&collected, expected, n);
+        CHECK(arena.reserved > 1024 && arena.failed == 0);
+        if (round == 0) reserved = arena.reserved;
+    }
+    CHECK(arena.reserved == reserved);
+
+    // An allocation larger than a chunk gets a chunk of its own.
+    ygo_json_arena_reset(&arena);
+    CHECK(ygo_json_arena_alloc(&arena, 4096) != NULL);
+    CHECK(arena.reserved >= reserved + 4096);
+
+    ygo_json_arena_free(&arena);
+    CHECK(arena.reserved == 0 && arena.chunks == NULL);
+}
+
+int main(void) {
+    ygo_card_t expected[YGO_JSON_FIXTURE_CARDS];
+    size_t n = _expected(expected);
+    CHECK(n == YGO_JSON_FIXTURE_CARDS);
+
+    _check_fixed(expected, n);
+    _check_growable(expected, n);
+
+    // cJSON's own allocator is back once the arena is done.
+    CHECK(n == _expected(expected));
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#ifndef __ygo_json_fixture_h
+#define __ygo_json_fixture_h
+
+/**
+ * @file ygo_json_fixture.h
+ * @brief A cardinfo dump as the YGOPRODeck API returns it, shared by the JSON tests.
+ *
+ * One card of each kind the readers map differently: Normal, Effect, Synchro, Pendulum and Link
+ * monsters, a Spell and a Trap, and races written with a hyphen ("Beast-Warrior"). Each card has
+ * the fields the readers skip too: descriptions with escapes, and nested set, image and price
+ * arrays.
+ */
+
+#include "ygo_card.h"
+
+#define YGO_JSON_FIXTURE_CARDS 10
+
+static const char ygo_json_fixture[] =
+    "{\"data\":[\n"
+    "{\"id\":46986414,\"name\":\"Dark Magician\",\"type\":\"Normal Monster\","
+    "\"frameType\":\"normal\",\"desc\":\"''The ultimate wizard in terms of attack and defense.''\","
+    "\"atk\":2500,\"def\":2100,\"level\":7,\"race\":\"Spellcaster\",\"attribute\":\"DARK\","
+    "\"archetype\":\"Dark Magician\",\"card_sets\":[{\"set_name\":\"Legend of Blue Eyes White "
+    "Dragon\",\"set_code\":\"LOB-EN005\",\"set_rarity\":\"Ultra Rare\",\"set_price\":\"35.5\"}],"
+    "\"card_images\":[{\"id\":46986414,\"image_url\":\"https:\\/\\/images.ygoprodeck.com\\/images"
+    "\\/cards\\/46986414.jpg\"}],\"card_prices\":[{\"cardmarket_price\":\"0.06\","
+    "\"tcgplayer_price\":\"0.14\"}]},\n"
+    "{\"id\":89631139,\"name\":\"Blue-Eyes White Dragon\",\"type\":\"Normal Monster\","
+    "\"desc\":\"This legendary dragon is a powerful engine of destruction.\",\"atk\":3000,"
+    "\"def\":2500,\"level\":8,\"race\":\"Dragon\",\"attribute\":\"LIGHT\","
+    "\"card_sets\":[{\"set_name\":\"Legend of Blue Eyes White Dragon\",\"set_code\":\"LOB-EN001\"},"
+    "{\"set_name\":\"Starter Deck: Kaiba\",\"set_code\":\"SDK-001\"}]},\n"
+    "{\"id\":44508094,\"name\":\"Stardust Dragon\",\"type\":\"Synchro Monster\","
+    "\"desc\":\"1 Tuner + 1+ non-Tuner monsters\\r\\nWhen a card or effect is activated that would "
+    "destroy a card(s) on the field (Quick Effect): You can Tribute this card; negate the "
+    "activation, and if you do, destroy it.\",\"atk\":2500,\"def\":2000,\"level\":8,"
+    "\"race\":\"Dragon\",\"attribute\":\"WIND\"},\n"
+    "{\"id\":16178681,\"name\":\"Odd-Eyes Pendulum Dragon\",\"type\":\"Pendulum Effect Monster\","
+    "\"desc\":\"[ Pendulum Effect ] \\u25cf You can reduce the battle damage you take.\","
+    "\"atk\":2500,\"def\":2000,\"level\":7,\"race\":\"Dragon\",\"attribute\":\"DARK\","
+    "\"scale\":4},\n"
+    "{\"id\":1861629,\"name\":\"Decode Talker\",\"type\":\"Link Monster\","
+    "\"desc\":\"2+ Effect Monsters\",\"atk\":2300,\"race\":\"Cyberse\",\"attribute\":\"DARK\","
+    "\"linkval\":3,\"linkmarkers\":[\"Top\",\"Bottom-Left\",\"Bottom-Right\"]},\n"
+    "{\"id\":5053103,\"name\":\"Enraged Battle Ox\",\"type\":\"Effect Monster\","
+    "\"desc\":\"Beast, Beast-Warrior, and Winged Beast monsters you control inflict piercing "
+    "battle damage.\",\"atk\":1700,\"def\":1000,\"level\":4,\"race\":\"Beast-Warrior\","
+    "\"attribute\":\"EARTH\"},\n"
+    "{\"id\":76812113,\"name\":\"Harpie Lady\",\"type\":\"Normal Monster\","
+    "\"desc\":\"This human-shaped animal with wings is beautiful to watch but deadly in battle.\","
+    "\"atk\":1300,\"def\":1400,\"level\":4,\"race\":\"Winged Beast\",\"attribute\":\"WIND\"},\n"
+    "{\"id\":10000000,\"name\":\"Obelisk the Tormentor\",\"type\":\"Effect Monster\","
+    "\"desc\":\"Requires 3 Tributes to Normal Summon (cannot be Normal Set).\",\"atk\":4000,"
+    "\"def\":4000,\"level\":10,\"race\":\"Divine-Beast\",\"attribute\":\"DIVINE\"},\n"
+    "{\"id\":55144522,\"name\":\"Pot of Greed\",\"type\":\"Spell Card\","
+    "\"desc\":\"Draw 2 cards.\",\"race\":\"Normal\",\"card_sets\":[]},\n"
+    "{\"id\":44095762,\"name\":\"Mirror Force\",\"type\":\"Trap Card\","
+    "\"desc\":\"When an opponent's monster declares an attack: Destroy all your opponent's "
+    "Attack Position monsters.\",\"race\":\"Normal\"}\n"
+    "]}\n";
+
+/**
+ * Whether two cards hold the same fields, padding aside.
+ */
+static inline int ygo_json_fixture_same_card(const ygo_card_t *a, const ygo_card_t *b) {
+    return a->id == b->id && a->type == b->type && a->flags == b->flags &&
+           a->monster_type == b->monster_type && a->ability == b->ability &&
+           a->summon == b->summon && a->attribute == b->attribute && a->atk == b->atk &&
+           a->def == b->def && a->level == b->level && a->scale == b->scale &&
+           a->link_markers == b->link_markers &&
+           strncmp(a->name, b->name, YGO_CARD_NAME_MAX_LEN) == 0;
+}
+
+#endif /* __ygo_json_fixture_h */
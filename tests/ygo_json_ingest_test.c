@@ -0,0 +1,231 @@
+/**
+ * @file ygo_json_ingest_test.c
+ * @brief ygo_json_ingest() over a generated dump spanning many blocks and runs: the same cards
+ * and errors, byte for byte, with 1 thread and with several, matching ygo_json_stream read in
+ * order then sorted by id. Broken text is a syntax error with any number of threads.
+ */
+
+#include "ygo_json_ingest.h"
+#include "ygo_json_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+// Enough elements for several blocks of text and many runs.
+#define TEST_ELEMENTS 3000
+#define TEST_BAD_EVERY 97
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * A dump of TEST_ELEMENTS elements, with repeated ids, descriptions full of brackets, commas and
+ * escaped quotes, and every TEST_BAD_EVERY-th element one which isn't a card.
+ * @return Length of the text, 0 if it didn't fit
+ */
+static size_t _generate(char *json, size_t max) {
+    static const char *const types[] = {"Normal Monster", "Effect Monster", "Spell Card",
+                                        "Trap Card", "Link Monster", "Synchro Monster"};
+    size_t n = (size_t)snprintf(json, max, "{\"meta\":{\"data\":[1,2]},\"data\":[\n");
+    for (size_t i = 0; i < TEST_ELEMENTS && n < max; i++) {
+        uint32_t id = 1000 + (uint32_t)(_rng() % (TEST_ELEMENTS / 2));
+        const char *sep = i + 1 < TEST_ELEMENTS ? ",\n" : "\n";
+        if (i % TEST_BAD_EVERY == 5) {
+            n += (size_t)snprintf(json + n, max - n, "{\"id\":%u,\"name\":\"No type\"}%s", id, sep);
+            continue;
+        }
+        n += (size_t)snprintf(json + n, max - n,
+                              "{\"id\":%u,\"name\":\"Card %zu [\\\"x\\\"]\",\"type\":\"%s\","
+                              "\"desc\":\"{not: [an, object]} \\\\\\\" ,]}\",\"atk\":%u,"
+                              "\"level\":%u,\"race\":\"Dragon\",\"card_sets\":[{\"a\":[1,[2]]}]}%s",
+                              id, i, types[i % 6], (unsigned)(_rng() % 5000),
+                              (unsigned)(1 + _rng() % 12), sep);
+    }
+    n += (size_t)snprintf(json + n, max - n, "]}\n");
+    return n < max ? n : 0;
+}
+
+typedef struct {
+    ygo_card_t card;
+    size_t element;
+} _ordered_t;
+
+static int _compare_ordered(const void *a, const void *b) {
+    const _ordered_t *x = (const _ordered_t *)a;
+    const _ordered_t *y = (const _ordered_t *)b;
+    if (x->card.id != y->card.id) return x->card.id < y->card.id ? -1 : 1;
+    return (x->element > y->element) - (x->element < y->element);
+}
+
+/**
+ * The expected result: every element read in order by ygo_json_stream, cards sorted by id then
+ * position.
+ */
+static void _expected(const char *json, size_t len, ygo_json_ingest_t *expected) {
+    _ordered_t *ordered = (_ordered_t *)malloc(TEST_ELEMENTS * sizeof(_ordered_t));
+    expected->cards = (ygo_card_t *)malloc(TEST_ELEMENTS * sizeof(ygo_card_t));
+    expected->errors = (ygo_json_ingest_error_t *)malloc(TEST_ELEMENTS * sizeof(*expected->errors));
+    expected->count = 0;
+    expected->error_count = 0;
+    expected->elements = 0;
+
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, json, len);
+    for (;;) {
+        ygo_card_t card;
+        ygo_json_err_t err = ygo_json_stream_next(&stream, &card);
+        if (err == YGO_JSON_ERR_END_OF_DATA || err == YGO_JSON_ERR_SYNTAX) {
+            CHECK(err == YGO_JSON_ERR_END_OF_DATA);
+            break;
+        }
+        if (expected->elements == TEST_ELEMENTS) break;
+        if (err == YGO_JSON_OK) {
+            ordered[expected->count].card = card;
+            ordered[expected->count++].element = expected->elements;
+        } else {
+            expected->errors[expected->error_count].element = (uint32_t)expected->elements;
+            expected->errors[expected->error_count++].err = err;
+        }
+        expected->elements++;
+    }
+
+    qsort(ordered, expected->count, sizeof(_ordered_t), _compare_ordered);
+    for (size_t i = 0; i < expected->count; i++) expected->cards[i] = ordered[i].card;
+    free(ordered);
+}
+
+static void _check_same(const ygo_json_ingest_t *ingest, const ygo_json_ingest_t *expected) {
+    CHECK(ingest->elements == expected->elements);
+    CHECK(ingest->count == expected->count);
+    CHECK(ingest->error_count == expected->error_count);
+    if (ingest->count == expected->count) {
+        CHECK(memcmp(ingest->cards, expected->cards, ingest->count * sizeof(ygo_card_t)) == 0);
+    }
+    if (ingest->error_count == expected->error_count) {
+        for (size_t i = 0; i < ingest->error_count; i++) {
+            CHECK(ingest->errors[i].element == expected->errors[i].element);
+            CHECK(ingest->errors[i].err == expected->errors[i].err);
+        }
+    }
+}
+
+static void _check_dump(const char *json, size_t len) {
+    CHECK(len > 2 * YGO_JSON_INGEST_BLOCK_LEN);
+
+    ygo_json_ingest_t expected;
+    _expected(json, len, &expected);
+    CHECK(expected.elements == TEST_ELEMENTS);
+    CHECK(expected.error_count == (TEST_ELEMENTS - 5 + TEST_BAD_EVERY - 1) / TEST_BAD_EVERY);
+
+    ygo_json_ingest_t single;
+    CHECK(ygo_json_ingest(&single, json, len, 1) == YGO_JSON_OK);
+    CHECK(single.threads == 1);
+    _check_same(&single, &expected);
+
+    static const unsigned threads[] = {2, 3, 8, 0};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        ygo_json_ingest_t ingest;
+        CHECK(ygo_json_ingest(&ingest, json, len, threads[t]) == YGO_JSON_OK);
+        CHECK(ingest.threads >= 1);
+        _check_same(&ingest, &single);
+        ygo_json_ingest_free(&ingest);
+    }
+
+    ygo_json_ingest_free(&single);
+    free(expected.cards);
+    free(expected.errors);
+}
+
+/**
+ * The same syntax error, at the same offset, with 1 thread and with several, and nothing else
+ * returned.
+ */
+static void _check_broken(const char *json, size_t len, size_t near) {
+    size_t offset = 0;
+    static const unsigned threads[] = {1, 2, 8};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        ygo_json_ingest_t ingest;
+        CHECK(ygo_json_ingest(&ingest, json, len, threads[t]) == YGO_JSON_ERR_SYNTAX);
+        CHECK(ingest.cards == NULL && ingest.count == 0);
+        CHECK(ingest.errors == NULL && ingest.error_count == 0);
+        CHECK(ingest.offset <= len && ingest.offset + 64 >= near);
+        if (t == 0) offset = ingest.offset;
+        CHECK(ingest.offset == offset);
+        ygo_json_ingest_free(&ingest);
+    }
+}
+
+static void _check_malformed(char *json, size_t len) {
+    // A record far into the text with a comma missing between two fields.
+    const char *needle = "\"name\":\"Card 2500 ";
+    char *record = strstr(json, needle);
+    CHECK(record != NULL);
+    if (record == NULL) return;
+    char *comma = strchr(record + strlen(needle), '\"');
+    comma = strstr(comma, "\",\"type\"");
+    CHECK(comma != NULL);
+    if (comma == NULL) return;
+    comma[1] = ' ';
+    _check_broken(json, len, (size_t)(comma - json));
+    comma[1] = ',';
+
+    // A quote missing turns the rest of the text inside out.
+    record[0] = ' ';
+    _check_broken(json, len, (size_t)(record - json));
+    record[0] = '\"';
+
+    // Cut short before the end of data[], and a bracket too many in a record.
+    _check_broken(json, len - 4, len - 4);
+    char *sets = strstr(record, "[2]]");
+    CHECK(sets != NULL);
+    if (sets == NULL) return;
+    sets[3] = '}';
+    _check_broken(json, len, (size_t)(sets - json));
+    sets[3] = ']';
+
+    // Put back together, the text reads again.
+    ygo_json_ingest_t ingest;
+    CHECK(ygo_json_ingest(&ingest, json, len, 4) == YGO_JSON_OK);
+    CHECK(ingest.elements == TEST_ELEMENTS);
+    ygo_json_ingest_free(&ingest);
+}
+
+int main(void) {
+    size_t max = 2 * 1024 * 1024;
+    char *json = (char *)malloc(max);
+    size_t len = _generate(json, max);
+    CHECK(len > 0);
+
+    _check_dump(json, len);
+    _check_malformed(json, len);
+
+    ygo_json_ingest_t ingest;
+    CHECK(ygo_json_ingest(&ingest, "[]", 2, 4) == YGO_JSON_OK && ingest.elements == 0);
+    ygo_json_ingest_free(&ingest);
+    static const char blank[] = "{\"data\":[\x01\t\x1f]}";
+    CHECK(ygo_json_ingest(&ingest, blank, sizeof(blank) - 1, 4) == YGO_JSON_OK);
+    CHECK(ingest.elements == 0 && ingest.error_count == 0);
+    ygo_json_ingest_free(&ingest);
+    CHECK(ygo_json_ingest(&ingest, NULL, 0, 4) == YGO_JSON_ERR_NULL_INPUT);
+    ygo_json_ingest_free(&ingest);
+    free(json);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
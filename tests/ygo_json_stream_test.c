@@ -0,0 +1,236 @@
+/**
+ * @file ygo_json_stream_test.c
+ * @brief ygo_json_stream over the cardinfo fixture, whole and through a reader returning it in
+ * pieces of every size up to a few chunks, and over documents at the edges of what it reads:
+ * nesting around YGO_JSON_STREAM_MAX_DEPTH, keys longer than its key buffer and white space
+ * made of control characters.
+ */
+
+#include "ygo_json_fixture.h"
+#include "ygo_json_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_DOC_MAX 4096
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * Input handed out piece by piece: step bytes at a time, or a random size up to a few chunks
+ * when step is 0, never more than asked for.
+ */
+typedef struct {
+    const char *json;
+    size_t len;
+    size_t pos;
+    size_t step;
+} _reader_t;
+
+static size_t _read(void *ctx, char *buffer, size_t len) {
+    _reader_t *reader = (_reader_t *)ctx;
+    size_t n = reader->step != 0 ? reader->step : 1 + (size_t)(_rng() % 700);
+    if (n > len) n = len;
+    if (n > reader->len - reader->pos) n = reader->len - reader->pos;
+    memcpy(buffer, reader->json + reader->pos, n);
+    reader->pos += n;
+    return n;
+}
+
+/**
+ * Read every element of stream into cards, errors into errs.
+ * @return Number of elements, the final status in end
+ */
+static size_t _read_all(ygo_json_stream_t *stream,
+                        ygo_card_t *cards,
+                        ygo_json_err_t *errs,
+                        size_t max,
+                        ygo_json_err_t *end) {
+    size_t n = 0;
+    for (;;) {
+        ygo_card_t card;
+        ygo_json_err_t err = ygo_json_stream_next(stream, &card);
+        if (err == YGO_JSON_ERR_END_OF_DATA || err == YGO_JSON_ERR_SYNTAX) {
+            *end = err;
+            return n;
+        }
+        if (n < max) {
+            cards[n] = card;
+            errs[n] = err;
+        }
+        n++;
+    }
+}
+
+static ygo_json_err_t _read_one(const char *json, ygo_card_t *card) {
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, json, strlen(json));
+    return ygo_json_stream_next(&stream, card);
+}
+
+static void _check_fixture_cards(const ygo_card_t *cards) {
+    CHECK(cards[0].id == 46986414 && strcmp(cards[0].name, "Dark Magician") == 0);
+    CHECK(cards[0].type == YGO_CARD_TYPE_MONSTER && cards[0].atk == 2500 && cards[0].def == 2100);
+    CHECK(cards[0].monster_type == YGO_MONSTER_TYPE_SPELLCASTER && cards[0].level == 7);
+    CHECK(cards[1].id == 89631139 && cards[1].attribute == YGO_ATTRIBUTE_LIGHT);
+    CHECK(cards[2].summon == YGO_SUMMON_TYPE_SYNCHRO && cards[2].attribute == YGO_ATTRIBUTE_WIND);
+    CHECK((cards[3].flags & YGO_MONSTER_FLAG_PENDULUM) && cards[3].scale == 4);
+    CHECK(cards[4].summon == YGO_SUMMON_TYPE_LINK && cards[4].link_value == 3);
+    CHECK(cards[4].link_markers ==
+          (YGO_CARD_LINK_TOP | YGO_CARD_LINK_BOTTOM_LEFT | YGO_CARD_LINK_BOTTOM_RIGHT));
+    CHECK(cards[5].monster_type == YGO_MONSTER_TYPE_BEAST_WARRIOR);
+    CHECK(cards[6].monster_type == YGO_MONSTER_TYPE_WINGED_BEAST);
+    CHECK(cards[7].monster_type == YGO_MONSTER_TYPE_DIVINE_BEAST);
+    CHECK(cards[8].type == YGO_CARD_TYPE_SPELL && cards[8].spell_type == YGO_SPELL_TYPE_NORMAL);
+    CHECK(cards[9].type == YGO_CARD_TYPE_TRAP && strcmp(cards[9].name, "Mirror Force") == 0);
+}
+
+/**
+ * The fixture from memory, then from readers cutting it at every offset.
+ */
+static void _check_fixture(void) {
+    size_t len = sizeof(ygo_json_fixture) - 1;
+    ygo_card_t expected[YGO_JSON_FIXTURE_CARDS];
+    ygo_json_err_t errs[YGO_JSON_FIXTURE_CARDS];
+    ygo_json_err_t end;
+
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, ygo_json_fixture, len);
+    CHECK(_read_all(&stream, expected, errs, YGO_JSON_FIXTURE_CARDS, &end) ==
+          YGO_JSON_FIXTURE_CARDS);
+    CHECK(end == YGO_JSON_ERR_END_OF_DATA);
+    for (size_t i = 0; i < YGO_JSON_FIXTURE_CARDS; i++) {
+        CHECK(errs[i] == YGO_JSON_OK);
+    }
+    _check_fixture_cards(expected);
+    CHECK(ygo_json_stream_next(&stream, &expected[0]) == YGO_JSON_ERR_END_OF_DATA);
+
+    // Steps 1 to a little over a chunk, then random ones.
+    for (size_t step = 0; step <= YGO_JSON_STREAM_CHUNK + 3; step++) {
+        for (int round = 0; round < (step == 0 ? 64 : 1); round++) {
+            _reader_t reader = {ygo_json_fixture, len, 0, step};
+            ygo_json_stream_init_reader(&stream, _read, &reader);
+            ygo_card_t cards[YGO_JSON_FIXTURE_CARDS];
+            size_t n = _read_all(&stream, cards, errs, YGO_JSON_FIXTURE_CARDS, &end);
+            CHECK(n == YGO_JSON_FIXTURE_CARDS && end == YGO_JSON_ERR_END_OF_DATA);
+            for (size_t i = 0; i < n && i < YGO_JSON_FIXTURE_CARDS; i++) {
+                int same = ygo_json_fixture_same_card(&cards[i], &expected[i]);
+                if (errs[i] != YGO_JSON_OK || !same) {
+                    fprintf(stderr, "step %zu: card %zu differs\n", step, i);
+                    failures++;
+                }
+            }
+        }
+    }
+
+    // Cut short anywhere, the document is a syntax error, never a shorter list.
+    for (size_t cut = 0; cut < len - 2; cut += 7) {
+        ygo_card_t cards[YGO_JSON_FIXTURE_CARDS];
+        ygo_json_stream_init_buffer(&stream, ygo_json_fixture, cut);
+        _read_all(&stream, cards, errs, YGO_JSON_FIXTURE_CARDS, &end);
+        CHECK(end == YGO_JSON_ERR_SYNTAX);
+    }
+}
+
+/**
+ * A card whose "card_sets" holds depth nested arrays.
+ */
+static ygo_json_err_t _read_nested(size_t depth) {
+    static char json[TEST_DOC_MAX];
+    size_t n = (size_t)snprintf(json, sizeof(json), "[{\"id\":1,\"card_sets\":");
+    for (size_t i = 0; i < depth; i++) json[n++] = '[';
+    for (size_t i = 0; i < depth; i++) json[n++] = ']';
+    n += (size_t)snprintf(json + n, sizeof(json) - n, ",\"name\":\"Deep\",\"type\":\"Token\"}]");
+
+    ygo_card_t card;
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, json, n);
+    ygo_json_err_t err = ygo_json_stream_next(&stream, &card);
+    if (err == YGO_JSON_OK) CHECK(card.id == 1 && strcmp(card.name, "Deep") == 0);
+    return err;
+}
+
+static void _check_nesting(void) {
+    CHECK(_read_nested(1) == YGO_JSON_OK);
+    CHECK(_read_nested(YGO_JSON_STREAM_MAX_DEPTH - 1) == YGO_JSON_OK);
+    CHECK(_read_nested(YGO_JSON_STREAM_MAX_DEPTH) == YGO_JSON_ERR_SYNTAX);
+    CHECK(_read_nested(1000) == YGO_JSON_ERR_SYNTAX);
+}
+
+static void _check_long_keys(void) {
+    ygo_card_t card;
+
+    // Keys past the key buffer are skipped with their values, even when they start like a card
+    // key, and the ones after them still count.
+    CHECK(_read_one("[{\"id_of_the_card_in_the_old_database_schema\":5,"
+                    "\"namenamenamenamenamenamenamenamename\":\"Wrong\","
+                    "\"a_key_well_past_thirty_two_bytes_long\":{\"id\":[1,{\"x\":2}]},"
+                    "\"id\":7,\"name\":\"Right\",\"type\":\"Normal Monster\"}]",
+                    &card) == YGO_JSON_OK);
+    CHECK(card.id == 7 && strcmp(card.name, "Right") == 0);
+
+    // Escapes count as the bytes they decode to.
+    CHECK(_read_one("[{\"\\u0069\\u0064\":8,\"name\":\"Escaped\",\"type\":\"Token\"}]", &card) ==
+          YGO_JSON_OK);
+    CHECK(card.id == 8);
+
+    // Nor does a long key before "data" hide the array.
+    CHECK(_read_one("{\"meta_data_with_a_rather_long_key_name\":{\"data\":[1]},"
+                    "\"data\":[{\"id\":9,\"name\":\"Nine\",\"type\":\"Token\"}]}",
+                    &card) == YGO_JSON_OK);
+    CHECK(card.id == 9);
+}
+
+/**
+ * Control characters between tokens are white space, as cJSON skips them. DEL (0x7f) is not.
+ */
+static void _check_white_space(void) {
+    static const char spaced[] = "\x01[\x0b{\f\"id\"\x1f:\x02" "10\x1e,\"name\"\x7f:\"A\\u0001B\","
+                                 "\"type\":\x10\"Token\"\x11}\x08,\x0c{\"id\":11,\"name\":"
+                                 "\"C\",\"type\":\"Token\"}\x1a]\x03";
+    ygo_card_t cards[2];
+    ygo_json_err_t errs[2];
+    ygo_json_err_t end;
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, spaced, sizeof(spaced) - 1);
+    _read_all(&stream, cards, errs, 2, &end);
+
+    // 0x7f is not white space, so the first card's name key is broken.
+    CHECK(end == YGO_JSON_ERR_SYNTAX);
+    CHECK(stream.count == 1);
+
+    static const char controls[] = "\x01[\x0b{\f\"id\"\x1f:\x02" "10\x1e,\"name\":\"A\","
+                                   "\"type\":\x10\"Token\"\x11}\x08,\x0c{\"id\":11,\"name\":"
+                                   "\"C\",\"type\":\"Token\"}\x1a]\x03";
+    ygo_json_stream_init_buffer(&stream, controls, sizeof(controls) - 1);
+    CHECK(_read_all(&stream, cards, errs, 2, &end) == 2);
+    CHECK(end == YGO_JSON_ERR_END_OF_DATA);
+    CHECK(errs[0] == YGO_JSON_OK && cards[0].id == 10 && strcmp(cards[0].name, "A") == 0);
+    CHECK(errs[1] == YGO_JSON_OK && cards[1].id == 11);
+}
+
+int main(void) {
+    _check_fixture();
+    _check_nesting();
+    _check_long_keys();
+    _check_white_space();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file ygo_json_test.c
+ * @brief ygo_json_to_card() over a cJSON tree against ygo_json_stream over the same text, card by
+ * card: the same error for each element and the same fields for each card read.
+ *
+ * Besides the cardinfo fixture, a document of awkward elements: hyphens and spaces swapped in
+ * races and link markers, numeric fields next to string ones, repeated keys, values of the wrong
+ * type, names too long and elements which aren't cards.
+ */
+
+#include "ygo_json_fixture.h"
+#include "ygo_json_stream.h"
+#include <cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static int failures = 0;
+
+static const char _awkward[] =
+    "[\n"
+    "{\"id\":1,\"name\":\"Spaced\",\"type\":\"Effect Monster\",\"race\":\"Beast Warrior\","
+    "\"attribute\":\"EARTH\"},\n"
+    "{\"id\":2,\"name\":\"Hyphenated\",\"type\":\"Effect Monster\",\"race\":\"Sea-Serpent\","
+    "\"attribute\":\"WATER\"},\n"
+    "{\"id\":3,\"name\":\"Markers\",\"type\":\"Link Monster\",\"race\":\"Cyberse\",\"linkval\":4,"
+    "\"linkmarkers\":[\"Top Right\",\"Bottom-Left\",\"Left\",\"Middle\",7]},\n"
+    "{\"id\":4,\"name\":\"Numeric\",\"type\":\"Spell Card\",\"type_id\":128,\"flags_id\":32,"
+    "\"summon_id\":96,\"monster_type_id\":4,\"attribute_id\":2,\"link_markers_id\":5,"
+    "\"race\":\"Dragon\",\"attribute\":\"DARK\",\"linkmarkers\":[\"Top\"]},\n"
+    "{\"id\":5,\"id\":6,\"name\":\"First\",\"name\":\"Second\",\"type\":\"Normal Monster\","
+    "\"atk\":100,\"atk\":200},\n"
+    "{\"id\":\"7\",\"name\":\"String id\",\"type\":\"Normal Monster\"},\n"
+    "{\"id\":8,\"name\":8,\"type\":\"Normal Monster\"},\n"
+    "{\"id\":9,\"name\":\"No type\"},\n"
+    "{\"id\":10,\"name\":\"Bad type\",\"type\":\"Nonsense\"},\n"
+    "{\"id\":11,\"name\":\"A name far longer than the sixty three bytes a card has room for in "
+    "its name field\",\"type\":\"Trap Card\",\"race\":\"Counter\"},\n"
+    "{\"id\":12,\"name\":\"Wrong types\",\"type\":\"Normal Monster\",\"atk\":\"1000\",\"def\":null,"
+    "\"level\":[4],\"race\":7,\"attribute\":{\"x\":1},\"linkmarkers\":\"Top\"},\n"
+    "{\"id\":13,\"name\":\"Unknown race\",\"type\":\"Effect Monster\",\"race\":\"Galaxy\","
+    "\"attribute\":\"LAUGH\",\"atk\":65535,\"def\":-1,\"level\":3.7},\n"
+    "{\"id\":14,\"name\":\"Esc\\u00e9ped \\\"name\\\"\",\"type\":\"Quick-Play Spell Card\","
+    "\"race\":\"Quick-Play\"},\n"
+    "5,\n"
+    "\"string\",\n"
+    "[1,2],\n"
+    "{}\n"
+    "]\n";
+
+/**
+ * Read every element of json both ways and compare them.
+ * @return Number of elements read as cards
+ */
+static size_t _compare(const char *json, size_t len) {
+    cJSON *root = cJSON_ParseWithLength(json, len);
+    CHECK(root != NULL);
+    if (root == NULL) return 0;
+    const cJSON *data = cJSON_IsArray(root) ? root : cJSON_GetObjectItemCaseSensitive(root, "data");
+    CHECK(cJSON_IsArray(data));
+
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, json, len);
+
+    size_t index = 0;
+    size_t cards = 0;
+    const cJSON *element;
+    cJSON_ArrayForEach(element, data) {
+        ygo_card_t expected;
+        memset(&expected, 0, sizeof(expected));
+        ygo_json_err_t expected_err = ygo_json_to_card(element, &expected);
+
+        ygo_card_t card;
+        ygo_json_err_t err = ygo_json_stream_next(&stream, &card);
+        if (err != expected_err) {
+            fprintf(stderr, "element %zu: stream %d, cJSON %d\n", index, err, expected_err);
+            failures++;
+        } else if (err == YGO_JSON_OK) {
+            if (!ygo_json_fixture_same_card(&card, &expected)) {
+                fprintf(stderr, "element %zu: cards differ\n", index);
+                failures++;
+            }
+            cards++;
+        }
+        index++;
+    }
+    ygo_card_t card;
+    CHECK(ygo_json_stream_next(&stream, &card) == YGO_JSON_ERR_END_OF_DATA);
+
+    cJSON_Delete(root);
+    return cards;
+}
+
+int main(void) {
+    CHECK(_compare(ygo_json_fixture, sizeof(ygo_json_fixture) - 1) == YGO_JSON_FIXTURE_CARDS);
+    CHECK(_compare(_awkward, sizeof(_awkward) - 1) > 0);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
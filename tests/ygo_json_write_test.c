@@ -0,0 +1,176 @@
+/**
+ * @file ygo_json_write_test.c
+ * @brief ygo_card_to_json() and ygo_cards_to_json() read back by ygo_json_stream: the numeric
+ * schema keeps random cards byte for byte, the API one the fields of the cardinfo fixture. Short
+ * buffers are cut as snprintf() cuts them, and a name filling the whole field comes back a byte
+ * shorter.
+ */
+
+#include "ygo_json.h"
+#include "ygo_json_fixture.h"
+#include "ygo_json_stream.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_CARDS 500
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * Any value in every field, and a name of up to 63 bytes mixing quotes, backslashes, control
+ * characters and UTF-8.
+ */
+static void _random_card(ygo_card_t *card) {
+    static const char bytes[] = "aZ09 -'\"\\/\n\t\r\x01\x1f\x7f\xc3\xa9";
+    uint8_t *raw = (uint8_t *)card;
+    memset(card, 0, sizeof(*card));
+    for (size_t i = 0; i < offsetof(ygo_card_t, name); i++) raw[i] = (uint8_t)_rng();
+    size_t len = (size_t)(_rng() % YGO_CARD_NAME_MAX_LEN);
+    for (size_t i = 0; i < len; i++) card->name[i] = bytes[_rng() % (sizeof(bytes) - 1)];
+}
+
+static size_t _read_back(const char *json, size_t len, ygo_card_t *cards, size_t max) {
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_buffer(&stream, json, len);
+    size_t n = 0;
+    ygo_json_err_t err;
+    ygo_card_t card;
+    while ((err = ygo_json_stream_next(&stream, &card)) == YGO_JSON_OK) {
+        if (n < max) cards[n] = card;
+        n++;
+    }
+    CHECK(err == YGO_JSON_ERR_END_OF_DATA);
+    return n;
+}
+
+static void _check_numeric(void) {
+    static ygo_card_t cards[TEST_CARDS];
+    static ygo_card_t back[TEST_CARDS];
+    for (size_t i = 0; i < TEST_CARDS; i++) _random_card(&cards[i]);
+
+    // One at a time, then the whole dump.
+    char text[YGO_JSON_CARD_MAX_LEN + 1];
+    for (size_t i = 0; i < TEST_CARDS; i++) {
+        size_t n = ygo_card_to_json(&cards[i], YGO_JSON_SCHEMA_NUMERIC, text, sizeof(text));
+        CHECK(n <= YGO_JSON_CARD_MAX_LEN && text[n] == '\0');
+        ygo_card_t card;
+        ygo_json_stream_t stream;
+        ygo_json_stream_init_slice(&stream, text, n);
+        CHECK(ygo_json_stream_next(&stream, &card) == YGO_JSON_OK);
+        CHECK(memcmp(&card, &cards[i], sizeof(card)) == 0);
+    }
+
+    size_t len = ygo_cards_to_json(cards, TEST_CARDS, YGO_JSON_SCHEMA_NUMERIC, NULL, 0);
+    char *json = (char *)malloc(len + 1);
+    CHECK(ygo_cards_to_json(cards, TEST_CARDS, YGO_JSON_SCHEMA_NUMERIC, json, len + 1) == len);
+    CHECK(_read_back(json, len, back, TEST_CARDS) == TEST_CARDS);
+    CHECK(memcmp(back, cards, sizeof(cards)) == 0);
+    free(json);
+
+    CHECK(ygo_cards_to_json(NULL, 0, YGO_JSON_SCHEMA_NUMERIC, text, sizeof(text)) == 11);
+    CHECK(strcmp(text, "{\"data\":[]}") == 0);
+    CHECK(ygo_card_to_json(NULL, YGO_JSON_SCHEMA_NUMERIC, text, sizeof(text)) == 0);
+}
+
+static void _check_api(void) {
+    ygo_card_t cards[YGO_JSON_FIXTURE_CARDS];
+    ygo_card_t back[YGO_JSON_FIXTURE_CARDS];
+    CHECK(_read_back(ygo_json_fixture, sizeof(ygo_json_fixture) - 1, cards,
+                     YGO_JSON_FIXTURE_CARDS) == YGO_JSON_FIXTURE_CARDS);
+
+    static char json[16 * 1024];
+    size_t len = ygo_cards_to_json(cards, YGO_JSON_FIXTURE_CARDS, YGO_JSON_SCHEMA_API, json,
+                                   sizeof(json));
+    CHECK(len < sizeof(json));
+    CHECK(_read_back(json, len, back, YGO_JSON_FIXTURE_CARDS) == YGO_JSON_FIXTURE_CARDS);
+    for (size_t i = 0; i < YGO_JSON_FIXTURE_CARDS; i++) {
+        CHECK(ygo_json_fixture_same_card(&back[i], &cards[i]));
+    }
+}
+
+/**
+ * Every buffer length up to a little over the text: len - 1 bytes of it and a NUL, the full
+ * length returned each time, and nothing written past len.
+ */
+static void _check_truncation(void) {
+    ygo_card_t cards[3];
+    for (size_t i = 0; i < 3; i++) _random_card(&cards[i]);
+
+    char full[3 * YGO_JSON_CARD_MAX_LEN];
+    size_t needed = ygo_cards_to_json(cards, 3, YGO_JSON_SCHEMA_API, full, sizeof(full));
+    CHECK(needed < sizeof(full) && full[needed] == '\0');
+    CHECK(ygo_cards_to_json(cards, 3, YGO_JSON_SCHEMA_API, NULL, 0) == needed);
+
+    char text[3 * YGO_JSON_CARD_MAX_LEN];
+    for (size_t len = 0; len <= needed + 2; len++) {
+        memset(text, '#', sizeof(text));
+        CHECK(ygo_cards_to_json(cards, 3, YGO_JSON_SCHEMA_API, text, len) == needed);
+        size_t kept = len == 0 ? 0 : len - 1 < needed ? len - 1 : needed;
+        if (len > 0 && (memcmp(text, full, kept) != 0 || text[kept] != '\0')) {
+            fprintf(stderr, "len %zu: wrong text\n", len);
+            failures++;
+        }
+        if (text[len == 0 ? 0 : kept + 1] != '#') {
+            fprintf(stderr, "len %zu: written past the end\n", len);
+            failures++;
+        }
+    }
+
+    // One byte short, the closing brace is cut, as snprintf() would.
+    CHECK(ygo_cards_to_json(cards, 3, YGO_JSON_SCHEMA_API, text, needed) == needed);
+    CHECK(strlen(text) == needed - 1 && text[needed - 2] == ']');
+
+    size_t one = ygo_card_to_json(&cards[0], YGO_JSON_SCHEMA_NUMERIC, NULL, 0);
+    CHECK(ygo_card_to_json(&cards[0], YGO_JSON_SCHEMA_NUMERIC, text, one) == one);
+    CHECK(strlen(text) == one - 1);
+}
+
+static void _check_full_name(void) {
+    ygo_card_t card;
+    _random_card(&card);
+    memset(card.name, 'N', YGO_CARD_NAME_MAX_LEN);
+
+    // Written whole, all 64 bytes of it.
+    char text[YGO_JSON_CARD_MAX_LEN + 1];
+    size_t n = ygo_card_to_json(&card, YGO_JSON_SCHEMA_NUMERIC, text, sizeof(text));
+    char name[YGO_CARD_NAME_MAX_LEN + 11];
+    snprintf(name, sizeof(name), "\"name\":\"%.*s\"", YGO_CARD_NAME_MAX_LEN, card.name);
+    CHECK(strstr(text, name) != NULL);
+
+    // Read back, the last byte makes way for the NUL.
+    ygo_card_t back;
+    ygo_json_stream_t stream;
+    ygo_json_stream_init_slice(&stream, text, n);
+    CHECK(ygo_json_stream_next(&stream, &back) == YGO_JSON_OK);
+    CHECK(strlen(back.name) == YGO_CARD_NAME_MAX_LEN - 1);
+    CHECK(memcmp(back.name, card.name, YGO_CARD_NAME_MAX_LEN - 1) == 0);
+    CHECK(back.id == card.id && back.atk == card.atk && back.link_markers == card.link_markers);
+}
+
+int main(void) {
+    _check_numeric();
+    _check_api();
+    _check_truncation();
+    _check_full_name();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,358 @@
+/**
+ * @file ygo_roaring_test.c
+ * @brief ygo_roaring against a plain bitset: AND, OR, AND NOT and their cardinality between sets
+ * made of ARRAY, BITMAP and RUN containers, and ygo_facet bitmaps and counts over a card table
+ * against a loop over its cards.
+ */
+
+#include "internals.h"
+#include "ygo_facet.h"
+#include "ygo_roaring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+// Four whole containers and part of a fifth.
+#define TEST_ROWS (4 * 65536 + 1000)
+#define TEST_WORDS ((TEST_ROWS + 63) / 64)
+#define TEST_SETS 8
+#define TEST_CARDS 70000
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+typedef struct {
+    ygo_roaring_t r;
+    uint64_t bits[TEST_WORDS];
+} _set_t;
+
+static void _add(_set_t *set, uint32_t row) {
+    CHECK(ygo_roaring_add(&set->r, row) == YGO_BIN_OK);
+    set->bits[row / 64] |= 1ull << (row % 64);
+}
+
+/**
+ * A set whose containers are, key by key, empty, a few random rows, most rows, or long stretches
+ * of rows, some added out of order.
+ */
+static void _random_set(_set_t *set) {
+    ygo_roaring_init(&set->r);
+    memset(set->bits, 0, sizeof(set->bits));
+    for (uint32_t key = 0; key * 65536u < TEST_ROWS; key++) {
+        uint32_t base = key * 65536u;
+        uint32_t end = base + 65536u < TEST_ROWS ? base + 65536u : TEST_ROWS;
+        switch (_rng() % 4) {
+        case 0: break;
+        case 1:
+            for (uint32_t i = 0; i < 1 + _rng() % 3000; i++) {
+                _add(set, base + (uint32_t)(_rng() % (end - base)));
+            }
+            break;
+        case 2:
+            for (uint32_t row = base; row < end; row++) {
+                if (_rng() % 3 != 0) _add(set, row);
+            }
+            break;
+        default:
+            for (uint32_t runs = 1 + (uint32_t)(_rng() % 20); runs > 0; runs--) {
+                uint32_t first = base + (uint32_t)(_rng() % (end - base));
+                uint32_t len = 1 + (uint32_t)(_rng() % 8000);
+                for (uint32_t row = first + len; row > first; row--) {
+                    if (row - 1 < end) _add(set, row - 1);
+                }
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * r holds exactly the rows of bits, by every accessor.
+ */
+static void _check_same(const ygo_roaring_t *r, const uint64_t *bits) {
+    static uint64_t words[TEST_WORDS];
+    static uint32_t rows[TEST_ROWS];
+    size_t cardinality = 0;
+    for (size_t w = 0; w < TEST_WORDS; w++) cardinality += ygo_popcount64(bits[w]);
+    CHECK(ygo_roaring_cardinality(r) == cardinality);
+
+    ygo_roaring_to_words(r, words, TEST_ROWS);
+    CHECK(memcmp(words, bits, sizeof(words)) == 0);
+
+    size_t n = ygo_roaring_to_array(r, rows);
+    CHECK(n == cardinality);
+    size_t i = 0;
+    for (uint32_t row = 0; row < TEST_ROWS && i <= n; row++) {
+        if ((bits[row / 64] >> (row % 64)) & 1u) {
+            if (i == n || rows[i] != row) break;
+            i++;
+        }
+    }
+    CHECK(i == n);
+
+    for (int k = 0; k < 2000; k++) {
+        uint32_t row = (uint32_t)(_rng() % TEST_ROWS);
+        if (ygo_roaring_contains(r, row) != (int)((bits[row / 64] >> (row % 64)) & 1u)) {
+            fprintf(stderr, "row %u: contains differs\n", row);
+            failures++;
+            break;
+        }
+    }
+    CHECK(!ygo_roaring_contains(r, TEST_ROWS + 70000));
+}
+
+/**
+ * Bit k set if some container of r is of kind k.
+ */
+static unsigned _kinds(const ygo_roaring_t *r) {
+    unsigned kinds = 0;
+    for (uint32_t i = 0; i < r->n; i++) kinds |= 1u << r->containers[i].kind;
+    return kinds;
+}
+
+static void _check_ops(void) {
+    static _set_t sets[TEST_SETS];
+    static uint64_t expected[TEST_WORDS];
+    unsigned kinds = 0;
+
+    // Half of the sets with runs, half without.
+    for (int i = 0; i < TEST_SETS; i++) {
+        _random_set(&sets[i]);
+        if (i % 2 == 1) CHECK(ygo_roaring_optimize(&sets[i].r) == YGO_BIN_OK);
+        _check_same(&sets[i].r, sets[i].bits);
+        kinds |= _kinds(&sets[i].r);
+    }
+    CHECK(kinds == (1u << YGO_ROARING_ARRAY | 1u << YGO_ROARING_BITMAP | 1u << YGO_ROARING_RUN));
+
+    for (int i = 0; i < TEST_SETS; i++) {
+        for (int j = 0; j < TEST_SETS; j++) {
+            const _set_t *a = &sets[i];
+            const _set_t *b = &sets[j];
+            ygo_roaring_t out;
+            ygo_roaring_init(&out);
+
+            size_t both = 0;
+            for (size_t w = 0; w < TEST_WORDS; w++) {
+                expected[w] = a->bits[w] & b->bits[w];
+                both += ygo_popcount64(expected[w]);
+            }
+            CHECK(ygo_roaring_and(&out, &a->r, &b->r) == YGO_BIN_OK);
+            _check_same(&out, expected);
+            CHECK(ygo_roaring_and_cardinality(&a->r, &b->r) == both);
+
+            for (size_t w = 0; w < TEST_WORDS; w++) expected[w] = a->bits[w] | b->bits[w];
+            CHECK(ygo_roaring_or(&out, &a->r, &b->r) == YGO_BIN_OK);
+            _check_same(&out, expected);
+
+            for (size_t w = 0; w < TEST_WORDS; w++) expected[w] = a->bits[w] & ~b->bits[w];
+            CHECK(ygo_roaring_andnot(&out, &a->r, &b->r) == YGO_BIN_OK);
+            _check_same(&out, expected);
+
+            // Results read back as operands, runs and all.
+            CHECK(ygo_roaring_optimize(&out) == YGO_BIN_OK);
+            _check_same(&out, expected);
+            CHECK(ygo_roaring_or(&out, &out, &b->r) == YGO_BIN_OK);
+            for (size_t w = 0; w < TEST_WORDS; w++) expected[w] |= b->bits[w];
+            _check_same(&out, expected);
+            ygo_roaring_free(&out);
+        }
+    }
+
+    // Adding to runs turns them back into arrays and bitmaps.
+    for (int i = 1; i < TEST_SETS; i += 2) {
+        for (int k = 0; k < 500; k++) _add(&sets[i], (uint32_t)(_rng() % TEST_ROWS));
+        _check_same(&sets[i].r, sets[i].bits);
+    }
+
+    // Through a plain bitmap of a count which isn't a multiple of 64.
+    ygo_roaring_t from;
+    ygo_roaring_init(&from);
+    CHECK(ygo_roaring_from_words(&from, sets[0].bits, TEST_ROWS) == YGO_BIN_OK);
+    _check_same(&from, sets[0].bits);
+    ygo_roaring_free(&from);
+
+    for (int i = 0; i < TEST_SETS; i++) ygo_roaring_free(&sets[i].r);
+}
+
+static void _check_optimize(void) {
+    ygo_roaring_t r;
+    ygo_roaring_init(&r);
+
+    // One long stretch, a scattering of rows, and every other row.
+    for (uint32_t row = 1000; row < 50000; row++) CHECK(ygo_roaring_add(&r, row) == YGO_BIN_OK);
+    for (uint32_t row = 65536; row < 65536 + 3000; row += 3) ygo_roaring_add(&r, row);
+    for (uint32_t row = 2 * 65536; row < 3 * 65536; row += 2) ygo_roaring_add(&r, row);
+    CHECK(r.n == 3 && r.containers[0].kind == YGO_ROARING_BITMAP);
+    CHECK(r.containers[1].kind == YGO_ROARING_ARRAY);
+    CHECK(r.containers[2].kind == YGO_ROARING_BITMAP);
+
+    CHECK(ygo_roaring_optimize(&r) == YGO_BIN_OK);
+    CHECK(r.containers[0].kind == YGO_ROARING_RUN && r.containers[0].capacity == 1);
+    CHECK(r.containers[0].runs[0] == 1000 && r.containers[0].runs[1] == 49999);
+    CHECK(r.containers[1].kind == YGO_ROARING_ARRAY);
+    CHECK(r.containers[2].kind == YGO_ROARING_BITMAP);
+    CHECK(ygo_roaring_cardinality(&r) == 49000 + 1000 + 32768);
+    CHECK(ygo_roaring_contains(&r, 1000) && ygo_roaring_contains(&r, 49999));
+    CHECK(!ygo_roaring_contains(&r, 999) && !ygo_roaring_contains(&r, 50000));
+    ygo_roaring_free(&r);
+}
+
+/**
+ * Facet slots of a card as ygo_facet documents them, -1 for none. Bit set facets give their bits.
+ */
+static void _card_slots(const ygo_card_t *card, int *slots) {
+    ygo_card_type_t type = GET_CARD_TYPE(card->type);
+    int monster = type == YGO_CARD_TYPE_MONSTER || type == YGO_CARD_TYPE_TRAP_MONSTER;
+    for (int f = 0; f < YGO_FACET_COUNT; f++) slots[f] = -1;
+
+    slots[YGO_FACET_CARD_TYPE] = ygo_facet_slot(YGO_FACET_CARD_TYPE, type);
+    if (monster) {
+        slots[YGO_FACET_ATTRIBUTE] = ygo_facet_slot(YGO_FACET_ATTRIBUTE, card->attribute);
+        slots[YGO_FACET_MONSTER_TYPE] = ygo_facet_slot(YGO_FACET_MONSTER_TYPE, card->monster_type);
+        slots[YGO_FACET_SUMMON_TYPE] = ygo_facet_slot(YGO_FACET_SUMMON_TYPE, card->summon);
+        slots[YGO_FACET_MONSTER_FLAG] = GET_MONSTER_FLAG(card->flags);
+        slots[YGO_FACET_LINK_MARKER] = card->link_markers;
+    } else if (type == YGO_CARD_TYPE_SPELL) {
+        slots[YGO_FACET_SPELL_TYPE] = ygo_facet_slot(YGO_FACET_SPELL_TYPE, card->spell_type);
+    } else if (type == YGO_CARD_TYPE_TRAP) {
+        slots[YGO_FACET_TRAP_TYPE] = ygo_facet_slot(YGO_FACET_TRAP_TYPE, card->trap_type);
+    }
+}
+
+static int _card_has(const int *slots, int facet, int slot) {
+    if (facet == YGO_FACET_MONSTER_FLAG || facet == YGO_FACET_LINK_MARKER) {
+        return slots[facet] > 0 && ((slots[facet] >> slot) & 1);
+    }
+    return slots[facet] == slot;
+}
+
+/**
+ * A table of random cards of every type, then from row 65536 on only spells, so that the spells of
+ * the second container are one long run.
+ */
+static void _random_cards(ygo_card_t *cards) {
+    static const ygo_card_type_t types[] = {YGO_CARD_TYPE_MONSTER, YGO_CARD_TYPE_MONSTER,
+                                            YGO_CARD_TYPE_SPELL, YGO_CARD_TYPE_TRAP,
+                                            YGO_CARD_TYPE_TRAP_MONSTER};
+    static const ygo_summon_type_t summons[] = {
+        YGO_SUMMON_TYPE_NORMAL, YGO_SUMMON_TYPE_SPECIAL, YGO_SUMMON_TYPE_RITUAL,
+        YGO_SUMMON_TYPE_FUSION, YGO_SUMMON_TYPE_LINK,    YGO_SUMMON_TYPE_XYZ};
+    memset(cards, 0, TEST_CARDS * sizeof(ygo_card_t));
+    for (uint32_t i = 0; i < TEST_CARDS; i++) {
+        ygo_card_t *card = &cards[i];
+        card->id = i;
+        card->type = i >= 65536 ? YGO_CARD_TYPE_SPELL : types[_rng() % 5];
+        if (card->type == YGO_CARD_TYPE_SPELL) {
+            card->spell_type = (ygo_spell_type_t)(_rng() % 6);
+        } else if (card->type == YGO_CARD_TYPE_TRAP) {
+            card->trap_type = (ygo_trap_type_t)(_rng() % 3);
+        } else {
+            card->summon = summons[_rng() % 6];
+            card->attribute = (ygo_attribute_t)(_rng() % 8);
+            card->monster_type = (ygo_monster_type_t)(_rng() % 26);
+            card->flags = (ygo_monster_flag_t)(_rng() & 0x38u);
+            card->link_markers = _rng() % 8 == 0 ? (ygo_card_link_markers_t)_rng() : 0;
+        }
+    }
+}
+
+static void _check_facets(void) {
+    static ygo_card_t cards[TEST_CARDS];
+    _random_cards(cards);
+
+    ygo_table_t table;
+    void *memory = malloc(ygo_table_size(TEST_CARDS));
+    CHECK(ygo_table_init(&table, memory, TEST_CARDS) == YGO_BIN_OK);
+    for (uint32_t i = 0; i < TEST_CARDS; i++) {
+        CHECK(ygo_table_append(&table, &cards[i]) == YGO_BIN_OK);
+    }
+
+    static ygo_facet_index_t index;
+    CHECK(ygo_facet_build(&index, &table) == YGO_BIN_OK);
+    CHECK(index.count == TEST_CARDS);
+
+    // Every value's rows, and between them every kind of container.
+    static int slots[TEST_CARDS][YGO_FACET_COUNT];
+    for (uint32_t i = 0; i < TEST_CARDS; i++) _card_slots(&cards[i], slots[i]);
+    static uint64_t bits[YGO_FACET_COUNT][YGO_FACET_VALUES][TEST_WORDS];
+    unsigned kinds = 0;
+    for (int f = 0; f < YGO_FACET_COUNT; f++) {
+        for (int s = 0; s < YGO_FACET_VALUES; s++) {
+            for (uint32_t i = 0; i < TEST_CARDS; i++) {
+                if (_card_has(slots[i], f, s)) bits[f][s][i / 64] |= 1ull << (i % 64);
+            }
+            _check_same(&index.values[f][s], bits[f][s]);
+            kinds |= _kinds(&index.values[f][s]);
+        }
+    }
+    CHECK(kinds == (1u << YGO_ROARING_ARRAY | 1u << YGO_ROARING_BITMAP | 1u << YGO_ROARING_RUN));
+    const ygo_roaring_t *spells = ygo_facet_get(&index, YGO_FACET_CARD_TYPE, YGO_CARD_TYPE_SPELL);
+    CHECK(spells != NULL && _kinds(spells) & 1u << YGO_ROARING_RUN);
+
+    // Filters of each kind: no filter, a few rows, most rows, one long stretch of rows, the spells
+    // with a few rows more, a run in part, and a few short stretches, walked row by row.
+    ygo_roaring_t filters[6];
+    for (int k = 0; k < 6; k++) ygo_roaring_init(&filters[k]);
+    for (int k = 0; k < 500; k++) ygo_roaring_add(&filters[1], (uint32_t)(_rng() % TEST_CARDS));
+    for (uint32_t row = 0; row < TEST_CARDS; row++) {
+        if (_rng() % 4 != 0) ygo_roaring_add(&filters[2], row);
+    }
+    for (uint32_t row = 15000; row < 68000; row++) ygo_roaring_add(&filters[3], row);
+    CHECK(ygo_roaring_optimize(&filters[3]) == YGO_BIN_OK);
+    CHECK(ygo_roaring_or(&filters[4], spells, &filters[1]) == YGO_BIN_OK);
+    CHECK(ygo_roaring_optimize(&filters[4]) == YGO_BIN_OK);
+    for (uint32_t row = 0; row < TEST_CARDS; row += 9000) {
+        for (uint32_t end = row + 40; row < end; row++) ygo_roaring_add(&filters[5], row);
+    }
+    CHECK(ygo_roaring_optimize(&filters[5]) == YGO_BIN_OK);
+    CHECK(_kinds(&filters[5]) == 1u << YGO_ROARING_RUN);
+
+    static uint32_t counts[YGO_FACET_COUNT][YGO_FACET_VALUES];
+    static uint32_t expected[YGO_FACET_COUNT][YGO_FACET_VALUES];
+    for (int k = 0; k < 6; k++) {
+        const ygo_roaring_t *filter = k == 0 ? NULL : &filters[k];
+        memset(expected, 0, sizeof(expected));
+        for (uint32_t i = 0; i < TEST_CARDS; i++) {
+            if (filter != NULL && !ygo_roaring_contains(filter, i)) continue;
+            for (int f = 0; f < YGO_FACET_COUNT; f++) {
+                for (int s = 0; s < YGO_FACET_VALUES; s++) {
+                    expected[f][s] += (uint32_t)_card_has(slots[i], f, s);
+                }
+            }
+        }
+        ygo_facet_counts(&index, filter, counts);
+        if (memcmp(counts, expected, sizeof(counts)) != 0) {
+            fprintf(stderr, "filter %d: counts differ\n", k);
+            failures++;
+        }
+        ygo_roaring_free(&filters[k]);
+    }
+
+    ygo_facet_free(&index);
+    free(memory);
+}
+
+int main(void) {
+    _check_ops();
+    _check_optimize();
+    _check_facets();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file ygo_search_test.c
+ * @brief ygo_search_query() against a brute-force scan of every folded name: for word prefixes
+ * shorter than a trigram, for substrings found through the trigrams, and for queries with edits,
+ * the same hits in the same order, whole or cut to a few.
+ */
+
+#include "ygo_search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+// Not a multiple of 16, so the last block of counts is a partial one.
+#define TEST_CARDS 613
+#define TEST_QUERIES 3000
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+static const char *const _words[] = {
+    "Blue-Eyes", "White", "Dragon", "Dark", "Magician", "Girl", "Elemental", "HERO", "Neos",
+    "Cyber", "End", "Stardust", "Red-Eyes", "Black", "Metal", "Toon", "Kuriboh", "Pot", "of",
+    "Greed", "Mirror", "Force", "Ash", "Blossom", "Joyous", "Spring", "Eyes", "Ra's", "Winged",
+    "Dragón", "Obelisk", "the", "Tormentor", "Ælf", "Number", "39:", "Utopia", "Zoodiac",
+    "Drident", "aaa"};
+
+static void _random_name(char *name) {
+    size_t n = 0;
+    size_t words = 1 + (size_t)(_rng() % 5);
+    for (size_t w = 0; w < words; w++) {
+        const char *word = _words[_rng() % (sizeof(_words) / sizeof(_words[0]))];
+        size_t len = strlen(word);
+        if (n + len + 2 >= YGO_CARD_NAME_MAX_LEN) break;
+        if (n > 0) name[n++] = _rng() % 4 == 0 ? '-' : ' ';
+        memcpy(name + n, word, len);
+        n += len;
+    }
+    name[n] = '\0';
+}
+
+typedef struct {
+    uint32_t id;
+    char text[YGO_SEARCH_MAX_LEN];
+    size_t len;
+} _name_t;
+
+static int _compare_names(const void *a, const void *b) {
+    uint32_t x = ((const _name_t *)a)->id, y = ((const _name_t *)b)->id;
+    return (x > y) - (x < y);
+}
+
+/**
+ * How query occurs in name, the same order of kinds as ygo_search_match_t, FUZZY if it doesn't.
+ */
+static ygo_search_match_t _classify(const _name_t *name, const char *query, size_t m) {
+    if (name->len == m && memcmp(name->text, query, m) == 0) return YGO_SEARCH_MATCH_EXACT;
+    if (name->len >= m && memcmp(name->text, query, m) == 0) return YGO_SEARCH_MATCH_PREFIX;
+    ygo_search_match_t match = YGO_SEARCH_MATCH_FUZZY;
+    for (size_t start = 1; start + m <= name->len; start++) {
+        if (memcmp(name->text + start, query, m) != 0) continue;
+        if (name->text[start - 1] == ' ') return YGO_SEARCH_MATCH_WORD;
+        match = YGO_SEARCH_MATCH_INFIX;
+    }
+    return match;
+}
+
+/**
+ * Fewest edits turning query into some substring of name, by the full matrix.
+ */
+static size_t _distance(const _name_t *name, const char *query, size_t m) {
+    size_t row[YGO_SEARCH_MAX_LEN + 1];
+    size_t best = m;
+    for (size_t i = 0; i <= m; i++) row[i] = i;
+    for (size_t j = 0; j < name->len; j++) {
+        size_t diagonal = row[0];
+        row[0] = 0;
+        for (size_t i = 1; i <= m; i++) {
+            size_t above = row[i];
+            size_t cost = diagonal + (query[i - 1] != name->text[j]);
+            if (above + 1 < cost) cost = above + 1;
+            if (row[i - 1] + 1 < cost) cost = row[i - 1] + 1;
+            row[i] = cost;
+            diagonal = above;
+        }
+        if (row[m] < best) best = row[m];
+    }
+    return best;
+}
+
+/**
+ * Distinct trigrams of the query padded with a space on each side.
+ */
+static size_t _trigram_count(const char *query, size_t m) {
+    char padded[YGO_SEARCH_MAX_LEN + 2];
+    padded[0] = ' ';
+    memcpy(padded + 1, query, m);
+    padded[m + 1] = ' ';
+    size_t n = 0;
+    for (size_t i = 0; i < m; i++) {
+        size_t j = 0;
+        while (j < i && memcmp(padded + j, padded + i, 3) != 0) j++;
+        n += j == i;
+    }
+    return n;
+}
+
+static int _before(const _name_t *names, const ygo_search_hit_t *a, const ygo_search_hit_t *b) {
+    if (a->match != b->match) return a->match < b->match;
+    if (a->distance != b->distance) return a->distance < b->distance;
+    if (names[a->entry].len != names[b->entry].len) {
+        return names[a->entry].len < names[b->entry].len;
+    }
+    return a->entry < b->entry;
+}
+
+/**
+ * Every name matching query, best first. Below 3 bytes only names with a word starting with it,
+ * otherwise names holding it, or within the edits a query of its length allows.
+ */
+static size_t _scan(const _name_t *names,
+                    size_t count,
+                    const char *query,
+                    size_t m,
+                    uint8_t max_distance,
+                    ygo_search_hit_t *hits) {
+    size_t t = _trigram_count(query, m);
+    size_t k = t >= 4 ? (t - 4) / 3 : 0;
+    if (k > max_distance) k = max_distance;
+
+    size_t found = 0;
+    for (size_t e = 0; e < count; e++) {
+        ygo_search_match_t match = _classify(&names[e], query, m);
+        size_t distance = 0;
+        if (m < 3) {
+            if (match == YGO_SEARCH_MATCH_FUZZY || match == YGO_SEARCH_MATCH_INFIX) continue;
+        } else if (match == YGO_SEARCH_MATCH_FUZZY) {
+            distance = _distance(&names[e], query, m);
+            if (k == 0 || distance > k) continue;
+        }
+        ygo_search_hit_t hit = {names[e].id, (uint32_t)e, (uint8_t)distance, match};
+        size_t pos = found++;
+        while (pos > 0 && _before(names, &hit, &hits[pos - 1])) {
+            hits[pos] = hits[pos - 1];
+            pos--;
+        }
+        hits[pos] = hit;
+    }
+    return found;
+}
+
+/**
+ * A query taken from one of the names: a word start of 1 or 2 bytes, a substring, or a substring
+ * with up to 3 random edits.
+ */
+static size_t _random_query(const _name_t *names, size_t count, char *query) {
+    const _name_t *name = &names[_rng() % count];
+    size_t start = (size_t)(_rng() % name->len);
+    size_t m = 1 + (size_t)(_rng() % (name->len - start));
+    int kind = (int)(_rng() % 3);
+    if (kind == 0) {
+        while (start > 0 && name->text[start - 1] != ' ') start--;
+        m = 1 + (size_t)(_rng() % 2);
+        if (start + m > name->len) m = name->len - start;
+    }
+    memcpy(query, name->text + start, m);
+
+    if (kind == 2) {
+        static const char letters[] = "abcdeghilmnorstuy ";
+        size_t edits = (size_t)(_rng() % 4);
+        for (size_t e = 0; e < edits && m > 1 && m + 1 < YGO_SEARCH_MAX_LEN; e++) {
+            size_t at = (size_t)(_rng() % m);
+            char c = letters[_rng() % (sizeof(letters) - 1)];
+            switch (_rng() % 3) {
+            case 0: query[at] = c; break;
+            case 1:
+                memmove(query + at + 1, query + at, m - at);
+                query[at] = c;
+                m++;
+                break;
+            default:
+                memmove(query + at, query + at + 1, m - at - 1);
+                m--;
+                break;
+            }
+        }
+    }
+    // Spaces at either end, or two in a row, would be folded away.
+    query[m] = '\0';
+    char folded[YGO_SEARCH_MAX_LEN];
+    m = ygo_search_fold(folded, sizeof(folded) - 1, query, m);
+    memcpy(query, folded, m);
+    query[m] = '\0';
+    return m;
+}
+
+static int _same_hits(const ygo_search_hit_t *a, const ygo_search_hit_t *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (a[i].id != b[i].id || a[i].entry != b[i].entry || a[i].distance != b[i].distance ||
+            a[i].match != b[i].match) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    static ygo_card_t cards[TEST_CARDS + 1];
+    static _name_t names[TEST_CARDS + 1];
+    memset(cards, 0, sizeof(cards));
+
+    // Unique ids in no order, and the last card listed twice.
+    for (size_t i = 0; i < TEST_CARDS; i++) {
+        cards[i].id = (uint32_t)((i * 7919u + 13u) % 100003u);
+        _random_name(cards[i].name);
+    }
+    cards[TEST_CARDS] = cards[TEST_CARDS - 1];
+
+    size_t len = ygo_search_build(NULL, cards, TEST_CARDS + 1);
+    uint8_t *data = (uint8_t *)malloc(len);
+    CHECK(len > 0 && ygo_search_build(data, cards, TEST_CARDS + 1) == len);
+    ygo_search_t index;
+    CHECK(ygo_search_open_memory(&index, data, len) == YGO_BIN_OK);
+    CHECK(index.count == TEST_CARDS);
+
+    // The entries are the folded names, ascending by id.
+    for (size_t i = 0; i < TEST_CARDS; i++) {
+        names[i].id = cards[i].id;
+        names[i].len = ygo_search_fold(names[i].text, YGO_SEARCH_MAX_LEN, cards[i].name,
+                                       YGO_CARD_NAME_MAX_LEN);
+    }
+    qsort(names, TEST_CARDS, sizeof(_name_t), _compare_names);
+    for (uint32_t e = 0; e < index.count; e++) {
+        size_t name_len = 0;
+        const char *name = ygo_search_name(&index, e, &name_len);
+        CHECK(name != NULL && name_len == names[e].len);
+        CHECK(name != NULL && memcmp(name, names[e].text, name_len) == 0);
+    }
+
+    uint16_t *scratch = (uint16_t *)malloc(ygo_search_scratch_len(&index) * sizeof(uint16_t));
+    static ygo_search_hit_t hits[TEST_CARDS];
+    static ygo_search_hit_t expected[TEST_CARDS];
+    size_t fuzzy = 0;
+    for (size_t q = 0; q < TEST_QUERIES; q++) {
+        char query[YGO_SEARCH_MAX_LEN + 1];
+        size_t m = _random_query(names, TEST_CARDS, query);
+        if (m == 0) continue;
+        uint8_t max_distance = (uint8_t)(_rng() % 4);
+
+        size_t n = _scan(names, TEST_CARDS, query, m, max_distance, expected);
+        size_t found = ygo_search_query(&index, query, max_distance, hits, TEST_CARDS, scratch);
+        if (found != n || !_same_hits(hits, expected, n)) {
+            fprintf(stderr, "\"%s\" within %u: %zu hits, %zu expected\n", query, max_distance,
+                    found, n);
+            failures++;
+        }
+        for (size_t i = 0; i < n; i++) fuzzy += expected[i].match == YGO_SEARCH_MATCH_FUZZY;
+
+        // Cut to a few, the best of them.
+        found = ygo_search_query(&index, query, max_distance, hits, 3, scratch);
+        CHECK(found == (n < 3 ? n : 3) && _same_hits(hits, expected, found));
+    }
+    CHECK(fuzzy > 0);
+
+    // Nothing for names which aren't there, nor for queries folding to nothing.
+    CHECK(ygo_search_query(&index, "qqqqqqqq", 3, hits, TEST_CARDS, scratch) == 0);
+    CHECK(ygo_search_query(&index, " -'- ", 3, hits, TEST_CARDS, scratch) == 0);
+
+    free(scratch);
+    free(data);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file ygo_sha256_test.c
+ * @brief Checks the portable SHA-256 against FIPS 180-4 vectors, then every engine the CPU
+ * supports against it.
+ *
+ * Lengths and start offsets are random and cover the padding edge cases around one block, for
+ * single messages, split updates and ygo_sha256_many() batches alike.
+ */
+
+#include "ygo_sha256.h"
+#include <stdio.h>
+
+#define TEST_BUFFER_LEN 1024
+#define TEST_MISALIGN 64
+#define TEST_ROUNDS 100
+#define TEST_BATCH 37
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * Half of the lengths stay within three blocks, where the padding spills or doesn't.
+ */
+static size_t _random_len(void) {
+    uint64_t r = _rng();
+    size_t max = (r & 1u) ? 3 * YGO_SHA256_BLOCK_LEN : TEST_BUFFER_LEN;
+    return (size_t)((r >> 1) % (max + 1));
+}
+
+static int _check_vectors(void) {
+    static const struct {
+        const char *message;
+        uint8_t digest[YGO_SHA256_LEN];
+    } vectors[] = {
+        {"",
+         {0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4,
+          0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b,
+          0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55}},
+        {"abc",
+         {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+          0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+          0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad}},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26,
+          0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff,
+          0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}},
+    };
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        uint8_t digest[YGO_SHA256_LEN];
+        ygo_sha256((const uint8_t *)vectors[i].message, strlen(vectors[i].message), digest);
+        if (memcmp(digest, vectors[i].digest, YGO_SHA256_LEN) != 0) {
+            fprintf(stderr, "portable: vector %zu mismatch\n", i);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(void) {
+    static uint8_t buffer[TEST_BUFFER_LEN + TEST_MISALIGN];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)_rng();
+    }
+
+    ygo_sha256_select_engine(YGO_SHA256_ENGINE_PORTABLE);
+    int failures = _check_vectors();
+    if (failures > 0) return 1;
+
+    for (int e = YGO_SHA256_ENGINE_SHANI; e <= YGO_SHA256_ENGINE_AVX2; e++) {
+        ygo_sha256_engine_t engine = (ygo_sha256_engine_t)e;
+        if (!ygo_sha256_engine_available(engine)) {
+            printf("%-8s not available, skipped\n", ygo_sha256_engine_to_str(engine));
+            continue;
+        }
+
+        for (int round = 0; round < TEST_ROUNDS; round++) {
+            const uint8_t *buffers[TEST_BATCH];
+            size_t sizes[TEST_BATCH];
+            uint8_t expected[TEST_BATCH][YGO_SHA256_LEN];
+            uint8_t digests[TEST_BATCH][YGO_SHA256_LEN];
+            for (size_t i = 0; i < TEST_BATCH; i++) {
+                buffers[i] = buffer + _rng() % TEST_MISALIGN;
+                sizes[i] = _random_len();
+            }
+
+            ygo_sha256_select_engine(YGO_SHA256_ENGINE_PORTABLE);
+            for (size_t i = 0; i < TEST_BATCH; i++) {
+                ygo_sha256(buffers[i], sizes[i], expected[i]);
+            }
+
+            if (ygo_sha256_select_engine(engine) != engine) {
+                const char *name = ygo_sha256_engine_to_str(engine);
+                fprintf(stderr, "%s: available but not selected\n", name);
+                return 1;
+            }
+            ygo_sha256_many(buffers, sizes, digests, TEST_BATCH);
+
+            for (size_t i = 0; i < TEST_BATCH; i++) {
+                // The same message again, one digest at a time and in two updates.
+                uint8_t whole[YGO_SHA256_LEN];
+                uint8_t pieces[YGO_SHA256_LEN];
+                size_t split = (size_t)(_rng() % (sizes[i] + 1));
+                ygo_sha256(buffers[i], sizes[i], whole);
+                ygo_sha256_t sha;
+                ygo_sha256_init(&sha);
+                ygo_sha256_update(&sha, buffers[i], split);
+                ygo_sha256_update(&sha, buffers[i] + split, sizes[i] - split);
+                ygo_sha256_final(&sha, pieces);
+
+                if (memcmp(digests[i], expected[i], YGO_SHA256_LEN) != 0 ||
+                    memcmp(whole, expected[i], YGO_SHA256_LEN) != 0 ||
+                    memcmp(pieces, expected[i], YGO_SHA256_LEN) != 0) {
+                    fprintf(stderr,
+                            "%s: entry %zu of %zu bytes, split %zu: digest mismatch\n",
+                            ygo_sha256_engine_to_str(engine),
+                            i,
+                            sizes[i],
+                            split);
+                    if (++failures > 16) return 1;
+                }
+            }
+        }
+
+        printf("%-8s ok\n", ygo_sha256_engine_to_str(engine));
+    }
+
+    ygo_sha256_engine_t selected = ygo_sha256_select_engine(YGO_SHA256_ENGINE_AUTO);
+    printf("auto selects %s\n", ygo_sha256_engine_to_str(selected));
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file ygo_slim_test.c
+ * @brief Slim cards and the string pool: random cards through ygo_card_slim_from_card() and back
+ * unchanged, each distinct name stored once, pools which run out of data or slots, and read-only
+ * pools opened from the data of an earlier one.
+ */
+
+#include "ygo_slim.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_CARDS 2000
+#define TEST_NAMES 300
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * Names of any length up to the whole buffer, the first one empty and the last one filling all
+ * of it without a null character.
+ */
+static void _random_names(char names[TEST_NAMES][YGO_CARD_NAME_MAX_LEN]) {
+    memset(names, 0, TEST_NAMES * YGO_CARD_NAME_MAX_LEN);
+    for (size_t i = 1; i < TEST_NAMES; i++) {
+        size_t len = i + 1 == TEST_NAMES ? YGO_CARD_NAME_MAX_LEN
+                                         : 2 + (size_t)(_rng() % (YGO_CARD_NAME_MAX_LEN - 2));
+        for (size_t j = 0; j < len; j++) names[i][j] = (char)('a' + _rng() % 26);
+        // Distinct, the index is written over the start.
+        names[i][0] = (char)('A' + i % 26);
+        names[i][1] = (char)('A' + i / 26);
+    }
+}
+
+static void _random_card(ygo_card_t *card, const char *name) {
+    memset(card, 0, sizeof(*card));
+    card->id = (uint32_t)_rng();
+    card->type = (ygo_card_type_t)(_rng() & 0xF0u);
+    card->flags = (ygo_monster_flag_t)(_rng() & 0x38u);
+    card->ability = (ygo_monster_ability_t)(_rng() & 0x07u);
+    card->monster_type = (ygo_monster_type_t)(uint8_t)_rng();
+    card->summon = (ygo_summon_type_t)(uint8_t)_rng();
+    card->attribute = (ygo_attribute_t)(uint8_t)_rng();
+    card->atk = (uint16_t)_rng();
+    card->def = (uint16_t)_rng();
+    card->level = (uint8_t)_rng();
+    card->scale = (uint8_t)_rng();
+    card->link_markers = (ygo_card_link_markers_t)(uint8_t)_rng();
+    memcpy(card->name, name, YGO_CARD_NAME_MAX_LEN);
+}
+
+static void _check_round_trip(void) {
+    static char names[TEST_NAMES][YGO_CARD_NAME_MAX_LEN];
+    static ygo_card_t cards[TEST_CARDS];
+    static ygo_card_slim_t slims[TEST_CARDS];
+    static char data[TEST_NAMES * (YGO_CARD_NAME_MAX_LEN + 1)];
+    static uint32_t slots[512];
+    _random_names(names);
+
+    ygo_strpool_t pool;
+    CHECK(ygo_strpool_init(&pool, data, sizeof(data), slots, 512) == YGO_BIN_OK);
+    uint32_t offsets[TEST_NAMES];
+    int seen[TEST_NAMES] = {0};
+    size_t bytes = 0;
+    for (size_t i = 0; i < TEST_CARDS; i++) {
+        // Every name at least once, then at random.
+        size_t n = i < TEST_NAMES ? i : (size_t)(_rng() % TEST_NAMES);
+        _random_card(&cards[i], names[n]);
+        CHECK(ygo_card_slim_from_card(&slims[i], &cards[i], &pool) == YGO_BIN_OK);
+
+        // The same name, the same offset.
+        if (!seen[n]) {
+            seen[n] = 1;
+            offsets[n] = slims[i].name;
+            const char *end = (const char *)memchr(names[n], '\0', YGO_CARD_NAME_MAX_LEN);
+            bytes += (end != NULL ? (size_t)(end - names[n]) : YGO_CARD_NAME_MAX_LEN) + 1;
+        }
+        CHECK(slims[i].name == offsets[n]);
+    }
+    CHECK(pool.count == TEST_NAMES);
+    CHECK(pool.len == bytes);
+
+    for (size_t i = 0; i < TEST_CARDS; i++) {
+        ygo_card_t card;
+        memset(&card, 0xA5, sizeof(card));
+        CHECK(ygo_card_slim_to_card(&card, &slims[i], &pool) == YGO_BIN_OK);
+        if (memcmp(&card, &cards[i], sizeof(card)) != 0) {
+            fprintf(stderr, "card %zu: not the same after the round trip\n", i);
+            failures++;
+        }
+        CHECK(ygo_card_slim_type(&slims[i]) == cards[i].type);
+        CHECK(ygo_card_slim_flags(&slims[i]) == cards[i].flags);
+        CHECK(ygo_card_slim_ability(&slims[i]) == cards[i].ability);
+    }
+
+    // The data alone, opened read-only, gives the same cards.
+    ygo_strpool_t read_only;
+    CHECK(ygo_strpool_open(&read_only, data, pool.len) == YGO_BIN_OK);
+    for (size_t i = 0; i < TEST_CARDS; i += 7) {
+        ygo_card_t card;
+        CHECK(ygo_card_slim_to_card(&card, &slims[i], &read_only) == YGO_BIN_OK);
+        CHECK(memcmp(&card, &cards[i], sizeof(card)) == 0);
+    }
+
+    // A name offset outside the pool.
+    ygo_card_slim_t bad = slims[0];
+    bad.name = pool.len;
+    ygo_card_t card;
+    CHECK(ygo_card_slim_to_card(&card, &bad, &pool) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_card_slim_name(&bad, &pool) == NULL);
+    CHECK(ygo_card_slim_name(&slims[1], &pool) != NULL);
+}
+
+static void _check_dedup(void) {
+    char data[64];
+    uint32_t slots[8];
+    ygo_strpool_t pool;
+    uint32_t a, b, c, d;
+    CHECK(ygo_strpool_init(&pool, data, sizeof(data), slots, 8) == YGO_BIN_OK);
+
+    CHECK(ygo_strpool_intern(&pool, "Kuriboh", 64, &a) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "Kuriboh", 64, &b) == YGO_BIN_OK && b == a);
+    CHECK(pool.count == 1 && pool.len == 8);
+
+    // Up to max_len bytes, or the null character: a prefix is a string of its own, then found.
+    CHECK(ygo_strpool_intern(&pool, "Kuriboh", 4, &b) == YGO_BIN_OK && b != a);
+    CHECK(strcmp(ygo_strpool_get(&pool, b), "Kuri") == 0);
+    CHECK(ygo_strpool_intern(&pool, "Kuri\0boh", 64, &c) == YGO_BIN_OK && c == b);
+    CHECK(ygo_strpool_intern(&pool, "Kuriboh!", 7, &d) == YGO_BIN_OK && d == a);
+    CHECK(ygo_strpool_intern(&pool, "", 64, &d) == YGO_BIN_OK && d != a && d != b);
+    CHECK(pool.count == 3 && pool.len == 8 + 5 + 1);
+
+    // Without slots every string is added.
+    ygo_strpool_t plain;
+    CHECK(ygo_strpool_init(&plain, data, sizeof(data), NULL, 0) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&plain, "Kuriboh", 64, &a) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&plain, "Kuriboh", 64, &b) == YGO_BIN_OK && b == a + 8);
+    CHECK(plain.len == 16);
+}
+
+static void _check_truncated(void) {
+    char data[16];
+    uint32_t slots[8];
+    ygo_strpool_t pool;
+    uint32_t offset = 0;
+
+    // The data: 9 bytes, then 7 fill it exactly, then not even the empty string.
+    CHECK(ygo_strpool_init(&pool, data, sizeof(data), slots, 8) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "Jinzo #7", 64, &offset) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "Ojamas!", 64, &offset) == YGO_BIN_ERR_TRUNCATED);
+    CHECK(ygo_strpool_intern(&pool, "Ojama!", 64, &offset) == YGO_BIN_OK && offset == 9);
+    CHECK(pool.len == 16);
+    CHECK(ygo_strpool_intern(&pool, "", 64, &offset) == YGO_BIN_ERR_TRUNCATED);
+    CHECK(pool.len == 16 && pool.count == 2);
+    // Strings it holds are still found.
+    CHECK(ygo_strpool_intern(&pool, "Jinzo #7", 64, &offset) == YGO_BIN_OK && offset == 0);
+
+    // The slots: 3 strings in 4 of them.
+    char big[64];
+    CHECK(ygo_strpool_init(&pool, big, sizeof(big), slots, 4) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "a", 64, &offset) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "b", 64, &offset) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "c", 64, &offset) == YGO_BIN_OK);
+    CHECK(ygo_strpool_intern(&pool, "d", 64, &offset) == YGO_BIN_ERR_TRUNCATED);
+    CHECK(pool.count == 3 && pool.len == 6);
+    CHECK(ygo_strpool_intern(&pool, "b", 64, &offset) == YGO_BIN_OK && offset == 2);
+
+    // A card whose name doesn't fit is left alone, as is the slim card.
+    static const char name[YGO_CARD_NAME_MAX_LEN] = "Dark Magician";
+    ygo_card_t card;
+    _random_card(&card, name);
+    ygo_card_slim_t slim, before;
+    memset(&slim, 0x5A, sizeof(slim));
+    before = slim;
+    CHECK(ygo_card_slim_from_card(&slim, &card, &pool) == YGO_BIN_ERR_TRUNCATED);
+    CHECK(memcmp(&slim, &before, sizeof(slim)) == 0);
+    CHECK(pool.count == 3 && pool.len == 6);
+
+    CHECK(ygo_strpool_init(&pool, big, sizeof(big), slots, 6) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_strpool_init(&pool, NULL, 4, NULL, 0) == YGO_BIN_ERR_BAD_ARGS);
+}
+
+static void _check_open(void) {
+    static const char good[] = "Blue-Eyes\0Red-Eyes\0";
+    ygo_strpool_t pool;
+
+    CHECK(ygo_strpool_open(&pool, good, sizeof(good) - 1) == YGO_BIN_OK);
+    CHECK(strcmp(ygo_strpool_get(&pool, 0), "Blue-Eyes") == 0);
+    CHECK(strcmp(ygo_strpool_get(&pool, 10), "Red-Eyes") == 0);
+    CHECK(ygo_strpool_get(&pool, 19) == NULL);
+
+    // Anything which doesn't end in a null character, so the last string would run off the end.
+    CHECK(ygo_strpool_open(&pool, good, sizeof(good) - 2) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_strpool_open(&pool, good, 9) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_strpool_open(&pool, "x", 1) == YGO_BIN_ERR_BAD_ARGS);
+    CHECK(ygo_strpool_open(&pool, NULL, 3) == YGO_BIN_ERR_BAD_ARGS);
+
+    // Empty, with nothing in it.
+    CHECK(ygo_strpool_open(&pool, good, 0) == YGO_BIN_OK);
+    CHECK(ygo_strpool_get(&pool, 0) == NULL);
+}
+
+int main(void) {
+    _check_round_trip();
+    _check_dedup();
+    _check_truncated();
+    _check_open();
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
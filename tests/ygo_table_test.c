@@ -0,0 +1,179 @@
+/**
+ * @file ygo_table_test.c
+ * @brief ygo_table_select() with every available engine against a loop over the rows: each op on
+ * each column, values at and past the ends of the column's width, conjunctions of several
+ * predicates, for row counts which are and aren't a multiple of the vector width and of a block.
+ */
+
+#include "ygo_table.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_MAX_ROWS 1100
+#define TEST_COLUMNS (YGO_TABLE_COLUMN_LINK_MARKERS + 1)
+#define TEST_OPS (YGO_TABLE_OP_ANY + 1)
+#define TEST_SELECTS 400
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+/**
+ * Every byte before the name either random or one of a few values, so that equal values and the
+ * ends of each width come up often.
+ */
+static void _random_card(ygo_card_t *card) {
+    static const uint8_t common[] = {0x00, 0x01, 0x7F, 0x80, 0xFF};
+    uint8_t *raw = (uint8_t *)card;
+    memset(card, 0, sizeof(*card));
+    for (size_t i = 0; i < offsetof(ygo_card_t, name); i++) {
+        raw[i] = _rng() % 2 == 0 ? (uint8_t)_rng() : common[_rng() % sizeof(common)];
+    }
+}
+
+static int _matches(uint32_t x, ygo_table_op_t op, uint32_t v) {
+    switch (op) {
+    case YGO_TABLE_OP_EQ: return x == v;
+    case YGO_TABLE_OP_NE: return x != v;
+    case YGO_TABLE_OP_LT: return x < v;
+    case YGO_TABLE_OP_LE: return x <= v;
+    case YGO_TABLE_OP_GT: return x > v;
+    case YGO_TABLE_OP_GE: return x >= v;
+    case YGO_TABLE_OP_ALL: return (x & v) == v;
+    case YGO_TABLE_OP_ANY: return (x & v) != 0;
+    default: return 0;
+    }
+}
+
+/**
+ * A value to compare with: one held by some row or next to it, an end of some width, one past
+ * it, or a few bits for ALL and ANY.
+ */
+static uint32_t _random_value(const ygo_table_t *table, ygo_table_column_t column) {
+    static const uint32_t ends[] = {0, 1, 0x7F, 0x80, 0xFF, 0x100, 0x7FFF, 0x8000, 0xFFFF, 0x10000,
+                                    0xFFFFFFFFu};
+    switch (_rng() % 4) {
+    case 0: return ends[_rng() % (sizeof(ends) / sizeof(ends[0]))];
+    case 1: return (uint32_t)_rng() & (uint32_t)_rng() & (uint32_t)_rng();
+    default: {
+        uint32_t x = table->count > 0 ? ygo_table_get(table, column, _rng() % table->count) : 0;
+        return x + (uint32_t)(_rng() % 3) - 1;
+    }
+    }
+}
+
+static void _check_select(const ygo_table_t *table, const ygo_table_pred_t *preds, size_t n) {
+    uint64_t bitmap[TEST_MAX_ROWS / 64 + 2];
+    size_t words = ygo_table_bitmap_words(table->count);
+    memset(bitmap, 0xA5, sizeof(bitmap));
+    size_t selected = ygo_table_select(table, preds, n, bitmap);
+
+    size_t expected = 0;
+    for (size_t row = 0; row < words * YGO_TABLE_BLOCK_ROWS; row++) {
+        int match = row < table->count;
+        for (size_t i = 0; i < n && match; i++) {
+            match = _matches(ygo_table_get(table, preds[i].column, row), preds[i].op,
+                             preds[i].value);
+        }
+        expected += (size_t)match;
+        if (((bitmap[row / 64] >> (row % 64)) & 1u) != (uint64_t)match) {
+            fprintf(stderr, "%s, %u rows, %zu predicates, first %s %s %u: row %zu differs\n",
+                    ygo_table_engine_to_str(ygo_table_active_engine()), table->count, n,
+                    ygo_table_column_to_str(preds[0].column), ygo_table_op_to_str(preds[0].op),
+                    preds[0].value, row);
+            failures++;
+            return;
+        }
+    }
+    CHECK(selected == expected);
+
+    // Nothing written past the bitmap.
+    CHECK(bitmap[words] == 0xA5A5A5A5A5A5A5A5ull);
+}
+
+static void _check_rows(uint32_t count) {
+    ygo_table_t table;
+    size_t capacity = count + (size_t)(_rng() % 100);
+    void *memory = malloc(ygo_table_size(capacity));
+    CHECK(ygo_table_init(&table, memory, capacity) == YGO_BIN_OK);
+    for (uint32_t i = 0; i < count; i++) {
+        ygo_card_t card;
+        _random_card(&card);
+        CHECK(ygo_table_append(&table, &card) == YGO_BIN_OK);
+        CHECK(ygo_table_get(&table, YGO_TABLE_COLUMN_ID, i) == card.id);
+        CHECK(ygo_table_get(&table, YGO_TABLE_COLUMN_ATK, i) == card.atk);
+        CHECK(ygo_table_get(&table, YGO_TABLE_COLUMN_LINK_MARKERS, i) == card.link_markers);
+    }
+
+    for (int e = YGO_TABLE_ENGINE_SCALAR; e <= YGO_TABLE_ENGINE_NEON; e++) {
+        ygo_table_engine_t engine = (ygo_table_engine_t)e;
+        if (!ygo_table_engine_available(engine)) continue;
+        CHECK(ygo_table_select_engine(engine) == engine);
+
+        // Every op on every column, then conjunctions of up to 4 random predicates.
+        _check_select(&table, NULL, 0);
+        for (int c = YGO_TABLE_COLUMN_ID; c <= YGO_TABLE_COLUMN_LINK_MARKERS; c++) {
+            for (int op = YGO_TABLE_OP_EQ; op <= YGO_TABLE_OP_ANY; op++) {
+                ygo_table_pred_t pred = {(ygo_table_column_t)c, (ygo_table_op_t)op, 0};
+                pred.value = _random_value(&table, pred.column);
+                _check_select(&table, &pred, 1);
+            }
+        }
+        for (int k = 0; k < TEST_SELECTS; k++) {
+            ygo_table_pred_t preds[4];
+            size_t n = 1 + (size_t)(_rng() % 4);
+            for (size_t i = 0; i < n; i++) {
+                preds[i].column = (ygo_table_column_t)(_rng() % TEST_COLUMNS);
+                preds[i].op = (ygo_table_op_t)(_rng() % TEST_OPS);
+                preds[i].value = _random_value(&table, preds[i].column);
+            }
+            _check_select(&table, preds, n);
+        }
+    }
+    ygo_table_select_engine(YGO_TABLE_ENGINE_AUTO);
+    free(memory);
+}
+
+int main(void) {
+    // Around each multiple of 16 and 32 rows up to a few blocks, then a few larger tables.
+    for (uint32_t count = 0; count <= 200; count++) _check_rows(count);
+    static const uint32_t counts[] = {255, 256, 257, 1000, 1023, 1024, 1025, TEST_MAX_ROWS};
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) _check_rows(counts[i]);
+
+    // An unknown column or op selects nothing.
+    ygo_table_t table;
+    void *memory = malloc(ygo_table_size(10));
+    CHECK(ygo_table_init(&table, memory, 10) == YGO_BIN_OK);
+    ygo_card_t card;
+    _random_card(&card);
+    for (int i = 0; i < 10; i++) CHECK(ygo_table_append(&table, &card) == YGO_BIN_OK);
+    CHECK(ygo_table_append(&table, &card) == YGO_BIN_ERR_TRUNCATED);
+    uint64_t bitmap[1];
+    ygo_table_pred_t bad[] = {{YGO_TABLE_COLUMN_ATK, YGO_TABLE_OP_GE, 0},
+                              {(ygo_table_column_t)99, YGO_TABLE_OP_EQ, 0}};
+    CHECK(ygo_table_select(&table, bad, 2, bitmap) == 0 && bitmap[0] == 0);
+    bad[1].column = YGO_TABLE_COLUMN_ATK;
+    bad[1].op = (ygo_table_op_t)99;
+    CHECK(ygo_table_select(&table, bad, 2, bitmap) == 0 && bitmap[0] == 0);
+    free(memory);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file ygo_tag_test.c
+ * @brief ygo_tag_diff() over pairs of tag images: applying its writes to the old image gives the
+ * new one, zero-padded to the longer length, pages equal in both are never written, and the magic
+ * word goes last. Pairs are edited cards, cards of different lengths, blank tags and random bytes.
+ */
+
+#include "ygo_tag.h"
+#include "ygo_card.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define TEST_MAX_LEN (3 * (4 + YGO_CARD_BASIC_MAX_LEN))
+#define TEST_MAX_PAGES ((TEST_MAX_LEN + YGO_TAG_PAGE_SIZE - 1) / YGO_TAG_PAGE_SIZE)
+#define TEST_PAIRS 2000
+
+static int failures = 0;
+
+static uint64_t _rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t _rng(void) {
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 7;
+    _rng_state ^= _rng_state << 17;
+    return _rng_state;
+}
+
+static void _random_card(ygo_card_t *card) {
+    memset(card, 0, sizeof(*card));
+    card->id = (uint32_t)(_rng() % 100000000u);
+    card->type = _rng() % 2 == 0 ? YGO_CARD_TYPE_MONSTER : YGO_CARD_TYPE_SPELL;
+    card->attribute = (ygo_attribute_t)(_rng() % 7);
+    card->atk = (uint16_t)(_rng() % 5000);
+    card->def = (uint16_t)(_rng() % 5000);
+    card->level = (uint8_t)(1 + _rng() % 12);
+    size_t len = 1 + (size_t)(_rng() % (YGO_CARD_NAME_MAX_LEN - 1));
+    for (size_t i = 0; i < len; i++) card->name[i] = (char)('a' + _rng() % 26);
+}
+
+/**
+ * One field of the card changed, or the name made longer or shorter.
+ */
+static void _edit_card(ygo_card_t *card) {
+    switch (_rng() % 4) {
+    case 0: card->atk = (uint16_t)(card->atk + 100); break;
+    case 1: card->level = (uint8_t)(card->level % 12 + 1); break;
+    case 2: card->name[_rng() % strlen(card->name)] = 'Z'; break;
+    default: {
+        size_t len = 1 + (size_t)(_rng() % (YGO_CARD_NAME_MAX_LEN - 1));
+        memset(card->name, 0, YGO_CARD_NAME_MAX_LEN);
+        for (size_t i = 0; i < len; i++) card->name[i] = (char)('a' + _rng() % 26);
+        break;
+    }
+    }
+}
+
+/**
+ * A pair of images: 1 or 2 cards and the same cards edited, one more or one less, a blank tag
+ * either side, or random bytes with a few changed, each of its own length.
+ */
+static void _random_pair(uint8_t *old_image, size_t *old_len, uint8_t *new_image, size_t *new_len) {
+    ygo_card_t cards[3];
+    size_t n = 1 + (size_t)(_rng() % 2);
+    for (size_t i = 0; i < n; i++) _random_card(&cards[i]);
+
+    switch (_rng() % 5) {
+    case 0:
+    case 1:
+        *old_len = ygo_card_serialize_many(old_image, cards, n);
+        for (size_t i = 0; i < n; i++) {
+            if (_rng() % 2 == 0) _edit_card(&cards[i]);
+        }
+        // Sometimes a card less or more.
+        if (_rng() % 4 == 0 && n > 1) {
+            n--;
+        } else if (_rng() % 4 == 0) {
+            _random_card(&cards[n++]);
+        }
+        *new_len = ygo_card_serialize_many(new_image, cards, n);
+        break;
+    case 2:
+        *old_len = (size_t)(_rng() % TEST_MAX_LEN);
+        memset(old_image, 0, *old_len);
+        *new_len = ygo_card_serialize_many(new_image, cards, n);
+        break;
+    case 3:
+        *old_len = ygo_card_serialize_many(old_image, cards, n);
+        *new_len = (size_t)(_rng() % TEST_MAX_LEN);
+        memset(new_image, 0, *new_len);
+        break;
+    default:
+        *old_len = (size_t)(_rng() % TEST_MAX_LEN);
+        for (size_t i = 0; i < *old_len; i++) old_image[i] = (uint8_t)_rng();
+        *new_len = _rng() % 2 == 0 ? *old_len : (size_t)(_rng() % TEST_MAX_LEN);
+        memcpy(new_image, old_image, *new_len < *old_len ? *new_len : *old_len);
+        for (size_t i = *old_len; i < *new_len; i++) new_image[i] = (uint8_t)_rng();
+        for (size_t k = 0; k < 4 && *new_len > 0; k++) new_image[_rng() % *new_len] ^= 0x40;
+        break;
+    }
+}
+
+static void _check_pair(const uint8_t *old_image,
+                        size_t old_len,
+                        const uint8_t *new_image,
+                        size_t new_len) {
+    // Both images zero-padded to whole pages of the longer one.
+    size_t len = old_len > new_len ? old_len : new_len;
+    size_t pages = (len + YGO_TAG_PAGE_SIZE - 1) / YGO_TAG_PAGE_SIZE;
+    uint8_t tag[TEST_MAX_PAGES * YGO_TAG_PAGE_SIZE] = {0};
+    uint8_t expected[TEST_MAX_PAGES * YGO_TAG_PAGE_SIZE] = {0};
+    memcpy(tag, old_image, old_len);
+    memcpy(expected, new_image, new_len);
+
+    ygo_tag_page_write_t writes[TEST_MAX_PAGES];
+    size_t n = ygo_tag_diff(writes, TEST_MAX_PAGES, old_image, old_len, new_image, new_len);
+    CHECK(ygo_tag_diff(NULL, 0, old_image, old_len, new_image, new_len) == n);
+
+    // Each page which differs written once, with its new bytes, and no other.
+    int written[TEST_MAX_PAGES] = {0};
+    size_t differing = 0;
+    for (size_t page = 0; page < pages; page++) {
+        size_t offset = page * YGO_TAG_PAGE_SIZE;
+        differing += memcmp(tag + offset, expected + offset, YGO_TAG_PAGE_SIZE) != 0;
+    }
+    CHECK(n == differing);
+    for (size_t i = 0; i < n && i < TEST_MAX_PAGES; i++) {
+        size_t page = writes[i].page;
+        size_t offset = page * YGO_TAG_PAGE_SIZE;
+        if (page >= pages || written[page]++ ||
+            memcmp(tag + offset, expected + offset, YGO_TAG_PAGE_SIZE) == 0 ||
+            memcmp(writes[i].data, expected + offset, YGO_TAG_PAGE_SIZE) != 0) {
+            fprintf(stderr, "%zu to %zu bytes: write %zu of page %zu is wrong\n", old_len, new_len,
+                    i, page);
+            failures++;
+            return;
+        }
+    }
+
+    // The magic word of either image, when it changes, is the last write.
+    ygo_bin_cursor_t cur;
+    int magic = ygo_bin_cursor_begin(&cur, old_image, old_len) == YGO_BIN_OK ||
+                ygo_bin_cursor_begin(&cur, new_image, new_len) == YGO_BIN_OK;
+    CHECK(!magic || !written[0] || writes[n - 1].page == 0);
+
+    ygo_tag_apply(tag, writes, n);
+    CHECK(memcmp(tag, expected, sizeof(tag)) == 0);
+
+    // Cut short, the writes stored are the first ones, and the count is still all of them.
+    ygo_tag_page_write_t some[TEST_MAX_PAGES];
+    size_t max = n / 2;
+    CHECK(ygo_tag_diff(some, max, old_image, old_len, new_image, new_len) == n);
+    CHECK(max == 0 || memcmp(some, writes, max * sizeof(ygo_tag_page_write_t)) == 0);
+}
+
+int main(void) {
+    static uint8_t old_image[TEST_MAX_LEN];
+    static uint8_t new_image[TEST_MAX_LEN];
+
+    for (size_t k = 0; k < TEST_PAIRS; k++) {
+        size_t old_len, new_len;
+        _random_pair(old_image, &old_len, new_image, &new_len);
+        _check_pair(old_image, old_len, new_image, new_len);
+    }
+
+    // The same image, nothing to write. A single changed byte, one page.
+    ygo_card_t card;
+    _random_card(&card);
+    size_t len = ygo_card_serialize(old_image, &card);
+    CHECK(ygo_tag_diff(NULL, 0, old_image, len, old_image, len) == 0);
+    memcpy(new_image, old_image, len);
+    new_image[len / 2] ^= 1;
+    ygo_tag_page_write_t writes[TEST_MAX_PAGES];
+    CHECK(ygo_tag_diff(writes, TEST_MAX_PAGES, old_image, len, new_image, len) == 1);
+    CHECK(writes[0].page == len / 2 / YGO_TAG_PAGE_SIZE);
+    CHECK(ygo_tag_diff(NULL, 0, NULL, 0, NULL, 0) == 0);
+
+    if (failures == 0) printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
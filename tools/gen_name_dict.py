@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""
+Build the 128 word name dictionary of BASIC record version 0x02 from a card list.
+
+The input is a YGOPRODeck cardinfo dump ({"data": [...]} or a bare array of cards, each with a
+"name"), the same file the JSON readers take:
+
+    curl -o cardinfo.json https://db.ygoprodeck.com/api/v7/cardinfo.php
+    tools/gen_name_dict.py cardinfo.json > words.h
+
+The output is the YGO_NAME_WORD_DEFS block of src/ygo_name.c. Words are picked greedily: each
+round takes the substring which saves the most bytes over all names, given the words already
+picked, as ygo_name_pack() would encode them. Ties go to the longer, then the smaller string, so
+the same card list always gives the same table.
+
+The dictionary is part of the format. Records already written with version 0x02 decode with the
+table they were written with, so a regenerated table goes in with a new data version, it never
+replaces the entries of an existing one. To see whether that is worth it, compare the current
+table against a fresh one on today's card list:
+
+    tools/gen_name_dict.py cardinfo.json --evaluate src/ygo_name.c
+"""
+
+import argparse
+import heapq
+import json
+import re
+import sys
+from collections import Counter
+
+WORD_COUNT = 128  # Codes 0x80-0xFF
+NAME_MAX_LEN = 64  # YGO_CARD_NAME_MAX_LEN
+MIN_WORD_LEN = 2  # A one byte word saves nothing
+MAX_WORD_LEN = 16
+COLUMN_LIMIT = 100  # Where the line continuation goes, as clang-format puts it
+
+
+def load_names(path):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+    cards = data["data"] if isinstance(data, dict) else data
+
+    names = set()
+    for card in cards:
+        name = card.get("name") if isinstance(card, dict) else None
+        if not name:
+            continue
+        # Records keep the first YGO_CARD_NAME_MAX_LEN bytes, whole characters only.
+        raw = name.encode("utf-8")[:NAME_MAX_LEN]
+        names.add(raw.decode("utf-8", errors="ignore"))
+    return sorted(names)
+
+
+def substrings(text, covered):
+    """
+    Every candidate word in text, with repeats, except those lying wholly within words already
+    picked: those bytes are taken care of.
+    """
+    # open_before[i]: number of uncovered bytes before i
+    open_before = [0]
+    for c in covered:
+        open_before.append(open_before[-1] + (not c))
+
+    n = len(text)
+    for i in range(n):
+        for j in range(i + MIN_WORD_LEN, min(n, i + MAX_WORD_LEN) + 1):
+            if open_before[j] > open_before[i]:
+                yield text[i:j]
+
+
+def word_cost(word):
+    """Bytes a word takes when spelled out: ASCII is one, everything else is escaped."""
+    return sum(1 if b < 0x80 else 2 for b in word.encode("utf-8"))
+
+
+def parse_cost(text, words):
+    """Bytes ygo_name_pack() makes of text with words: the shortest parse, not the greediest."""
+    raw = text.encode("utf-8")
+    encoded = [w.encode("utf-8") for w in words]
+    n = len(raw)
+    cost = [0] * (n + 1)
+    for i in range(n - 1, -1, -1):
+        cost[i] = (1 if raw[i] < 0x80 else 2) + cost[i + 1]
+        for w in encoded:
+            if raw.startswith(w, i):
+                cost[i] = min(cost[i], 1 + cost[i + len(w)])
+    return cost[0]
+
+
+def pick_words(names, count):
+    """
+    Pick words one at a time. A candidate saves what its occurrences cost with the words picked
+    so far, less the one byte of its code, for every occurrence not already inside a picked word.
+    "Knight" still saves two bytes an occurrence after "ight", "ragon" nothing after "Dragon".
+    """
+    covered = [[False] * len(name) for name in names]
+    counts = Counter()
+    for name, cov in zip(names, covered):
+        counts.update(substrings(name, cov))
+
+    words = []
+
+    # Both the counts and the costs only drop as words are picked, so savings only drop. A heap
+    # entry whose saving went stale is pushed back with the current one when it comes up.
+    def entry(word):
+        saving = counts[word] * (parse_cost(word, words) - 1)
+        return (-saving, -len(word), word)
+
+    heap = [(-counts[w] * (word_cost(w) - 1), -len(w), w) for w in counts]
+    heapq.heapify(heap)
+
+    while heap and len(words) < count:
+        top = heapq.heappop(heap)
+        current = entry(top[2])
+        if current[0] >= 0:
+            continue
+        if current != top:
+            heapq.heappush(heap, current)
+            continue
+
+        best = top[2]
+        words.append(best)
+        for name, cov in zip(names, covered):
+            at = name.find(best)
+            if at < 0:
+                continue
+            counts.subtract(substrings(name, cov))
+            while at >= 0:
+                cov[at : at + len(best)] = [True] * len(best)
+                at = name.find(best, at + len(best))
+            counts.update(substrings(name, cov))
+
+    return words
+
+
+def stored_len(name, words):
+    """Name bytes of a record: the packed form if shorter, as the writer decides."""
+    plain = len(name.encode("utf-8"))
+    return min(plain, parse_cost(name, words))
+
+
+def read_words(path):
+    """The words of the YGO_NAME_WORD_DEFS block in a ygo_name.c."""
+    with open(path, encoding="utf-8") as f:
+        source = f.read()
+    block = source[source.index("#define YGO_NAME_WORD_DEFS") :]
+    block = block[: block.index("\n\n")]
+    return [json.loads(s) for s in re.findall(r'X\(\w+, ("(?:[^"\\]|\\.)*")\)', block)]
+
+
+def macro_id(word, taken):
+    symbols = {"&": "AMP", "-": "DASH", ",": "COMMA", "'": "APOS", ".": "DOT", ":": "COLON"}
+    core = word.strip(" ")
+    ident = re.sub(r"[^A-Z0-9]+", "_", core.upper()).strip("_")
+    if not ident:
+        ident = "_".join(symbols.get(c, "X%02X" % ord(c)) for c in core if c != " ") or "SP"
+    if word.startswith(" "):
+        ident = "SP_" + ident
+    if word.endswith(" ") and word.strip(" "):
+        ident += "_SP"
+    if ident[0].isdigit():
+        ident = "N" + ident
+
+    unique, k = ident, 2
+    while unique in taken:
+        unique, k = "%s_%d" % (ident, k), k + 1
+    taken.add(unique)
+    return unique
+
+
+def c_string(word):
+    out = []
+    for b in word.encode("utf-8"):
+        c = chr(b)
+        if c in '"\\':
+            out.append("\\" + c)
+        elif 0x20 <= b < 0x7F:
+            out.append(c)
+        else:
+            # Octal, which unlike hex stops after three digits whatever follows.
+            out.append("\\%03o" % b)
+    return '"' + "".join(out) + '"'
+
+
+def emit(words):
+    lines = ["#define YGO_NAME_WORD_DEFS(X)"]
+    taken = set()
+    for word in words:
+        lines.append("    X(%s, %s)" % (macro_id(word, taken), c_string(word)))
+    out = []
+    for k, line in enumerate(lines):
+        if k + 1 < len(lines):
+            line = line.ljust(COLUMN_LIMIT - 1) + "\\"
+        out.append(line)
+    return "\n".join(out) + "\n"
+
+
+def report(label, names, words):
+    plain = sum(len(n.encode("utf-8")) for n in names)
+    stored = sum(stored_len(n, words) for n in names)
+    print(
+        "%-10s %6d names, %7d plain bytes, %7d stored (%.1f%%)"
+        % (label, len(names), plain, stored, 100.0 * stored / plain),
+        file=sys.stderr,
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("cardinfo", help="YGOPRODeck cardinfo JSON")
+    parser.add_argument(
+        "--evaluate",
+        metavar="YGO_NAME_C",
+        help="also report how the dictionary in this ygo_name.c does on the same names",
+    )
+    args = parser.parse_args()
+
+    names = load_names(args.cardinfo)
+    words = pick_words(names, WORD_COUNT)
+    if len(words) < WORD_COUNT:
+        sys.exit("only %d words save anything, the table needs %d" % (len(words), WORD_COUNT))
+
+    if args.evaluate:
+        report("current", names, read_words(args.evaluate))
+    report("generated", names, words)
+    sys.stdout.write(emit(words))
+
+
+if __name__ == "__main__":
+    main()